@@ -0,0 +1,1297 @@
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <filesystem>
+#include <sstream>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+#include "MatrixN.h"
+#include "DecompositionN.h"
+#include "MatrixBatchN.h"
+#include "MatrixExprN.h"
+#include "MatrixDyn.h"
+#include "SparseMatrixN.h"
+#include "TransposeN.h"
+#include "MatrixIoN.h"
+#include "ParallelAlgorithmsN.h"
+#include "ThreadPoolN.h"
+#include "SortN.h"
+#include "HashMapN.h"
+#include "ConcurrentHashMapN.h"
+#include "BTreeMapN.h"
+#include "HeapN.h"
+#include "IndexedHeapN.h"
+#include "SlotMapN.h"
+#include "ObjectPoolN.h"
+#include "ListN.h"
+#include "AllocationStatsN.h"
+
+/**
+ * @brief Runs a function repeatedly and returns the best time of one run, in seconds.
+ *
+ * @tparam Fn Type of the function to measure.
+ * @param fn Function to measure.
+ * @param repeat Number of runs.
+ * @return Shortest measured duration.
+ */
+template<typename Fn>
+static double benchBestOf(Fn fn, int repeat = 5)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeat; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Reference product going through the bounds-checked operator(), as MatrixND::multiply used to.
+ */
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+static void naiveMultiply(const MatrixND<T, R, K>& lhs, const MatrixND<T, K, C>& rhs, MatrixND<T, R, C>& result)
+{
+    for (std::size_t i = 0; i < R; ++i)
+    {
+        for (std::size_t j = 0; j < C; ++j)
+        {
+            T sum = T{};
+            for (std::size_t k = 0; k < K; ++k)
+                sum += lhs(i, k) * rhs(k, j);
+            result(i, j) = sum;
+        }
+    }
+}
+
+/**
+ * @brief Compares the reference product with MatrixND::multiply for one square size.
+ */
+template<typename T, std::size_t Size>
+static void benchMatrixMultiplySize(const char* typeName)
+{
+    auto a = std::make_unique<MatrixND<T, Size, Size>>();
+    auto b = std::make_unique<MatrixND<T, Size, Size>>();
+    auto c = std::make_unique<MatrixND<T, Size, Size>>();
+    for (std::size_t i = 0; i < Size * Size; ++i)
+    {
+        a->data()[i] = static_cast<T>(i % 7) * T(0.5);
+        b->data()[i] = static_cast<T>(i % 5) * T(0.25);
+    }
+
+    const double flops = 2.0 * Size * Size * Size;
+    double naive = benchBestOf([&]() { naiveMultiply(*a, *b, *c); });
+    double fast = benchBestOf([&]() { *c = MatrixND<T, Size, Size>::template multiply<Size>(*a, *b); });
+
+    std::cout << "  " << typeName << " " << Size << "x" << Size
+        << " : naive " << naive * 1e3 << " ms (" << flops / naive * 1e-9 << " GFLOP/s)"
+        << ", multiply " << fast * 1e3 << " ms (" << flops / fast * 1e-9 << " GFLOP/s)"
+        << ", speedup x" << naive / fast << std::endl;
+}
+
+static void benchMatrixMultiply()
+{
+    std::cout << "=== Bench MatrixND::multiply ===" << std::endl;
+    benchMatrixMultiplySize<float, 64>("float ");
+    benchMatrixMultiplySize<float, 128>("float ");
+    benchMatrixMultiplySize<float, 256>("float ");
+    benchMatrixMultiplySize<double, 64>("double");
+    benchMatrixMultiplySize<double, 128>("double");
+    benchMatrixMultiplySize<double, 256>("double");
+}
+
+/**
+ * @brief Measures the parallel MatrixDyn product for increasing thread counts.
+ */
+static void benchParallelMultiply()
+{
+    std::cout << "=== Bench parallel MatrixDyn::multiply ===" << std::endl;
+
+    const std::size_t size = 1024;
+    MatrixDyn<float> a(size, size), b(size, size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        for (std::size_t j = 0; j < size; ++j)
+        {
+            a(i, j) = float((i + j) % 7) * 0.5f;
+            b(i, j) = float((i * j) % 5) * 0.25f;
+        }
+    }
+
+    const double flops = 2.0 * size * size * size;
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; ; threads *= 2)
+    {
+        threads = std::min(threads, hardware);
+        ThreadPoolN pool(threads);
+        double seconds = benchBestOf([&]() { MatrixDyn<float>::multiply(pool, a, b); }, 3);
+        std::cout << "  float " << size << "x" << size << " with " << threads << " thread(s) : "
+            << seconds * 1e3 << " ms, " << flops / seconds * 1e-9 << " GFLOP/s" << std::endl;
+        if (threads == hardware)
+            break;
+    }
+}
+
+
+/**
+ * @brief Reference Gaussian elimination with partial pivoting through operator().
+ */
+template<typename T, std::size_t N>
+static VectorND<T, N> naiveSolve(MatrixND<T, N, N> a, VectorND<T, N> b)
+{
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i < N; ++i)
+        {
+            if (std::abs(a(i, k)) > std::abs(a(pivot, k)))
+                pivot = i;
+        }
+        for (std::size_t j = 0; j < N; ++j)
+            std::swap(a(k, j), a(pivot, j));
+        std::swap(b[k], b[pivot]);
+        for (std::size_t i = k + 1; i < N; ++i)
+        {
+            T factor = a(i, k) / a(k, k);
+            for (std::size_t j = k; j < N; ++j)
+                a(i, j) -= factor * a(k, j);
+            b[i] -= factor * b[k];
+        }
+    }
+    VectorND<T, N> x;
+    for (std::size_t i = N; i-- > 0;)
+    {
+        T sum = b[i];
+        for (std::size_t j = i + 1; j < N; ++j)
+            sum -= a(i, j) * x[j];
+        x[i] = sum / a(i, i);
+    }
+    return x;
+}
+
+/**
+ * @brief Solves a batch of small SPD systems with the reference elimination, LuN and CholeskyN.
+ */
+template<std::size_t N>
+static void benchSmallSolvesSize(std::size_t count)
+{
+    std::vector<MatrixND<double, N, N>> matrices(count);
+    std::vector<VectorND<double, N>> rhs(count);
+    std::vector<VectorND<double, N>> solutions(count);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j <= i; ++j)
+            {
+                double value = i == j ? 2.0 * N : double((s + i * 3 + j * 5) % 7) * 0.1;
+                matrices[s](i, j) = value;
+                matrices[s](j, i) = value;
+            }
+            rhs[s][i] = double((s + i) % 11);
+        }
+    }
+
+    double naive = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            solutions[s] = naiveSolve(matrices[s], rhs[s]);
+    });
+    double lu = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            solutions[s] = LuN<double, N>(matrices[s]).solve(rhs[s]);
+    });
+    double chol = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            solutions[s] = CholeskyN<double, N>(matrices[s]).solve(rhs[s]);
+    });
+    double luBatch = benchBestOf([&]() { LuN<double, N>::solveBatch(matrices, rhs, solutions); });
+    double cholBatch = benchBestOf([&]() { CholeskyN<double, N>::solveBatch(matrices, rhs, solutions); });
+
+    std::cout << "  " << count << " systems " << N << "x" << N
+        << " : naive " << naive * 1e3 << " ms, LuN " << lu * 1e3 << " ms, CholeskyN " << chol * 1e3
+        << " ms, LuN::solveBatch " << luBatch * 1e3 << " ms, CholeskyN::solveBatch " << cholBatch * 1e3
+        << " ms, best speedup x" << naive / std::min({ lu, chol, luBatch, cholBatch }) << std::endl;
+}
+
+static void benchSmallSolves()
+{
+    std::cout << "=== Bench small dense solves ===" << std::endl;
+    benchSmallSolvesSize<6>(10000);
+    benchSmallSolvesSize<16>(10000);
+    benchSmallSolvesSize<64>(1000);
+}
+
+
+/**
+ * @brief Compares per-instance loops with the interleaved MatrixBatchN kernels for one order.
+ */
+template<std::size_t N>
+static void benchMatrixBatchSize(std::size_t count)
+{
+    std::vector<MatrixND<float, N, N>> lhs(count);
+    std::vector<MatrixND<float, N, N>> rhs(count);
+    std::vector<MatrixND<float, N, N>> results(count);
+    std::vector<VectorND<float, N>> points(count);
+    std::vector<VectorND<float, N>> transformed(count);
+    std::vector<float> determinants(count);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                lhs[s](i, j) = float((s + i * 3 + j) % 7) * 0.25f + (i == j ? 4.0f : 0.0f);
+                rhs[s](i, j) = float((s * 5 + i + j * 2) % 9) * 0.5f;
+            }
+            points[s][i] = float(i + 1);
+        }
+    }
+    MatrixBatchN<float, N> a(lhs);
+    MatrixBatchN<float, N> b(rhs);
+    MatrixBatchN<float, N> out;
+
+    const int repeat = count < 10000 ? 50 : 5;
+    double loopMultiply = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            results[s] = MatrixND<float, N, N>::template multiply<N>(lhs[s], rhs[s]);
+    }, repeat);
+    double batchMultiply = benchBestOf([&]() { MatrixBatchN<float, N>::multiply(a, b, out); }, repeat);
+
+    double loopInverse = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            results[s] = LuN<float, N>(lhs[s]).inverse();
+    }, repeat);
+    double batchInverse = benchBestOf([&]() { MatrixBatchN<float, N>::inverse(a, out); }, repeat);
+
+    double loopDeterminant = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            determinants[s] = LuN<float, N>(lhs[s]).determinant();
+    }, repeat);
+    double batchDeterminant = benchBestOf([&]() { MatrixBatchN<float, N>::determinant(a, determinants); }, repeat);
+
+    double loopTransform = benchBestOf([&]() {
+        for (std::size_t s = 0; s < count; ++s)
+            transformed[s] = lhs[s] * points[s];
+    }, repeat);
+    double batchTransform = benchBestOf([&]() { MatrixBatchN<float, N>::transform(a, points, transformed); }, repeat);
+
+    auto report = [](const char* name, double loop, double batch) {
+        std::cout << "    " << name << " : loop " << loop * 1e3 << " ms, batch " << batch * 1e3
+            << " ms, speedup x" << loop / batch << std::endl;
+    };
+    std::cout << "  " << count << " float " << N << "x" << N << " matrices" << std::endl;
+    report("multiply   ", loopMultiply, batchMultiply);
+    report("inverse    ", loopInverse, batchInverse);
+    report("determinant", loopDeterminant, batchDeterminant);
+    report("transform  ", loopTransform, batchTransform);
+}
+
+static void benchMatrixBatch()
+{
+    std::cout << "=== Bench MatrixBatchN ===" << std::endl;
+    benchMatrixBatchSize<3>(4096);
+    benchMatrixBatchSize<4>(4096);
+    benchMatrixBatchSize<3>(200000);
+    benchMatrixBatchSize<4>(200000);
+}
+
+
+/**
+ * @brief Sparse matrix-vector products on the Laplacian of a 2D grid, against a scalar CSR loop.
+ */
+static void benchSparseMultiply()
+{
+    std::cout << "=== Bench SparseMatrixN ===" << std::endl;
+
+    const std::size_t side = 400;
+    const std::size_t n = side * side;
+    VectorN<TripletN<double>> triplets;
+    triplets.reserve(n * 5);
+    for (std::size_t y = 0; y < side; ++y)
+    {
+        for (std::size_t x = 0; x < side; ++x)
+        {
+            const std::size_t i = y * side + x;
+            double degree = 0.0;
+            auto link = [&](std::size_t j) { triplets.push_back({ i, j, -1.0 }); degree += 1.0; };
+            if (x > 0) link(i - 1);
+            if (x + 1 < side) link(i + 1);
+            if (y > 0) link(i - side);
+            if (y + 1 < side) link(i + side);
+            triplets.push_back({ i, i, degree });
+        }
+    }
+    SparseMatrixN<double> laplacian(n, n, triplets);
+    std::vector<double> in(n), out(n);
+    for (std::size_t i = 0; i < n; ++i)
+        in[i] = double(i % 13) * 0.1;
+
+    const auto& offsets = laplacian.offsets();
+    const auto& indices = laplacian.indices();
+    const auto& values = laplacian.values();
+    double naive = benchBestOf([&]() {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double sum = 0.0;
+            for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+                sum += values[k] * in[indices[k]];
+            out[i] = sum;
+        }
+    }, 20);
+    ThreadPoolN single(1);
+    double serial = benchBestOf([&]() { laplacian.multiply(in.data(), out.data(), single); }, 20);
+    double parallel = benchBestOf([&]() { laplacian.multiply(in.data(), out.data()); }, 20);
+
+    std::cout << "  " << n << " x " << n << " grid Laplacian, " << laplacian.nonZeros() << " non-zeros, "
+        << laplacian.memoryBytes() / 1024 << " KiB instead of " << n * n * sizeof(double) / (1024 * 1024)
+        << " MiB dense" << std::endl;
+    std::cout << "    scalar loop " << naive * 1e3 << " ms, SpMV 1 thread " << serial * 1e3 << " ms, SpMV "
+        << ThreadPoolN::global().threadCount() << " threads " << parallel * 1e3 << " ms" << std::endl;
+}
+
+
+/**
+ * @brief Compares strided double loops with the cache-oblivious TransposeN kernels.
+ */
+static void benchTranspose()
+{
+    std::cout << "=== Bench TransposeN ===" << std::endl;
+
+    for (std::size_t n : { 512, 2048 })
+    {
+        std::vector<float> src(n * n), dst(n * n);
+        for (std::size_t i = 0; i < n * n; ++i)
+            src[i] = float(i % 1000);
+
+        double naiveCopy = benchBestOf([&]() {
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    dst[j * n + i] = src[i * n + j];
+        });
+        double fastCopy = benchBestOf([&]() { TransposeN<float>::copy(n, n, src.data(), n, dst.data(), n); });
+        double naiveInPlace = benchBestOf([&]() {
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = i + 1; j < n; ++j)
+                    std::swap(src[i * n + j], src[j * n + i]);
+        });
+        double fastInPlace = benchBestOf([&]() { TransposeN<float>::inPlace(n, src.data(), n); });
+
+        std::cout << "  float " << n << "x" << n << " : out-of-place naive " << naiveCopy * 1e3 << " ms, TransposeN "
+            << fastCopy * 1e3 << " ms (x" << naiveCopy / fastCopy << "), in-place naive " << naiveInPlace * 1e3
+            << " ms, TransposeN " << fastInPlace * 1e3 << " ms (x" << naiveInPlace / fastInPlace << ")" << std::endl;
+    }
+}
+
+
+/**
+ * @brief Compares operator<< with the MatrixIoN text writer, and times .npy save, load and mapping.
+ */
+static void benchMatrixIo()
+{
+    std::cout << "=== Bench MatrixIoN ===" << std::endl;
+
+    const std::size_t n = 1024;
+    MatrixDyn<double> matrix(n, n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            matrix(i, j) = double(i * n + j) / 7.0;
+
+    double stream = benchBestOf([&]() { std::ostringstream out; out << matrix; }, 3);
+    double text = benchBestOf([&]() { std::ostringstream out; MatrixIoN::writeText(out, matrix); }, 3);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "containers_bench_matrix.npy").string();
+    double save = benchBestOf([&]() { MatrixIoN::saveNpy(path, matrix); }, 3);
+    double load = benchBestOf([&]() { MatrixIoN::loadNpy<MatrixDyn<double>>(path); }, 3);
+    double map = benchBestOf([&]() { NpyMappedN<double> mapped(path); }, 3);
+    std::filesystem::remove(path);
+
+    std::cout << "  double " << n << "x" << n << " : operator<< " << stream * 1e3 << " ms, writeText " << text * 1e3
+        << " ms (x" << stream / text << "), saveNpy " << save * 1e3 << " ms, loadNpy " << load * 1e3
+        << " ms, NpyMappedN " << map * 1e3 << " ms" << std::endl;
+}
+
+
+static void benchParallelAlgorithms()
+{
+    std::cout << "=== Bench ParallelAlgorithmsN ===" << std::endl;
+
+    const std::size_t n = 4000000;
+    VectorN<double> input(n);
+    std::uint64_t state = 88172645463325252ull;
+    for (auto& value : input)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        value = double(state >> 11) * 0x1.0p-53;
+    }
+    VectorN<double> work(n);
+    ThreadPoolN& pool = ThreadPoolN::global();
+
+    double seqSort = benchBestOf([&]() { work = input; std::sort(work.begin(), work.end()); }, 3);
+    double parSort = benchBestOf([&]() { work = input; ParallelAlgorithmsN::sort(work); }, 3);
+    double seqStable = benchBestOf([&]() { work = input; std::stable_sort(work.begin(), work.end()); }, 3);
+    double parStable = benchBestOf([&]() { work = input; ParallelAlgorithmsN::stable_sort(work); }, 3);
+
+    volatile double sink = 0.0;
+    double seqReduce = benchBestOf([&]() { sink = std::accumulate(input.begin(), input.end(), 0.0); });
+    double parReduce = benchBestOf([&]() { sink = ParallelAlgorithmsN::reduce(input, 0.0); });
+    double seqScan = benchBestOf([&]() { std::inclusive_scan(input.begin(), input.end(), work.begin()); });
+    double parScan = benchBestOf([&]() { ParallelAlgorithmsN::inclusive_scan(input, work); });
+    double seqTransform = benchBestOf([&]() { std::transform(input.begin(), input.end(), work.begin(), [](double v) { return std::sqrt(v); }); });
+    double parTransform = benchBestOf([&]() { ParallelAlgorithmsN::transform(input, work, [](double v) { return std::sqrt(v); }); });
+    double seqPartition = benchBestOf([&]() { work = input; std::stable_partition(work.begin(), work.end(), [](double v) { return v < 0.5; }); }, 3);
+    double parPartition = benchBestOf([&]() { work = input; ParallelAlgorithmsN::partition(work, [](double v) { return v < 0.5; }); }, 3);
+
+    auto line = [](const char* name, double seq, double par)
+    {
+        std::cout << "  " << name << " : std " << seq * 1e3 << " ms, parallel " << par * 1e3 << " ms (x" << seq / par << ")" << std::endl;
+    };
+    std::cout << "  " << n << " doubles, " << pool.threadCount() << " worker threads" << std::endl;
+    line("sort            ", seqSort, parSort);
+    line("stable_sort     ", seqStable, parStable);
+    line("reduce          ", seqReduce, parReduce);
+    line("inclusive_scan  ", seqScan, parScan);
+    line("transform (sqrt)", seqTransform, parTransform);
+    line("partition       ", seqPartition, parPartition);
+}
+
+static void benchSort()
+{
+    std::cout << "=== Bench SortN ===" << std::endl;
+
+    const std::size_t n = 4000000;
+    std::uint64_t state = 88172645463325252ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    VectorN<std::uint32_t> integers(n);
+    for (auto& value : integers)
+        value = std::uint32_t(next());
+    VectorN<double> reals(n);
+    for (auto& value : reals)
+        value = double(std::int64_t(next() >> 11) - (std::int64_t(1) << 52)) * 0x1.0p-40;
+    VectorN<double> nearlySorted(n);
+    for (std::size_t i = 0; i < n; ++i)
+        nearlySorted[i] = double(i) + ((next() & 1023) == 0 ? 1e7 : 0.0);
+    ThreadPoolN& pool = ThreadPoolN::global();
+
+    auto line = [](const char* name, double reference, double measured)
+    {
+        std::cout << "  " << name << " : " << measured * 1e3 << " ms (x" << reference / measured << " vs std::sort)" << std::endl;
+    };
+    std::cout << "  " << n << " elements, " << pool.threadCount() << " worker threads" << std::endl;
+
+    VectorN<std::uint32_t> intWork(n);
+    double stdInt = benchBestOf([&]() { intWork = integers; std::sort(intWork.begin(), intWork.end()); }, 3);
+    double pdqInt = benchBestOf([&]() { intWork = integers; SortN::pdqsort(intWork); }, 3);
+    double radixInt = benchBestOf([&]() { intWork = integers; SortN::radix_sort(intWork); }, 3);
+    double parInt = benchBestOf([&]() { intWork = integers; SortN::sort(intWork); }, 3);
+    std::cout << "  uint32, random: std::sort " << stdInt * 1e3 << " ms" << std::endl;
+    line("  pdqsort       ", stdInt, pdqInt);
+    line("  radix_sort    ", stdInt, radixInt);
+    line("  parallel sort ", stdInt, parInt);
+
+    VectorN<double> realWork(n);
+    double stdReal = benchBestOf([&]() { realWork = reals; std::sort(realWork.begin(), realWork.end()); }, 3);
+    double pdqReal = benchBestOf([&]() { realWork = reals; SortN::pdqsort(realWork); }, 3);
+    double radixReal = benchBestOf([&]() { realWork = reals; SortN::radix_sort(realWork); }, 3);
+    std::cout << "  double, random: std::sort " << stdReal * 1e3 << " ms" << std::endl;
+    line("  pdqsort       ", stdReal, pdqReal);
+    line("  radix_sort    ", stdReal, radixReal);
+
+    double stdNearly = benchBestOf([&]() { realWork = nearlySorted; std::sort(realWork.begin(), realWork.end()); }, 3);
+    double pdqNearly = benchBestOf([&]() { realWork = nearlySorted; SortN::pdqsort(realWork); }, 3);
+    std::cout << "  double, sorted with 0.1% outliers: std::sort " << stdNearly * 1e3 << " ms" << std::endl;
+    line("  pdqsort       ", stdNearly, pdqNearly);
+
+    const std::size_t listSize = 500000;
+    ListN<std::uint32_t> list;
+    for (std::size_t i = 0; i < listSize; ++i)
+        list.push_back(integers[i]);
+    double listRelink = benchBestOf([&]()
+    {
+        list.sort(std::greater<>());
+        list.sort();
+    }, 3) / 2;
+    double listCopy = benchBestOf([&]()
+    {
+        ParallelAlgorithmsN::sort(list, std::greater<>(), pool);
+        ParallelAlgorithmsN::sort(list, std::less<>(), pool);
+    }, 3) / 2;
+    std::cout << "  ListN, " << listSize << " uint32: relinking merge sort " << listRelink * 1e3
+              << " ms, sort through a vector " << listCopy * 1e3 << " ms" << std::endl;
+}
+
+static void benchHashMap()
+{
+    std::cout << "=== Bench HashMapN ===" << std::endl;
+
+    const std::size_t n = 1000000;
+    std::uint64_t state = 88172645463325252ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    VectorN<std::uint64_t> keys(n), missing(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        keys[i] = next() | 1;
+        missing[i] = next() & ~std::uint64_t(1);
+    }
+
+    auto run = [&](auto& map, double& insertTime, double& hitTime, double& missTime, double& eraseTime)
+    {
+        volatile std::uint64_t sink = 0;
+        insertTime = benchBestOf([&]()
+        {
+            map.clear();
+            for (std::size_t i = 0; i < n; ++i)
+                map[keys[i]] = i;
+        }, 3);
+        hitTime = benchBestOf([&]()
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                sum += map.find(keys[i])->second;
+            sink = sum;
+        }, 3);
+        missTime = benchBestOf([&]()
+        {
+            std::uint64_t found = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                found += map.find(missing[i]) != map.end();
+            sink = found;
+        }, 3);
+        eraseTime = benchBestOf([&]()
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                map[keys[i]] = i;
+            for (std::size_t i = 0; i < n; ++i)
+                map.erase(keys[i]);
+        }, 3);
+    };
+
+    double stdInsert, stdHit, stdMiss, stdErase, swissInsert, swissHit, swissMiss, swissErase;
+    {
+        std::unordered_map<std::uint64_t, std::size_t> map;
+        run(map, stdInsert, stdHit, stdMiss, stdErase);
+    }
+    {
+        HashMapN<std::uint64_t, std::size_t> map;
+        run(map, swissInsert, swissHit, swissMiss, swissErase);
+    }
+
+    auto line = [](const char* name, double reference, double measured)
+    {
+        std::cout << "  " << name << " : std::unordered_map " << reference * 1e3 << " ms, HashMapN " << measured * 1e3
+                  << " ms (x" << reference / measured << ")" << std::endl;
+    };
+    std::cout << "  " << n << " uint64 keys" << std::endl;
+    line("insert        ", stdInsert, swissInsert);
+    line("find (hit)    ", stdHit, swissHit);
+    line("find (miss)   ", stdMiss, swissMiss);
+    line("insert + erase", stdErase, swissErase);
+
+    const std::size_t wordCount = 200000;
+    VectorN<std::string> words(wordCount);
+    for (auto& word : words)
+        word = "key-" + std::to_string(next() % 100000000);
+    std::unordered_map<std::string, int> stdWords;
+    HashMapN<std::string, int> swissWords;
+    for (std::size_t i = 0; i < wordCount; ++i)
+    {
+        stdWords[words[i]] = int(i);
+        swissWords[words[i]] = int(i);
+    }
+    volatile int sink = 0;
+    double stdLookup = benchBestOf([&]()
+    {
+        int sum = 0;
+        for (const auto& word : words)
+            sum += stdWords.find(word)->second;
+        sink = sum;
+    }, 3);
+    double swissLookup = benchBestOf([&]()
+    {
+        int sum = 0;
+        for (const auto& word : words)
+            sum += swissWords.find(std::string_view(word))->second;
+        sink = sum;
+    }, 3);
+    std::cout << "  " << wordCount << " string keys" << std::endl;
+    line("find (hit)    ", stdLookup, swissLookup);
+}
+
+static void benchConcurrentHashMap()
+{
+    std::cout << "=== Bench ConcurrentHashMapN ===" << std::endl;
+
+    // 90% lookups, 10% insert_or_assign over 1M keys, half of them present.
+    const std::size_t keySpace = 1000000;
+    const std::size_t operationsPerThread = 400000;
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::atomic<std::uint64_t> sink{ 0 };
+    auto measure = [&](unsigned threadCount, auto& findFn, auto& writeFn)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::uint64_t state = 88172645463325252ull + 7919 * t;
+                std::uint64_t found = 0;
+                for (std::size_t i = 0; i < operationsPerThread; ++i)
+                {
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    const std::uint64_t key = state % keySpace;
+                    if ((state >> 40) % 10 == 0)
+                        writeFn(key, i);
+                    else
+                        found += findFn(key);
+                }
+                sink += found;
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return double(threadCount * operationsPerThread) / seconds * 1e-6;
+    };
+
+    std::cout << "  90% find / 10% insert_or_assign, " << keySpace << " keys, Mops/s" << std::endl;
+    std::vector<unsigned> threadCounts;
+    for (unsigned threadCount = 1; threadCount < maxThreads; threadCount *= 2)
+        threadCounts.push_back(threadCount);
+    threadCounts.push_back(maxThreads);
+    for (unsigned threadCount : threadCounts)
+    {
+        ConcurrentHashMapN<std::uint64_t, std::uint64_t> concurrent;
+        std::unordered_map<std::uint64_t, std::uint64_t> locked;
+        std::mutex lockedMutex;
+        for (std::uint64_t key = 0; key < keySpace; key += 2)
+        {
+            concurrent.insert(key, key);
+            locked[key] = key;
+        }
+
+        auto concurrentFind = [&](std::uint64_t key) { return concurrent.contains(key) ? 1 : 0; };
+        auto concurrentWrite = [&](std::uint64_t key, std::uint64_t value) { concurrent.insert_or_assign(key, value); };
+        auto lockedFind = [&](std::uint64_t key)
+        {
+            std::lock_guard<std::mutex> lock(lockedMutex);
+            return locked.count(key) ? 1 : 0;
+        };
+        auto lockedWrite = [&](std::uint64_t key, std::uint64_t value)
+        {
+            std::lock_guard<std::mutex> lock(lockedMutex);
+            locked[key] = value;
+        };
+        const double concurrentRate = measure(threadCount, concurrentFind, concurrentWrite);
+        const double lockedRate = measure(threadCount, lockedFind, lockedWrite);
+        std::cout << "  " << threadCount << " threads: std::unordered_map + mutex " << lockedRate
+                  << ", ConcurrentHashMapN " << concurrentRate << " (x" << concurrentRate / lockedRate << ")" << std::endl;
+    }
+}
+
+static void benchBTreeMap()
+{
+    std::cout << "=== Bench BTreeMapN ===" << std::endl;
+
+    const std::size_t n = 1000000;
+    std::uint64_t state = 88172645463325252ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    VectorN<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i)
+        keys[i] = next() >> 1;
+    VectorN<std::uint64_t> sortedKeys = keys;
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+    sortedKeys.resize(std::size_t(std::unique(sortedKeys.begin(), sortedKeys.end()) - sortedKeys.begin()));
+    VectorN<std::uint64_t> sortedValues(sortedKeys.size());
+    for (std::size_t i = 0; i < sortedKeys.size(); ++i)
+        sortedValues[i] = i;
+
+    // Range scans of 1000 consecutive keys from random starting points.
+    const std::size_t scans = 2000;
+    const std::size_t scanLength = 1000;
+
+    auto run = [&](auto& map, double& insertTime, double& findTime, double& scanTime, double& eraseTime)
+    {
+        volatile std::uint64_t sink = 0;
+        insertTime = benchBestOf([&]()
+        {
+            map.clear();
+            for (std::size_t i = 0; i < n; ++i)
+                map[keys[i]] = i;
+        }, 3);
+        findTime = benchBestOf([&]()
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                sum += map.find(keys[i])->second;
+            sink = sum;
+        }, 3);
+        scanTime = benchBestOf([&]()
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t s = 0; s < scans; ++s)
+            {
+                auto it = map.lower_bound(keys[s]);
+                for (std::size_t i = 0; i < scanLength && it != map.end(); ++i, ++it)
+                    sum += it->second;
+            }
+            sink = sum;
+        }, 3);
+        eraseTime = benchBestOf([&]()
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                map[keys[i]] = i;
+            for (std::size_t i = 0; i < n; ++i)
+                map.erase(keys[i]);
+        }, 3);
+    };
+
+    double stdInsert, stdFind, stdScan, stdErase, treeInsert, treeFind, treeScan, treeErase;
+    {
+        std::map<std::uint64_t, std::size_t> map;
+        run(map, stdInsert, stdFind, stdScan, stdErase);
+    }
+    {
+        BTreeMapN<std::uint64_t, std::size_t> map;
+        run(map, treeInsert, treeFind, treeScan, treeErase);
+    }
+
+    BTreeMapN<std::uint64_t, std::uint64_t> loaded;
+    double bulkTime = benchBestOf([&]() { loaded.bulk_load(sortedKeys, sortedValues); }, 3);
+    double sortedInsertTime = benchBestOf([&]()
+    {
+        std::map<std::uint64_t, std::uint64_t> map;
+        for (std::size_t i = 0; i < sortedKeys.size(); ++i)
+            map.emplace_hint(map.end(), sortedKeys[i], sortedValues[i]);
+    }, 3);
+
+    auto line = [](const char* name, double reference, double measured)
+    {
+        std::cout << "  " << name << " : std::map " << reference * 1e3 << " ms, BTreeMapN " << measured * 1e3
+                  << " ms (x" << reference / measured << ")" << std::endl;
+    };
+    std::cout << "  " << n << " uint64 keys" << std::endl;
+    line("insert       ", stdInsert, treeInsert);
+    line("find (hit)   ", stdFind, treeFind);
+    line("range scan   ", stdScan, treeScan);
+    line("insert+erase ", stdErase, treeErase);
+    line("sorted build ", sortedInsertTime, bulkTime);
+}
+
+static void benchHeap()
+{
+    std::cout << "=== Bench HeapN ===" << std::endl;
+
+    const std::size_t n = 1000000;
+    std::uint64_t state = 88172645463325252ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    VectorN<std::uint64_t> values(n);
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = next();
+
+    volatile std::uint64_t sink = 0;
+    double stdPushPop = benchBestOf([&]()
+    {
+        std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> queue;
+        for (std::size_t i = 0; i < n; ++i)
+            queue.push(values[i]);
+        std::uint64_t sum = 0;
+        while (!queue.empty())
+        {
+            sum += queue.top();
+            queue.pop();
+        }
+        sink = sum;
+    }, 3);
+    double heapPushPop = benchBestOf([&]()
+    {
+        HeapN<std::uint64_t> heap;
+        for (std::size_t i = 0; i < n; ++i)
+            heap.push(values[i]);
+        std::uint64_t sum = 0;
+        while (!heap.empty())
+        {
+            sum += heap.top();
+            heap.pop();
+        }
+        sink = sum;
+    }, 3);
+    double stdHeapify = benchBestOf([&]()
+    {
+        std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> queue(
+            std::greater<std::uint64_t>(), std::vector<std::uint64_t>(values.begin(), values.end()));
+        sink = queue.top();
+    }, 3);
+    double heapHeapify = benchBestOf([&]()
+    {
+        HeapN<std::uint64_t> heap(values);
+        sink = heap.top();
+    }, 3);
+
+    // Dijkstra on a grid: decrease-key in place against std::priority_queue with stale entries.
+    const std::size_t side = 700;
+    const std::size_t nodes = side * side;
+    VectorN<std::uint32_t> cost(nodes);
+    for (std::size_t i = 0; i < nodes; ++i)
+        cost[i] = std::uint32_t(next() % 100) + 1;
+    auto neighbours = [side](std::size_t node, std::size_t* out)
+    {
+        std::size_t count = 0;
+        const std::size_t x = node % side, y = node / side;
+        if (x > 0)
+            out[count++] = node - 1;
+        if (x + 1 < side)
+            out[count++] = node + 1;
+        if (y > 0)
+            out[count++] = node - side;
+        if (y + 1 < side)
+            out[count++] = node + side;
+        return count;
+    };
+    double stdDijkstra = benchBestOf([&]()
+    {
+        using Item = std::pair<std::uint32_t, std::size_t>;
+        std::vector<std::uint32_t> distance(nodes, std::numeric_limits<std::uint32_t>::max());
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        distance[0] = 0;
+        queue.push({ 0, 0 });
+        std::size_t adjacent[4];
+        while (!queue.empty())
+        {
+            const auto [dist, node] = queue.top();
+            queue.pop();
+            if (dist != distance[node])
+                continue;
+            for (std::size_t k = 0, count = neighbours(node, adjacent); k < count; ++k)
+            {
+                const std::uint32_t candidate = dist + cost[adjacent[k]];
+                if (candidate < distance[adjacent[k]])
+                {
+                    distance[adjacent[k]] = candidate;
+                    queue.push({ candidate, adjacent[k] });
+                }
+            }
+        }
+        sink = distance[nodes - 1];
+    }, 3);
+    double indexedDijkstra = benchBestOf([&]()
+    {
+        // Nodes enter the heap when first reached; handles are kept per node to decrease them.
+        constexpr std::size_t unseen = std::numeric_limits<std::size_t>::max();
+        constexpr std::size_t done = unseen - 1;
+        std::vector<std::size_t> handle(nodes, unseen);
+        std::vector<std::size_t> nodeOf(nodes);
+        IndexedHeapN<std::uint32_t> frontier;
+        handle[0] = frontier.push(0);
+        nodeOf[handle[0]] = 0;
+        std::uint32_t last = 0;
+        std::size_t adjacent[4];
+        while (!frontier.empty())
+        {
+            const auto [top, dist] = frontier.take();
+            const std::size_t node = nodeOf[top];
+            handle[node] = done;
+            last = dist;
+            for (std::size_t k = 0, count = neighbours(node, adjacent); k < count; ++k)
+            {
+                const std::size_t next = adjacent[k];
+                const std::uint32_t candidate = dist + cost[next];
+                if (handle[next] == unseen)
+                {
+                    handle[next] = frontier.push(candidate);
+                    nodeOf[handle[next]] = next;
+                }
+                else if (handle[next] != done && candidate < frontier[handle[next]])
+                {
+                    frontier.decrease_key(handle[next], candidate);
+                }
+            }
+        }
+        sink = last;
+    }, 3);
+
+    auto line = [](const char* name, const char* reference, double referenceTime, const char* measured, double measuredTime)
+    {
+        std::cout << "  " << name << " : " << reference << " " << referenceTime * 1e3 << " ms, " << measured << " "
+                  << measuredTime * 1e3 << " ms (x" << referenceTime / measuredTime << ")" << std::endl;
+    };
+    std::cout << "  " << n << " uint64 values, " << side << "x" << side << " grid" << std::endl;
+    line("push+pop", "std::priority_queue", stdPushPop, "HeapN", heapPushPop);
+    line("heapify ", "std::priority_queue", stdHeapify, "HeapN", heapHeapify);
+    line("dijkstra", "std::priority_queue (lazy)", stdDijkstra, "IndexedHeapN", indexedDijkstra);
+}
+
+static void benchSlotMap()
+{
+    std::cout << "=== Bench SlotMapN ===" << std::endl;
+
+    struct Particle
+    {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        float vx = 1.0f, vy = 2.0f, vz = 3.0f;
+    };
+    const std::size_t n = 1000000;
+    const std::size_t churn = n / 10;
+    std::uint64_t state = 88172645463325252ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    // Both containers are built, then churned: 10% of the elements, picked at random, are erased
+    // and re-inserted, three times. ListN nodes end up scattered as in a long-running program.
+    ListN<Particle> list;
+    std::vector<ListN<Particle>::iterator> listHandles;
+    SlotMapN<Particle> slots;
+    std::vector<SlotMapN<Particle>::Handle> slotHandles;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        list.push_back(Particle());
+        listHandles.push_back(--list.end());
+        slotHandles.push_back(slots.insert(Particle()));
+    }
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    double listChurn = 1e30, slotChurn = 1e30;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (std::size_t i = 0; i < churn; ++i)
+            std::swap(order[i], order[i + std::size_t(next() % (n - i))]);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < churn; ++i)
+        {
+            list.erase(listHandles[order[i]]);
+            list.push_back(Particle());
+            listHandles[order[i]] = --list.end();
+        }
+        listChurn = std::min(listChurn, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < churn; ++i)
+        {
+            slots.erase(slotHandles[order[i]]);
+            slotHandles[order[i]] = slots.insert(Particle());
+        }
+        slotChurn = std::min(slotChurn, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    volatile float sink = 0.0f;
+    double listIterate = benchBestOf([&]()
+    {
+        for (Particle& p : list)
+        {
+            p.x += p.vx;
+            p.y += p.vy;
+            p.z += p.vz;
+        }
+        sink = list.front().x;
+    });
+    double slotIterate = benchBestOf([&]()
+    {
+        for (Particle& p : slots)
+        {
+            p.x += p.vx;
+            p.y += p.vy;
+            p.z += p.vz;
+        }
+        sink = slots.data()[0].x;
+    });
+    double listLookup = benchBestOf([&]()
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < n; i += 7)
+            sum += (*listHandles[i]).x;
+        sink = sum;
+    });
+    double slotLookup = benchBestOf([&]()
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < n; i += 7)
+            sum += slots[slotHandles[i]].x;
+        sink = sum;
+    });
+
+    auto line = [](const char* name, double reference, double measured)
+    {
+        std::cout << "  " << name << " : ListN " << reference * 1e3 << " ms, SlotMapN " << measured * 1e3
+                  << " ms (x" << reference / measured << ")" << std::endl;
+    };
+    std::cout << "  " << n << " particles of 24 bytes" << std::endl;
+    line("erase+insert 10%", listChurn, slotChurn);
+    line("iterate         ", listIterate, slotIterate);
+    line("lookup by handle", listLookup, slotLookup);
+}
+
+static void benchObjectPool()
+{
+    std::cout << "=== Bench ObjectPoolN ===" << std::endl;
+
+    // Intrusive task objects churned through a list: a window of live objects, oldest destroyed first.
+    struct Task
+    {
+        IntrusiveListHook hook;
+        std::uint64_t id = 0;
+        double payload[4] = {};
+
+        explicit Task(std::uint64_t value) : id(value) {}
+    };
+    using TaskList = IntrusiveList<Task, &Task::hook>;
+    const std::size_t operations = 2000000;
+    const std::size_t window = 4096;
+
+    auto churn = [&](auto create, auto destroy)
+    {
+        TaskList live;
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < operations; ++i)
+        {
+            live.push_back(*create(i));
+            if (live.size() > window)
+            {
+                Task& oldest = live.front();
+                sum += oldest.id;
+                live.pop_front();
+                destroy(&oldest);
+            }
+        }
+        while (!live.empty())
+        {
+            Task& oldest = live.front();
+            live.pop_front();
+            destroy(&oldest);
+        }
+        return sum;
+    };
+
+    std::atomic<std::uint64_t> sink{ 0 };
+    auto heapCreate = [](std::uint64_t id) { return new Task(id); };
+    auto heapDestroy = [](Task* task) { delete task; };
+    ObjectPoolN<Task> pool;
+    auto poolCreate = [&pool](std::uint64_t id) { return pool.create(id); };
+    auto poolDestroy = [&pool](Task* task) { pool.destroy(task); };
+
+    double heapTime = benchBestOf([&]() { sink += churn(heapCreate, heapDestroy); }, 3);
+    double poolTime = benchBestOf([&]() { sink += churn(poolCreate, poolDestroy); }, 3);
+    std::cout << "  " << operations << " create/destroy, " << window << " live : new/delete " << heapTime * 1e3
+              << " ms, ObjectPoolN " << poolTime * 1e3 << " ms (x" << heapTime / poolTime << ")" << std::endl;
+
+    const unsigned threadCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    auto parallel = [&](auto create, auto destroy)
+    {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threadCount; ++t)
+            threads.emplace_back([&]() { sink += churn(create, destroy); });
+        for (std::thread& thread : threads)
+            thread.join();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    ObjectPoolN<Task> uncachedPool(ObjectPoolN<Task>::DefaultSlabObjects, false);
+    auto uncachedCreate = [&uncachedPool](std::uint64_t id) { return uncachedPool.create(id); };
+    auto uncachedDestroy = [&uncachedPool](Task* task) { uncachedPool.destroy(task); };
+    const double heapParallel = parallel(heapCreate, heapDestroy);
+    const double poolParallel = parallel(poolCreate, poolDestroy);
+    const double uncachedParallel = parallel(uncachedCreate, uncachedDestroy);
+    std::cout << "  " << threadCount << " threads : new/delete " << heapParallel * 1e3 << " ms, ObjectPoolN "
+              << poolParallel * 1e3 << " ms (x" << heapParallel / poolParallel << "), without thread cache "
+              << uncachedParallel * 1e3 << " ms" << std::endl;
+    const auto stats = pool.stats();
+    std::cout << "  pool stats: live " << stats.live << ", peak " << stats.peak << ", slabs " << stats.slabs
+              << ", cached " << stats.cached << std::endl;
+}
+
+static void benchPmr()
+{
+    std::cout << "=== Bench pmr containers ===" << std::endl;
+
+    // A request builds a small container graph (rows of values, a work list, an index) and drops it.
+    const std::size_t requests = 20000;
+    const int rowCount = 32;
+    const int listLength = 64;
+
+    auto handle = [&](auto& rows, auto& work, auto& index, int seed)
+    {
+        for (int r = 0; r < rowCount; ++r)
+        {
+            rows.emplace_back(rows.get_allocator());
+            for (int c = 0; c < 16 + (r + seed) % 16; ++c)
+                rows.back().push_back(r * c + seed);
+        }
+        for (int i = 0; i < listLength; ++i)
+            work.push_back((i * 7919 + seed) % 1000);
+        for (int i = 0; i < listLength; ++i)
+            index[(i * 31 + seed) % 4096] = i;
+        std::uint64_t sum = 0;
+        for (const auto& row : rows)
+            sum += std::uint64_t(row.back());
+        for (int value : work)
+            sum += std::uint64_t(value);
+        return sum + index.size();
+    };
+
+    std::atomic<std::uint64_t> sink{ 0 };
+    double heapTime = benchBestOf([&]()
+    {
+        for (std::size_t i = 0; i < requests; ++i)
+        {
+            VectorN<VectorN<int>> rows;
+            ListN<int> work;
+            HashMapN<int, int> index;
+            sink += handle(rows, work, index, int(i));
+        }
+    }, 3);
+
+    std::pmr::monotonic_buffer_resource arena(1 << 20);
+    double arenaTime = benchBestOf([&]()
+    {
+        for (std::size_t i = 0; i < requests; ++i)
+        {
+            {
+                pmr::VectorN<pmr::VectorN<int>> rows(&arena);
+                pmr::ListN<int> work(&arena);
+                pmr::HashMapN<int, int> index(&arena);
+                sink += handle(rows, work, index, int(i));
+            }
+            arena.release();
+        }
+    }, 3);
+
+    std::pmr::unsynchronized_pool_resource pool;
+    double poolTime = benchBestOf([&]()
+    {
+        for (std::size_t i = 0; i < requests; ++i)
+        {
+            pmr::VectorN<pmr::VectorN<int>> rows(&pool);
+            pmr::ListN<int> work(&pool);
+            pmr::HashMapN<int, int> index(&pool);
+            sink += handle(rows, work, index, int(i));
+        }
+    }, 3);
+
+    std::cout << "  " << requests << " request graphs : new/delete " << heapTime * 1e3 << " ms, monotonic arena "
+              << arenaTime * 1e3 << " ms (x" << heapTime / arenaTime << "), unsynchronized pool " << poolTime * 1e3
+              << " ms (x" << heapTime / poolTime << ")" << std::endl;
+}
+
+static void benchAllocationStats()
+{
+    std::cout << "=== Bench AllocationStatsN (tracking " << (AllocationStatsN::enabled ? "on" : "compiled out") << ") ===" << std::endl;
+
+    // The hot path of tracking: every push_back reports the new size.
+    const std::size_t vectors = 2000;
+    const int length = 1000;
+    std::atomic<std::uint64_t> sink{ 0 };
+    double pushTime = benchBestOf([&]()
+    {
+        AllocationTagN scope("bench-push");
+        for (std::size_t v = 0; v < vectors; ++v)
+        {
+            VectorN<int> values;
+            for (int i = 0; i < length; ++i)
+                values.push_back(i);
+            sink += std::uint64_t(values.back());
+        }
+    }, 3);
+    double listTime = benchBestOf([&]()
+    {
+        AllocationTagN scope("bench-list");
+        ListN<int> values;
+        for (int i = 0; i < 200000; ++i)
+            values.push_back(i);
+        sink += values.size();
+    }, 3);
+    std::cout << "  " << vectors * length << " VectorN push_back " << pushTime * 1e3 << " ms, 200000 ListN push_back "
+              << listTime * 1e3 << " ms" << std::endl;
+
+    // Where the slack is: the buckets wasting the most bytes right now.
+    AllocationTagN scope("bench-slack");
+    VectorN<double> drained(1 << 20, 1.0);
+    drained.clear();
+    auto entries = AllocationStatsN::snapshot();
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.wastedBytes() > b.wastedBytes(); });
+    for (std::size_t i = 0; i < entries.size() && i < 3; ++i)
+    {
+        const auto& entry = entries[i];
+        std::cout << "  " << entry.container << " [" << entry.tag << "] live " << entry.live << ", held "
+                  << entry.capacityBytes << " B, wasted " << entry.wastedBytes() << " B, peak "
+                  << entry.peakCapacityBytes << " B, " << entry.allocations << " allocations ("
+                  << entry.reallocations << " reallocations)" << std::endl;
+    }
+}
+
+int Benchmark()
+{
+    try
+    {
+        benchMatrixMultiply();
+        benchParallelMultiply();
+        benchSmallSolves();
+        benchMatrixBatch();
+        benchSparseMultiply();
+        benchTranspose();
+        benchMatrixIo();
+        benchParallelAlgorithms();
+        benchSort();
+        benchHashMap();
+        benchConcurrentHashMap();
+        benchBTreeMap();
+        benchHeap();
+        benchSlotMap();
+        benchObjectPool();
+        benchPmr();
+        benchAllocationStats();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Benchmark failed : " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
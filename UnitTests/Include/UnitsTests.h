@@ -1,11 +1,59 @@
 #include <iostream>
 #include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <span>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <set>
+#include <forward_list>
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+#include <memory_resource>
 #include "ArrayN.h"
 #include "VecteurND.h"
 #include "MatrixN.h"
 #include "VectorN.h"
 #include "ListN.h"
 #include "IntrusiveListN.h"
+#include "QuaternionN.h"
+#include "TransformN.h"
+#include "KdTreeN.h"
+#include "MatrixDyn.h"
+#include "ThreadPoolN.h"
+#include "MatrixExprN.h"
+#include "DecompositionN.h"
+#include "MatrixBatchN.h"
+#include "SparseMatrixN.h"
+#include "TransposeN.h"
+#include "MatrixIoN.h"
+#include "IteratorsN.h"
+#include "ParallelAlgorithmsN.h"
+#include "TaskGraphN.h"
+#include "SortN.h"
+#include "HashMapN.h"
+#include "HashSetN.h"
+#include "ConcurrentHashMapN.h"
+#include "BTreeMapN.h"
+#include "HeapN.h"
+#include "IndexedHeapN.h"
+#include "SlotMapN.h"
+#include "ObjectPoolN.h"
+#include "AlignedAllocatorN.h"
+#include "AllocationStatsN.h"
 
 static void testVectorN()
 {
@@ -187,6 +235,19 @@ static void testVectorN()
     if (v7.size() != 3 || v7[0] != 1 || v7[2] != 3)
         throw std::runtime_error("swap error");
 
+
+    // ------ Test ranges ------
+    static_assert(std::ranges::contiguous_range<VectorN<int>> && std::ranges::sized_range<const VectorN<int>>);
+    VectorN<int> v8 = { 5, 3, 9, 1, 7 };
+    std::ranges::sort(v8);
+    if (!std::ranges::is_sorted(v8) || *v8.rbegin() != 9 || std::ranges::data(v8) != v8.data())
+        throw std::runtime_error("ranges sort error");
+
+    VectorN<int> v9(5);
+    std::ranges::copy(v8 | std::views::reverse, v9.begin());
+    if (v9[0] != 9 || v9[4] != 1)
+        throw std::runtime_error("ranges copy error");
+
     std::cout << "VectorN test passed!" << std::endl;
 
 }
@@ -318,6 +379,29 @@ static void testListN()
         throw std::runtime_error("clear failed");
 
 
+    //------Test ranges------
+    static_assert(std::ranges::bidirectional_range<ListN<int>> && std::ranges::sized_range<const ListN<int>>);
+    ListN<int> rangeList = { 1, 2, 3, 4 };
+    auto last = rangeList.end();
+    --last;
+    if (*last != 4 || *rangeList.rbegin() != 4 || *std::ranges::prev(rangeList.end(), 4) != 1)
+        throw std::runtime_error("decrementing end failed");
+
+    auto inserted = rangeList.insert(rangeList.end(), 5);
+    if (*inserted != 5 || rangeList.back() != 5)
+        throw std::runtime_error("insert at end failed");
+
+    int reversedSum = 0;
+    for (int value : rangeList | std::views::reverse | std::views::take(2))
+        reversedSum = reversedSum * 10 + value;
+    if (reversedSum != 54 || std::ranges::distance(rangeList) != 5)
+        throw std::runtime_error("ranges views failed");
+
+    const ListN<int>& constRange = rangeList;
+    if (std::ranges::find(constRange, 3) == constRange.end() || std::ranges::count_if(constRange, [](int v) { return v % 2 == 0; }) != 2)
+        throw std::runtime_error("ranges algorithms failed");
+
+
     std::cout << "ListN test passed!" << std::endl;
 }
 
@@ -452,6 +536,34 @@ static void testIntrusiveListN()
             throw std::runtime_error("splice error");
     }
 
+
+    //------ ranges ------
+    {
+        using NodeList = IntrusiveList<Node, &Node::hook>;
+        static_assert(std::ranges::bidirectional_range<NodeList> && std::ranges::sized_range<const NodeList>);
+
+        NodeList rangeList;
+        Node r1(1), r2(2), r3(3);
+        rangeList.push_back(r1);
+        rangeList.push_back(r2);
+        rangeList.push_back(r3);
+
+        if ((*std::ranges::prev(rangeList.end())).data != 3 || std::ranges::distance(rangeList) != 3)
+            throw std::runtime_error("ranges decrement error");
+
+        int reversedSum = 0;
+        for (const Node& node : rangeList | std::views::reverse)
+            reversedSum = reversedSum * 10 + node.data;
+        if (reversedSum != 321)
+            throw std::runtime_error("ranges reverse error");
+
+        rangeList.remove_if([](const Node& node) { return node.data == 3; });
+        rangeList.pop_back();
+        rangeList.pop_back();
+        if (!rangeList.empty() || rangeList.begin() != rangeList.end())
+            throw std::runtime_error("pop_back to empty error");
+    }
+
     std::cout << "IntrusiveListN test passed!" << std::endl;
 }
 
@@ -472,9 +584,123 @@ static void testArrayN()
             throw std::runtime_error("ArrayN test failed: wrong stockage of the values.");
     }
 
+    static_assert(std::ranges::contiguous_range<ArrayN<int, 5>> && std::ranges::sized_range<const ArrayN<int, 5>>);
+    std::ranges::reverse(array);
+    if (array[0] != 40 || *array.rbegin() != 0 || std::ranges::size(array) != 5)
+        throw std::runtime_error("ArrayN test failed: ranges algorithms incorrect.");
+
     std::cout << "ArrayN test passed!" << std::endl;
 }
 
+// Fonction de test pour IteratorsN
+static void testIteratorsN()
+{
+    std::cout << "\n=== Test IteratorsN ===" << std::endl;
+
+    using VectorView = std::views::all_t<VectorN<int>&>;
+    static_assert(std::ranges::random_access_range<TransformViewN<VectorView, int (*)(int)>>);
+    static_assert(std::ranges::random_access_range<StridedViewN<VectorView>>);
+    static_assert(std::ranges::random_access_range<ChunkViewN<VectorView>>);
+    static_assert(std::ranges::random_access_range<EnumerateViewN<VectorView>>);
+    static_assert(std::ranges::random_access_range<ReverseViewN<VectorView>>);
+    static_assert(std::ranges::random_access_range<ZipViewN<VectorView, VectorView>>);
+    static_assert(std::ranges::bidirectional_range<FilterViewN<VectorView, bool (*)(int)>>);
+    static_assert(std::ranges::forward_range<ZipViewN<VectorView, std::views::all_t<std::forward_list<int>&>>>);
+
+    VectorN<int> values;
+    for (int i = 0; i < 10; ++i)
+        values.push_back(i);
+
+    int expected = 0;
+    for (int value : values | filtered([](int v) { return v % 2 == 1; }) | transformed([](int v) { return v * v; }))
+    {
+        ++expected;
+        if (value != expected * expected)
+            throw std::runtime_error("IteratorsN test failed: filtered/transformed incorrect");
+        ++expected;
+    }
+    auto squares = transformed(values, [](int v) { return v * v; });
+    if (squares.size() != 10 || squares[7] != 49 || squares.end() - squares.begin() != 10 || *(squares.end() - 1) != 81)
+        throw std::runtime_error("IteratorsN test failed: transformed random access incorrect");
+
+    // Writing through adaptors modifies the adapted container.
+    for (auto [index, value] : values | reversed() | enumerated())
+        value += int(index) * 100;
+    if (values[9] != 9 || values[0] != 900)
+        throw std::runtime_error("IteratorsN test failed: enumerated/reversed incorrect");
+    for (int& value : values | strided(3))
+        value = -1;
+    if (values[0] != -1 || values[3] != -1 || values[9] != -1 || values[1] == -1)
+        throw std::runtime_error("IteratorsN test failed: strided write incorrect");
+
+    // Strides and chunks that do not divide the length.
+    ArrayN<int, 7> array{ 0, 1, 2, 3, 4, 5, 6 };
+    auto everyThird = strided(array, 3);
+    if (everyThird.size() != 3 || everyThird.end() - everyThird.begin() != 3 || everyThird[2] != 6
+        || *std::ranges::prev(everyThird.end()) != 6)
+        throw std::runtime_error("IteratorsN test failed: strided size incorrect");
+    auto chunks = chunked(array, 3);
+    if (chunks.size() != 3 || chunks[2].size() != 1 || chunks[1][2] != 5 || std::ranges::distance(chunks) != 3)
+        throw std::runtime_error("IteratorsN test failed: chunked incorrect");
+    int chunkSum = 0;
+    for (auto chunk : array | chunked(2) | reversed())
+        chunkSum = chunkSum * 10 + int(chunk.size());
+    if (chunkSum != 1222)
+        throw std::runtime_error("IteratorsN test failed: reversed chunks incorrect");
+
+    // Non-random-access and non-common ranges.
+    ListN<int> list{ 5, 6, 7, 8, 9 };
+    static_assert(std::ranges::bidirectional_range<decltype(strided(list, 2))>);
+    auto listStride = strided(list, 2);
+    if (std::ranges::distance(listStride) != 3 || *std::ranges::next(listStride.begin(), 2) != 9)
+        throw std::runtime_error("IteratorsN test failed: strided list incorrect");
+    int listDigits = 0;
+    for (auto [index, value] : list | reversed() | filtered([](int v) { return v != 7; }) | enumerated())
+        listDigits = listDigits * 10 + int(index) + value % 5;
+    if (listDigits != 4433)
+        throw std::runtime_error("IteratorsN test failed: list pipeline incorrect");
+    std::size_t counted = 0;
+    for (auto [index, value] : std::views::iota(3) | filtered([](int v) { return v % 5 == 0; }) | enumerated())
+    {
+        if (value != int(index + 1) * 5)
+            throw std::runtime_error("IteratorsN test failed: unbounded pipeline incorrect");
+        if (++counted == 4)
+            break;
+    }
+    int strideDigits = 0;
+    for (int value : std::views::iota(0) | std::views::take(7) | strided(3))
+        strideDigits = strideDigits * 10 + value;
+    int lastChunk = -1;
+    for (auto chunk : std::views::iota(0) | std::views::take(7) | chunked(3))
+        lastChunk = int(std::ranges::distance(chunk)) * 10 + *chunk.begin();
+    if (strideDigits != 36 || lastChunk != 16)
+        throw std::runtime_error("IteratorsN test failed: strided/chunked over a counted range incorrect");
+
+    // Zip stops at the shorter range and sorts both ranges together.
+    VectorN<int> keys{ 4, 1, 3, 0, 2 };
+    std::vector<std::string> names{ "four", "one", "three", "zero", "two", "extra" };
+    auto pairs = zip(keys, names);
+    if (pairs.size() != 5 || pairs[4].second != "two")
+        throw std::runtime_error("IteratorsN test failed: zip size incorrect");
+    std::ranges::sort(pairs, {}, [](const auto& pair) { return pair.first; });
+    for (auto [key, name] : zip(keys, names))
+    {
+        static const char* sorted[] = { "zero", "one", "two", "three", "four" };
+        if (name != sorted[key])
+            throw std::runtime_error("IteratorsN test failed: zip sort incorrect");
+    }
+    if (names[5] != "extra")
+        throw std::runtime_error("IteratorsN test failed: zip overran the shorter range");
+    std::forward_list<int> forward{ 7, 8 };
+    std::size_t zipped = 0;
+    for (auto pair : zip(keys, forward))
+        zipped += std::size_t(pair.first + pair.second);
+    if (zipped != 0 + 7 + 1 + 8)
+        throw std::runtime_error("IteratorsN test failed: zip with forward range incorrect");
+
+    std::cout << "IteratorsN test passed!" << std::endl;
+}
+
 // Fonction de test pour VectorND
 static void testVectorND()
 {
@@ -536,10 +762,2914 @@ static void testMatrixND()
         throw std::runtime_error("MatrixND test failed: wrong multiplication incorrecte");
     }
 
+    // Sizes that are not multiples of the GemmN tiles exercise the packed edge tiles.
+    auto checkLargeProduct = [](auto tag)
+    {
+        using T = decltype(tag);
+        auto lhs = std::make_unique<MatrixND<T, 70, 300>>();
+        auto rhs = std::make_unique<MatrixND<T, 300, 45>>();
+        for (std::size_t i = 0; i < 70 * 300; ++i)
+            lhs->data()[i] = static_cast<T>(int(i % 7) - 3);
+        for (std::size_t i = 0; i < 300 * 45; ++i)
+            rhs->data()[i] = static_cast<T>(int(i % 5) - 2);
+
+        auto product = std::make_unique<MatrixND<T, 70, 45>>(MatrixND<T, 70, 300>::template multiply<45>(*lhs, *rhs));
+        for (std::size_t i = 0; i < 70; ++i)
+        {
+            for (std::size_t j = 0; j < 45; ++j)
+            {
+                T expected = T{};
+                for (std::size_t k = 0; k < 300; ++k)
+                    expected += (*lhs)(i, k) * (*rhs)(k, j);
+                if ((*product)(i, j) != expected)
+                    throw std::runtime_error("MatrixND test failed: blocked multiplication incorrect");
+            }
+        }
+    };
+    checkLargeProduct(float{});
+    checkLargeProduct(double{});
+    checkLargeProduct(int{});
+
     std::cout << "MatrixND test passed!" << std::endl;
 }
 
 
+// Fonction de test pour les expressions MatrixND / VectorND
+static void testMatrixExprN()
+{
+    std::cout << "\n=== Test MatrixExprN ===" << std::endl;
+
+    MatrixND<double, 2, 3> a{ {
+        {1, 2, 3},
+        {4, 5, 6}
+    } };
+    MatrixND<double, 2, 3> b{ {
+        {6, 5, 4},
+        {3, 2, 1}
+    } };
+    VectorND<double, 3> x{ 1, 0, -1 };
+    VectorND<double, 2> y{ 10, 20 };
+
+    MatrixND<double, 2, 3> sum = 2.0 * a + b;
+    if (sum(0, 0) != 8 || sum(0, 2) != 10 || sum(1, 1) != 12)
+        throw std::runtime_error("MatrixExprN test failed: alpha * A + B incorrect");
+
+    MatrixND<double, 2, 3> diff = -(a - b) / 2.0;
+    if (diff(0, 0) != 2.5 || diff(1, 2) != -2.5)
+        throw std::runtime_error("MatrixExprN test failed: negation or division incorrect");
+
+    VectorND<double, 2> affine = a * x + y;
+    if (affine[0] != 8 || affine[1] != 18)
+        throw std::runtime_error("MatrixExprN test failed: A * x + b incorrect");
+
+    // Converting to another element type must be spelled out.
+    static_assert(!std::is_convertible_v<VectorND<double, 3>, VectorND<int, 3>>);
+    static_assert(!std::is_convertible_v<MatrixND<double, 2, 3>, MatrixND<int, 2, 3>>);
+    static_assert(std::is_convertible_v<decltype(a * x + y), VectorND<double, 2>>);
+    const VectorND<int, 2> rounded(a * x + y);
+    const MatrixND<int, 2, 3> truncated(diff);
+    if (rounded[1] != 18 || truncated(0, 0) != 2)
+        throw std::runtime_error("MatrixExprN test failed: explicit conversion of the element type incorrect");
+
+    // transpose() is a view, A^T * B is computed without materialising A^T.
+    MatrixND<double, 3, 3> gram = transpose(a) * b;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            double expected = a(0, i) * b(0, j) + a(1, i) * b(1, j);
+            if (gram(i, j) != expected)
+                throw std::runtime_error("MatrixExprN test failed: transpose(A) * B incorrect");
+        }
+    }
+
+    MatrixND<double, 3, 2> at = transpose(a);
+    if (at(2, 1) != 6 || at(0, 1) != 4)
+        throw std::runtime_error("MatrixExprN test failed: transpose copy incorrect");
+
+    // Nested products and products inside sums.
+    MatrixND<double, 2, 2> chain = a * transpose(b) * MatrixND<double, 2, 2>{ { {1, 0}, {0, 2} } } + 0.5 * (a * transpose(a));
+    auto reference = MatrixND<double, 2, 3>::multiply<2>(a, MatrixND<double, 3, 2>(transpose(b)));
+    auto aat = MatrixND<double, 2, 3>::multiply<2>(a, at);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        for (std::size_t j = 0; j < 2; ++j)
+        {
+            double expected = reference(i, j) * (j == 0 ? 1.0 : 2.0) + 0.5 * aat(i, j);
+            if (chain(i, j) != expected)
+                throw std::runtime_error("MatrixExprN test failed: nested product incorrect");
+        }
+    }
+
+    // Assignment from an expression that reads its own target is alias-safe.
+    MatrixND<double, 2, 2> m{ { {1, 2}, {3, 4} } };
+    m = transpose(m) * m;
+    if (m(0, 0) != 10 || m(0, 1) != 14 || m(1, 0) != 14 || m(1, 1) != 20)
+        throw std::runtime_error("MatrixExprN test failed: aliased assignment incorrect");
+
+    VectorND<double, 2> v{ 1, 1 };
+    v = MatrixND<double, 2, 2>{ { {0, 1}, {1, 0} } } * (v + VectorND<double, 2>{ 1, 0 });
+    if (v[0] != 1 || v[1] != 2)
+        throw std::runtime_error("MatrixExprN test failed: aliased vector assignment incorrect");
+
+    // Products large enough to go through GemmN.
+    auto lhs = std::make_unique<MatrixND<float, 40, 30>>();
+    auto rhs = std::make_unique<MatrixND<float, 30, 20>>();
+    auto bias = std::make_unique<MatrixND<float, 40, 20>>();
+    for (std::size_t i = 0; i < 40 * 30; ++i)
+        lhs->data()[i] = static_cast<float>(int(i % 7) - 3);
+    for (std::size_t i = 0; i < 30 * 20; ++i)
+        rhs->data()[i] = static_cast<float>(int(i % 5) - 2);
+    for (std::size_t i = 0; i < 40 * 20; ++i)
+        bias->data()[i] = static_cast<float>(i % 3);
+    auto fused = std::make_unique<MatrixND<float, 40, 20>>(*lhs * *rhs - 2.0f * *bias);
+    auto product = MatrixND<float, 40, 30>::multiply<20>(*lhs, *rhs);
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        for (std::size_t j = 0; j < 20; ++j)
+        {
+            if ((*fused)(i, j) != product(i, j) - 2.0f * (*bias)(i, j))
+                throw std::runtime_error("MatrixExprN test failed: large fused product incorrect");
+        }
+    }
+
+    std::cout << "MatrixExprN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour MatrixViewN
+static void testMatrixViewN()
+{
+    std::cout << "\n=== Test MatrixViewN ===" << std::endl;
+
+    MatrixND<int, 3, 4> m{ { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 } };
+    const MatrixND<int, 3, 4>& cm = m;
+    if (m.row(1)[2] != 7 || m.col(3)[2] != 12 || cm.block<2, 2>(1, 2)(1, 0) != 11 || m.row(2).data() != m.data() + 8)
+        throw std::runtime_error("MatrixViewN test failed: row, column or block access incorrect");
+
+    // Writes go through to the matrix.
+    m.row(0).fill(0);
+    m.col(1)[2] = -1;
+    m.block<2, 2>(1, 2) *= 2;
+    if (m(0, 3) != 0 || m(2, 1) != -1 || m(1, 2) != 14 || m(2, 3) != 24 || m(1, 1) != 6)
+        throw std::runtime_error("MatrixViewN test failed: writes through views incorrect");
+
+    // Views are expressions: rows combine, a column transposes into a row.
+    MatrixND<int, 1, 4> rowSum = cm.row(1) + 2 * cm.row(2);
+    MatrixND<int, 1, 3> colT = transpose(cm.col(2));
+    if (rowSum(0, 0) != 23 || rowSum(0, 1) != 4 || colT(0, 1) != 14 || colT(0, 2) != 22)
+        throw std::runtime_error("MatrixViewN test failed: views in expressions incorrect");
+    m.row(0) = m.row(1) - m.row(2);
+    if (m(0, 0) != -4 || m(0, 3) != -8 || m(1, 0) != 5)
+        throw std::runtime_error("MatrixViewN test failed: assignment from expression incorrect");
+
+    // Overlapping blocks and block = block * B read their own storage safely.
+    MatrixND<int, 3, 3> s{ { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    s.block<2, 2>(1, 1) = s.block<2, 2>(0, 0);
+    if (s(1, 1) != 1 || s(1, 2) != 2 || s(2, 1) != 4 || s(2, 2) != 5)
+        throw std::runtime_error("MatrixViewN test failed: overlapping block copy incorrect");
+    MatrixND<int, 2, 2> swapCols{ { 0, 1 }, { 1, 0 } };
+    s.block<2, 2>(0, 0) = s.block<2, 2>(0, 0) * swapCols;
+    s.block<3, 1>(0, 2) += s.col(0);
+    if (s(0, 0) != 2 || s(0, 1) != 1 || s(1, 0) != 1 || s(1, 1) != 4 || s(0, 2) != 5 || s(2, 2) != 12)
+        throw std::runtime_error("MatrixViewN test failed: block product or compound assignment incorrect");
+
+    bool caught = false;
+    try
+    {
+        m.block<2, 3>(2, 0);
+    }
+    catch (const std::out_of_range&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("MatrixViewN test failed: out of range block not detected");
+
+    // Products of strided tiles take the GemmN path with the parent leading dimension.
+    auto big = std::make_unique<MatrixND<float, 48, 40>>();
+    for (std::size_t i = 0; i < 48; ++i)
+        for (std::size_t j = 0; j < 40; ++j)
+            (*big)(i, j) = float(int((i * 5 + j * 3) % 11) - 5);
+    auto tile = std::make_unique<MatrixND<float, 32, 24>>();
+    *tile = big->block<32, 16>(8, 4) * big->block<16, 24>(20, 10);
+    for (std::size_t i = 0; i < 32; ++i)
+    {
+        for (std::size_t j = 0; j < 24; ++j)
+        {
+            float expected = 0.0f;
+            for (std::size_t k = 0; k < 16; ++k)
+                expected += (*big)(8 + i, 4 + k) * (*big)(20 + k, 10 + j);
+            if ((*tile)(i, j) != expected)
+                throw std::runtime_error("MatrixViewN test failed: strided tile product incorrect");
+        }
+    }
+
+    std::cout << "MatrixViewN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour TransposeN
+template<typename T>
+static void checkTransposeN()
+{
+    const std::size_t shapes[][2] = { { 1, 1 }, { 3, 5 }, { 8, 8 }, { 7, 13 }, { 37, 100 }, { 130, 67 } };
+    for (const auto& shape : shapes)
+    {
+        const std::size_t rows = shape[0], cols = shape[1], srcStride = cols + 3, dstStride = rows + 1;
+        std::vector<T> src(rows * srcStride), dst(cols * dstStride, T(-1));
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = T(i % 251);
+        TransposeN<T>::copy(rows, cols, src.data(), srcStride, dst.data(), dstStride);
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            for (std::size_t j = 0; j < cols; ++j)
+            {
+                if (dst[j * dstStride + i] != src[i * srcStride + j])
+                    throw std::runtime_error("TransposeN test failed: out-of-place transpose incorrect");
+            }
+        }
+        for (std::size_t j = 0; j < cols; ++j)
+        {
+            if (dst[j * dstStride + rows] != T(-1))
+                throw std::runtime_error("TransposeN test failed: write outside the destination");
+        }
+    }
+
+    for (std::size_t n : { 1, 5, 8, 33, 100, 129 })
+    {
+        const std::size_t stride = n + 2;
+        std::vector<T> data(n * stride), original;
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = T(i % 241);
+        original = data;
+        TransposeN<T>::inPlace(n, data.data(), stride);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = 0; j < stride; ++j)
+            {
+                const T expected = j < n ? original[j * stride + i] : original[i * stride + j];
+                if (data[i * stride + j] != expected)
+                    throw std::runtime_error("TransposeN test failed: in-place transpose incorrect");
+            }
+        }
+    }
+}
+
+static void testTransposeN()
+{
+    std::cout << "\n=== Test TransposeN ===" << std::endl;
+
+    checkTransposeN<float>();
+    checkTransposeN<double>();
+    checkTransposeN<int>();
+
+    MatrixND<int, 2, 3> a{ { 1, 2, 3 }, { 4, 5, 6 } };
+    MatrixND<int, 3, 2> at = a.transposed();
+    MatrixND<int, 3, 3> sq{ { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    sq.transposeInPlace();
+    if (at(0, 1) != 4 || at(2, 0) != 3 || sq(0, 2) != 7 || sq(2, 1) != 6 || sq(1, 1) != 5)
+        throw std::runtime_error("TransposeN test failed: MatrixND transpose incorrect");
+
+    MatrixDyn<double> rowMajor(19, 45);
+    for (std::size_t i = 0; i < 19; ++i)
+        for (std::size_t j = 0; j < 45; ++j)
+            rowMajor(i, j) = double(i * 100 + j);
+    MatrixDyn<double, MatrixLayout::ColMajor> colMajor = rowMajor.toLayout<MatrixLayout::ColMajor>();
+    MatrixDyn<double> back = colMajor.toLayout<MatrixLayout::RowMajor>();
+    MatrixDyn<double> rowT = rowMajor.transposed();
+    MatrixDyn<double, MatrixLayout::ColMajor> colT = colMajor.transposed();
+    if (colMajor.rowCount() != 19 || rowT.rowCount() != 45 || colT.colCount() != 19)
+        throw std::runtime_error("TransposeN test failed: MatrixDyn dimensions incorrect");
+    for (std::size_t i = 0; i < 19; ++i)
+    {
+        for (std::size_t j = 0; j < 45; ++j)
+        {
+            if (colMajor(i, j) != rowMajor(i, j) || back(i, j) != rowMajor(i, j) || rowT(j, i) != rowMajor(i, j)
+                || colT(j, i) != rowMajor(i, j))
+                throw std::runtime_error("TransposeN test failed: MatrixDyn layout conversion incorrect");
+        }
+    }
+    if (colMajor.data()[colMajor.stride() - 1] != 0.0 || rowT.data()[rowT.stride() - 1] != 0.0)
+        throw std::runtime_error("TransposeN test failed: padding not cleared");
+
+    std::cout << "TransposeN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour MatrixIoN
+static void testMatrixIoN()
+{
+    std::cout << "\n=== Test MatrixIoN ===" << std::endl;
+
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string path = directory + "/containers_matrix_io_test.npy";
+
+    MatrixND<double, 3, 4> fixed{ { 1.5, -2, 3, 4 }, { 5, 6.25, 7, 8 }, { 9, 10, 11, -12.75 } };
+    MatrixIoN::saveNpy(path, fixed);
+    {
+        std::ifstream in(path, std::ios::binary);
+        NpyHeaderN header = MatrixIoN::readNpyHeader(in);
+        if (header.descr != "<f8" || header.fortranOrder || header.rows != 3 || header.cols != 4 || header.dataOffset % 64 != 0)
+            throw std::runtime_error("MatrixIoN test failed: header incorrect");
+    }
+    auto fixedBack = MatrixIoN::loadNpy<MatrixND<double, 3, 4>>(path);
+    auto fixedCol = MatrixIoN::loadNpy<MatrixDyn<double, MatrixLayout::ColMajor>>(path);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            if (fixedBack(i, j) != fixed(i, j) || fixedCol(i, j) != fixed(i, j))
+                throw std::runtime_error("MatrixIoN test failed: MatrixND round trip incorrect");
+        }
+    }
+
+    // Padded MatrixDyn storage in both orders, read back in both orders and through a mapping.
+    MatrixDyn<float, MatrixLayout::ColMajor> dyn(37, 19);
+    for (std::size_t i = 0; i < 37; ++i)
+        for (std::size_t j = 0; j < 19; ++j)
+            dyn(i, j) = float(i) * 0.5f - float(j);
+    MatrixIoN::saveNpy(path, dyn);
+    auto dynRow = MatrixIoN::loadNpy<MatrixDyn<float>>(path);
+    auto dynCol = MatrixIoN::loadNpy<MatrixDyn<float, MatrixLayout::ColMajor>>(path);
+    {
+        NpyMappedN<float> mapped(path);
+        NpyMappedN<float> moved(std::move(mapped));
+        auto mappedRow = moved.toMatrixDyn();
+        if (!moved.fortranOrder() || moved.rowCount() != 37 || moved.colCount() != 19 || mapped.data() != nullptr)
+            throw std::runtime_error("MatrixIoN test failed: mapping incorrect");
+        for (std::size_t i = 0; i < 37; ++i)
+        {
+            for (std::size_t j = 0; j < 19; ++j)
+            {
+                if (dynRow(i, j) != dyn(i, j) || dynCol(i, j) != dyn(i, j) || moved(i, j) != dyn(i, j) || mappedRow(i, j) != dyn(i, j))
+                    throw std::runtime_error("MatrixIoN test failed: MatrixDyn round trip incorrect");
+            }
+        }
+    }
+
+    bool caught = false;
+    try
+    {
+        MatrixIoN::loadNpy<MatrixDyn<double>>(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("MatrixIoN test failed: element type mismatch not detected");
+    caught = false;
+    try
+    {
+        MatrixIoN::loadNpy<MatrixND<float, 19, 37>>(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("MatrixIoN test failed: shape mismatch not detected");
+
+    // A big-endian Fortran-ordered int32 file, as written by another machine.
+    {
+        std::string dict = "{'descr': '>i4', 'fortran_order': True, 'shape': (2, 3), }";
+        dict.append(128 - 10 - dict.size() - 1, ' ');
+        dict.push_back('\n');
+        std::ofstream out(path, std::ios::binary);
+        out.write("\x93NUMPY\x01\x00", 8);
+        out.put(char(dict.size()));
+        out.put(0);
+        out.write(dict.data(), std::streamsize(dict.size()));
+        for (int value : { 1, 4, 2, 5, 3, -6 })
+        {
+            const unsigned bits = unsigned(value);
+            const char bytes[4] = { char(bits >> 24), char(bits >> 16), char(bits >> 8), char(bits) };
+            out.write(bytes, 4);
+        }
+    }
+    auto foreign = MatrixIoN::loadNpy<MatrixND<std::int32_t, 2, 3>>(path);
+    if (foreign(0, 0) != 1 || foreign(0, 2) != 3 || foreign(1, 0) != 4 || foreign(1, 2) != -6)
+        throw std::runtime_error("MatrixIoN test failed: byte order or Fortran order conversion incorrect");
+    caught = false;
+    try
+    {
+        NpyMappedN<std::int32_t> mapped(path);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("MatrixIoN test failed: mapping foreign byte order not detected");
+    std::filesystem::remove(path);
+
+    std::ostringstream text;
+    MatrixIoN::writeText(text, MatrixND<int, 2, 3>{ { 1, -2, 3 }, { 40, 0, 6 } }, ',');
+    MatrixIoN::writeText(text, MatrixDyn<double, MatrixLayout::ColMajor>{ { 0.1, 2.5 } });
+    if (text.str() != "1,-2,3\n40,0,6\n0.1 2.5\n")
+        throw std::runtime_error("MatrixIoN test failed: text output incorrect");
+
+    std::cout << "MatrixIoN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour LuN, CholeskyN et QrN
+static void testDecompositionN()
+{
+    std::cout << "\n=== Test DecompositionN ===" << std::endl;
+
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 * (1.0 + std::abs(b)); };
+
+    // Needs pivoting: the leading coefficient is zero.
+    MatrixND<double, 3, 3> a{ {
+        {0, 2, 1},
+        {1, 1, 1},
+        {2, 1, 3}
+    } };
+    VectorND<double, 3> b{ 7, 6, 13 };
+
+    LuN<double, 3> lu(a);
+    VectorND<double, 3> x = lu.solve(b);
+    if (!near(x[0], 1) || !near(x[1], 2) || !near(x[2], 3))
+        throw std::runtime_error("DecompositionN test failed: LU solve incorrect");
+    if (!near(lu.determinant(), -3))
+        throw std::runtime_error("DecompositionN test failed: LU determinant incorrect");
+
+    MatrixND<double, 3, 3> identity = a * lu.inverse();
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            if (!near(identity(i, j) + 1.0, i == j ? 2.0 : 1.0))
+                throw std::runtime_error("DecompositionN test failed: LU inverse incorrect");
+        }
+    }
+
+    bool thrown = false;
+    try
+    {
+        LuN<double, 2> singular(MatrixND<double, 2, 2>{ { {1, 2}, {2, 4} } });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+        throw std::runtime_error("DecompositionN test failed: singular matrix not detected");
+
+    // Triangular solves.
+    MatrixND<double, 2, 2> lower{ { {2, 0}, {1, 4} } };
+    VectorND<double, 2> lx = solveLowerTriangular(lower, VectorND<double, 2>{ 2, 9 });
+    VectorND<double, 2> ux = solveUpperTriangular(MatrixND<double, 2, 2>(transpose(lower)), VectorND<double, 2>{ 4, 8 });
+    if (lx[0] != 1 || lx[1] != 2 || ux[0] != 1 || ux[1] != 2)
+        throw std::runtime_error("DecompositionN test failed: triangular solve incorrect");
+
+    // Cholesky on a small SPD matrix, and rejection of an indefinite one.
+    MatrixND<double, 3, 3> spd{ {
+        {4, 2, 2},
+        {2, 5, 3},
+        {2, 3, 6}
+    } };
+    CholeskyN<double, 3> chol(spd);
+    VectorND<double, 3> cx = chol.solve(VectorND<double, 3>{ 8, 10, 11 });
+    VectorND<double, 3> residual = spd * cx - VectorND<double, 3>{ 8, 10, 11 };
+    if (residual.norm() > 1e-12 || !near(chol.determinant(), 64))
+        throw std::runtime_error("DecompositionN test failed: Cholesky solve incorrect");
+    MatrixND<double, 3, 3> rebuilt = chol.matrixL() * transpose(chol.matrixL());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            if (!near(rebuilt(i, j), spd(i, j)))
+                throw std::runtime_error("DecompositionN test failed: Cholesky factor incorrect");
+        }
+    }
+
+    thrown = false;
+    try
+    {
+        CholeskyN<double, 2> indefinite(MatrixND<double, 2, 2>{ { {1, 2}, {2, 1} } });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+        throw std::runtime_error("DecompositionN test failed: indefinite matrix not detected");
+
+    // Sizes above the block threshold, with rows that force pivoting across panels.
+    {
+        constexpr std::size_t N = 53;
+        auto m = std::make_unique<MatrixND<double, N, N>>();
+        auto s = std::make_unique<MatrixND<double, N, N>>();
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+                (*m)(i, j) = static_cast<double>((i * 7 + j * 13) % 17) - 8.0 + (i == (j * 5) % N ? 40.0 : 0.0);
+        }
+        *s = transpose(*m) * *m;
+        VectorND<double, N> rhs;
+        for (std::size_t i = 0; i < N; ++i)
+            rhs[i] = static_cast<double>(i % 5) - 2.0;
+
+        auto bigLu = std::make_unique<LuN<double, N>>(*m);
+        VectorND<double, N> r1 = *m * bigLu->solve(rhs) - rhs;
+        auto bigChol = std::make_unique<CholeskyN<double, N>>(*s);
+        VectorND<double, N> r2 = *s * bigChol->solve(rhs) - rhs;
+        auto bigQr = std::make_unique<QrN<double, N, N>>(*m);
+        VectorND<double, N> r3 = *m * bigQr->solve(rhs) - rhs;
+        if (r1.norm() > 1e-9 || r2.norm() > 1e-9 || r3.norm() > 1e-9)
+            throw std::runtime_error("DecompositionN test failed: blocked factorization incorrect");
+    }
+
+    // Interleaved batches, with a remainder solved one system at a time.
+    {
+        constexpr std::size_t N = 6;
+        constexpr std::size_t Count = 21;
+        std::vector<MatrixND<double, N, N>> matrices(Count);
+        std::vector<VectorND<double, N>> rhs(Count);
+        std::vector<VectorND<double, N>> luSolutions(Count);
+        std::vector<VectorND<double, N>> cholSolutions(Count);
+        for (std::size_t s = 0; s < Count; ++s)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                for (std::size_t j = 0; j <= i; ++j)
+                {
+                    double value = i == j ? 10.0 + double(s % 3) : double((s + i * 3 + j * 5) % 7) - 3.0;
+                    matrices[s](i, j) = value;
+                    matrices[s](j, i) = value;
+                }
+                rhs[s][i] = double((s + i) % 11) - 5.0;
+            }
+        }
+        // The first system needs a row exchange before its first elimination step.
+        matrices[0](0, 0) = 0.0;
+
+        LuN<double, N>::solveBatch(matrices, rhs, luSolutions);
+        CholeskyN<double, N>::solveBatch(std::span<const MatrixND<double, N, N>>(matrices.data() + 1, Count - 1),
+            std::span<const VectorND<double, N>>(rhs.data() + 1, Count - 1),
+            std::span<VectorND<double, N>>(cholSolutions.data() + 1, Count - 1));
+        for (std::size_t s = 0; s < Count; ++s)
+        {
+            VectorND<double, N> r1 = matrices[s] * luSolutions[s] - rhs[s];
+            if (r1.norm() > 1e-10)
+                throw std::runtime_error("DecompositionN test failed: LuN::solveBatch incorrect");
+            if (s > 0)
+            {
+                VectorND<double, N> r2 = matrices[s] * cholSolutions[s] - rhs[s];
+                if (r2.norm() > 1e-10)
+                    throw std::runtime_error("DecompositionN test failed: CholeskyN::solveBatch incorrect");
+            }
+        }
+
+        matrices[3] = MatrixND<double, N, N>();
+        thrown = false;
+        try
+        {
+            LuN<double, N>::solveBatch(matrices, rhs, luSolutions);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        if (!thrown)
+            throw std::runtime_error("DecompositionN test failed: singular batch member not detected");
+    }
+
+    // Least-squares line fit through points of y = 2x + 1.
+    MatrixND<double, 4, 2> design{ { {1, 0}, {1, 1}, {1, 2}, {1, 3} } };
+    QrN<double, 4, 2> qr(design);
+    VectorND<double, 2> fit = qr.solve(VectorND<double, 4>{ 1, 3, 5, 7 });
+    if (!near(fit[0], 1) || !near(fit[1], 2))
+        throw std::runtime_error("DecompositionN test failed: QR least squares incorrect");
+    MatrixND<double, 2, 2> qtq = transpose(qr.matrixQ()) * qr.matrixQ();
+    MatrixND<double, 4, 2> qrProduct = qr.matrixQ() * qr.matrixR();
+    if (!near(qtq(0, 0), 1) || !near(qtq(1, 1), 1) || !near(qtq(0, 1) + 1.0, 1.0))
+        throw std::runtime_error("DecompositionN test failed: Q not orthonormal");
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        for (std::size_t j = 0; j < 2; ++j)
+        {
+            if (!near(qrProduct(i, j), design(i, j)))
+                throw std::runtime_error("DecompositionN test failed: Q * R incorrect");
+        }
+    }
+
+    MatrixND<double, 3, 2> multi = QrN<double, 3, 3>(a).solve(MatrixND<double, 3, 2>{ { {7, 2}, {6, 1}, {13, 2} } });
+    if (!near(multi(0, 0), 1) || !near(multi(2, 0), 3) || !near((a * multi).coeff(1, 1), 1))
+        throw std::runtime_error("DecompositionN test failed: QR multiple right-hand sides incorrect");
+
+    if (QrN<double, 3, 2>(MatrixND<double, 3, 2>{ { {1, 2}, {2, 4}, {3, 6} } }).isFullRank())
+        throw std::runtime_error("DecompositionN test failed: rank deficiency not detected");
+
+    std::cout << "DecompositionN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour MatrixBatchN
+template<std::size_t N>
+static void checkMatrixBatchN()
+{
+    constexpr std::size_t Count = 19;
+    std::vector<MatrixND<double, N, N>> lhs(Count);
+    std::vector<MatrixND<double, N, N>> rhs(Count);
+    std::vector<VectorND<double, N>> points(Count);
+    for (std::size_t s = 0; s < Count; ++s)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                lhs[s](i, j) = double((s * 7 + i * 5 + j * 3) % 11) - 5.0 + (i == j ? 9.0 : 0.0);
+                rhs[s](i, j) = double((s + i * 2 + j) % 5) - 2.0;
+            }
+            points[s][i] = double(s + i);
+        }
+    }
+
+    MatrixBatchN<double, N> a(lhs);
+    MatrixBatchN<double, N> b(rhs);
+    MatrixBatchN<double, N> product;
+    MatrixBatchN<double, N>::multiply(a, b, product);
+
+    MatrixBatchN<double, N> inverse;
+    MatrixBatchN<double, N>::inverse(a, inverse);
+
+    std::vector<double> determinants(Count);
+    MatrixBatchN<double, N>::determinant(a, determinants);
+
+    std::vector<VectorND<double, N>> transformed(Count);
+    MatrixBatchN<double, N>::transform(a, points, transformed);
+
+    if (product.size() != Count || a.blockCount() != (Count + 7) / 8)
+        throw std::runtime_error("MatrixBatchN test failed: wrong size");
+
+    for (std::size_t s = 0; s < Count; ++s)
+    {
+        if (a.get(s)(N - 1, 0) != lhs[s](N - 1, 0))
+            throw std::runtime_error("MatrixBatchN test failed: get incorrect");
+
+        MatrixND<double, N, N> expected = lhs[s] * rhs[s];
+        MatrixND<double, N, N> got = product.get(s);
+        LuN<double, N> lu(lhs[s]);
+        MatrixND<double, N, N> expectedInverse = lu.inverse();
+        MatrixND<double, N, N> gotInverse = inverse.get(s);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                if (got(i, j) != expected(i, j))
+                    throw std::runtime_error("MatrixBatchN test failed: multiply incorrect");
+                if (std::abs(gotInverse(i, j) - expectedInverse(i, j)) > 1e-12)
+                    throw std::runtime_error("MatrixBatchN test failed: inverse incorrect");
+            }
+        }
+        if (std::abs(determinants[s] - lu.determinant()) > 1e-9 * std::abs(lu.determinant()))
+            throw std::runtime_error("MatrixBatchN test failed: determinant incorrect");
+
+        VectorND<double, N> expectedPoint = lhs[s] * points[s];
+        if (transformed[s] != expectedPoint)
+            throw std::runtime_error("MatrixBatchN test failed: transform incorrect");
+    }
+
+    // Growing keeps the matrices and pads with identities, shrinking leaves identities behind.
+    a.resize(Count + 10);
+    if (a.get(Count - 1)(0, 0) != lhs[Count - 1](0, 0) || a.get(Count + 9)(N - 1, N - 1) != 1.0 || a.get(Count + 9)(0, N - 1) != 0.0)
+        throw std::runtime_error("MatrixBatchN test failed: resize incorrect");
+    a.resize(3);
+    a.resize(8);
+    if (a.get(5)(0, 0) != 1.0 || a.get(2)(0, 0) != lhs[2](0, 0))
+        throw std::runtime_error("MatrixBatchN test failed: shrinking resize incorrect");
+
+    a.set(1, MatrixND<double, N, N>());
+    bool thrown = false;
+    try
+    {
+        MatrixBatchN<double, N>::inverse(a, inverse);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+        throw std::runtime_error("MatrixBatchN test failed: singular matrix not detected");
+}
+
+static void testMatrixBatchN()
+{
+    std::cout << "\n=== Test MatrixBatchN ===" << std::endl;
+
+    checkMatrixBatchN<2>();
+    checkMatrixBatchN<3>();
+    checkMatrixBatchN<4>();
+
+    // Large enough to be split across the pool.
+    MatrixBatchN<float, 4> big(8 * 2000);
+    MatrixBatchN<float, 4> squared;
+    big.set(12345, MatrixND<float, 4, 4>{ { {2, 0, 0, 0}, {0, 2, 0, 0}, {0, 0, 2, 0}, {0, 0, 0, 2} } });
+    MatrixBatchN<float, 4>::multiply(big, big, squared);
+    if (squared.get(12345)(3, 3) != 4.0f || squared.get(12344)(3, 3) != 1.0f)
+        throw std::runtime_error("MatrixBatchN test failed: parallel multiply incorrect");
+
+    std::cout << "MatrixBatchN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour SparseMatrixN
+static void testSparseMatrixN()
+{
+    std::cout << "\n=== Test SparseMatrixN ===" << std::endl;
+
+    VectorN<TripletN<double>> triplets{ { 2, 1, 4.0 }, { 0, 3, 1.0 }, { 1, 0, -2.0 }, { 2, 1, 1.0 }, { 0, 0, 3.0 }, { 2, 3, 6.0 } };
+    SparseMatrixN<double> csr(3, 4, triplets);
+    SparseMatrixN<double, SparseFormat::CSC> csc(3, 4, triplets);
+    if (csr.nonZeros() != 5 || csc.nonZeros() != 5 || csr.coeff(2, 1) != 5.0 || csc.coeff(2, 1) != 5.0 || csr.coeff(1, 1) != 0.0)
+        throw std::runtime_error("SparseMatrixN test failed: triplet construction incorrect");
+    if (csr.offsets()[1] != 2 || csr.indices()[0] != 0 || csr.indices()[1] != 3 || csc.offsets()[1] != 2 || csc.indices()[1] != 1)
+        throw std::runtime_error("SparseMatrixN test failed: compressed arrays incorrect");
+
+    MatrixND<double, 3, 4> dense = csr.toMatrixND<3, 4>();
+    MatrixND<double, 3, 4> expected{ { 3, 0, 0, 1 }, { -2, 0, 0, 0 }, { 0, 5, 0, 6 } };
+    MatrixND<double, 3, 4> denseCsc = csc.toMatrixND<3, 4>();
+    for (std::size_t i = 0; i < 12; ++i)
+    {
+        if (dense.data()[i] != expected.data()[i] || denseCsc.data()[i] != expected.data()[i])
+            throw std::runtime_error("SparseMatrixN test failed: dense conversion incorrect");
+    }
+    SparseMatrixN<double, SparseFormat::CSC> fromDense(expected);
+    if (fromDense.nonZeros() != 5 || fromDense.coeff(0, 3) != 1.0 || fromDense.toMatrixDyn()(2, 3) != 6.0)
+        throw std::runtime_error("SparseMatrixN test failed: construction from dense incorrect");
+
+    VectorN<double> x{ 1, 2, 3, 4 };
+    VectorN<double> y = csr.multiply(x);
+    VectorN<double> yc = csc.multiply(x);
+    VectorN<double> z{ 1, -1, 2 };
+    VectorN<double> zt = csr.multiplyTransposed(z);
+    VectorN<double> ztc = csc.multiplyTransposed(z);
+    if (y[0] != 7 || y[1] != -2 || y[2] != 34 || yc[0] != 7 || yc[2] != 34)
+        throw std::runtime_error("SparseMatrixN test failed: multiply incorrect");
+    if (zt[0] != 5 || zt[1] != 10 || zt[2] != 0 || zt[3] != 13 || ztc[0] != 5 || ztc[3] != 13)
+        throw std::runtime_error("SparseMatrixN test failed: transposed multiply incorrect");
+
+    SparseMatrixN<double> t = csr.transposed();
+    SparseMatrixN<double, SparseFormat::CSC> converted = csr.toFormat<SparseFormat::CSC>();
+    if (t.rowCount() != 4 || t.colCount() != 3 || t.coeff(3, 2) != 6.0 || t.coeff(0, 1) != -2.0)
+        throw std::runtime_error("SparseMatrixN test failed: transpose incorrect");
+    for (std::size_t k = 0; k < converted.nonZeros(); ++k)
+    {
+        if (converted.indices()[k] != csc.indices()[k] || converted.values()[k] != csc.values()[k])
+            throw std::runtime_error("SparseMatrixN test failed: format conversion incorrect");
+    }
+
+    bool caught = false;
+    try
+    {
+        VectorN<TripletN<double>> outside{ { 3, 0, 1.0 } };
+        SparseMatrixN<double> bad(3, 4, outside);
+    }
+    catch (const std::out_of_range&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("SparseMatrixN test failed: out of range triplet not detected");
+
+    // Graph Laplacian of a ring with chords: rows of varied length exercise every dot product kernel.
+    const std::size_t n = 5000;
+    VectorN<TripletN<float>> edges;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::size_t degree = i % 500 == 0 ? 150 : 2 + i % 11;
+        for (std::size_t d = 1; d <= degree; ++d)
+            edges.push_back({ i, (i + d * 37) % n, -1.0f });
+        edges.push_back({ i, i, float(degree) });
+    }
+    SparseMatrixN<float> laplacian(n, n, edges);
+    VectorN<float> in(n, 0.0f);
+    for (std::size_t i = 0; i < n; ++i)
+        in[i] = float(int(i % 7) - 3);
+    ThreadPoolN pool(3);
+    VectorN<float> out = laplacian.multiply(in, pool);
+    VectorN<float> outT = laplacian.toFormat<SparseFormat::CSC>().multiplyTransposed(in, pool);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        float reference = 0.0f;
+        for (std::size_t k = laplacian.offsets()[i]; k < laplacian.offsets()[i + 1]; ++k)
+            reference += laplacian.values()[k] * in[laplacian.indices()[k]];
+        if (out[i] != reference)
+            throw std::runtime_error("SparseMatrixN test failed: parallel multiply incorrect");
+    }
+    VectorN<float> outScatter = laplacian.transposed().multiplyTransposed(in);
+    VectorN<float> outTScatter = laplacian.multiplyTransposed(in);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (outScatter[i] != out[i] || outT[i] != outTScatter[i])
+            throw std::runtime_error("SparseMatrixN test failed: scatter multiply incorrect");
+    }
+    if (laplacian.memoryBytes() >= n * n * sizeof(float) / 100)
+        throw std::runtime_error("SparseMatrixN test failed: storage is not compact");
+
+    std::cout << "SparseMatrixN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour QuaternionN
+static void testQuaternionN()
+{
+    std::cout << "\n=== Test QuaternionN ===" << std::endl;
+
+    const float halfPi = 1.57079632679f;
+    auto near = [](const VectorND<float, 3>& a, const VectorND<float, 3>& b)
+    {
+        return std::abs(a[0] - b[0]) < 1e-5f && std::abs(a[1] - b[1]) < 1e-5f && std::abs(a[2] - b[2]) < 1e-5f;
+    };
+
+    auto rotZ = QuaternionN<float>::fromAxisAngle(VectorND<float, 3>{ 0.0f, 0.0f, 2.0f }, halfPi);
+    if (!near(rotZ.rotate(VectorND<float, 3>{ 1.0f, 0.0f, 0.0f }), VectorND<float, 3>{ 0.0f, 1.0f, 0.0f }))
+        throw std::runtime_error("QuaternionN test failed: rotate incorrect");
+
+    auto rotX = QuaternionN<float>::fromAxisAngle(VectorND<float, 3>{ 1.0f, 0.0f, 0.0f }, halfPi);
+    auto composed = rotX * rotZ;
+    VectorND<float, 3> v{ 1.0f, 2.0f, 3.0f };
+    if (!near(composed.rotate(v), rotX.rotate(rotZ.rotate(v))))
+        throw std::runtime_error("QuaternionN test failed: compose incorrect");
+
+    if (!near((composed * composed.inverse()).rotate(v), v))
+        throw std::runtime_error("QuaternionN test failed: inverse incorrect");
+
+    auto half = QuaternionN<float>::slerp(QuaternionN<float>::identity(), rotZ, 0.5f);
+    auto quarter = QuaternionN<float>::fromAxisAngle(VectorND<float, 3>{ 0.0f, 0.0f, 1.0f }, halfPi / 2.0f);
+    if (std::abs(QuaternionN<float>::dot(half, quarter) - 1.0f) > 1e-5f)
+        throw std::runtime_error("QuaternionN test failed: slerp incorrect");
+
+    auto roundTrip = QuaternionN<float>::fromMatrix(composed.toMatrix());
+    if (std::abs(std::abs(QuaternionN<float>::dot(roundTrip, composed)) - 1.0f) > 1e-5f)
+        throw std::runtime_error("QuaternionN test failed: matrix conversion incorrect");
+
+    std::cout << "QuaternionN test passed!" << std::endl;
+}
+
+// Fonction de test pour TransformN
+static void testTransformN()
+{
+    std::cout << "\n=== Test TransformN ===" << std::endl;
+
+    auto near = [](const VectorND<float, 3>& a, const VectorND<float, 3>& b)
+    {
+        return std::abs(a[0] - b[0]) < 1e-4f && std::abs(a[1] - b[1]) < 1e-4f && std::abs(a[2] - b[2]) < 1e-4f;
+    };
+
+    auto rot = QuaternionN<float>::fromAxisAngle(VectorND<float, 3>{ 1.0f, 1.0f, 0.0f }, 0.7f);
+    auto a = TransformN<float>::fromTRS(VectorND<float, 3>{ 1.0f, 2.0f, 3.0f }, rot, VectorND<float, 3>{ 2.0f, 2.0f, 2.0f });
+    auto b = TransformN<float>::fromTranslation(VectorND<float, 3>{ -4.0f, 0.5f, 0.0f });
+
+    VectorND<float, 3> p{ 0.5f, -1.0f, 2.0f };
+    if (!near((a * b).apply(p), a.apply(b.apply(p))))
+        throw std::runtime_error("TransformN test failed: compose incorrect");
+
+    if (!near(a.inverse().apply(a.apply(p)), p))
+        throw std::runtime_error("TransformN test failed: inverse incorrect");
+
+    VectorN<VectorND<float, 3>> points;
+    for (int i = 0; i < 37; ++i)
+        points.push_back(VectorND<float, 3>{ float(i), float(i % 5) - 2.0f, 0.25f * float(i) });
+
+    VectorN<VectorND<float, 3>> out(points.size());
+    a.apply(points, out);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        if (!near(out[i], a.apply(points[i])))
+            throw std::runtime_error("TransformN test failed: batch apply incorrect");
+    }
+
+    a.apply(points);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        if (!near(out[i], points[i]))
+            throw std::runtime_error("TransformN test failed: in-place batch apply incorrect");
+    }
+
+    auto r0 = TransformN<float>::fromRotation(QuaternionN<float>::identity());
+    auto r1 = TransformN<float>(rot.toMatrix(), VectorND<float, 3>{ 2.0f, 0.0f, 0.0f });
+    auto mid = TransformN<float>::slerp(r0, r1, 0.5f);
+    auto expected = TransformN<float>(QuaternionN<float>::slerp(QuaternionN<float>::identity(), rot, 0.5f).toMatrix(),
+        VectorND<float, 3>{ 1.0f, 0.0f, 0.0f });
+    if (!near(mid.apply(p), expected.apply(p)))
+        throw std::runtime_error("TransformN test failed: slerp incorrect");
+
+    std::cout << "TransformN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour KdTreeN
+static void testKdTreeN()
+{
+    std::cout << "\n=== Test KdTreeN ===" << std::endl;
+
+    VectorN<VectorND<float, 3>> points;
+    unsigned int seed = 12345u;
+    auto next = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1u << 24);
+    };
+    for (int i = 0; i < 40000; ++i)
+        points.push_back(VectorND<float, 3>{ next(), next(), next() });
+
+    KdTreeN<float, 3> tree(points, 8, 4);
+    if (tree.size() != points.size())
+        throw std::runtime_error("KdTreeN test failed: wrong size");
+
+    for (int q = 0; q < 20; ++q)
+    {
+        VectorND<float, 3> query{ next(), next(), next() };
+
+        VectorN<float> distances(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            distances[i] = VectorND<float, 3>::distanceSquared(query, points[i]);
+        VectorN<float> sorted = distances;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto neighbors = tree.knn(query, 10);
+        if (neighbors.size() != 10)
+            throw std::runtime_error("KdTreeN test failed: knn returned wrong count");
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            if (neighbors[i].distanceSquared != sorted[i] || distances[neighbors[i].index] != sorted[i])
+                throw std::runtime_error("KdTreeN test failed: knn incorrect");
+        }
+
+        if (tree.nearest(query).distanceSquared != sorted[0])
+            throw std::runtime_error("KdTreeN test failed: nearest incorrect");
+
+        const float radius = 0.05f;
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < distances.size(); ++i)
+        {
+            if (distances[i] <= radius * radius)
+                ++expected;
+        }
+        auto inRadius = tree.radiusSearch(query, radius);
+        if (inRadius.size() != expected)
+            throw std::runtime_error("KdTreeN test failed: radius search incorrect");
+        for (std::size_t i = 0; i < inRadius.size(); ++i)
+        {
+            if (distances[inRadius[i]] > radius * radius)
+                throw std::runtime_error("KdTreeN test failed: radius search returned a far point");
+        }
+    }
+
+    KdTreeN<float, 3> emptyTree;
+    if (!emptyTree.empty() || emptyTree.knn(VectorND<float, 3>{}, 3).size() != 0)
+        throw std::runtime_error("KdTreeN test failed: empty tree");
+
+    std::cout << "KdTreeN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour MatrixDyn
+static void testMatrixDyn()
+{
+    std::cout << "\n=== Test MatrixDyn ===" << std::endl;
+
+    MatrixDyn<int> small{ { 1, 2, 3 }, { 4, 5 } };
+    if (small.rowCount() != 2 || small.colCount() != 3 || small(1, 1) != 5 || small(1, 2) != 0)
+        throw std::runtime_error("MatrixDyn test failed: initializer list constructor");
+
+    bool caught = false;
+    try
+    {
+        small(2, 0);
+    }
+    catch (const std::out_of_range&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("MatrixDyn test failed: out of range access not detected");
+
+    MatrixDyn<float> rowMajor(37, 21, 1.5f);
+    if (reinterpret_cast<std::uintptr_t>(rowMajor.data()) % 64 != 0 || (rowMajor.stride() * sizeof(float)) % 64 != 0
+        || rowMajor.stride() < rowMajor.colCount())
+        throw std::runtime_error("MatrixDyn test failed: storage is not aligned");
+
+    MatrixND<double, 2, 3> fixedA{ { 1, 2, 3 }, { 4, 5, 6 } };
+    MatrixND<double, 3, 2> fixedB{ { 7, 8 }, { 9, 10 }, { 11, 12 } };
+    auto fixedC = MatrixND<double, 2, 3>::multiply<2>(fixedA, fixedB);
+
+    MatrixDyn<double> dynA(fixedA);
+    MatrixDyn<double> dynB(fixedB);
+    auto dynC = MatrixDyn<double>::multiply(dynA, dynB);
+    auto backC = dynC.toMatrixND<2, 2>();
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        if (backC.data()[i] != fixedC.data()[i])
+            throw std::runtime_error("MatrixDyn test failed: multiply or conversion incorrect");
+    }
+
+    const std::size_t m = 53, k = 300, n = 41;
+    MatrixDyn<float> lhsRow(m, k), rhsRow(k, n);
+    MatrixDyn<float, MatrixLayout::ColMajor> lhsCol(m, k), rhsCol(k, n);
+    for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < k; ++j)
+            lhsRow(i, j) = lhsCol(i, j) = float(int((i * 7 + j) % 9) - 4);
+    for (std::size_t i = 0; i < k; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            rhsRow(i, j) = rhsCol(i, j) = float(int((i + j * 3) % 5) - 2);
+
+    auto prodRow = MatrixDyn<float>::multiply(lhsRow, rhsRow);
+    auto prodCol = MatrixDyn<float, MatrixLayout::ColMajor>::multiply(lhsCol, rhsCol);
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            float expected = 0.0f;
+            for (std::size_t p = 0; p < k; ++p)
+                expected += lhsRow(i, p) * rhsRow(p, j);
+            if (prodRow(i, j) != expected || prodCol(i, j) != expected)
+                throw std::runtime_error("MatrixDyn test failed: blocked multiply incorrect");
+        }
+    }
+
+    bool mismatch = false;
+    try
+    {
+        MatrixDyn<float>::multiply(lhsRow, lhsRow);
+    }
+    catch (const std::runtime_error&)
+    {
+        mismatch = true;
+    }
+    if (!mismatch)
+        throw std::runtime_error("MatrixDyn test failed: dimension mismatch not detected");
+
+    MatrixDyn<float> copy(prodRow);
+    MatrixDyn<float> moved(std::move(copy));
+    if (!copy.empty() || moved(5, 7) != prodRow(5, 7))
+        throw std::runtime_error("MatrixDyn test failed: copy or move incorrect");
+
+    MatrixDyn<std::string> strings(2, 2, "x");
+    strings = MatrixDyn<std::string>(3, 1, "y");
+    if (strings.rowCount() != 3 || strings(2, 0) != "y")
+        throw std::runtime_error("MatrixDyn test failed: non trivial elements");
+
+    std::cout << "MatrixDyn test passed!" << std::endl;
+}
+
+
+// Fonction de test pour ThreadPoolN
+static void testThreadPoolN()
+{
+    std::cout << "\n=== Test ThreadPoolN ===" << std::endl;
+
+    ThreadPoolN pool(3);
+    if (pool.threadCount() != 3)
+        throw std::runtime_error("ThreadPoolN test failed: wrong thread count");
+
+    VectorN<int> hits(10000, 0);
+    pool.parallel_for(0, hits.size(), 64, [&hits](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+            hits[i] += 1;
+    });
+    for (std::size_t i = 0; i < hits.size(); ++i)
+    {
+        if (hits[i] != 1)
+            throw std::runtime_error("ThreadPoolN test failed: parallel_for index visited wrong number of times");
+    }
+
+    std::atomic<long long> nestedSum{ 0 };
+    pool.parallel_for(0, 16, 1, [&](std::size_t outerFirst, std::size_t outerLast)
+    {
+        for (std::size_t outer = outerFirst; outer < outerLast; ++outer)
+        {
+            pool.parallel_for(0, 100, 7, [&](std::size_t first, std::size_t last)
+            {
+                long long local = 0;
+                for (std::size_t i = first; i < last; ++i)
+                    local += static_cast<long long>(i);
+                nestedSum += local;
+            });
+        }
+    });
+    if (nestedSum != 16 * 4950)
+        throw std::runtime_error("ThreadPoolN test failed: nested parallel_for incorrect");
+
+    bool caught = false;
+    try
+    {
+        pool.parallel_for(0, 100, 1, [](std::size_t first, std::size_t)
+        {
+            if (first == 42)
+                throw std::runtime_error("task failure");
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("ThreadPoolN test failed: exception not propagated");
+
+    std::atomic<int> counter{ 0 };
+    {
+        ThreadPoolN::TaskGroup group(pool);
+        for (int i = 0; i < 50; ++i)
+            group.run([&counter]() { ++counter; });
+        group.wait();
+    }
+    if (counter != 50)
+        throw std::runtime_error("ThreadPoolN test failed: task group incorrect");
+
+    VectorN<int> autoHits(5000, 0);
+    std::atomic<int> chunks{ 0 };
+    pool.parallel_for(0, autoHits.size(), [&](std::size_t first, std::size_t last)
+    {
+        ++chunks;
+        for (std::size_t i = first; i < last; ++i)
+            autoHits[i] += 1;
+    });
+    for (std::size_t i = 0; i < autoHits.size(); ++i)
+    {
+        if (autoHits[i] != 1)
+            throw std::runtime_error("ThreadPoolN test failed: automatic chunking visited index wrong number of times");
+    }
+    if (pool.autoGrain(5000) != 209 || chunks < 3 || pool.autoGrain(0) != 1)
+        throw std::runtime_error("ThreadPoolN test failed: automatic chunking incorrect");
+
+    WorkStealingDequeN<int> deque(2);
+    for (int i = 0; i < 100; ++i)
+        deque.push(i);
+    int value = -1;
+    if (deque.size() != 100 || !deque.steal(value) || value != 0 || !deque.pop(value) || value != 99)
+        throw std::runtime_error("WorkStealingDequeN test failed: push/pop/steal order incorrect");
+    while (deque.pop(value))
+    {
+    }
+    if (!deque.empty() || deque.steal(value))
+        throw std::runtime_error("WorkStealingDequeN test failed: deque not empty");
+
+    // The owner pushes and pops while thieves steal: every item must come out exactly once.
+    const int itemCount = 20000;
+    VectorN<int> taken(itemCount, 0);
+    std::atomic<bool> producing{ true };
+    std::atomic<int> stolen{ 0 };
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            int item = 0;
+            while (producing.load() || !deque.empty())
+            {
+                if (deque.steal(item))
+                {
+                    ++taken[item];
+                    ++stolen;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < itemCount; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value))
+            ++taken[value];
+    }
+    while (deque.pop(value))
+        ++taken[value];
+    producing = false;
+    for (std::thread& thief : thieves)
+        thief.join();
+    for (int i = 0; i < itemCount; ++i)
+    {
+        if (taken[i] != 1)
+            throw std::runtime_error("WorkStealingDequeN test failed: item lost or taken twice");
+    }
+
+    MatrixDyn<double> lhs(200, 150), rhs(150, 130);
+    for (std::size_t i = 0; i < 200; ++i)
+        for (std::size_t j = 0; j < 150; ++j)
+            lhs(i, j) = double(int((i + 2 * j) % 11) - 5);
+    for (std::size_t i = 0; i < 150; ++i)
+        for (std::size_t j = 0; j < 130; ++j)
+            rhs(i, j) = double(int((3 * i + j) % 7) - 3);
+    auto product = MatrixDyn<double>::multiply(pool, lhs, rhs);
+    for (std::size_t i = 0; i < 200; i += 13)
+    {
+        for (std::size_t j = 0; j < 130; ++j)
+        {
+            double expected = 0.0;
+            for (std::size_t p = 0; p < 150; ++p)
+                expected += lhs(i, p) * rhs(p, j);
+            if (product(i, j) != expected)
+                throw std::runtime_error("ThreadPoolN test failed: parallel multiply incorrect");
+        }
+    }
+
+    MatrixDyn<int, MatrixLayout::ColMajor> grid(40, 30);
+    grid.forEachRow([](std::size_t row, int* first, std::size_t step)
+    {
+        for (std::size_t j = 0; j < 30; ++j)
+            first[j * step] = int(row);
+    }, pool);
+    grid.forEachCol([](std::size_t col, int* first, std::size_t step)
+    {
+        for (std::size_t i = 0; i < 40; ++i)
+            first[i * step] += int(col) * 100;
+    }, pool);
+    if (grid(7, 3) != 307 || grid(39, 29) != 2939)
+        throw std::runtime_error("ThreadPoolN test failed: row/column operations incorrect");
+
+    std::cout << "ThreadPoolN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour ParallelAlgorithmsN
+static void testParallelAlgorithmsN()
+{
+    std::cout << "\n=== Test ParallelAlgorithmsN ===" << std::endl;
+
+    // Small grains force the parallel paths even on short inputs.
+    ThreadPoolN pool(4);
+    const std::size_t grain = 1000;
+    const std::size_t count = 20011;
+
+    VectorN<std::int64_t> values(count);
+    std::uint32_t state = 12345;
+    for (auto& value : values)
+    {
+        state = state * 1664525u + 1013904223u;
+        value = std::int64_t(state >> 8) % 5000 - 2500;
+    }
+
+    VectorN<std::int64_t> sorted = values;
+    ParallelAlgorithmsN::sort(sorted, std::less<>(), pool, grain);
+    VectorN<std::int64_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    if (!std::equal(sorted.begin(), sorted.end(), expected.begin()))
+        throw std::runtime_error("ParallelAlgorithmsN test failed: sort incorrect");
+
+    // Stable sort on the key only: equal keys must keep their original order.
+    VectorN<std::pair<int, std::size_t>> pairs(count);
+    for (std::size_t i = 0; i < count; ++i)
+        pairs[i] = { int(values[i] % 17), i };
+    ParallelAlgorithmsN::stable_sort(pairs, [](const auto& a, const auto& b) { return a.first < b.first; }, pool, grain);
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        if (pairs[i - 1].first > pairs[i].first || (pairs[i - 1].first == pairs[i].first && pairs[i - 1].second > pairs[i].second))
+            throw std::runtime_error("ParallelAlgorithmsN test failed: stable_sort incorrect");
+    }
+
+    std::int64_t total = ParallelAlgorithmsN::reduce(values, std::int64_t(7), std::plus<>(), pool, grain);
+    if (total != std::accumulate(values.begin(), values.end(), std::int64_t(7)))
+        throw std::runtime_error("ParallelAlgorithmsN test failed: reduce incorrect");
+
+    VectorN<std::int64_t> scanned(count);
+    ParallelAlgorithmsN::inclusive_scan(values, scanned, std::plus<>(), pool, grain);
+    std::int64_t running = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        running += values[i];
+        if (scanned[i] != running)
+            throw std::runtime_error("ParallelAlgorithmsN test failed: inclusive_scan incorrect");
+    }
+    ParallelAlgorithmsN::inclusive_scan(scanned, scanned, [](std::int64_t a, std::int64_t b) { return std::max(a, b); }, pool, grain);
+    if (!std::is_sorted(scanned.begin(), scanned.end()))
+        throw std::runtime_error("ParallelAlgorithmsN test failed: in-place inclusive_scan incorrect");
+
+    // A non-commutative op over T and elements of another type, at a small grain.
+    VectorN<std::string> words(200);
+    for (std::size_t i = 0; i < words.size(); ++i)
+        words[i] = std::string(1, char('a' + i % 26));
+    const std::string joined = std::accumulate(words.begin(), words.end(), std::string(">"));
+    const auto concat = [](std::string a, const std::string& b) { return std::move(a) += b; };
+    if (ParallelAlgorithmsN::reduce(words, std::string(">"), concat, pool, 7) != joined)
+        throw std::runtime_error("ParallelAlgorithmsN test failed: reduce with a non-commutative op incorrect");
+    VectorN<std::string> prefixes(words.size());
+    ParallelAlgorithmsN::inclusive_scan(words, prefixes, concat, pool, 7);
+    if (prefixes[0] != "a" || prefixes[words.size() - 1] != joined.substr(1))
+        throw std::runtime_error("ParallelAlgorithmsN test failed: inclusive_scan with a non-commutative op incorrect");
+    VectorN<int> ones(10000, 1);
+    if (ParallelAlgorithmsN::reduce(ones, 0L, std::plus<long>(), pool, 1000) != 10000
+        || ParallelAlgorithmsN::reduce(ones, 0L, std::plus<long>(), pool) != 10000)
+        throw std::runtime_error("ParallelAlgorithmsN test failed: reduce into a wider type incorrect");
+
+    // The first match wins even when a later chunk finishes first.
+    values[15000] = 99999;
+    values[3] = 99999;
+    auto* found = ParallelAlgorithmsN::find_if(values, [](std::int64_t v) { return v == 99999; }, pool, grain);
+    auto* missing = ParallelAlgorithmsN::find_if(values, [](std::int64_t v) { return v > 100000; }, pool, grain);
+    if (found != values.begin() + 3 || missing != values.end())
+        throw std::runtime_error("ParallelAlgorithmsN test failed: find_if incorrect");
+
+    VectorN<std::int64_t> partitioned = values;
+    auto* middle = ParallelAlgorithmsN::partition(partitioned, [](std::int64_t v) { return v % 3 == 0; }, pool, grain);
+    VectorN<std::int64_t> reference = values;
+    std::stable_partition(reference.begin(), reference.end(), [](std::int64_t v) { return v % 3 == 0; });
+    if (!std::equal(partitioned.begin(), partitioned.end(), reference.begin())
+        || middle - partitioned.begin() != std::count_if(values.begin(), values.end(), [](std::int64_t v) { return v % 3 == 0; }))
+        throw std::runtime_error("ParallelAlgorithmsN test failed: partition incorrect");
+
+    // MatrixND and ArrayN storage.
+    auto matrix = std::make_unique<MatrixND<double, 64, 80>>();
+    const std::span<const std::int64_t> head(values.data(), 64 * 80);
+    ParallelAlgorithmsN::transform(head, *matrix, [](std::int64_t v) { return double(v) * 0.5; }, pool, grain);
+    ParallelAlgorithmsN::for_each(*matrix, [](double& v) { v += 1.0; }, pool, grain);
+    if ((*matrix)(0, 3) != double(values[3]) * 0.5 + 1.0 || (*matrix)(63, 79) != double(values[64 * 80 - 1]) * 0.5 + 1.0)
+        throw std::runtime_error("ParallelAlgorithmsN test failed: transform/for_each on MatrixND incorrect");
+    ArrayN<int, 6> array{ 4, 2, 6, 1, 5, 3 };
+    ParallelAlgorithmsN::sort(array, std::greater<>());
+    if (array[0] != 6 || array[5] != 1 || ParallelAlgorithmsN::reduce(array, 0) != 21)
+        throw std::runtime_error("ParallelAlgorithmsN test failed: ArrayN incorrect");
+
+    ListN<int> list;
+    for (std::size_t i = 0; i < 5000; ++i)
+        list.push_back(int((i * 7919) % 5000));
+    ParallelAlgorithmsN::sort(list, std::less<>(), pool, 300);
+    int previous = -1;
+    for (int value : list)
+    {
+        if (value != previous + 1)
+            throw std::runtime_error("ParallelAlgorithmsN test failed: ListN sort incorrect");
+        previous = value;
+    }
+
+    bool caught = false;
+    try
+    {
+        VectorN<std::int64_t> tooSmall(10);
+        ParallelAlgorithmsN::transform(values, tooSmall, [](std::int64_t v) { return v; }, pool);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("ParallelAlgorithmsN test failed: output size not checked");
+
+    std::cout << "ParallelAlgorithmsN test passed!" << std::endl;
+}
+
+
+// Fonction de test pour TaskGraphN
+static void testTaskGraphN()
+{
+    std::cout << "\n=== Test TaskGraphN ===" << std::endl;
+
+    ThreadPoolN pool(4);
+
+    // Diamond: load -> (left, right) -> merge, run twice.
+    std::atomic<int> order{ 0 };
+    int loadStep = -1, leftStep = -1, rightStep = -1, mergeStep = -1;
+    VectorN<int> data(1000, 0);
+    long long leftSum = 0, rightSum = 0, total = 0;
+    std::mutex sumMutex;
+
+    TaskGraphN graph;
+    const TaskGraphN::TaskId load = graph.add([&]()
+    {
+        loadStep = order++;
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = int(i);
+    });
+    const TaskGraphN::TaskId left = graph.add([&]()
+    {
+        leftStep = order++;
+        leftSum = 0;
+        for (std::size_t i = 0; i < 500; ++i)
+            leftSum += data[i];
+    }, { load });
+    const TaskGraphN::TaskId right = graph.add([&]()
+    {
+        rightStep = order++;
+        rightSum = 0;
+        pool.parallel_for(500, 1000, [&](std::size_t first, std::size_t last)
+        {
+            long long local = 0;
+            for (std::size_t i = first; i < last; ++i)
+                local += data[i];
+            std::lock_guard<std::mutex> lock(sumMutex);
+            rightSum += local;
+        });
+    }, { load });
+    graph.add([&]()
+    {
+        mergeStep = order++;
+        total = leftSum + rightSum;
+    }, { left, right });
+
+    for (int iteration = 0; iteration < 2; ++iteration)
+    {
+        order = 0;
+        total = 0;
+        graph.run(pool);
+        if (total != 499500 || loadStep != 0 || mergeStep != 3 || leftStep < 1 || rightStep < 1)
+            throw std::runtime_error("TaskGraphN test failed: diamond graph incorrect");
+    }
+    if (graph.size() != 4)
+        throw std::runtime_error("TaskGraphN test failed: wrong size");
+
+    // Wide graph: a chain of stages each fanning out to many tasks.
+    TaskGraphN wide;
+    std::atomic<int> stageDone[3] = { 0, 0, 0 };
+    std::atomic<bool> wideOrderOk{ true };
+    TaskGraphN::TaskId previous = wide.add([]() {});
+    for (int stage = 0; stage < 3; ++stage)
+    {
+        const TaskGraphN::TaskId join = wide.add([]() {});
+        for (int i = 0; i < 40; ++i)
+        {
+            const TaskGraphN::TaskId task = wide.add([&, stage]()
+            {
+                if (stage > 0 && stageDone[stage - 1] != 40)
+                    wideOrderOk = false;
+                ++stageDone[stage];
+            }, { previous });
+            wide.precede(task, join);
+        }
+        previous = join;
+    }
+    wide.run(pool);
+    if (!wideOrderOk || stageDone[2] != 40)
+        throw std::runtime_error("TaskGraphN test failed: stages ran out of order");
+
+    // A failing task skips its dependents and the error reaches run().
+    TaskGraphN failing;
+    bool dependentRan = false, independentRan = false;
+    const TaskGraphN::TaskId broken = failing.add([]() { throw std::runtime_error("stage failure"); });
+    failing.add([&]() { dependentRan = true; }, { broken });
+    failing.add([&]() { independentRan = true; });
+    bool caught = false;
+    try
+    {
+        failing.run(pool);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught || dependentRan || !independentRan)
+        throw std::runtime_error("TaskGraphN test failed: failure handling incorrect");
+
+    TaskGraphN cyclic;
+    bool cycleRan = false;
+    const TaskGraphN::TaskId a = cyclic.add([&]() { cycleRan = true; });
+    const TaskGraphN::TaskId b = cyclic.add([&]() { cycleRan = true; }, { a });
+    cyclic.precede(b, a);
+    caught = false;
+    try
+    {
+        cyclic.run(pool);
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    if (!caught || cycleRan)
+        throw std::runtime_error("TaskGraphN test failed: cycle not detected");
+
+    caught = false;
+    try
+    {
+        cyclic.precede(a, 7);
+    }
+    catch (const std::out_of_range&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("TaskGraphN test failed: unknown task accepted");
+
+    std::cout << "TaskGraphN test passed!" << std::endl;
+}
+
+// Fonction de test pour SortN
+static void testSortN()
+{
+    std::cout << "\n=== Test SortN ===" << std::endl;
+
+    ThreadPoolN pool(4);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    // Radix sort on integers, below and above the parallel threshold.
+    for (std::size_t n : { std::size_t(50), std::size_t(5000), std::size_t(100000) })
+    {
+        VectorN<std::uint32_t> values(n);
+        for (auto& value : values)
+            value = std::uint32_t(next());
+        VectorN<std::uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+        SortN::radix_sort(values, pool);
+        if (!std::equal(values.begin(), values.end(), expected.begin()))
+            throw std::runtime_error("SortN test failed: radix_sort on unsigned integers incorrect");
+
+        VectorN<int> signedValues(n);
+        for (auto& value : signedValues)
+            value = int(next() % 2001) - 1000;
+        VectorN<int> signedExpected = signedValues;
+        std::sort(signedExpected.begin(), signedExpected.end());
+        SortN::radix_sort(signedValues, pool);
+        if (!std::equal(signedValues.begin(), signedValues.end(), signedExpected.begin()))
+            throw std::runtime_error("SortN test failed: radix_sort on signed integers incorrect");
+    }
+
+    VectorN<double> reals = { 3.5, -0.0, -1e300, 0.0, std::numeric_limits<double>::infinity(), -2.25, 1e-300,
+        -std::numeric_limits<double>::infinity(), 2.0, -2.25 };
+    VectorN<double> realsExpected = reals;
+    std::sort(realsExpected.begin(), realsExpected.end());
+    SortN::radix_sort(reals);
+    if (!std::equal(reals.begin(), reals.end(), realsExpected.begin()) || !std::signbit(reals[4]) || std::signbit(reals[5]))
+        throw std::runtime_error("SortN test failed: radix_sort on doubles incorrect");
+
+    VectorN<float> floats(80000);
+    for (auto& value : floats)
+        value = float(std::int64_t(next() % 200001) - 100000) * 0.125f;
+    SortN::radix_sort(floats, pool);
+    if (!std::is_sorted(floats.begin(), floats.end()))
+        throw std::runtime_error("SortN test failed: parallel radix_sort on floats incorrect");
+
+    // Radix sort of records by key is stable.
+    struct Record
+    {
+        std::int64_t key;
+        std::size_t order;
+    };
+    for (std::size_t n : { std::size_t(1000), std::size_t(90000) })
+    {
+        VectorN<Record> records(n);
+        for (std::size_t i = 0; i < n; ++i)
+            records[i] = Record{ std::int64_t(next() % 100) - 50, i };
+        SortN::radix_sort(records, [](const Record& record) { return record.key; }, pool);
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            if (records[i - 1].key > records[i].key
+                || (records[i - 1].key == records[i].key && records[i - 1].order > records[i].order))
+                throw std::runtime_error("SortN test failed: radix_sort by key not stable");
+        }
+    }
+
+    // pdqsort and the parallel sort on random and patterned inputs.
+    const std::size_t n = 120000;
+    VectorN<VectorN<int>> inputs;
+    VectorN<int> pattern(n);
+    for (auto& value : pattern)
+        value = int(next() % 1000000);
+    inputs.push_back(pattern);
+    for (std::size_t i = 0; i < n; ++i)
+        pattern[i] = int(i);
+    inputs.push_back(pattern);
+    for (std::size_t i = 0; i < n; ++i)
+        pattern[i] = int(n - i);
+    inputs.push_back(pattern);
+    for (std::size_t i = 0; i < n; ++i)
+        pattern[i] = 7;
+    inputs.push_back(pattern);
+    for (std::size_t i = 0; i < n; ++i)
+        pattern[i] = int(i < n / 2 ? i : n - i);
+    inputs.push_back(pattern);
+    for (std::size_t i = 0; i < n; ++i)
+        pattern[i] = int(next() % 4);
+    inputs.push_back(pattern);
+
+    for (const VectorN<int>& input : inputs)
+    {
+        VectorN<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        VectorN<int> work = input;
+        SortN::pdqsort(work);
+        if (!std::equal(work.begin(), work.end(), expected.begin()))
+            throw std::runtime_error("SortN test failed: pdqsort incorrect");
+
+        work = input;
+        SortN::sort(work, std::less<>(), pool);
+        if (!std::equal(work.begin(), work.end(), expected.begin()))
+            throw std::runtime_error("SortN test failed: parallel sort incorrect");
+
+        work = input;
+        SortN::pdqsort(work.begin(), work.begin() + 1000, std::greater<>());
+        if (!std::is_sorted(work.begin(), work.begin() + 1000, std::greater<>())
+            || !std::equal(work.begin() + 1000, work.end(), input.begin() + 1000))
+            throw std::runtime_error("SortN test failed: pdqsort on a subrange incorrect");
+    }
+
+    VectorN<std::string> words = { "pear", "apple", "fig", "kiwi", "banana", "cherry", "date" };
+    SortN::pdqsort(words);
+    if (words[0] != "apple" || words[6] != "pear")
+        throw std::runtime_error("SortN test failed: pdqsort on strings incorrect");
+
+    // List sorts relink the nodes: stable, and iterators keep pointing to the same elements.
+    ListN<std::pair<int, int>> list;
+    for (int i = 0; i < 500; ++i)
+        list.push_back({ int(next() % 10), i });
+    auto firstElement = list.begin();
+    const std::pair<int, int> firstValue = *firstElement;
+    SortN::sort(list, [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (list.size() != 500 || *firstElement != firstValue)
+        throw std::runtime_error("SortN test failed: ListN sort moved elements");
+    auto previousElement = list.begin();
+    for (auto it = std::next(list.begin()); it != list.end(); ++it, ++previousElement)
+    {
+        if (previousElement->first > it->first || (previousElement->first == it->first && previousElement->second > it->second))
+            throw std::runtime_error("SortN test failed: ListN sort not stable");
+    }
+    if ((--list.end())->first != 9 || list.back().first != 9)
+        throw std::runtime_error("SortN test failed: ListN sort tail incorrect");
+
+    using NodeList = IntrusiveList<Node, &Node::hook>;
+    std::vector<std::unique_ptr<Node>> nodes;
+    NodeList nodeList;
+    for (int value : { 5, 3, 9, 1, 3, 7 })
+    {
+        nodes.push_back(std::make_unique<Node>(value));
+        nodeList.push_back(*nodes.back());
+    }
+    nodeList.sort();
+    int concatenated = 0;
+    for (const Node& node : nodeList)
+        concatenated = concatenated * 10 + node.data;
+    int reversedDigits = 0;
+    for (const Node& node : nodeList | std::views::reverse)
+        reversedDigits = reversedDigits * 10 + node.data;
+    if (concatenated != 133579 || reversedDigits != 975331 || &nodeList.front() != nodes[3].get())
+        throw std::runtime_error("SortN test failed: IntrusiveList sort incorrect");
+    SortN::sort(nodeList, [](const Node& a, const Node& b) { return a.data > b.data; });
+    if (nodeList.front().data != 9 || nodeList.back().data != 1)
+        throw std::runtime_error("SortN test failed: IntrusiveList sort with comparator incorrect");
+    nodeList.clear();
+
+    std::cout << "SortN test passed!" << std::endl;
+}
+
+// Fonction de test pour HashMapN
+static void testHashMapN()
+{
+    std::cout << "\n=== Test HashMapN ===" << std::endl;
+
+    HashMapN<int, int> map;
+    if (!map.empty() || map.find(3) != map.end() || map.capacity() != 0)
+        throw std::runtime_error("HashMapN test failed: empty map incorrect");
+
+    // Random inserts, overwrites and erases, checked against std::unordered_map.
+    std::unordered_map<int, int> reference;
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (int step = 0; step < 200000; ++step)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const int key = int(state % 5000);
+        switch ((state >> 32) % 4)
+        {
+        case 0:
+        case 1:
+            map.insert_or_assign(key, step);
+            reference[key] = step;
+            break;
+        case 2:
+            if (map.erase(key) != reference.erase(key))
+                throw std::runtime_error("HashMapN test failed: erase count incorrect");
+            break;
+        default:
+        {
+            auto it = map.find(key);
+            auto expected = reference.find(key);
+            if ((it == map.end()) != (expected == reference.end()) || (it != map.end() && it->second != expected->second))
+                throw std::runtime_error("HashMapN test failed: find incorrect");
+        }
+        }
+    }
+    if (map.size() != reference.size() || std::size_t(std::distance(map.begin(), map.end())) != reference.size())
+        throw std::runtime_error("HashMapN test failed: size incorrect");
+    for (const auto& [key, value] : map)
+    {
+        if (reference.at(key) != value)
+            throw std::runtime_error("HashMapN test failed: iteration incorrect");
+    }
+    if (map.load_factor() > HashMapN<int, int>::max_load_factor())
+        throw std::runtime_error("HashMapN test failed: load factor above maximum");
+
+    // Erase while iterating, erase_if, rehash and reserve.
+    for (auto it = map.begin(); it != map.end();)
+        it = (it->first % 2 == 0) ? map.erase(it) : std::next(it);
+    for (const auto& entry : map)
+    {
+        if (entry.first % 2 == 0)
+            throw std::runtime_error("HashMapN test failed: erase during iteration incorrect");
+    }
+    const std::size_t odd = map.size();
+    if (map.erase_if([](const auto& entry) { return entry.first % 3 == 0; }) + map.size() != odd)
+        throw std::runtime_error("HashMapN test failed: erase_if count incorrect");
+    map.rehash(0);
+    const std::size_t shrunk = map.capacity();
+    map.reserve(10000);
+    if (map.capacity() - map.capacity() / 8 < 10000 || shrunk >= map.capacity())
+        throw std::runtime_error("HashMapN test failed: reserve incorrect");
+    const std::size_t reserved = map.capacity();
+    for (int key = 100000; key < 100000 + 5000; ++key)
+        map[key] = key;
+    if (map.capacity() != reserved || map.at(100042) != 100042)
+        throw std::runtime_error("HashMapN test failed: reserved map rehashed");
+
+    // Copy, move, equality.
+    HashMapN<int, int> copy = map;
+    if (!(copy == map))
+        throw std::runtime_error("HashMapN test failed: copy incorrect");
+    copy[-1] = 1;
+    if (copy == map)
+        throw std::runtime_error("HashMapN test failed: equality incorrect");
+    HashMapN<int, int> moved = std::move(copy);
+    if (!copy.empty() || moved.at(-1) != 1)
+        throw std::runtime_error("HashMapN test failed: move incorrect");
+    copy = moved;
+    moved.clear();
+    if (!moved.empty() || moved.contains(-1) || copy.at(-1) != 1)
+        throw std::runtime_error("HashMapN test failed: clear or copy assignment incorrect");
+
+    bool caught = false;
+    try
+    {
+        moved.at(12);
+    }
+    catch (const std::out_of_range&)
+    {
+        caught = true;
+    }
+    if (!caught)
+        throw std::runtime_error("HashMapN test failed: at did not throw");
+
+    // String keys: heterogeneous lookup, try_emplace leaves the argument untouched on a hit.
+    HashMapN<std::string, int> words = { { "alpha", 1 }, { "beta", 2 }, { "gamma", 3 } };
+    if (words.at("beta") != 2 || !words.contains(std::string_view("gamma")) || words.count("delta") != 0
+        || words.find("alpha") == words.end() || words.erase("alpha") != 1 || words.size() != 2)
+        throw std::runtime_error("HashMapN test failed: heterogeneous lookup incorrect");
+    std::string key = "beta";
+    if (words.try_emplace(std::move(key), 5).second || key != "beta" || words["beta"] != 2)
+        throw std::runtime_error("HashMapN test failed: try_emplace incorrect");
+    words["delta"] += 4;
+    if (words.at("delta") != 4)
+        throw std::runtime_error("HashMapN test failed: operator[] incorrect");
+
+    // emplace takes the std::unordered_map forms: a pair, key and mapped, or piecewise construction.
+    HashMapN<std::string, std::string> names;
+    if (!names.emplace(std::pair<const std::string, std::string>("ada", "lovelace")).second
+        || !names.emplace(std::string("alan"), "turing").second || !names.emplace("grace", "hopper").second
+        || !names.emplace(std::piecewise_construct, std::forward_as_tuple("edsger"), std::forward_as_tuple(3, 'd')).second
+        || names.at("edsger") != "ddd" || names.at("grace") != "hopper" || names.size() != 4)
+        throw std::runtime_error("HashMapN test failed: emplace incorrect");
+    std::string present = "alan";
+    if (names.emplace(std::move(present), "kay").second || present != "alan" || names.at("alan") != "turing"
+        || names.emplace(std::piecewise_construct, std::forward_as_tuple(present), std::forward_as_tuple(2, 'k')).second)
+        throw std::runtime_error("HashMapN test failed: emplace of a present key incorrect");
+
+    // Move-only values, a custom allocator, and a degenerate hash that puts every key in one probe sequence.
+    HashMapN<int, std::unique_ptr<int>, HashN<int>, std::equal_to<>, AlignedAllocatorN<std::pair<const int, std::unique_ptr<int>>>> owners;
+    for (int i = 0; i < 100; ++i)
+        owners.try_emplace(i, std::make_unique<int>(i * i));
+    if (*owners.at(9) != 81 || owners.size() != 100)
+        throw std::runtime_error("HashMapN test failed: move-only values incorrect");
+
+    struct ConstantHash
+    {
+        std::size_t operator()(int) const { return 42; }
+    };
+    HashMapN<int, int, ConstantHash> collisions;
+    for (int i = 0; i < 300; ++i)
+        collisions[i] = -i;
+    for (int i = 0; i < 300; i += 2)
+        collisions.erase(i);
+    for (int i = 0; i < 300; ++i)
+    {
+        if (collisions.contains(i) != (i % 2 == 1) || (i % 2 == 1 && collisions.at(i) != -i))
+            throw std::runtime_error("HashMapN test failed: colliding keys incorrect");
+    }
+
+    std::cout << "HashMapN test passed!" << std::endl;
+}
+
+// Fonction de test pour HashSetN
+static void testHashSetN()
+{
+    std::cout << "\n=== Test HashSetN ===" << std::endl;
+
+    HashSetN<int> set = { 4, 8, 15, 16, 23, 42 };
+    if (set.size() != 6 || !set.contains(15) || set.contains(7))
+        throw std::runtime_error("HashSetN test failed: initializer list incorrect");
+    if (set.insert(8).second || !set.insert(7).second || set.size() != 7)
+        throw std::runtime_error("HashSetN test failed: insert incorrect");
+
+    // Insert and erase many keys, so that tombstones are created and purged.
+    std::unordered_set<int> reference(set.begin(), set.end());
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 2000; ++i)
+        {
+            set.insert(round * 1000 + i);
+            reference.insert(round * 1000 + i);
+        }
+        for (int i = 0; i < 2000; i += 3)
+        {
+            set.erase(round * 1000 + i);
+            reference.erase(round * 1000 + i);
+        }
+    }
+    if (set.size() != reference.size())
+        throw std::runtime_error("HashSetN test failed: size incorrect");
+    for (int key : reference)
+    {
+        if (!set.contains(key))
+            throw std::runtime_error("HashSetN test failed: key lost");
+    }
+    int total = 0;
+    for (int key : set)
+        total += reference.count(key) ? 1 : 0;
+    if (std::size_t(total) != reference.size())
+        throw std::runtime_error("HashSetN test failed: iteration incorrect");
+
+    HashSetN<std::string> names;
+    names.emplace("ada");
+    names.emplace(3, 'x');
+    if (!names.contains("xxx") || names.find(std::string_view("ada")) == names.end() || names.erase("ada") != 1)
+        throw std::runtime_error("HashSetN test failed: string keys incorrect");
+
+    HashSetN<int> other = { 1, 2, 3 };
+    HashSetN<int> same = { 3, 2, 1 };
+    if (!(other == same))
+        throw std::runtime_error("HashSetN test failed: equality incorrect");
+    other.swap(set);
+    if (other.size() != reference.size() || set.size() != 3)
+        throw std::runtime_error("HashSetN test failed: swap incorrect");
+
+    std::cout << "HashSetN test passed!" << std::endl;
+}
+
+// Fonction de test pour ConcurrentHashMapN
+static void testConcurrentHashMapN()
+{
+    std::cout << "\n=== Test ConcurrentHashMapN ===" << std::endl;
+
+    ConcurrentHashMapN<int, long long> map(8);
+    if (map.shard_count() != 8 || !map.empty() || map.get(1).has_value())
+        throw std::runtime_error("ConcurrentHashMapN test failed: empty map incorrect");
+
+    // Writers fill disjoint ranges (every shard grows while others are used) while readers check the invariant value == 2 * key.
+    const int threadCount = 4;
+    const int perThread = 20000;
+    std::atomic<bool> writing{ true };
+    std::atomic<int> badReads{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&map, t]()
+        {
+            for (int i = t * perThread; i < (t + 1) * perThread; ++i)
+                map.insert(i, 2LL * i);
+        });
+    }
+    for (int r = 0; r < 2; ++r)
+    {
+        threads.emplace_back([&map, &writing, &badReads, r]()
+        {
+            int key = r;
+            while (writing.load())
+            {
+                long long value = 0;
+                if (map.find(key, value) && value != 2LL * key)
+                    ++badReads;
+                key = (key + 7919) % (threadCount * perThread);
+            }
+        });
+    }
+    for (int t = 0; t < threadCount; ++t)
+        threads[t].join();
+    writing = false;
+    for (std::size_t t = threadCount; t < threads.size(); ++t)
+        threads[t].join();
+    threads.clear();
+    if (badReads != 0 || map.size() != std::size_t(threadCount * perThread) || map.get(12345) != 24690LL)
+        throw std::runtime_error("ConcurrentHashMapN test failed: concurrent inserts incorrect");
+
+    // Concurrent upserts on shared keys act as atomic counters.
+    ConcurrentHashMapN<std::string, int> counters;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&counters, t]()
+        {
+            for (int i = 0; i < 5000; ++i)
+            {
+                counters.upsert("key" + std::to_string(i % 10), [](int& count) { ++count; });
+                counters.upsert("thread" + std::to_string(t), [](int& count) { count += 2; }, 100);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    threads.clear();
+    int sum = 0;
+    counters.for_each([&sum](const std::string& key, int count)
+    {
+        if (key.starts_with("key"))
+            sum += count;
+    });
+    if (sum != threadCount * 5000 || counters.get("key3") != threadCount * 500 || counters.get("thread2") != 10100
+        || !counters.contains("thread0") || counters.size() != 10 + std::size_t(threadCount))
+        throw std::runtime_error("ConcurrentHashMapN test failed: upsert incorrect");
+
+    // Concurrent erase and insert_or_assign on the same keys.
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&map, t]()
+        {
+            for (int i = t; i < threadCount * perThread; i += threadCount)
+            {
+                if (i % 2 == 0)
+                    map.erase(i);
+                else
+                    map.insert_or_assign(i, -1LL);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    if (map.size() != std::size_t(threadCount * perThread / 2) || map.contains(10) || map.get(11) != -1LL)
+        throw std::runtime_error("ConcurrentHashMapN test failed: concurrent erase incorrect");
+
+    if (map.erase_if([](const auto& entry) { return entry.first < 1000; }) != 500 || map.erase(1000) || !map.erase(1001))
+        throw std::runtime_error("ConcurrentHashMapN test failed: erase_if incorrect");
+    map.clear();
+    map.reserve(1000);
+    if (!map.empty() || !map.insert(3, 9LL) || map.insert(3, 10LL) || map.get(3) != 9LL)
+        throw std::runtime_error("ConcurrentHashMapN test failed: clear or insert incorrect");
+
+    std::cout << "ConcurrentHashMapN test passed!" << std::endl;
+}
+
+// Fonction de test pour BTreeMapN
+static void testBTreeMapN()
+{
+    std::cout << "\n=== Test BTreeMapN ===" << std::endl;
+
+    BTreeMapN<int, int> map;
+    if (!map.empty() || map.height() != 0 || map.begin() != map.end() || map.find(3) != map.end())
+        throw std::runtime_error("BTreeMapN test failed: empty map incorrect");
+    bool thrown = false;
+    try
+    {
+        map.at(3);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+        throw std::runtime_error("BTreeMapN test failed: at() on a missing key did not throw");
+
+    // Random inserts and erases, checked against std::map: splits, borrows, merges and root collapses.
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    std::map<int, int> reference;
+    for (int round = 0; round < 60000; ++round)
+    {
+        const int key = int(next() % 20000) - 10000;
+        if (next() % 3 != 0)
+        {
+            const bool inserted = map.try_emplace(key, round).second;
+            if (inserted != reference.try_emplace(key, round).second)
+                throw std::runtime_error("BTreeMapN test failed: try_emplace incorrect");
+        }
+        else if (map.erase(key) != reference.erase(key))
+        {
+            throw std::runtime_error("BTreeMapN test failed: erase incorrect");
+        }
+    }
+    if (map.size() != reference.size() || map.height() < 2)
+        throw std::runtime_error("BTreeMapN test failed: size incorrect");
+    if (!std::ranges::equal(map, reference, [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }))
+        throw std::runtime_error("BTreeMapN test failed: iteration order incorrect");
+    auto last = map.end();
+    for (auto it = reference.rbegin(); it != reference.rend(); ++it)
+    {
+        --last;
+        if (last.key() != it->first || last->second != it->second)
+            throw std::runtime_error("BTreeMapN test failed: reverse iteration incorrect");
+    }
+    if (last != map.begin())
+        throw std::runtime_error("BTreeMapN test failed: reverse iteration did not reach begin");
+
+    for (int key = -10002; key <= 10002; key += 7)
+    {
+        auto lower = map.lower_bound(key);
+        auto upper = map.upper_bound(key);
+        auto expectedLower = reference.lower_bound(key);
+        auto expectedUpper = reference.upper_bound(key);
+        if ((lower == map.end()) != (expectedLower == reference.end()) || (lower != map.end() && lower.key() != expectedLower->first)
+            || (upper == map.end()) != (expectedUpper == reference.end()) || (upper != map.end() && upper.key() != expectedUpper->first)
+            || map.contains(key) != reference.contains(key))
+            throw std::runtime_error("BTreeMapN test failed: lower_bound/upper_bound incorrect");
+    }
+
+    // Range scans: scan() and range() visit [low, high) in order.
+    long long scanned = 0;
+    const std::size_t visited = map.scan(-500, 1500, [&scanned](const int& key, const int& value) { scanned += key + value; });
+    long long expected = 0;
+    std::size_t expectedCount = 0;
+    for (auto it = reference.lower_bound(-500); it != reference.lower_bound(1500); ++it, ++expectedCount)
+        expected += it->first + it->second;
+    if (scanned != expected || visited != expectedCount || std::size_t(std::ranges::distance(map.range(-500, 1500))) != expectedCount
+        || !map.range(10, 10).empty() || map.scan(20000, 30000, [](const int&, const int&) {}) != 0)
+        throw std::runtime_error("BTreeMapN test failed: range scan incorrect");
+
+    // Values are mutable through iterators, operator[] and insert_or_assign.
+    for (auto element : map.range(0, 100))
+        element.second = -element.first;
+    for (auto it = reference.lower_bound(0); it != reference.lower_bound(100); ++it)
+    {
+        if (map.at(it->first) != -it->first)
+            throw std::runtime_error("BTreeMapN test failed: update through iterators incorrect");
+    }
+    map[100000] = 5;
+    map.insert_or_assign(100000, 6);
+    if (map.at(100000) != 6 || map.insert({ 100000, 7 }).second)
+        throw std::runtime_error("BTreeMapN test failed: value update incorrect");
+    map.erase(100000);
+
+    // Erasing through iterators returns the following element.
+    std::size_t erased = 0;
+    for (auto it = map.begin(); it != map.end();)
+    {
+        if (it.key() % 2 == 0)
+        {
+            it = map.erase(it);
+            ++erased;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    std::erase_if(reference, [](const auto& element) { return element.first % 2 == 0; });
+    if (map.size() != reference.size() || !std::ranges::equal(map | std::views::transform([](auto element) { return element.first; }),
+        reference | std::views::keys))
+        throw std::runtime_error("BTreeMapN test failed: erase through iterators incorrect");
+
+    // Erasing everything collapses the tree back to empty.
+    for (const auto& [key, value] : reference)
+        map.erase(key);
+    if (!map.empty() || map.height() != 0 || map.begin() != map.end())
+        throw std::runtime_error("BTreeMapN test failed: erase all incorrect");
+
+    // Bulk loading from sorted vectors builds the same map in linear time.
+    const std::size_t count = 100000;
+    VectorN<long long> keys(count);
+    VectorN<double> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        keys[i] = 3LL * i - 1000;
+        values[i] = 0.5 * double(i);
+    }
+    BTreeMapN<long long, double> loaded;
+    loaded.bulk_load(keys, values);
+    if (loaded.size() != count || loaded.at(3LL * 777 - 1000) != 388.5 || loaded.contains(0) || loaded.find(-1000) != loaded.begin()
+        || (--loaded.end()).key() != 3LL * (count - 1) - 1000)
+        throw std::runtime_error("BTreeMapN test failed: bulk_load incorrect");
+    for (long long key = -1000; key < 20000; key += 2)
+        loaded.insert_or_assign(key, 1.0);
+    for (long long key = -1000; key < 100000; key += 5)
+        loaded.erase(key);
+    long long previous = std::numeric_limits<long long>::min();
+    std::size_t walked = 0;
+    for (const auto& [key, value] : loaded)
+    {
+        if (key <= previous || (key % 5 == 0 && key < 100000))
+            throw std::runtime_error("BTreeMapN test failed: updates after bulk_load incorrect");
+        previous = key;
+        ++walked;
+    }
+    if (walked != loaded.size())
+        throw std::runtime_error("BTreeMapN test failed: size after bulk_load incorrect");
+
+    VectorN<long long> unsorted{ 1, 3, 2 };
+    VectorN<double> three{ 1.0, 2.0, 3.0 };
+    thrown = false;
+    try
+    {
+        loaded.bulk_load(unsorted, three);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    if (!thrown || !loaded.empty())
+        throw std::runtime_error("BTreeMapN test failed: unsorted bulk_load not rejected");
+
+    // Copies are independent; string keys go through the generic (non-SIMD) search.
+    BTreeMapN<std::string, int> words{ { "pear", 1 }, { "apple", 2 }, { "fig", 3 } };
+    for (int i = 0; i < 500; ++i)
+        words["word" + std::to_string(i)] = i;
+    BTreeMapN<std::string, int> copy = words;
+    copy.erase("apple");
+    if (words.size() != 503 || copy.size() != 502 || words.begin().key() != "apple" || copy.begin().key() != "fig"
+        || copy.at("word250") != 250 || !words.contains("pear"))
+        throw std::runtime_error("BTreeMapN test failed: string keys or copy incorrect");
+
+    // Unsigned and floating point keys use the biased and floating SIMD compares.
+    BTreeMapN<unsigned, int> unsignedKeys;
+    BTreeMapN<float, int> floatKeys;
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        unsignedKeys[i * 2147483u] = int(i);
+        floatKeys[float(i) - 1000.5f] = int(i);
+    }
+    if (unsignedKeys.at(1999u * 2147483u) != 1999 || unsignedKeys.lower_bound(3000000000u).key() != 1397u * 2147483u
+        || floatKeys.at(-1000.5f) != 0 || floatKeys.lower_bound(0.0f).key() != 0.5f)
+        throw std::runtime_error("BTreeMapN test failed: unsigned or float keys incorrect");
+
+    std::cout << "BTreeMapN tests passed." << std::endl;
+}
+
+// Fonction de test pour HeapN
+static void testHeapN()
+{
+    std::cout << "\n=== Test HeapN ===" << std::endl;
+
+    HeapN<int> heap;
+    bool thrown = false;
+    try
+    {
+        heap.pop();
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    if (!thrown || !heap.empty())
+        throw std::runtime_error("HeapN test failed: pop on an empty heap did not throw");
+
+    // Pushes and pops in random order always yield the smallest element, as a sorted multiset would.
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    std::multiset<int> reference;
+    for (int round = 0; round < 20000; ++round)
+    {
+        if (reference.empty() || next() % 3 != 0)
+        {
+            const int value = int(next() % 1000);
+            heap.push(value);
+            reference.insert(value);
+        }
+        else
+        {
+            if (heap.top() != *reference.begin())
+                throw std::runtime_error("HeapN test failed: top incorrect");
+            heap.pop();
+            reference.erase(reference.begin());
+        }
+    }
+    if (heap.size() != reference.size())
+        throw std::runtime_error("HeapN test failed: size incorrect");
+    for (int expected : reference)
+    {
+        if (heap.take() != expected)
+            throw std::runtime_error("HeapN test failed: take order incorrect");
+    }
+
+    // Heapify from a range, from a VectorN taken over in place, and from an initializer list.
+    VectorN<int> values(5000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = int(next() % 100000);
+    VectorN<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    HeapN<int, 2> binary(values);
+    HeapN<int, 8> wide;
+    VectorN<int> storage = values;
+    wide.adopt(storage);
+    if (!storage.empty() || binary.size() != values.size() || wide.size() != values.size())
+        throw std::runtime_error("HeapN test failed: heapify size incorrect");
+    for (int expected : sorted)
+    {
+        if (binary.take() != expected || wide.take() != expected)
+            throw std::runtime_error("HeapN test failed: heapify order incorrect");
+    }
+
+    HeapN<int, 4, std::greater<int>> maxHeap = { 3, 9, 1, 7, 5 };
+    maxHeap.replace_top(4);
+    if (maxHeap.take() != 7 || maxHeap.take() != 5 || maxHeap.take() != 4 || maxHeap.top() != 3)
+        throw std::runtime_error("HeapN test failed: max-heap or replace_top incorrect");
+
+    // Strings ordered by length through a custom comparator.
+    auto shorter = [](const std::string& a, const std::string& b) { return a.size() < b.size(); };
+    HeapN<std::string, 3, decltype(shorter)> words(shorter);
+    for (const char* word : { "banana", "fig", "kiwi", "apple", "pomegranate" })
+        words.emplace(word);
+    if (words.take() != "fig" || words.take() != "kiwi" || words.top() != "apple" || words.size() != 3)
+        throw std::runtime_error("HeapN test failed: custom comparator incorrect");
+
+    std::cout << "HeapN test passed!" << std::endl;
+}
+
+// Fonction de test pour IndexedHeapN
+static void testIndexedHeapN()
+{
+    std::cout << "\n=== Test IndexedHeapN ===" << std::endl;
+
+    IndexedHeapN<int> heap;
+    const auto a = heap.push(50);
+    const auto b = heap.push(20);
+    const auto c = heap.push(40);
+    if (heap.top() != 20 || heap.top_handle() != b || heap[a] != 50 || !heap.contains(c))
+        throw std::runtime_error("IndexedHeapN test failed: push incorrect");
+
+    heap.decrease_key(a, 10);
+    if (heap.top_handle() != a)
+        throw std::runtime_error("IndexedHeapN test failed: decrease_key incorrect");
+    heap.increase_key(a, 45);
+    heap.erase(b);
+    if (heap.top_handle() != c || heap.contains(b) || heap.size() != 2)
+        throw std::runtime_error("IndexedHeapN test failed: increase_key or erase incorrect");
+
+    bool thrown = false;
+    try
+    {
+        heap.decrease_key(c, 99);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    if (!thrown || heap[c] != 40)
+        throw std::runtime_error("IndexedHeapN test failed: decrease_key to a larger value not rejected");
+    thrown = false;
+    try
+    {
+        heap.erase(b);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    if (!thrown)
+        throw std::runtime_error("IndexedHeapN test failed: erase of a free handle not rejected");
+    if (heap.push(7) != b)
+        throw std::runtime_error("IndexedHeapN test failed: free handle not reused");
+
+    // Random updates and erasures by handle, checked against a set of (value, handle) pairs.
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    heap.clear();
+    std::set<std::pair<int, std::size_t>> reference;
+    std::vector<int> current;
+    std::vector<std::size_t> live;
+    for (int round = 0; round < 30000; ++round)
+    {
+        const std::uint64_t action = next() % 6;
+        if (live.empty() || action < 2)
+        {
+            const int value = int(next() % 100000);
+            const std::size_t handle = heap.push(value);
+            if (handle >= current.size())
+                current.resize(handle + 1);
+            current[handle] = value;
+            reference.insert({ value, handle });
+            live.push_back(handle);
+        }
+        else
+        {
+            const std::size_t pick = std::size_t(next() % live.size());
+            const std::size_t handle = live[pick];
+            reference.erase({ current[handle], handle });
+            if (action == 2)
+            {
+                heap.erase(handle);
+                live[pick] = live.back();
+                live.pop_back();
+                continue;
+            }
+            if (action == 3)
+                current[handle] -= int(next() % 1000);
+            else
+                current[handle] = int(next() % 100000);
+            if (action == 3)
+                heap.decrease_key(handle, current[handle]);
+            else
+                heap.update(handle, current[handle]);
+            reference.insert({ current[handle], handle });
+        }
+        if (heap.size() != reference.size() || (!heap.empty() && heap.top() != reference.begin()->first))
+            throw std::runtime_error("IndexedHeapN test failed: top after random operations incorrect");
+    }
+    while (!heap.empty())
+    {
+        const auto [handle, value] = heap.take();
+        if (value != reference.begin()->first || current[handle] != value)
+            throw std::runtime_error("IndexedHeapN test failed: take order incorrect");
+        reference.erase(reference.begin());
+    }
+
+    // Draining with take() must not compare against the moved-out top value.
+    IndexedHeapN<std::string, 4, std::greater<>> words;
+    for (const char* word : { "m", "z", "y", "x", "w", "a", "b", "c", "d", "e", "f", "g" })
+        words.push(word);
+    std::string drained;
+    while (!words.empty())
+        drained += words.take().second;
+    if (drained != "zyxwmgfedcba")
+        throw std::runtime_error("IndexedHeapN test failed: take order of a max-heap of strings incorrect");
+
+    // Dijkstra on a grid with decrease_key, heapified from the initial distances.
+    const std::size_t side = 40;
+    std::vector<int> cost(side * side);
+    for (int& value : cost)
+        value = int(next() % 9) + 1;
+    VectorN<int> initial(side * side, std::numeric_limits<int>::max());
+    initial[0] = 0;
+    IndexedHeapN<int> frontier(initial);
+    std::vector<int> distance(side * side, std::numeric_limits<int>::max());
+    while (!frontier.empty())
+    {
+        const auto [node, dist] = frontier.take();
+        distance[node] = dist;
+        const std::size_t x = node % side, y = node / side;
+        const std::size_t neighbours[4] = { x > 0 ? node - 1 : node, x + 1 < side ? node + 1 : node,
+            y > 0 ? node - side : node, y + 1 < side ? node + side : node };
+        for (std::size_t neighbour : neighbours)
+        {
+            if (frontier.contains(neighbour) && dist + cost[neighbour] < frontier[neighbour])
+                frontier.decrease_key(neighbour, dist + cost[neighbour]);
+        }
+    }
+    // Bellman-Ford style relaxation must not find any shorter path.
+    for (std::size_t node = 0; node < side * side; ++node)
+    {
+        const std::size_t x = node % side, y = node / side;
+        if ((x > 0 && distance[node - 1] + cost[node] < distance[node]) || (y > 0 && distance[node - side] + cost[node] < distance[node])
+            || (x + 1 < side && distance[node + 1] + cost[node] < distance[node])
+            || (y + 1 < side && distance[node + side] + cost[node] < distance[node]))
+            throw std::runtime_error("IndexedHeapN test failed: Dijkstra distances incorrect");
+    }
+    if (distance[0] != 0)
+        throw std::runtime_error("IndexedHeapN test failed: Dijkstra source incorrect");
+
+    std::cout << "IndexedHeapN test passed!" << std::endl;
+}
+
+// Fonction de test pour SlotMapN
+static void testSlotMapN()
+{
+    std::cout << "\n=== Test SlotMapN ===" << std::endl;
+
+    SlotMapN<std::string> names;
+    const auto ada = names.insert("ada");
+    const auto bob = names.emplace(3, 'b');
+    const auto eve = names.insert(std::string("eve"));
+    if (names.size() != 3 || names[ada] != "ada" || names.at(bob) != "bbb" || *names.get(eve) != "eve")
+        throw std::runtime_error("SlotMapN test failed: insert incorrect");
+
+    // Erasing moves the last element into the hole; other handles still reach their element.
+    if (!names.erase(ada) || names.erase(ada) || names.contains(ada) || names.get(ada) != nullptr)
+        throw std::runtime_error("SlotMapN test failed: erase incorrect");
+    if (names.size() != 2 || names[bob] != "bbb" || names[eve] != "eve" || names.data()[0] != "eve")
+        throw std::runtime_error("SlotMapN test failed: handles after erase incorrect");
+
+    // The freed slot is reused with a new generation: the old handle stays stale.
+    const auto zed = names.insert("zed");
+    if (zed.index != ada.index || zed == ada || names.contains(ada) || names[zed] != "zed")
+        throw std::runtime_error("SlotMapN test failed: slot reuse incorrect");
+    bool thrown = false;
+    try
+    {
+        names.at(ada);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    if (!thrown || names.contains(SlotMapN<std::string>::Handle{}))
+        throw std::runtime_error("SlotMapN test failed: stale handle not rejected");
+
+    // A throwing construction leaves the map unchanged.
+    thrown = false;
+    try
+    {
+        names.emplace(std::string("abc"), 5);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    const auto kai = names.insert("kai");
+    if (!thrown || names.size() != 4 || names[kai] != "kai" || names.handle_at(3) != kai)
+        throw std::runtime_error("SlotMapN test failed: throwing emplace not rolled back");
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[names.handle_at(i)] != names.data()[i])
+            throw std::runtime_error("SlotMapN test failed: handle_at incorrect");
+    }
+
+    // Random inserts and erases, checked against a map from handle to value.
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    auto next = [&state]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    SlotMapN<int> values;
+    std::vector<std::pair<SlotMapN<int>::Handle, int>> live;
+    std::vector<SlotMapN<int>::Handle> dead;
+    for (int round = 0; round < 50000; ++round)
+    {
+        if (live.empty() || next() % 5 < 3)
+        {
+            const int value = int(next() % 1000000);
+            live.push_back({ values.insert(value), value });
+        }
+        else
+        {
+            const std::size_t pick = std::size_t(next() % live.size());
+            if (!values.erase(live[pick].first))
+                throw std::runtime_error("SlotMapN test failed: erase of a live handle failed");
+            dead.push_back(live[pick].first);
+            live[pick] = live.back();
+            live.pop_back();
+        }
+    }
+    if (values.size() != live.size())
+        throw std::runtime_error("SlotMapN test failed: size incorrect");
+    long long expected = 0;
+    for (const auto& [handle, value] : live)
+    {
+        if (!values.contains(handle) || values[handle] != value)
+            throw std::runtime_error("SlotMapN test failed: live handle incorrect");
+        expected += value;
+    }
+    for (const auto& handle : dead)
+    {
+        if (values.contains(handle))
+            throw std::runtime_error("SlotMapN test failed: dead handle still valid");
+    }
+    if (std::accumulate(values.begin(), values.end(), 0LL) != expected)
+        throw std::runtime_error("SlotMapN test failed: dense iteration incorrect");
+
+    // clear() invalidates every handle and keeps the slots for reuse.
+    values.clear();
+    if (!values.empty() || values.begin() != values.end())
+        throw std::runtime_error("SlotMapN test failed: clear incorrect");
+    for (const auto& [handle, value] : live)
+    {
+        if (values.contains(handle))
+            throw std::runtime_error("SlotMapN test failed: handle valid after clear");
+    }
+    const auto reused = values.insert(7);
+    if (values[reused] != 7 || values.size() != 1)
+        throw std::runtime_error("SlotMapN test failed: insert after clear incorrect");
+
+    std::cout << "SlotMapN test passed!" << std::endl;
+}
+
+// Fonction de test pour ObjectPoolN
+static void testObjectPoolN()
+{
+    std::cout << "\n=== Test ObjectPoolN ===" << std::endl;
+
+    // Pooled objects go straight into an IntrusiveList and come back through destroy_all().
+    ObjectPoolN<Node> pool(16);
+    IntrusiveList<Node, &Node::hook> list;
+    for (int i = 0; i < 100; ++i)
+        list.push_back(*pool.create(i));
+    auto stats = pool.stats();
+    if (list.size() != 100 || stats.live != 100 || stats.slabs < 7 || stats.capacity != stats.slabs * 16 || stats.peak < 100)
+        throw std::runtime_error("ObjectPoolN test failed: create into IntrusiveList incorrect");
+    int sum = 0;
+    for (const Node& node : list)
+        sum += node.data;
+    if (sum != 4950)
+        throw std::runtime_error("ObjectPoolN test failed: pooled objects incorrect");
+
+    Node& middle = *std::next(list.begin(), 50);
+    pool.destroy(list, middle);
+    if (list.size() != 99 || pool.live() != 99)
+        throw std::runtime_error("ObjectPoolN test failed: destroy(list, object) incorrect");
+    pool.destroy_all(list);
+    if (!list.empty() || pool.live() != 0)
+        throw std::runtime_error("ObjectPoolN test failed: destroy_all incorrect");
+
+    // Freed cells are reused before any new slab is allocated.
+    const std::size_t slabs = pool.stats().slabs;
+    std::vector<Node*> again;
+    for (int i = 0; i < 100; ++i)
+        again.push_back(pool.create(i));
+    if (pool.stats().slabs != slabs || pool.stats().peak > slabs * 16)
+        throw std::runtime_error("ObjectPoolN test failed: cells not reused");
+    for (Node* node : again)
+    {
+        if (node->hook.is_linked())
+            throw std::runtime_error("ObjectPoolN test failed: reused object not unlinked");
+        pool.destroy(node);
+    }
+    pool.destroy(nullptr);
+
+    // A throwing constructor leaves the cell in the pool.
+    struct Throwing
+    {
+        explicit Throwing(bool fail)
+        {
+            if (fail)
+                throw std::runtime_error("constructor failed");
+        }
+    };
+    ObjectPoolN<Throwing> throwingPool(8, false);
+    bool thrown = false;
+    try
+    {
+        throwingPool.create(true);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    Throwing* kept = throwingPool.create(false);
+    if (!thrown || throwingPool.live() != 1 || throwingPool.stats().slabs != 1 || throwingPool.stats().peak != 1)
+        throw std::runtime_error("ObjectPoolN test failed: throwing constructor incorrect");
+    throwingPool.destroy(kept);
+
+    // Several threads create objects and hand half of them to other threads to destroy.
+    for (bool threadCache : { true, false })
+    {
+        ObjectPoolN<std::string> strings(64, threadCache);
+        const int threadCount = 4;
+        const int perThread = 20000;
+        std::vector<std::vector<std::string*>> handoff(threadCount);
+        std::vector<std::thread> threads;
+        std::atomic<int> errors{ 0 };
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::vector<std::string*> mine;
+                for (int i = 0; i < perThread; ++i)
+                {
+                    mine.push_back(strings.create(std::to_string(t * perThread + i)));
+                    if (mine.size() == 64)
+                    {
+                        for (std::size_t k = 0; k < 32; ++k)
+                        {
+                            if (*mine[k] != std::to_string(t * perThread + i - 63 + int(k)))
+                                ++errors;
+                            strings.destroy(mine[k]);
+                        }
+                        mine.erase(mine.begin(), mine.begin() + 32);
+                    }
+                }
+                handoff[t] = std::move(mine);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        threads.clear();
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (std::string* object : handoff[(t + 1) % threadCount])
+                    strings.destroy(object);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        const auto finalStats = strings.stats();
+        if (errors != 0 || finalStats.live != 0 || finalStats.peak > finalStats.capacity
+            || (!threadCache && finalStats.cached != 0))
+            throw std::runtime_error("ObjectPoolN test failed: multithreaded create/destroy incorrect");
+    }
+
+    std::cout << "ObjectPoolN test passed!" << std::endl;
+}
+
+/**
+ * @brief memory_resource forwarding to an upstream resource and counting the bytes it hands out.
+ */
+class CountingResourceN : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResourceN(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : m_upstream(upstream)
+    {
+    }
+
+    std::size_t allocated = 0; ///< Bytes currently handed out.
+    std::size_t calls = 0;     ///< Number of allocations.
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocated += bytes;
+        ++calls;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        allocated -= bytes;
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+};
+
+static void testPmrN()
+{
+    std::cout << "\n=== Test pmr containers ===" << std::endl;
+
+    CountingResourceN arena;
+    CountingResourceN other;
+
+    // Storage and the elements' own allocations come from the resource.
+    {
+        pmr::VectorN<std::pmr::string> words(&arena);
+        for (int i = 0; i < 20; ++i)
+            words.push_back(std::pmr::string(40, char('a' + i)));
+        if (words.size() != 20 || words[3] != std::pmr::string(40, 'd') || words.get_allocator().resource() != &arena
+            || words[3].get_allocator().resource() != &arena || arena.allocated == 0)
+            throw std::runtime_error("pmr test failed: VectorN does not allocate from its resource");
+
+        pmr::ListN<std::pmr::string> names(&arena);
+        const std::size_t before = arena.calls;
+        names.push_back(std::pmr::string(40, 'x'));
+        names.push_front(std::pmr::string(40, 'w'));
+        if (names.size() != 2 || names.front() != std::pmr::string(40, 'w') || arena.calls < before + 4
+            || names.get_allocator().resource() != &arena || names.front().get_allocator().resource() != &arena)
+            throw std::runtime_error("pmr test failed: ListN does not allocate from its resource");
+    }
+    if (arena.allocated != 0)
+        throw std::runtime_error("pmr test failed: memory not returned to the resource");
+
+    // Copy construction uses the default resource; allocator-extended copy uses the given one.
+    {
+        pmr::VectorN<int> a({ 1, 2, 3 }, &arena);
+        pmr::VectorN<int> copy(a);
+        pmr::VectorN<int> copyOther(a, &other);
+        if (copy.get_allocator().resource() != std::pmr::get_default_resource() || copy.size() != 3 || copy[2] != 3
+            || copyOther.get_allocator().resource() != &other || copyOther[1] != 2)
+            throw std::runtime_error("pmr test failed: VectorN copy construction incorrect");
+
+        pmr::ListN<int> l({ 1, 2, 3 }, &arena);
+        pmr::ListN<int> lcopy(l);
+        if (lcopy.get_allocator().resource() != std::pmr::get_default_resource() || lcopy.size() != 3)
+            throw std::runtime_error("pmr test failed: ListN copy construction incorrect");
+
+        // Copy assignment keeps the resource of the target (no propagation).
+        copyOther = a;
+        if (copyOther.get_allocator().resource() != &other || copyOther.size() != 3)
+            throw std::runtime_error("pmr test failed: VectorN copy assignment propagated the resource");
+    }
+
+    // Move construction takes the storage and the resource.
+    {
+        pmr::VectorN<int> a({ 1, 2, 3 }, &arena);
+        const int* storage = a.data();
+        pmr::VectorN<int> moved(std::move(a));
+        if (moved.data() != storage || moved.get_allocator().resource() != &arena || !a.empty())
+            throw std::runtime_error("pmr test failed: VectorN move construction incorrect");
+
+        pmr::ListN<int> l({ 4, 5 }, &arena);
+        pmr::ListN<int> lmoved(std::move(l));
+        if (lmoved.size() != 2 || lmoved.get_allocator().resource() != &arena || !l.empty())
+            throw std::runtime_error("pmr test failed: ListN move construction incorrect");
+    }
+
+    // Move assignment between unequal resources moves the elements into the target's resource.
+    {
+        pmr::VectorN<std::pmr::string> a(&arena);
+        a.push_back(std::pmr::string(40, 'a'));
+        pmr::VectorN<std::pmr::string> b(&other);
+        b = std::move(a);
+        if (b.get_allocator().resource() != &other || b.size() != 1 || b[0] != std::pmr::string(40, 'a')
+            || b[0].get_allocator().resource() != &other || !a.empty())
+            throw std::runtime_error("pmr test failed: VectorN move assignment across resources incorrect");
+
+        pmr::VectorN<int> c({ 7, 8 }, &other);
+        const int* storage = c.data();
+        b.clear();
+        pmr::VectorN<int> d(&other);
+        d = std::move(c);
+        if (d.data() != storage)
+            throw std::runtime_error("pmr test failed: VectorN move assignment did not steal equal storage");
+
+        pmr::ListN<int> l1({ 1, 2 }, &arena);
+        pmr::ListN<int> l2({ 3 }, &other);
+        l2 = std::move(l1);
+        if (l2.get_allocator().resource() != &other || l2.size() != 2 || l2.front() != 1 || !l1.empty())
+            throw std::runtime_error("pmr test failed: ListN move assignment across resources incorrect");
+    }
+
+    // Swap keeps each container's resource; the elements change sides.
+    {
+        pmr::VectorN<int> a({ 1, 2, 3 }, &arena);
+        pmr::VectorN<int> b({ 9 }, &other);
+        a.swap(b);
+        if (a.get_allocator().resource() != &arena || b.get_allocator().resource() != &other || a.size() != 1
+            || a[0] != 9 || b.size() != 3 || b[2] != 3)
+            throw std::runtime_error("pmr test failed: VectorN swap across resources incorrect");
+
+        pmr::VectorN<int> c({ 4, 5 }, &arena);
+        const int* storage = c.data();
+        a.swap(c);
+        if (a.data() != storage || c[0] != 9)
+            throw std::runtime_error("pmr test failed: VectorN swap with equal resources incorrect");
+
+        pmr::ListN<int> l1({ 1, 2, 3 }, &arena);
+        pmr::ListN<int> l2({ 9 }, &other);
+        l1.swap(l2);
+        if (l1.get_allocator().resource() != &arena || l1.size() != 1 || l1.front() != 9 || l2.size() != 3)
+            throw std::runtime_error("pmr test failed: ListN swap across resources incorrect");
+    }
+    if (arena.allocated != 0 || other.allocated != 0)
+        throw std::runtime_error("pmr test failed: memory leaked");
+
+    // A whole container graph lives in one arena and goes away with it.
+    {
+        std::pmr::monotonic_buffer_resource buffer(1 << 16);
+        pmr::VectorN<pmr::VectorN<int>> rows(&buffer);
+        for (int i = 0; i < 8; ++i)
+        {
+            rows.emplace_back(pmr::VectorN<int>(&buffer));
+            for (int j = 0; j <= i; ++j)
+                rows.back().push_back(i * j);
+        }
+        pmr::ListN<int> order({ 3, 1, 2 }, &buffer);
+        SortN::sort(order);
+        pmr::HashMapN<int, int> index(&buffer);
+        index[7] = 49;
+        if (rows.size() != 8 || rows[7].size() != 8 || rows[7][7] != 49 || order.front() != 1 || index.at(7) != 49
+            || rows[5].get_allocator().resource() != &buffer)
+            throw std::runtime_error("pmr test failed: container graph in a monotonic arena incorrect");
+    }
+
+    std::cout << "pmr containers test passed!" << std::endl;
+}
+
+static void testAllocationStatsN()
+{
+    std::cout << "\n=== Test AllocationStatsN ===" << std::endl;
+
+    if (AllocationStatsN::typeName<int>() != "int" || AllocationStatsN::typeName<VectorN<int>>().find("VectorN<int") != 0)
+        throw std::runtime_error("AllocationStatsN test failed: typeName incorrect");
+
+    auto find = [](std::string_view container, std::string_view tag)
+    {
+        for (const auto& entry : AllocationStatsN::snapshot())
+        {
+            if (entry.container == container && entry.tag == tag)
+                return entry;
+        }
+        return AllocationStatsN::Entry{};
+    };
+    const std::string_view vectorType = AllocationStatsN::typeName<VectorN<int>>();
+    const std::string_view listType = AllocationStatsN::typeName<ListN<int>>();
+
+    if (!AllocationStatsN::enabled)
+    {
+        // Compiled out: tags are ignored and nothing is recorded.
+        AllocationTagN scope("stats-vector");
+        VectorN<int> values(100, 1);
+        if (!AllocationStatsN::snapshot().empty() || std::string_view(AllocationTagN::current()) != "")
+            throw std::runtime_error("AllocationStatsN test failed: disabled tracking recorded something");
+        std::cout << "AllocationStatsN test passed (tracking compiled out)!" << std::endl;
+        return;
+    }
+
+    // Growth by doubling: 1, 2, 4 ... 128 slots, each step but the first a reallocation.
+    auto build = []()
+    {
+        AllocationTagN scope("stats-vector");
+        VectorN<int> values;
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i);
+        return values;
+    };
+    {
+        VectorN<int> values = build();
+        if (std::string_view(AllocationTagN::current()) != "")
+            throw std::runtime_error("AllocationStatsN test failed: tag scope not restored");
+        auto entry = find(vectorType, "stats-vector");
+        if (entry.live != 1 || entry.allocations != 8 || entry.reallocations != 7 || entry.deallocations != 7
+            || entry.capacityBytes != 128 * sizeof(int) || entry.usedBytes != 100 * sizeof(int)
+            || entry.wastedBytes() != 28 * sizeof(int) || entry.allocatedBytes != 255 * sizeof(int)
+            || entry.largestCapacityBytes != 128 * sizeof(int))
+            throw std::runtime_error("AllocationStatsN test failed: VectorN growth not accounted");
+
+        // clear() keeps the storage: all of it becomes slack.
+        values.clear();
+        entry = find(vectorType, "stats-vector");
+        if (entry.usedBytes != 0 || entry.wastedBytes() != 128 * sizeof(int))
+            throw std::runtime_error("AllocationStatsN test failed: VectorN slack not accounted");
+
+        // A copy made outside the scope keeps the tag of its source.
+        values.push_back(1);
+        VectorN<int> copy(values);
+        entry = find(vectorType, "stats-vector");
+        if (entry.live != 2 || entry.capacityBytes != 256 * sizeof(int) || entry.usedBytes != 2 * sizeof(int)
+            || entry.peakCapacityBytes != 256 * sizeof(int))
+            throw std::runtime_error("AllocationStatsN test failed: VectorN copy not accounted");
+
+        // Storage moving between tags moves its bytes along.
+        AllocationTagN scope("stats-other");
+        VectorN<int> other;
+        other.swap(copy);
+        if (find(vectorType, "stats-other").capacityBytes != 128 * sizeof(int)
+            || find(vectorType, "stats-vector").capacityBytes != 128 * sizeof(int))
+            throw std::runtime_error("AllocationStatsN test failed: VectorN swap not accounted");
+    }
+    // Events count where they happen: the swapped storage was freed under the other tag.
+    auto entry = find(vectorType, "stats-vector");
+    const auto otherEntry = find(vectorType, "stats-other");
+    if (entry.live != 0 || entry.capacityBytes != 0 || entry.usedBytes != 0 || otherEntry.capacityBytes != 0
+        || entry.allocations != entry.deallocations + otherEntry.deallocations || entry.peakCapacityBytes != 256 * sizeof(int))
+        throw std::runtime_error("AllocationStatsN test failed: VectorN destruction not accounted");
+
+    // Lists count one allocation per node; the links are overhead.
+    {
+        AllocationTagN scope("stats-list");
+        ListN<int> list = { 1, 2, 3 };
+        list.pop_front();
+        entry = find(listType, "stats-list");
+        if (entry.live != 1 || entry.allocations != 3 || entry.deallocations != 1 || entry.usedBytes != 2 * sizeof(int)
+            || entry.capacityBytes <= entry.usedBytes || entry.largestCapacityBytes != entry.capacityBytes * 3 / 2)
+            throw std::runtime_error("AllocationStatsN test failed: ListN not accounted");
+    }
+    entry = find(listType, "stats-list");
+    if (entry.live != 0 || entry.capacityBytes != 0 || entry.deallocations != 3)
+        throw std::runtime_error("AllocationStatsN test failed: ListN destruction not accounted");
+
+    // reset() clears the event counters and restarts the peaks.
+    AllocationStatsN::reset();
+    entry = find(vectorType, "stats-vector");
+    if (entry.allocations != 0 || entry.reallocations != 0 || entry.peakCapacityBytes != 0 || entry.largestCapacityBytes != 0)
+        throw std::runtime_error("AllocationStatsN test failed: reset incorrect");
+
+    // Counters stay exact with several threads working under one tag.
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([]()
+            {
+                AllocationTagN scope("stats-threads");
+                for (int round = 0; round < 200; ++round)
+                {
+                    VectorN<int> values;
+                    for (int i = 0; i < 64; ++i)
+                        values.push_back(i);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+    entry = find(vectorType, "stats-threads");
+    if (entry.live != 0 || entry.capacityBytes != 0 || entry.usedBytes != 0 || entry.allocations != 4 * 200 * 7
+        || entry.allocations != entry.deallocations)
+        throw std::runtime_error("AllocationStatsN test failed: multithreaded accounting incorrect");
+
+    std::cout << "AllocationStatsN test passed!" << std::endl;
+}
+
 int Test()
 {
     try
@@ -548,8 +3678,34 @@ int Test()
         testListN();
         testIntrusiveListN();
         testArrayN();
+        testIteratorsN();
         testVectorND();
         testMatrixND();
+        testMatrixExprN();
+        testMatrixViewN();
+        testTransposeN();
+        testMatrixIoN();
+        testDecompositionN();
+        testMatrixBatchN();
+        testSparseMatrixN();
+        testQuaternionN();
+        testTransformN();
+        testKdTreeN();
+        testMatrixDyn();
+        testThreadPoolN();
+        testParallelAlgorithmsN();
+        testTaskGraphN();
+        testSortN();
+        testHashMapN();
+        testHashSetN();
+        testConcurrentHashMapN();
+        testBTreeMapN();
+        testHeapN();
+        testIndexedHeapN();
+        testSlotMapN();
+        testObjectPoolN();
+        testPmrN();
+        testAllocationStatsN();
         std::cout << "\n=== ALL TESTS PASSED ===" << std::endl;
     }
     catch (const std::exception& e)
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <new>
+
+/**
+ * @brief A standard-conforming allocator returning memory aligned to Alignment bytes.
+ *
+ * Used by the numeric containers so that rows and packed panels start on a
+ * cache-line (and therefore SIMD register) boundary.
+ *
+ * @tparam T Type of the allocated elements.
+ * @tparam Alignment Alignment in bytes, a power of two at least alignof(T).
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocatorN
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must be at least alignof(T)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr size_type alignment = Alignment; ///< Alignment of every allocation, in bytes.
+
+    /**
+     * @brief Rebinds the allocator to another element type.
+     */
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocatorN<U, Alignment>;
+    };
+
+    /**
+     * @brief Default constructor.
+     */
+    AlignedAllocatorN() noexcept = default;
+
+    /**
+     * @brief Converting constructor from an allocator of another element type.
+     */
+    template<typename U>
+    AlignedAllocatorN(const AlignedAllocatorN<U, Alignment>&) noexcept
+    {
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for count elements.
+     *
+     * @param count Number of elements.
+     * @return Pointer to the aligned storage.
+     * @throws std::bad_array_new_length if the size overflows, std::bad_alloc on failure.
+     */
+    T* allocate(size_type count)
+    {
+        if (count > std::numeric_limits<size_type>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    /**
+     * @brief Releases storage obtained from allocate.
+     *
+     * @param ptr Pointer returned by allocate.
+     * @param count Number of elements passed to allocate.
+     */
+    void deallocate(T* ptr, size_type count) noexcept
+    {
+        ::operator delete(ptr, count * sizeof(T), std::align_val_t{ Alignment });
+    }
+
+    /**
+     * @brief All instances are interchangeable.
+     */
+    template<typename U>
+    bool operator==(const AlignedAllocatorN<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+
+    /**
+     * @brief All instances are interchangeable.
+     */
+    template<typename U>
+    bool operator!=(const AlignedAllocatorN<U, Alignment>&) const noexcept
+    {
+        return false;
+    }
+};
@@ -0,0 +1,439 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file AllocationStatsN.h
+ * @brief Opt-in accounting of the memory held by the containers, per container type and per tag.
+ *
+ * Define CONTAINERS_TRACK_ALLOCATIONS (CMake option of the same name) to
+ * turn it on. VectorN and ListN then report every allocation, reallocation
+ * and change of size or capacity to a bucket named after their type (for
+ * instance "VectorN<int>") and the tag that was
+ * current on the constructing thread. AllocationStatsN::snapshot() reads
+ * every bucket at runtime.
+ *
+ * Without the macro the trackers are empty classes whose members do
+ * nothing, so containers are as large and as fast as before, and
+ * snapshot() returns nothing.
+ *
+ * Tags name a part of the program:
+ * @code
+ * {
+ *     AllocationTagN scope("request-cache");
+ *     VectorN<Entry> entries; // accounted under "request-cache" for its whole life
+ * }
+ * @endcode
+ * Copy and move construction keep the tag of the source, so a container
+ * built inside a scope and returned from a function stays under that tag.
+ */
+
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+#endif
+
+/**
+ * @class AllocationStatsN
+ * @brief Registry of the allocation counters of the containers.
+ */
+class AllocationStatsN
+{
+public:
+    using size_type = std::size_t;
+
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+    static constexpr bool enabled = true; ///< Whether the containers report to the registry.
+#else
+    static constexpr bool enabled = false; ///< Whether the containers report to the registry.
+#endif
+
+    /**
+     * @brief Counters of one container type under one tag.
+     *
+     * Bytes count the storage of the elements: the slots of a VectorN and
+     * the nodes of a ListN.
+     */
+    struct Entry
+    {
+        std::string container;         ///< Container type.
+        std::string tag;               ///< Tag current when the containers were constructed, "" when none.
+        size_type live = 0;            ///< Containers alive.
+        size_type allocations = 0;     ///< Storage allocations.
+        size_type deallocations = 0;   ///< Storage deallocations.
+        size_type reallocations = 0;   ///< Allocations that replaced smaller storage (growth).
+        size_type allocatedBytes = 0;  ///< Bytes requested by all allocations.
+        size_type capacityBytes = 0;   ///< Bytes held now.
+        size_type usedBytes = 0;       ///< Bytes held now by elements (size, not capacity).
+        size_type peakCapacityBytes = 0;    ///< Highest capacityBytes.
+        size_type largestCapacityBytes = 0; ///< Largest storage held by a single container.
+
+        /**
+         * @brief Bytes held now but not used by elements: capacity slack, and node links for lists.
+         */
+        size_type wastedBytes() const
+        {
+            return capacityBytes > usedBytes ? capacityBytes - usedBytes : 0;
+        }
+    };
+
+    /**
+     * @brief Reads the counters of every container type and tag seen so far.
+     *
+     * Counters are read one by one while containers keep running, so an
+     * entry is exact only when no container of its bucket is changing.
+     *
+     * @return Entries sorted by container type then tag; empty when compiled out.
+     */
+    static std::vector<Entry> snapshot()
+    {
+        std::vector<Entry> entries;
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        entries.reserve(reg.buckets.size());
+        for (const auto& [key, bucket] : reg.buckets)
+        {
+            Entry entry;
+            entry.container = bucket.container;
+            entry.tag = bucket.tag;
+            entry.live = bucket.live.load(std::memory_order_relaxed);
+            entry.allocations = bucket.allocations.load(std::memory_order_relaxed);
+            entry.deallocations = bucket.deallocations.load(std::memory_order_relaxed);
+            entry.reallocations = bucket.reallocations.load(std::memory_order_relaxed);
+            entry.allocatedBytes = bucket.allocatedBytes.load(std::memory_order_relaxed);
+            entry.capacityBytes = bucket.capacityBytes.load(std::memory_order_relaxed);
+            entry.usedBytes = bucket.usedBytes.load(std::memory_order_relaxed);
+            entry.peakCapacityBytes = bucket.peakCapacityBytes.load(std::memory_order_relaxed);
+            entry.largestCapacityBytes = bucket.largestCapacityBytes.load(std::memory_order_relaxed);
+            entries.push_back(std::move(entry));
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+        {
+            return a.container != b.container ? a.container < b.container : a.tag < b.tag;
+        });
+#endif
+        return entries;
+    }
+
+    /**
+     * @brief Zeroes the event counters and restarts the peaks from the current state.
+     *
+     * live, capacityBytes and usedBytes describe the current state and are kept.
+     */
+    static void reset()
+    {
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (auto& [key, bucket] : reg.buckets)
+        {
+            bucket.allocations.store(0, std::memory_order_relaxed);
+            bucket.deallocations.store(0, std::memory_order_relaxed);
+            bucket.reallocations.store(0, std::memory_order_relaxed);
+            bucket.allocatedBytes.store(0, std::memory_order_relaxed);
+            bucket.peakCapacityBytes.store(bucket.capacityBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            bucket.largestCapacityBytes.store(0, std::memory_order_relaxed);
+        }
+#endif
+    }
+
+    /**
+     * @brief Readable name of a type, for instance "VectorN<int>".
+     *
+     * Taken from the compiler's signature of this function; the exact
+     * spelling depends on the compiler.
+     */
+    template<typename T>
+    static constexpr std::string_view typeName()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        constexpr std::string_view signature = __FUNCSIG__;
+        constexpr std::string_view open = "typeName<";
+        constexpr size_type first = signature.find(open) + open.size();
+        constexpr size_type last = signature.rfind(">(void)");
+#else
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        constexpr std::string_view open = "T = ";
+        constexpr size_type first = signature.find(open) + open.size();
+        constexpr size_type last = signature.find(';', first) != std::string_view::npos ? signature.find(';', first)
+                                                                                        : signature.rfind(']');
+#endif
+        return signature.substr(first, last - first);
+    }
+
+private:
+    template<typename Container>
+    friend class AllocationTrackerN;
+    friend class AllocationTagN;
+
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+    /**
+     * @brief Counters shared by the containers of one type and tag.
+     */
+    struct Bucket
+    {
+        Bucket(std::string_view containerName, std::string_view tagName) : container(containerName), tag(tagName) {}
+
+        std::string container;
+        std::string tag;
+        std::atomic<size_type> live{ 0 };
+        std::atomic<size_type> allocations{ 0 };
+        std::atomic<size_type> deallocations{ 0 };
+        std::atomic<size_type> reallocations{ 0 };
+        std::atomic<size_type> allocatedBytes{ 0 };
+        std::atomic<size_type> capacityBytes{ 0 };
+        std::atomic<size_type> usedBytes{ 0 };
+        std::atomic<size_type> peakCapacityBytes{ 0 };
+        std::atomic<size_type> largestCapacityBytes{ 0 };
+    };
+
+    /**
+     * @brief Buckets by (typeKey of the container, tag). Map nodes never move, so containers keep pointers to their bucket.
+     */
+    struct Registry
+    {
+        std::mutex mutex;
+        std::map<std::pair<const void*, std::string>, Bucket> buckets;
+    };
+
+    /**
+     * @brief Object whose address identifies a type in every translation unit.
+     *
+     * Buckets are keyed by it rather than by typeName(), which a compiler
+     * may spell differently for the same type.
+     */
+    template<typename T>
+    static constexpr char typeKey = 0;
+
+    /**
+     * @brief The registry, never destroyed: containers with static storage may outlive any static object.
+     */
+    static Registry& registry()
+    {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    /**
+     * @brief Tag of the calling thread.
+     */
+    static const char*& currentTag()
+    {
+        static thread_local const char* tag = "";
+        return tag;
+    }
+
+    /**
+     * @brief Bucket of Container under the current tag.
+     *
+     * Each thread remembers the last bucket per container type, so
+     * constructing containers in a loop does not lock the registry.
+     */
+    template<typename Container>
+    static Bucket& bucketFor()
+    {
+        struct Cache
+        {
+            const char* tag = nullptr;
+            Bucket* bucket = nullptr;
+        };
+        static thread_local Cache cache;
+        const char* tag = currentTag();
+        if (cache.bucket && cache.tag == tag && std::strcmp(cache.bucket->tag.c_str(), tag) == 0)
+            return *cache.bucket;
+
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto key = std::make_pair(static_cast<const void*>(&typeKey<Container>), std::string(tag));
+        auto it = reg.buckets.find(key);
+        if (it == reg.buckets.end())
+            it = reg.buckets.try_emplace(std::move(key), typeName<Container>(), tag).first;
+        cache.tag = tag;
+        cache.bucket = &it->second;
+        return it->second;
+    }
+
+    /**
+     * @brief Raises target to value if it is lower.
+     */
+    static void raise(std::atomic<size_type>& target, size_type value)
+    {
+        size_type current = target.load(std::memory_order_relaxed);
+        while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+#endif
+};
+
+/**
+ * @class AllocationTagN
+ * @brief Makes a tag current on the calling thread for the lifetime of the scope.
+ *
+ * Scopes nest; the previous tag comes back when the scope ends. The tag
+ * string must outlive the scope. Does nothing when compiled out.
+ */
+class AllocationTagN
+{
+public:
+    explicit AllocationTagN(const char* tag)
+    {
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+        m_previous = AllocationStatsN::currentTag();
+        AllocationStatsN::currentTag() = tag;
+#else
+        (void)tag;
+#endif
+    }
+
+    ~AllocationTagN()
+    {
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+        AllocationStatsN::currentTag() = m_previous;
+#endif
+    }
+
+    AllocationTagN(const AllocationTagN&) = delete;
+    AllocationTagN& operator=(const AllocationTagN&) = delete;
+
+    /**
+     * @brief Tag current on the calling thread, "" when none (always "" when compiled out).
+     */
+    static const char* current()
+    {
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+        return AllocationStatsN::currentTag();
+#else
+        return "";
+#endif
+    }
+
+private:
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+    const char* m_previous; ///< Tag to restore.
+#endif
+};
+
+#if defined(CONTAINERS_TRACK_ALLOCATIONS)
+
+/**
+ * @class AllocationTrackerN
+ * @brief Member of a container reporting its storage to the bucket of its type and tag.
+ *
+ * The tracker remembers the capacity and used bytes it last reported, so
+ * update() publishes only the difference and the destructor takes the
+ * container's share back out of the bucket.
+ *
+ * @tparam Container The container type, naming the bucket.
+ */
+template<typename Container>
+class AllocationTrackerN
+{
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Tracker in the bucket of the current tag.
+     */
+    AllocationTrackerN() : m_bucket(&AllocationStatsN::bucketFor<Container>()), m_capacity(0), m_used(0)
+    {
+        m_bucket->live.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Tracker in the same bucket as source, holding nothing yet.
+     */
+    AllocationTrackerN(const AllocationTrackerN& source) : m_bucket(source.m_bucket), m_capacity(0), m_used(0)
+    {
+        m_bucket->live.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    AllocationTrackerN& operator=(const AllocationTrackerN&) = delete;
+
+    ~AllocationTrackerN()
+    {
+        update(0, 0);
+        m_bucket->live.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records an allocation of bytes.
+     */
+    void allocated(size_type bytes)
+    {
+        m_bucket->allocations.fetch_add(1, std::memory_order_relaxed);
+        m_bucket->allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a deallocation.
+     */
+    void deallocated()
+    {
+        m_bucket->deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records that the last allocation replaced smaller storage.
+     */
+    void reallocated()
+    {
+        m_bucket->reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reports the bytes the container holds and how many of them its elements use.
+     */
+    void update(size_type capacityBytes, size_type usedBytes)
+    {
+        if (capacityBytes != m_capacity)
+        {
+            const size_type total = m_bucket->capacityBytes.fetch_add(capacityBytes - m_capacity, std::memory_order_relaxed)
+                + (capacityBytes - m_capacity);
+            AllocationStatsN::raise(m_bucket->peakCapacityBytes, total);
+            AllocationStatsN::raise(m_bucket->largestCapacityBytes, capacityBytes);
+            m_capacity = capacityBytes;
+        }
+        if (usedBytes != m_used)
+        {
+            m_bucket->usedBytes.fetch_add(usedBytes - m_used, std::memory_order_relaxed);
+            m_used = usedBytes;
+        }
+    }
+
+private:
+    AllocationStatsN::Bucket* m_bucket; ///< Counters of the container type and tag.
+    size_type m_capacity;               ///< Capacity bytes last reported.
+    size_type m_used;                   ///< Used bytes last reported.
+};
+
+#else
+
+/**
+ * @class AllocationTrackerN
+ * @brief Empty stand-in when allocation tracking is compiled out; every member does nothing.
+ */
+template<typename Container>
+class AllocationTrackerN
+{
+public:
+    using size_type = std::size_t;
+
+    AllocationTrackerN() = default;
+    AllocationTrackerN(const AllocationTrackerN&) = default;
+    AllocationTrackerN& operator=(const AllocationTrackerN&) = delete;
+
+    void allocated(size_type) {}
+    void deallocated() {}
+    void reallocated() {}
+    void update(size_type, size_type) {}
+};
+
+#endif
@@ -3,10 +3,15 @@
 #include <exception>
 #include <algorithm>
 #include <initializer_list>
+#include <cstddef>
+#include <iterator>
 
 /**
  * @brief A fixed-size array class template.
  *
+ * Iterators are raw pointers, so ArrayN models std::ranges::contiguous_range
+ * and std::ranges::sized_range.
+ *
  * @tparam Type The type of elements stored in the array.
  * @tparam N The size of the array.
  */
@@ -19,8 +24,15 @@ class ArrayN
 public:
     using value_type = Type;
     using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
     using iterator = value_type*;
     using const_iterator = const value_type*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     static constexpr size_type size = N;
 
@@ -269,6 +281,46 @@ public:
         return m_data + size;
     }
 
+    /**
+     * @brief Get a reverse iterator to the last element of the array.
+     *
+     * @return reverse_iterator A reverse iterator to the last element.
+     */
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Get a const reverse iterator to the last element of the array.
+     *
+     * @return const_reverse_iterator A const reverse iterator to the last element.
+     */
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Get a reverse iterator past the first element of the array.
+     *
+     * @return reverse_iterator A reverse iterator past the first element.
+     */
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Get a const reverse iterator past the first element of the array.
+     *
+     * @return const_reverse_iterator A const reverse iterator past the first element.
+     */
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
     /**
      * @brief Fill the array with a specified value.
      *
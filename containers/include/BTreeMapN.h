@@ -0,0 +1,1104 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "IteratorsN.h"
+#include "SimdN.h"
+#include "VectorN.h"
+
+/**
+ * @class BTreeMapN
+ * @brief Ordered map stored as a B+-tree with cache-line-sized nodes.
+ *
+ * Every element lives in a leaf; inner nodes only route searches. A node
+ * holds up to NodeBytes / sizeof(K) keys (between 8 and 64), so a search
+ * reads a few contiguous cache lines per level instead of one scattered node
+ * per element. Leaves keep their keys and values in separate arrays, so the
+ * in-node search touches keys only, and are linked to their neighbours, so
+ * iteration and range scans walk arrays without going back up the tree.
+ *
+ * With std::less on 32 or 64-bit integers, float or double, the in-node
+ * search counts the keys smaller than the searched key with SIMD compares
+ * (SSE2, and AVX2 for 64-bit integers, see SimdN.h); other keys use a binary
+ * search.
+ *
+ * Inner node separators are upper bounds: every key of child i is greater
+ * than separator i - 1 and not greater than separator i. Nodes other than
+ * the root stay at least half full.
+ *
+ * Dereferencing an iterator yields ZippedN<const K&, V&> (members first and
+ * second). Insertions and erasures move elements inside their leaf: they
+ * invalidate iterators and references.
+ *
+ * @tparam K Key type; default constructible and move assignable.
+ * @tparam V Mapped type; default constructible and move assignable.
+ * @tparam Compare Strict weak ordering of the keys.
+ */
+template<typename K, typename V, typename Compare = std::less<K>>
+class BTreeMapN
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = ZippedN<K, V>;
+    using reference = ZippedN<const K&, V&>;
+    using const_reference = ZippedN<const K&, const V&>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+
+    static constexpr size_type NodeBytes = 256; ///< Bytes of keys per node: four cache lines.
+    static constexpr size_type LeafSlots = std::clamp<size_type>(NodeBytes / sizeof(K), 8, 64);  ///< Maximum elements per leaf.
+    static constexpr size_type InnerSlots = std::clamp<size_type>(NodeBytes / sizeof(K), 8, 64); ///< Maximum children per inner node.
+
+private:
+    static constexpr size_type MinLeaf = LeafSlots / 2;   ///< Minimum elements of a leaf other than the root.
+    static constexpr size_type MinInner = InnerSlots / 2; ///< Minimum children of an inner node other than the root.
+    static constexpr size_type MaxDepth = 64;             ///< Bound on the height (fanout is at least 4).
+
+    /**
+     * @brief Fields shared by leaves and inner nodes.
+     */
+    struct NodeBase
+    {
+        explicit NodeBase(bool isLeaf) : count(0), leaf(isLeaf) {}
+
+        std::uint32_t count; ///< Elements of a leaf, children of an inner node.
+        bool leaf;           ///< Whether the node is a Leaf.
+    };
+
+    /**
+     * @brief Leaf: sorted keys, their values, and links to the neighbouring leaves.
+     */
+    struct Leaf : NodeBase
+    {
+        Leaf() : NodeBase(true), prev(nullptr), next(nullptr) {}
+
+        alignas(64) K keys[LeafSlots]; ///< Sorted keys.
+        V values[LeafSlots];           ///< Values, at the index of their key.
+        Leaf* prev;                    ///< Previous leaf in key order.
+        Leaf* next;                    ///< Next leaf in key order.
+    };
+
+    /**
+     * @brief Inner node: count children and count - 1 separators.
+     */
+    struct Inner : NodeBase
+    {
+        Inner() : NodeBase(false) {}
+
+        alignas(64) K keys[InnerSlots - 1]; ///< keys[i] is an upper bound of the keys of children[i].
+        NodeBase* children[InnerSlots];     ///< Subtrees.
+    };
+
+    /**
+     * @brief Inner node crossed by a descent, and the index of the child taken.
+     */
+    struct PathStep
+    {
+        Inner* node;
+        size_type index;
+    };
+
+public:
+    /**
+     * @brief Bidirectional iterator over the elements, in key order.
+     */
+    template<bool Const>
+    class IteratorT
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using value_type = ZippedN<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, ZippedN<const K&, const V&>, ZippedN<const K&, V&>>;
+
+        /**
+         * @brief Gives operator-> a pointer to a temporary reference.
+         */
+        struct pointer
+        {
+            reference ref;
+
+            const reference* operator->() const
+            {
+                return &ref;
+            }
+        };
+
+        IteratorT() : m_leaf(nullptr), m_index(0), m_tree(nullptr) {}
+
+        /**
+         * @brief Converts an iterator to a const_iterator.
+         */
+        template<bool OtherConst>
+            requires (Const && !OtherConst)
+        IteratorT(const IteratorT<OtherConst>& other) : m_leaf(other.m_leaf), m_index(other.m_index), m_tree(other.m_tree)
+        {
+        }
+
+        reference operator*() const
+        {
+            return reference(m_leaf->keys[m_index], m_leaf->values[m_index]);
+        }
+
+        pointer operator->() const
+        {
+            return pointer{ **this };
+        }
+
+        /**
+         * @brief Key of the current element.
+         */
+        const K& key() const
+        {
+            return m_leaf->keys[m_index];
+        }
+
+        /**
+         * @brief Value of the current element.
+         */
+        std::conditional_t<Const, const V&, V&> value() const
+        {
+            return m_leaf->values[m_index];
+        }
+
+        IteratorT& operator++()
+        {
+            if (++m_index == m_leaf->count)
+            {
+                m_leaf = m_leaf->next;
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        IteratorT operator++(int)
+        {
+            IteratorT copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        /**
+         * @brief Moves to the previous element; decrementing end() reaches the last element.
+         */
+        IteratorT& operator--()
+        {
+            if (!m_leaf)
+            {
+                m_leaf = m_tree->m_last;
+                m_index = m_leaf->count - 1;
+            }
+            else if (m_index == 0)
+            {
+                m_leaf = m_leaf->prev;
+                m_index = m_leaf->count - 1;
+            }
+            else
+            {
+                --m_index;
+            }
+            return *this;
+        }
+
+        IteratorT operator--(int)
+        {
+            IteratorT copy = *this;
+            --*this;
+            return copy;
+        }
+
+        friend bool operator==(const IteratorT& a, const IteratorT& b)
+        {
+            return a.m_leaf == b.m_leaf && a.m_index == b.m_index;
+        }
+
+    private:
+        friend class BTreeMapN;
+        template<bool> friend class IteratorT;
+
+        IteratorT(Leaf* leaf, size_type index, const BTreeMapN* tree) : m_leaf(leaf), m_index(index), m_tree(tree)
+        {
+        }
+
+        Leaf* m_leaf;             ///< Current leaf, nullptr at the end.
+        size_type m_index;        ///< Index in the leaf.
+        const BTreeMapN* m_tree;  ///< Tree, to decrement from end().
+    };
+
+    using iterator = IteratorT<false>;
+    using const_iterator = IteratorT<true>;
+
+    /**
+     * @brief Constructs an empty map.
+     */
+    explicit BTreeMapN(const Compare& comp = Compare())
+        : m_root(nullptr), m_first(nullptr), m_last(nullptr), m_size(0), m_comp(comp)
+    {
+    }
+
+    /**
+     * @brief Constructs a map from an initializer list; later duplicates are ignored.
+     */
+    BTreeMapN(std::initializer_list<std::pair<K, V>> init, const Compare& comp = Compare())
+        : BTreeMapN(comp)
+    {
+        for (const auto& [key, value] : init)
+            try_emplace(key, value);
+    }
+
+    /**
+     * @brief Copy constructor, in linear time through bulk_load().
+     */
+    BTreeMapN(const BTreeMapN& other) : BTreeMapN(other.m_comp)
+    {
+        bulk_load(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     */
+    BTreeMapN(BTreeMapN&& other) noexcept
+        : m_root(std::exchange(other.m_root, nullptr)), m_first(std::exchange(other.m_first, nullptr)),
+          m_last(std::exchange(other.m_last, nullptr)), m_size(std::exchange(other.m_size, 0)), m_comp(other.m_comp)
+    {
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    BTreeMapN& operator=(const BTreeMapN& other)
+    {
+        if (this != &other)
+        {
+            m_comp = other.m_comp;
+            bulk_load(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     */
+    BTreeMapN& operator=(BTreeMapN&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            m_root = std::exchange(other.m_root, nullptr);
+            m_first = std::exchange(other.m_first, nullptr);
+            m_last = std::exchange(other.m_last, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_comp = other.m_comp;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~BTreeMapN()
+    {
+        clear();
+    }
+
+    iterator begin()
+    {
+        return iterator(m_first, 0, this);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_first, 0, this);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr, 0, this);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr, 0, this);
+    }
+
+    /**
+     * @brief Checks if the map is empty.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Returns the number of levels (0 when empty, 1 for a single leaf).
+     */
+    size_type height() const
+    {
+        size_type levels = 0;
+        for (const NodeBase* node = m_root; node; node = node->leaf ? nullptr : static_cast<const Inner*>(node)->children[0])
+            ++levels;
+        return levels;
+    }
+
+    key_compare key_comp() const
+    {
+        return m_comp;
+    }
+
+    /**
+     * @brief Removes every element.
+     */
+    void clear()
+    {
+        if (m_root)
+            destroy(m_root);
+        m_root = nullptr;
+        m_first = m_last = nullptr;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Finds the element with the given key.
+     */
+    iterator find(const K& key)
+    {
+        return mutableIterator(findConst(key));
+    }
+
+    const_iterator find(const K& key) const
+    {
+        return findConst(key);
+    }
+
+    /**
+     * @brief Checks whether an element has the given key.
+     */
+    bool contains(const K& key) const
+    {
+        return findConst(key) != end();
+    }
+
+    /**
+     * @brief Returns 1 if an element has the given key, 0 otherwise.
+     */
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the value mapped to key.
+     *
+     * @throws std::out_of_range if the key is absent.
+     */
+    V& at(const K& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("BTreeMapN::at: key not found");
+        return it.value();
+    }
+
+    const V& at(const K& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("BTreeMapN::at: key not found");
+        return it.value();
+    }
+
+    /**
+     * @brief Returns the value mapped to key, inserting a value-initialized one if absent.
+     */
+    V& operator[](const K& key)
+    {
+        return try_emplace(key).first.value();
+    }
+
+    /**
+     * @brief First element whose key is not less than key.
+     */
+    iterator lower_bound(const K& key)
+    {
+        return mutableIterator(lowerBoundConst(key));
+    }
+
+    const_iterator lower_bound(const K& key) const
+    {
+        return lowerBoundConst(key);
+    }
+
+    /**
+     * @brief First element whose key is greater than key.
+     */
+    iterator upper_bound(const K& key)
+    {
+        return mutableIterator(upperBoundConst(key));
+    }
+
+    const_iterator upper_bound(const K& key) const
+    {
+        return upperBoundConst(key);
+    }
+
+    /**
+     * @brief Range of the elements with the given key (empty or one element).
+     */
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    /**
+     * @brief Elements with keys in [low, high), as a range.
+     */
+    std::ranges::subrange<iterator> range(const K& low, const K& high)
+    {
+        return { lower_bound(low), m_comp(low, high) ? lower_bound(high) : lower_bound(low) };
+    }
+
+    std::ranges::subrange<const_iterator> range(const K& low, const K& high) const
+    {
+        return { lower_bound(low), m_comp(low, high) ? lower_bound(high) : lower_bound(low) };
+    }
+
+    /**
+     * @brief Calls fn(const K&, const V&) on every element with a key in [low, high), in order.
+     *
+     * Walks the leaf arrays directly, which is faster than iterating over range().
+     *
+     * @return Number of elements visited.
+     */
+    template<typename Fn>
+    size_type scan(const K& low, const K& high, Fn&& fn) const
+    {
+        const_iterator start = lower_bound(low);
+        size_type visited = 0;
+        for (const Leaf* leaf = start.m_leaf, *first = leaf; leaf; leaf = leaf->next)
+        {
+            for (size_type i = leaf == first ? start.m_index : 0; i < leaf->count; ++i)
+            {
+                if (!m_comp(leaf->keys[i], high))
+                    return visited;
+                fn(leaf->keys[i], leaf->values[i]);
+                ++visited;
+            }
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Inserts the pair if its key is absent.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    std::pair<iterator, bool> insert(const std::pair<K, V>& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    /**
+     * @brief Constructs the value from args if key is absent; does nothing otherwise.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+    {
+        if (!m_root)
+        {
+            m_first = m_last = new Leaf();
+            m_root = m_first;
+        }
+
+        PathStep path[MaxDepth];
+        size_type depth = 0;
+        Leaf* leaf = descend(key, path, depth);
+        size_type pos = lowerBound(leaf->keys, leaf->count, key);
+        if (pos < leaf->count && !m_comp(key, leaf->keys[pos]))
+            return { iterator(leaf, pos, this), false };
+
+        V value(std::forward<Args>(args)...);
+        if (leaf->count < LeafSlots)
+        {
+            insertInLeaf(leaf, pos, key, std::move(value));
+            ++m_size;
+            return { iterator(leaf, pos, this), true };
+        }
+
+        // Split the full leaf in two halves, then insert in the half that covers the key.
+        Leaf* right = new Leaf();
+        const size_type mid = LeafSlots / 2;
+        std::move(leaf->keys + mid, leaf->keys + LeafSlots, right->keys);
+        std::move(leaf->values + mid, leaf->values + LeafSlots, right->values);
+        right->count = std::uint32_t(LeafSlots - mid);
+        leaf->count = std::uint32_t(mid);
+        right->prev = leaf;
+        right->next = leaf->next;
+        (leaf->next ? leaf->next->prev : m_last) = right;
+        leaf->next = right;
+
+        Leaf* target = leaf;
+        if (pos > mid)
+        {
+            target = right;
+            pos -= mid;
+        }
+        insertInLeaf(target, pos, key, std::move(value));
+        ++m_size;
+        insertInParent(path, depth, leaf->keys[leaf->count - 1], right);
+        return { iterator(target, pos, this), true };
+    }
+
+    /**
+     * @brief Inserts the pair, or assigns value to the element with the key.
+     *
+     * @return Iterator to the element, and whether it was inserted.
+     */
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+    {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second)
+            result.first.value() = std::forward<M>(value);
+        return result;
+    }
+
+    /**
+     * @brief Removes the element with the given key.
+     *
+     * @return Number of elements removed (0 or 1).
+     */
+    size_type erase(const K& key)
+    {
+        if (!m_root)
+            return 0;
+        PathStep path[MaxDepth];
+        size_type depth = 0;
+        Leaf* leaf = descend(key, path, depth);
+        const size_type pos = lowerBound(leaf->keys, leaf->count, key);
+        if (pos == leaf->count || m_comp(key, leaf->keys[pos]))
+            return 0;
+
+        std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+        std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+        --leaf->count;
+        --m_size;
+        rebalanceLeaf(leaf, path, depth);
+        return 1;
+    }
+
+    /**
+     * @brief Removes the element at pos.
+     *
+     * @return Iterator to the element that followed pos.
+     */
+    iterator erase(const_iterator pos)
+    {
+        const_iterator next = pos;
+        ++next;
+        if (next == end())
+        {
+            erase(K(pos.key()));
+            return end();
+        }
+        K nextKey = next.key();
+        erase(K(pos.key()));
+        return lower_bound(nextKey);
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    /**
+     * @brief Replaces the contents with sorted pairs, in linear time.
+     *
+     * Leaves are filled evenly and the inner levels built bottom-up, without
+     * any search or split.
+     *
+     * @param sorted Range of elements with members first and second, keys strictly increasing.
+     * @throws std::runtime_error if the keys are not strictly increasing (the map is then empty).
+     */
+    template<std::ranges::input_range R>
+    void bulk_load(R&& sorted)
+    {
+        std::vector<std::pair<K, V>> buffer;
+        if (static_cast<const void*>(&sorted) == static_cast<const void*>(this))
+        {
+            for (auto&& element : sorted)
+                buffer.emplace_back(element.first, element.second);
+            bulkLoad(buffer);
+        }
+        else
+        {
+            bulkLoad(sorted);
+        }
+    }
+
+    /**
+     * @brief Replaces the contents with keys[i] mapped to values[i], in linear time.
+     *
+     * @param keys Strictly increasing keys.
+     * @param values Values, one per key.
+     * @throws std::runtime_error if the sizes differ or the keys are not strictly increasing.
+     */
+    void bulk_load(const VectorN<K>& keys, const VectorN<V>& values)
+    {
+        if (keys.size() != values.size())
+            throw std::runtime_error("BTreeMapN::bulk_load: keys and values differ in size");
+        bulkLoad(zip(keys, values));
+    }
+
+private:
+    /**
+     * @brief Number of keys in keys[0, count) that are less than key, i.e. the lower bound.
+     */
+    size_type lowerBound(const K* keys, size_type count, const K& key) const
+    {
+        if constexpr (simdSearch)
+            return countLess(keys, count, key);
+        else
+            return size_type(std::lower_bound(keys, keys + count, key, m_comp) - keys);
+    }
+
+    /**
+     * @brief Whether the keys are compared with SIMD instructions.
+     */
+    static constexpr bool simdSearch = (std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>)
+        && (std::is_integral_v<K> || std::is_floating_point_v<K>) && (sizeof(K) == 4 || sizeof(K) == 8);
+
+    /**
+     * @brief Counts keys[i] < key over the whole array, several keys per instruction.
+     */
+    static size_type countLess(const K* keys, size_type count, K key)
+    {
+        size_type i = 0;
+        size_type result = 0;
+#if defined(CONTAINERS_HAS_AVX2)
+        if constexpr (std::is_integral_v<K> && sizeof(K) == 8)
+        {
+            // Unsigned keys are biased so that the signed compare orders them.
+            const long long bias = std::is_signed_v<K> ? 0 : (long long)(1ull << 63);
+            const __m256i needle = _mm256_set1_epi64x((long long)key ^ bias);
+            const __m256i biasVector = _mm256_set1_epi64x(bias);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256i block = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), biasVector);
+                result += size_type(std::popcount(unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, block))))));
+            }
+        }
+#endif
+#if defined(CONTAINERS_HAS_SSE2)
+        if constexpr (std::is_integral_v<K> && sizeof(K) == 4)
+        {
+            const int bias = std::is_signed_v<K> ? 0 : int(0x80000000u);
+            const __m128i needle = _mm_set1_epi32(int(key) ^ bias);
+            const __m128i biasVector = _mm_set1_epi32(bias);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), biasVector);
+                result += size_type(std::popcount(unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, block))))));
+            }
+        }
+        else if constexpr (std::is_same_v<K, float>)
+        {
+            const __m128 needle = _mm_set1_ps(key);
+            for (; i + 4 <= count; i += 4)
+                result += size_type(std::popcount(unsigned(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(keys + i), needle)))));
+        }
+        else if constexpr (std::is_same_v<K, double>)
+        {
+            const __m128d needle = _mm_set1_pd(key);
+            for (; i + 2 <= count; i += 2)
+                result += size_type(std::popcount(unsigned(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(keys + i), needle)))));
+        }
+#endif
+        for (; i < count; ++i)
+            result += keys[i] < key ? 1 : 0;
+        return result;
+    }
+
+    /**
+     * @brief Iterator to the same element as a const_iterator of this map.
+     */
+    iterator mutableIterator(const_iterator it)
+    {
+        return iterator(it.m_leaf, it.m_index, this);
+    }
+
+    /**
+     * @brief Descends to the leaf that covers key, recording the inner nodes crossed.
+     */
+    Leaf* descend(const K& key, PathStep* path, size_type& depth) const
+    {
+        NodeBase* node = m_root;
+        while (!node->leaf)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            const size_type index = lowerBound(inner->keys, inner->count - 1, key);
+            path[depth++] = PathStep{ inner, index };
+            node = inner->children[index];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    const_iterator lowerBoundConst(const K& key) const
+    {
+        if (!m_root)
+            return end();
+        PathStep path[MaxDepth];
+        size_type depth = 0;
+        Leaf* leaf = descend(key, path, depth);
+        const size_type pos = lowerBound(leaf->keys, leaf->count, key);
+        if (pos == leaf->count)
+            return const_iterator(leaf->next, 0, this);
+        return const_iterator(leaf, pos, this);
+    }
+
+    const_iterator upperBoundConst(const K& key) const
+    {
+        const_iterator it = lowerBoundConst(key);
+        if (it != end() && !m_comp(key, it.key()))
+            ++it;
+        return it;
+    }
+
+    const_iterator findConst(const K& key) const
+    {
+        const_iterator it = lowerBoundConst(key);
+        if (it != end() && m_comp(key, it.key()))
+            return end();
+        return it;
+    }
+
+    /**
+     * @brief Inserts an element at pos in a leaf that has room.
+     */
+    static void insertInLeaf(Leaf* leaf, size_type pos, const K& key, V&& value)
+    {
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = std::move(value);
+        ++leaf->count;
+    }
+
+    /**
+     * @brief Inserts separator and child right after children[index] of an inner node that has room.
+     */
+    static void insertInInner(Inner* inner, size_type index, K&& separator, NodeBase* child)
+    {
+        std::move_backward(inner->keys + index, inner->keys + inner->count - 1, inner->keys + inner->count);
+        std::move_backward(inner->children + index + 1, inner->children + inner->count, inner->children + inner->count + 1);
+        inner->keys[index] = std::move(separator);
+        inner->children[index + 1] = child;
+        ++inner->count;
+    }
+
+    /**
+     * @brief Adds the right half of a split node to its parent, splitting ancestors as needed.
+     *
+     * @param separator Upper bound of the left half.
+     * @param child The new right half.
+     */
+    void insertInParent(PathStep* path, size_type depth, K separator, NodeBase* child)
+    {
+        while (depth > 0)
+        {
+            const PathStep step = path[--depth];
+            Inner* parent = step.node;
+            if (parent->count < InnerSlots)
+            {
+                insertInInner(parent, step.index, std::move(separator), child);
+                return;
+            }
+
+            // Split: the left half keeps mid children, the separator between the halves moves up.
+            Inner* right = new Inner();
+            const size_type mid = InnerSlots / 2;
+            K promoted = std::move(parent->keys[mid - 1]);
+            std::move(parent->keys + mid, parent->keys + InnerSlots - 1, right->keys);
+            std::copy(parent->children + mid, parent->children + InnerSlots, right->children);
+            right->count = std::uint32_t(InnerSlots - mid);
+            parent->count = std::uint32_t(mid);
+            if (step.index < mid)
+                insertInInner(parent, step.index, std::move(separator), child);
+            else
+                insertInInner(right, step.index - mid, std::move(separator), child);
+
+            separator = std::move(promoted);
+            child = right;
+        }
+
+        Inner* root = new Inner();
+        root->children[0] = m_root;
+        root->children[1] = child;
+        root->keys[0] = std::move(separator);
+        root->count = 2;
+        m_root = root;
+    }
+
+    /**
+     * @brief Removes children[index] and the separator before it from an inner node.
+     */
+    static void removeChild(Inner* inner, size_type index)
+    {
+        std::move(inner->keys + index, inner->keys + inner->count - 1, inner->keys + index - 1);
+        std::copy(inner->children + index + 1, inner->children + inner->count, inner->children + index);
+        --inner->count;
+    }
+
+    /**
+     * @brief Restores the minimum occupancy of a leaf by borrowing from or merging with a sibling.
+     */
+    void rebalanceLeaf(Leaf* leaf, PathStep* path, size_type depth)
+    {
+        if (depth == 0)
+        {
+            if (leaf->count == 0)
+            {
+                delete leaf;
+                m_root = nullptr;
+                m_first = m_last = nullptr;
+            }
+            return;
+        }
+        if (leaf->count >= MinLeaf)
+            return;
+
+        const PathStep step = path[depth - 1];
+        Inner* parent = step.node;
+        const size_type index = step.index;
+        Leaf* left = index > 0 ? static_cast<Leaf*>(parent->children[index - 1]) : nullptr;
+        Leaf* right = index + 1 < parent->count ? static_cast<Leaf*>(parent->children[index + 1]) : nullptr;
+
+        if (left && left->count > MinLeaf)
+        {
+            std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            std::move_backward(leaf->values, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+            leaf->keys[0] = std::move(left->keys[left->count - 1]);
+            leaf->values[0] = std::move(left->values[left->count - 1]);
+            ++leaf->count;
+            --left->count;
+            parent->keys[index - 1] = left->keys[left->count - 1];
+            return;
+        }
+        if (right && right->count > MinLeaf)
+        {
+            leaf->keys[leaf->count] = std::move(right->keys[0]);
+            leaf->values[leaf->count] = std::move(right->values[0]);
+            ++leaf->count;
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            std::move(right->values + 1, right->values + right->count, right->values);
+            --right->count;
+            parent->keys[index] = leaf->keys[leaf->count - 1];
+            return;
+        }
+
+        // Merge with a sibling: the right node of the pair is emptied into the left one.
+        Leaf* into = left ? left : leaf;
+        Leaf* from = left ? leaf : right;
+        std::move(from->keys, from->keys + from->count, into->keys + into->count);
+        std::move(from->values, from->values + from->count, into->values + into->count);
+        into->count += from->count;
+        into->next = from->next;
+        (from->next ? from->next->prev : m_last) = into;
+        removeChild(parent, left ? index : index + 1);
+        delete from;
+        rebalanceInner(path, depth - 1);
+    }
+
+    /**
+     * @brief Restores the minimum occupancy of path[depth].node, then of its ancestors.
+     */
+    void rebalanceInner(PathStep* path, size_type depth)
+    {
+        Inner* node = path[depth].node;
+        if (depth == 0)
+        {
+            if (node->count == 1)
+            {
+                m_root = node->children[0];
+                delete node;
+            }
+            return;
+        }
+        if (node->count >= MinInner)
+            return;
+
+        const PathStep step = path[depth - 1];
+        Inner* parent = step.node;
+        const size_type index = step.index;
+        Inner* left = index > 0 ? static_cast<Inner*>(parent->children[index - 1]) : nullptr;
+        Inner* right = index + 1 < parent->count ? static_cast<Inner*>(parent->children[index + 1]) : nullptr;
+
+        if (left && left->count > MinInner)
+        {
+            std::move_backward(node->keys, node->keys + node->count - 1, node->keys + node->count);
+            std::copy_backward(node->children, node->children + node->count, node->children + node->count + 1);
+            node->keys[0] = std::move(parent->keys[index - 1]);
+            node->children[0] = left->children[left->count - 1];
+            parent->keys[index - 1] = std::move(left->keys[left->count - 2]);
+            ++node->count;
+            --left->count;
+            return;
+        }
+        if (right && right->count > MinInner)
+        {
+            node->keys[node->count - 1] = std::move(parent->keys[index]);
+            node->children[node->count] = right->children[0];
+            parent->keys[index] = std::move(right->keys[0]);
+            std::move(right->keys + 1, right->keys + right->count - 1, right->keys);
+            std::copy(right->children + 1, right->children + right->count, right->children);
+            ++node->count;
+            --right->count;
+            return;
+        }
+
+        // Merge: the separator between the two nodes comes down between their keys.
+        Inner* into = left ? left : node;
+        Inner* from = left ? node : right;
+        const size_type separator = left ? index - 1 : index;
+        into->keys[into->count - 1] = std::move(parent->keys[separator]);
+        std::move(from->keys, from->keys + from->count - 1, into->keys + into->count);
+        std::copy(from->children, from->children + from->count, into->children + into->count);
+        into->count += from->count;
+        removeChild(parent, separator + 1);
+        delete from;
+        rebalanceInner(path, depth - 1);
+    }
+
+    /**
+     * @brief Builds the tree from strictly increasing pairs.
+     */
+    template<typename R>
+    void bulkLoad(R&& sorted)
+    {
+        clear();
+
+        // Fill leaves to capacity, then even out the last two so both are at least half full.
+        std::vector<NodeBase*> level;
+        std::vector<K> upper;
+        Leaf* leaf = nullptr;
+        try
+        {
+            for (auto&& element : sorted)
+            {
+                if (m_size > 0 && !m_comp(m_last->keys[m_last->count - 1], element.first))
+                    throw std::runtime_error("BTreeMapN::bulk_load: keys are not strictly increasing");
+                if (!leaf || leaf->count == LeafSlots)
+                {
+                    Leaf* next = new Leaf();
+                    next->prev = leaf;
+                    (leaf ? leaf->next : m_first) = next;
+                    leaf = m_last = next;
+                    level.push_back(leaf);
+                }
+                leaf->keys[leaf->count] = element.first;
+                leaf->values[leaf->count] = element.second;
+                ++leaf->count;
+                ++m_size;
+            }
+        }
+        catch (...)
+        {
+            for (NodeBase* node : level)
+                delete static_cast<Leaf*>(node);
+            m_first = m_last = nullptr;
+            m_size = 0;
+            throw;
+        }
+        if (level.empty())
+            return;
+        if (level.size() > 1 && leaf->count < MinLeaf)
+        {
+            Leaf* prev = leaf->prev;
+            const size_type move = MinLeaf - leaf->count;
+            std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + move);
+            std::move_backward(leaf->values, leaf->values + leaf->count, leaf->values + leaf->count + move);
+            std::move(prev->keys + prev->count - move, prev->keys + prev->count, leaf->keys);
+            std::move(prev->values + prev->count - move, prev->values + prev->count, leaf->values);
+            prev->count -= std::uint32_t(move);
+            leaf->count += std::uint32_t(move);
+        }
+        for (NodeBase* node : level)
+        {
+            const Leaf* full = static_cast<const Leaf*>(node);
+            upper.push_back(full->keys[full->count - 1]);
+        }
+
+        // Group each level into parents with evenly spread children.
+        while (level.size() > 1)
+        {
+            const size_type parents = (level.size() + InnerSlots - 1) / InnerSlots;
+            std::vector<NodeBase*> nextLevel;
+            std::vector<K> nextUpper;
+            size_type child = 0;
+            for (size_type p = 0; p < parents; ++p)
+            {
+                const size_type take = level.size() / parents + (p < level.size() % parents ? 1 : 0);
+                Inner* inner = new Inner();
+                for (size_type c = 0; c < take; ++c, ++child)
+                {
+                    inner->children[c] = level[child];
+                    if (c + 1 < take)
+                        inner->keys[c] = upper[child];
+                }
+                inner->count = std::uint32_t(take);
+                nextLevel.push_back(inner);
+                nextUpper.push_back(upper[child - 1]);
+            }
+            level = std::move(nextLevel);
+            upper = std::move(nextUpper);
+        }
+        m_root = level[0];
+    }
+
+    /**
+     * @brief Deletes a subtree.
+     */
+    static void destroy(NodeBase* node)
+    {
+        if (node->leaf)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (size_type i = 0; i < inner->count; ++i)
+            destroy(inner->children[i]);
+        delete inner;
+    }
+
+    NodeBase* m_root;               ///< Root node, nullptr when empty.
+    Leaf* m_first;                  ///< Leftmost leaf.
+    Leaf* m_last;                   ///< Rightmost leaf.
+    size_type m_size;               ///< Number of elements.
+    [[no_unique_address]] Compare m_comp; ///< Key ordering.
+};
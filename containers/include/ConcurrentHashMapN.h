@@ -0,0 +1,311 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "HashMapN.h"
+
+/**
+ * @class ConcurrentHashMapN
+ * @brief Hash map safe for concurrent readers and writers, striped over independently locked shards.
+ *
+ * Keys are spread over a power-of-two number of shards; each shard is a
+ * HashMapN guarded by its own reader-writer lock and padded to a cache line,
+ * so threads working on different shards share neither a lock nor a line.
+ * Lookups take the shard lock in shared mode and run in parallel; inserts
+ * and erases lock one shard exclusively.
+ *
+ * A shard that fills up rehashes on its own, under its own lock: the table
+ * grows incrementally, one shard at a time, and never stops the whole map.
+ *
+ * No reference to a stored element escapes a lock: lookups copy the value
+ * out (find(), get()) or run a callback under the lock (visit(), upsert()).
+ * Callbacks must not access the same map, or they may deadlock.
+ *
+ * @tparam K Key type.
+ * @tparam V Mapped type.
+ * @tparam Hash Hash function object.
+ * @tparam KeyEqual Equality function object.
+ * @tparam Allocator Allocator of std::pair<const K, V>.
+ */
+template<typename K, typename V, typename Hash = HashN<K>, typename KeyEqual = std::equal_to<>,
+    typename Allocator = std::allocator<std::pair<const K, V>>>
+class ConcurrentHashMapN
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using map_type = HashMapN<K, V, Hash, KeyEqual, Allocator>; ///< Map held by each shard.
+
+    /**
+     * @brief Default number of shards: four per hardware thread, at least 16, rounded up to a power of two.
+     */
+    static size_type defaultShardCount()
+    {
+        return std::bit_ceil(std::max<size_type>(16, 4 * size_type(std::thread::hardware_concurrency())));
+    }
+
+    /**
+     * @brief Constructs an empty map.
+     *
+     * @param shardCount Number of shards, rounded up to a power of two (0 = defaultShardCount()).
+     * @param capacity Total number of elements to reserve room for.
+     * @param hash Hash function.
+     * @param equal Key equality.
+     * @param alloc Allocator used by every shard.
+     */
+    explicit ConcurrentHashMapN(size_type shardCount = 0, size_type capacity = 0, const Hash& hash = Hash(),
+        const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+        : m_hash(hash)
+    {
+        shardCount = std::bit_ceil(shardCount ? shardCount : defaultShardCount());
+        m_shardMask = shardCount - 1;
+        m_shards.reserve(shardCount);
+        for (size_type i = 0; i < shardCount; ++i)
+            m_shards.push_back(std::make_unique<Shard>((capacity + shardCount - 1) / shardCount, hash, equal, alloc));
+    }
+
+    ConcurrentHashMapN(const ConcurrentHashMapN&) = delete; ///< Delete copy constructor.
+    ConcurrentHashMapN& operator=(const ConcurrentHashMapN&) = delete; ///< Delete copy assignment operator.
+
+    /**
+     * @brief Returns the number of shards.
+     */
+    size_type shard_count() const
+    {
+        return m_shards.size();
+    }
+
+    /**
+     * @brief Returns the number of elements; a snapshot when other threads are writing.
+     */
+    size_type size() const
+    {
+        size_type total = 0;
+        for (const auto& shard : m_shards)
+        {
+            std::shared_lock lock(shard->mutex);
+            total += shard->map.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Checks if the map is empty; a snapshot when other threads are writing.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Copies the value mapped to key into out.
+     *
+     * @return true if the key was found.
+     */
+    template<typename Q>
+    bool find(const Q& key, V& out) const
+    {
+        return visit(key, [&out](const V& value) { out = value; });
+    }
+
+    /**
+     * @brief Returns a copy of the value mapped to key, or std::nullopt.
+     */
+    template<typename Q>
+    std::optional<V> get(const Q& key) const
+    {
+        std::optional<V> result;
+        visit(key, [&result](const V& value) { result.emplace(value); });
+        return result;
+    }
+
+    /**
+     * @brief Checks whether the key is present.
+     */
+    template<typename Q>
+    bool contains(const Q& key) const
+    {
+        const Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.contains(key);
+    }
+
+    /**
+     * @brief Calls fn(const V&) on the value mapped to key, under the shard's shared lock.
+     *
+     * @return true if the key was found.
+     */
+    template<typename Q, typename Fn>
+    bool visit(const Q& key, Fn&& fn) const
+    {
+        const Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end())
+            return false;
+        fn(std::as_const(it->second));
+        return true;
+    }
+
+    /**
+     * @brief Inserts the pair if the key is absent.
+     *
+     * @return true if inserted.
+     */
+    template<typename M>
+    bool insert(const K& key, M&& value)
+    {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.try_emplace(key, std::forward<M>(value)).second;
+    }
+
+    /**
+     * @brief Inserts the pair, or assigns value to the element with the key.
+     *
+     * @return true if inserted, false if assigned.
+     */
+    template<typename M>
+    bool insert_or_assign(const K& key, M&& value)
+    {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(key, std::forward<M>(value)).second;
+    }
+
+    /**
+     * @brief Atomically updates the value mapped to key, creating it first if absent.
+     *
+     * If the key is absent, a value is constructed from args (value-initialized
+     * without args); fn(V&) is then called on the value, all under the shard's
+     * exclusive lock. Suitable for counters and read-modify-write updates.
+     *
+     * @return true if the key was inserted.
+     */
+    template<typename Fn, typename... Args>
+    bool upsert(const K& key, Fn&& fn, Args&&... args)
+    {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        auto [it, inserted] = shard.map.try_emplace(key, std::forward<Args>(args)...);
+        fn(it->second);
+        return inserted;
+    }
+
+    /**
+     * @brief Removes the key.
+     *
+     * @return true if it was present.
+     */
+    template<typename Q>
+    bool erase(const Q& key)
+    {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.erase(key) != 0;
+    }
+
+    /**
+     * @brief Removes every element for which pred(const value_type&) is true, one shard at a time.
+     *
+     * @return Number of elements removed.
+     */
+    template<typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        size_type removed = 0;
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard->mutex);
+            removed += shard->map.erase_if(pred);
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Calls fn(const K&, const V&) on every element, one shard at a time under its shared lock.
+     *
+     * Not a snapshot: elements of other shards may change during the walk.
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (const auto& shard : m_shards)
+        {
+            std::shared_lock lock(shard->mutex);
+            for (const auto& [key, value] : shard->map)
+                fn(key, value);
+        }
+    }
+
+    /**
+     * @brief Removes every element, one shard at a time.
+     */
+    void clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard->mutex);
+            shard->map.clear();
+        }
+    }
+
+    /**
+     * @brief Makes room for count elements in total, spread evenly over the shards.
+     */
+    void reserve(size_type count)
+    {
+        const size_type perShard = (count + m_shards.size() - 1) / m_shards.size();
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard->mutex);
+            shard->map.reserve(perShard);
+        }
+    }
+
+private:
+    /**
+     * @brief A map and its lock, alone on their cache lines.
+     */
+    struct alignas(64) Shard
+    {
+        Shard(size_type capacity, const Hash& hash, const KeyEqual& equal, const Allocator& alloc)
+            : map(capacity, hash, equal, alloc)
+        {
+        }
+
+        mutable std::shared_mutex mutex; ///< Guards map.
+        map_type map;                    ///< Elements of the shard.
+    };
+
+    /**
+     * @brief Shard owning key. Uses other hash bits than the table inside the shard.
+     */
+    template<typename Q>
+    Shard& shardFor(const Q& key) const
+    {
+        std::uint64_t x = std::uint64_t(m_hash(key));
+        x ^= x >> 31;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 29;
+        return *m_shards[size_type(x) & m_shardMask];
+    }
+
+    [[no_unique_address]] Hash m_hash;        ///< Hash used to pick the shard.
+    size_type m_shardMask;                    ///< shard_count() - 1.
+    std::vector<std::unique_ptr<Shard>> m_shards; ///< The shards.
+};
@@ -0,0 +1,1035 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "ArrayN.h"
+#include "MatrixN.h"
+#include "VecteurND.h"
+
+/**
+ * @file DecompositionN.h
+ * @brief Dense LU, Cholesky and QR decompositions of fixed-size matrices.
+ *
+ * Every size is a template parameter, so the loops of small systems have
+ * compile-time trip counts and are fully unrolled by the optimiser. Matrices
+ * larger than BlockThreshold are factorized by panels of BlockSize columns so
+ * that the trailing updates stream through cache-resident rows.
+ *
+ * A single small factorization is bound by the latency of its dependency
+ * chain (pivot, division, update). LuN::solveBatch and CholeskyN::solveBatch
+ * interleave BatchLanes independent systems coefficient by coefficient, so
+ * every step of the elimination is a SIMD operation across systems.
+ *
+ * Only floating-point element types are supported.
+ */
+
+/**
+ * @class TriangularSolveN
+ * @brief Forward and backward substitution kernels on row-major storage.
+ *
+ * The right-hand side holds K columns stored row-major (K = 1 for a vector),
+ * and is overwritten with the solution. The kernels take the reciprocals of
+ * the diagonal, computed once by inverseDiagonal (or kept by a decomposition),
+ * so the substitution itself only multiplies.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+class TriangularSolveN {
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Computes the reciprocals of the diagonal of a triangular matrix.
+     *
+     * @tparam N The order of the matrix.
+     * @param a Row-major storage of the matrix with leading dimension lda.
+     * @param lda Leading dimension of the matrix.
+     * @param out Receives the N reciprocals.
+     * @throws std::runtime_error if a diagonal coefficient is zero.
+     */
+    template<std::size_t N>
+    static void inverseDiagonal(const T* a, size_type lda, T* out) {
+        for (size_type i = 0; i < N; ++i) {
+            const T diagonal = a[i * lda + i];
+            if (diagonal == T{})
+                throw std::runtime_error("Zero diagonal coefficient in triangular solve");
+            out[i] = T{ 1 } / diagonal;
+        }
+    }
+
+    /**
+     * @brief Solves L * X = B where L is lower triangular.
+     *
+     * @tparam N The order of L.
+     * @tparam K The number of right-hand sides.
+     * @param l Row-major storage of L with leading dimension lda.
+     * @param lda Leading dimension of L.
+     * @param x Row-major N x K right-hand side, overwritten with X.
+     * @param invDiagonal Reciprocals of the diagonal of L, or nullptr for a unit diagonal.
+     */
+    template<std::size_t N, std::size_t K>
+    static void lower(const T* l, size_type lda, T* x, const T* invDiagonal) {
+        for (size_type i = 0; i < N; ++i) {
+            T* xi = x + i * K;
+            const T* li = l + i * lda;
+            for (size_type k = 0; k < i; ++k) {
+                const T lik = li[k];
+                const T* xk = x + k * K;
+                for (size_type j = 0; j < K; ++j) {
+                    xi[j] -= lik * xk[j];
+                }
+            }
+            if (invDiagonal) {
+                scaleRow<K>(xi, invDiagonal[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Solves U * X = B where U is upper triangular.
+     *
+     * @tparam N The order of U.
+     * @tparam K The number of right-hand sides.
+     * @param u Row-major storage of U with leading dimension ldu.
+     * @param ldu Leading dimension of U.
+     * @param x Row-major N x K right-hand side, overwritten with X.
+     * @param invDiagonal Reciprocals of the diagonal of U, or nullptr for a unit diagonal.
+     */
+    template<std::size_t N, std::size_t K>
+    static void upper(const T* u, size_type ldu, T* x, const T* invDiagonal) {
+        for (size_type i = N; i-- > 0;) {
+            T* xi = x + i * K;
+            const T* ui = u + i * ldu;
+            for (size_type k = i + 1; k < N; ++k) {
+                const T uik = ui[k];
+                const T* xk = x + k * K;
+                for (size_type j = 0; j < K; ++j) {
+                    xi[j] -= uik * xk[j];
+                }
+            }
+            if (invDiagonal) {
+                scaleRow<K>(xi, invDiagonal[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Solves transpose(L) * X = B where L is lower triangular.
+     *
+     * Reads L row by row, which keeps the accesses contiguous in row-major storage.
+     *
+     * @tparam N The order of L.
+     * @tparam K The number of right-hand sides.
+     * @param l Row-major storage of L with leading dimension lda.
+     * @param lda Leading dimension of L.
+     * @param x Row-major N x K right-hand side, overwritten with X.
+     * @param invDiagonal Reciprocals of the diagonal of L.
+     */
+    template<std::size_t N, std::size_t K>
+    static void lowerTransposed(const T* l, size_type lda, T* x, const T* invDiagonal) {
+        for (size_type i = N; i-- > 0;) {
+            T* xi = x + i * K;
+            const T* li = l + i * lda;
+            scaleRow<K>(xi, invDiagonal[i]);
+            for (size_type k = 0; k < i; ++k) {
+                const T lik = li[k];
+                T* xk = x + k * K;
+                for (size_type j = 0; j < K; ++j) {
+                    xk[j] -= lik * xi[j];
+                }
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Multiplies a row of the right-hand side by the reciprocal of a diagonal coefficient.
+     */
+    template<std::size_t K>
+    static void scaleRow(T* row, T invDiagonal) {
+        for (size_type j = 0; j < K; ++j) {
+            row[j] *= invDiagonal;
+        }
+    }
+};
+
+/**
+ * @brief Solves a triangular system, computing the reciprocals of the diagonal first.
+ */
+template<typename T, std::size_t N, std::size_t K, bool Lower>
+void solveTriangularInPlace(const T* a, T* x, bool unitDiagonal)
+{
+    ArrayN<T, N> invDiagonal;
+    if (!unitDiagonal)
+        TriangularSolveN<T>::template inverseDiagonal<N>(a, N, invDiagonal.data());
+    const T* inv = unitDiagonal ? nullptr : invDiagonal.data();
+    if constexpr (Lower)
+        TriangularSolveN<T>::template lower<N, K>(a, N, x, inv);
+    else
+        TriangularSolveN<T>::template upper<N, K>(a, N, x, inv);
+}
+
+/**
+ * @brief Solves L * x = b for a lower triangular matrix.
+ *
+ * @param l The lower triangular matrix (the upper part is ignored).
+ * @param b The right-hand side.
+ * @param unitDiagonal Whether the diagonal of L is implicitly one.
+ * @return The solution x.
+ * @throws std::runtime_error if a diagonal coefficient is zero.
+ */
+template<typename T, std::size_t N>
+VectorND<T, N> solveLowerTriangular(const MatrixND<T, N, N>& l, const VectorND<T, N>& b, bool unitDiagonal = false)
+{
+    VectorND<T, N> x(b);
+    solveTriangularInPlace<T, N, 1, true>(l.data(), x.data(), unitDiagonal);
+    return x;
+}
+
+/**
+ * @brief Solves L * X = B for a lower triangular matrix and K right-hand sides.
+ *
+ * @param l The lower triangular matrix (the upper part is ignored).
+ * @param b The right-hand sides, one per column.
+ * @param unitDiagonal Whether the diagonal of L is implicitly one.
+ * @return The solution X.
+ * @throws std::runtime_error if a diagonal coefficient is zero.
+ */
+template<typename T, std::size_t N, std::size_t K>
+MatrixND<T, N, K> solveLowerTriangular(const MatrixND<T, N, N>& l, const MatrixND<T, N, K>& b, bool unitDiagonal = false)
+{
+    MatrixND<T, N, K> x(b);
+    solveTriangularInPlace<T, N, K, true>(l.data(), x.data(), unitDiagonal);
+    return x;
+}
+
+/**
+ * @brief Solves U * x = b for an upper triangular matrix.
+ *
+ * @param u The upper triangular matrix (the lower part is ignored).
+ * @param b The right-hand side.
+ * @param unitDiagonal Whether the diagonal of U is implicitly one.
+ * @return The solution x.
+ * @throws std::runtime_error if a diagonal coefficient is zero.
+ */
+template<typename T, std::size_t N>
+VectorND<T, N> solveUpperTriangular(const MatrixND<T, N, N>& u, const VectorND<T, N>& b, bool unitDiagonal = false)
+{
+    VectorND<T, N> x(b);
+    solveTriangularInPlace<T, N, 1, false>(u.data(), x.data(), unitDiagonal);
+    return x;
+}
+
+/**
+ * @brief Solves U * X = B for an upper triangular matrix and K right-hand sides.
+ *
+ * @param u The upper triangular matrix (the lower part is ignored).
+ * @param b The right-hand sides, one per column.
+ * @param unitDiagonal Whether the diagonal of U is implicitly one.
+ * @return The solution X.
+ * @throws std::runtime_error if a diagonal coefficient is zero.
+ */
+template<typename T, std::size_t N, std::size_t K>
+MatrixND<T, N, K> solveUpperTriangular(const MatrixND<T, N, N>& u, const MatrixND<T, N, K>& b, bool unitDiagonal = false)
+{
+    MatrixND<T, N, K> x(b);
+    solveTriangularInPlace<T, N, K, false>(u.data(), x.data(), unitDiagonal);
+    return x;
+}
+
+/**
+ * @class LuN
+ * @brief LU decomposition with partial pivoting: P * A = L * U.
+ *
+ * L (unit diagonal) and U are stored packed in a single matrix. Above
+ * BlockThreshold the factorization is right-looking by panels of BlockSize
+ * columns: each panel is factorized, then the trailing matrix receives a
+ * single rank-BlockSize update.
+ *
+ * @tparam T The element type (floating point).
+ * @tparam N The order of the matrix.
+ */
+template<typename T, std::size_t N>
+class LuN {
+    static_assert(std::is_floating_point_v<T>, "LuN requires a floating-point element type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type BlockThreshold = 32; ///< Orders above this are factorized by panels.
+    static constexpr size_type BlockSize = 16;      ///< Width of a panel.
+    static constexpr size_type BatchLanes = 8;      ///< Systems interleaved by solveBatch.
+    static constexpr size_type BatchMaxOrder = 16;  ///< Largest order solved interleaved by solveBatch.
+
+    /**
+     * @brief Factorizes a matrix.
+     *
+     * @param matrix The matrix to factorize.
+     * @throws std::runtime_error if the matrix is singular to working precision.
+     */
+    explicit LuN(const MatrixND<T, N, N>& matrix)
+        : m_lu(matrix), m_sign(1) {
+        size_type* perm = m_permutation.data();
+        for (size_type i = 0; i < N; ++i) {
+            perm[i] = i;
+        }
+
+        T maxAbs{};
+        const T* a = m_lu.data();
+        for (size_type i = 0; i < N * N; ++i) {
+            maxAbs = std::max(maxAbs, std::abs(a[i]));
+        }
+        m_tolerance = maxAbs * static_cast<T>(N) * std::numeric_limits<T>::epsilon();
+
+        if constexpr (N <= BlockThreshold) {
+            factorPanel(0, N);
+        }
+        else {
+            for (size_type k0 = 0; k0 < N; k0 += BlockSize) {
+                const size_type k1 = std::min(k0 + BlockSize, N);
+                factorPanel(k0, k1);
+                updateTrailing(k0, k1);
+            }
+        }
+    }
+
+    /**
+     * @brief Solves A * x = b.
+     *
+     * @param b The right-hand side.
+     * @return The solution x.
+     */
+    VectorND<T, N> solve(const VectorND<T, N>& b) const {
+        VectorND<T, N> x;
+        const size_type* perm = m_permutation.data();
+        for (size_type i = 0; i < N; ++i) {
+            x.data()[i] = b.data()[perm[i]];
+        }
+        TriangularSolveN<T>::template lower<N, 1>(m_lu.data(), N, x.data(), nullptr);
+        TriangularSolveN<T>::template upper<N, 1>(m_lu.data(), N, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for K right-hand sides.
+     *
+     * @param b The right-hand sides, one per column.
+     * @return The solution X.
+     */
+    template<std::size_t K>
+    MatrixND<T, N, K> solve(const MatrixND<T, N, K>& b) const {
+        MatrixND<T, N, K> x;
+        const size_type* perm = m_permutation.data();
+        for (size_type i = 0; i < N; ++i) {
+            std::copy(b.data() + perm[i] * K, b.data() + perm[i] * K + K, x.data() + i * K);
+        }
+        TriangularSolveN<T>::template lower<N, K>(m_lu.data(), N, x.data(), nullptr);
+        TriangularSolveN<T>::template upper<N, K>(m_lu.data(), N, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Returns the determinant of the factorized matrix.
+     */
+    T determinant() const {
+        T det = static_cast<T>(m_sign);
+        for (size_type i = 0; i < N; ++i) {
+            det *= m_lu.coeff(i, i);
+        }
+        return det;
+    }
+
+    /**
+     * @brief Returns the inverse of the factorized matrix.
+     */
+    MatrixND<T, N, N> inverse() const {
+        MatrixND<T, N, N> identity;
+        for (size_type i = 0; i < N; ++i) {
+            identity.coeffRef(i, i) = T{ 1 };
+        }
+        return solve(identity);
+    }
+
+    /**
+     * @brief Returns L and U packed in one matrix (the unit diagonal of L is not stored).
+     */
+    const MatrixND<T, N, N>& packed() const {
+        return m_lu;
+    }
+
+    /**
+     * @brief Solves matrices[i] * solutions[i] = rhs[i] for every system of a batch.
+     *
+     * Orders up to BatchMaxOrder are solved BatchLanes systems at a time, with
+     * the systems interleaved so the elimination runs across SIMD lanes; the
+     * remaining systems use the regular factorization.
+     *
+     * @param matrices The matrices of the systems.
+     * @param rhs The right-hand sides.
+     * @param solutions Receives the solutions.
+     * @throws std::runtime_error if the spans have different sizes or a matrix is singular.
+     */
+    static void solveBatch(std::span<const MatrixND<T, N, N>> matrices, std::span<const VectorND<T, N>> rhs,
+        std::span<VectorND<T, N>> solutions) {
+        if (matrices.size() != rhs.size() || matrices.size() != solutions.size())
+            throw std::runtime_error("LuN::solveBatch: spans have different sizes");
+
+        size_type s = 0;
+        if constexpr (N <= BatchMaxOrder) {
+            for (; s + BatchLanes <= matrices.size(); s += BatchLanes) {
+                solveLanes(matrices.data() + s, rhs.data() + s, solutions.data() + s);
+            }
+        }
+        for (; s < matrices.size(); ++s) {
+            solutions[s] = LuN(matrices[s]).solve(rhs[s]);
+        }
+    }
+
+    /**
+     * @brief Returns the row permutation: row i of L * U is row permutation()[i] of A.
+     */
+    const ArrayN<size_type, N>& permutation() const {
+        return m_permutation;
+    }
+
+private:
+    /**
+     * @brief Solves BatchLanes systems interleaved: coefficient e of system w is at a[e * BatchLanes + w].
+     *
+     * The forward substitution is fused with the elimination, so L is never stored.
+     */
+    static void solveLanes(const MatrixND<T, N, N>* matrices, const VectorND<T, N>* rhs, VectorND<T, N>* solutions) {
+        constexpr size_type W = BatchLanes;
+        T a[N * N * W];
+        T y[N * W];
+        T invDiagonal[N * W];
+        T tolerance[W];
+
+        for (size_type w = 0; w < W; ++w) {
+            const T* src = matrices[w].data();
+            T maxAbs{};
+            for (size_type e = 0; e < N * N; ++e) {
+                a[e * W + w] = src[e];
+                maxAbs = std::max(maxAbs, std::abs(src[e]));
+            }
+            tolerance[w] = maxAbs * static_cast<T>(N) * std::numeric_limits<T>::epsilon();
+            for (size_type i = 0; i < N; ++i) {
+                y[i * W + w] = rhs[w].data()[i];
+            }
+        }
+
+        for (size_type k = 0; k < N; ++k) {
+            size_type pivot[W];
+            T best[W];
+            for (size_type w = 0; w < W; ++w) {
+                pivot[w] = k;
+                best[w] = std::abs(a[(k * N + k) * W + w]);
+            }
+            for (size_type i = k + 1; i < N; ++i) {
+                for (size_type w = 0; w < W; ++w) {
+                    const T value = std::abs(a[(i * N + k) * W + w]);
+                    pivot[w] = value > best[w] ? i : pivot[w];
+                    best[w] = value > best[w] ? value : best[w];
+                }
+            }
+            for (size_type w = 0; w < W; ++w) {
+                if (best[w] <= tolerance[w])
+                    throw std::runtime_error("LuN: matrix is singular");
+                if (pivot[w] != k) {
+                    for (size_type j = 0; j < N; ++j) {
+                        std::swap(a[(k * N + j) * W + w], a[(pivot[w] * N + j) * W + w]);
+                    }
+                    std::swap(y[k * W + w], y[pivot[w] * W + w]);
+                }
+            }
+
+            T* inv = invDiagonal + k * W;
+            for (size_type w = 0; w < W; ++w) {
+                inv[w] = T{ 1 } / a[(k * N + k) * W + w];
+            }
+            const T* rowK = a + k * N * W;
+            for (size_type i = k + 1; i < N; ++i) {
+                T* rowI = a + i * N * W;
+                T l[W];
+                for (size_type w = 0; w < W; ++w) {
+                    l[w] = rowI[k * W + w] * inv[w];
+                }
+                for (size_type j = k + 1; j < N; ++j) {
+                    for (size_type w = 0; w < W; ++w) {
+                        rowI[j * W + w] -= l[w] * rowK[j * W + w];
+                    }
+                }
+                for (size_type w = 0; w < W; ++w) {
+                    y[i * W + w] -= l[w] * y[k * W + w];
+                }
+            }
+        }
+
+        for (size_type i = N; i-- > 0;) {
+            const T* rowI = a + i * N * W;
+            for (size_type k = i + 1; k < N; ++k) {
+                for (size_type w = 0; w < W; ++w) {
+                    y[i * W + w] -= rowI[k * W + w] * y[k * W + w];
+                }
+            }
+            for (size_type w = 0; w < W; ++w) {
+                y[i * W + w] *= invDiagonal[i * W + w];
+            }
+        }
+
+        for (size_type w = 0; w < W; ++w) {
+            for (size_type i = 0; i < N; ++i) {
+                solutions[w].data()[i] = y[i * W + w];
+            }
+        }
+    }
+
+    /**
+     * @brief Factorizes columns [k0, k1) with partial pivoting, updating only those columns.
+     *
+     * @throws std::runtime_error if a pivot is below the tolerance.
+     */
+    void factorPanel(size_type k0, size_type k1) {
+        T* a = m_lu.data();
+        size_type* perm = m_permutation.data();
+        for (size_type k = k0; k < k1; ++k) {
+            size_type pivot = k;
+            T pivotAbs = std::abs(a[k * N + k]);
+            for (size_type i = k + 1; i < N; ++i) {
+                const T value = std::abs(a[i * N + k]);
+                if (value > pivotAbs) {
+                    pivotAbs = value;
+                    pivot = i;
+                }
+            }
+            if (pivotAbs <= m_tolerance)
+                throw std::runtime_error("LuN: matrix is singular");
+
+            if (pivot != k) {
+                std::swap_ranges(a + k * N, a + k * N + N, a + pivot * N);
+                std::swap(perm[k], perm[pivot]);
+                m_sign = -m_sign;
+            }
+
+            const T inv = T{ 1 } / a[k * N + k];
+            m_invDiagonal.data()[k] = inv;
+            const T* rowK = a + k * N;
+            for (size_type i = k + 1; i < N; ++i) {
+                T* rowI = a + i * N;
+                const T lik = rowI[k] * inv;
+                rowI[k] = lik;
+                for (size_type j = k + 1; j < k1; ++j) {
+                    rowI[j] -= lik * rowK[j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Computes U12 = inverse(L11) * A12 and A22 -= L21 * U12 after factorPanel(k0, k1).
+     */
+    void updateTrailing(size_type k0, size_type k1) {
+        if (k1 >= N)
+            return;
+        T* a = m_lu.data();
+        for (size_type i = k0; i < N; ++i) {
+            T* rowI = a + i * N;
+            const size_type last = std::min(i, k1);
+            for (size_type k = k0; k < last; ++k) {
+                const T lik = rowI[k];
+                const T* rowK = a + k * N;
+                for (size_type j = k1; j < N; ++j) {
+                    rowI[j] -= lik * rowK[j];
+                }
+            }
+        }
+    }
+
+    MatrixND<T, N, N> m_lu;                ///< L and U packed.
+    ArrayN<T, N> m_invDiagonal;            ///< Reciprocals of the diagonal of U.
+    ArrayN<size_type, N> m_permutation;    ///< Row permutation.
+    int m_sign;                            ///< Sign of the permutation.
+    T m_tolerance;                         ///< Pivots at or below this magnitude are treated as zero.
+};
+
+/**
+ * @class CholeskyN
+ * @brief Cholesky decomposition of a symmetric positive definite matrix: A = L * transpose(L).
+ *
+ * Only the lower triangle of the input is read. Above BlockThreshold the
+ * factorization is right-looking by panels of BlockSize columns.
+ *
+ * @tparam T The element type (floating point).
+ * @tparam N The order of the matrix.
+ */
+template<typename T, std::size_t N>
+class CholeskyN {
+    static_assert(std::is_floating_point_v<T>, "CholeskyN requires a floating-point element type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type BlockThreshold = 32; ///< Orders above this are factorized by panels.
+    static constexpr size_type BlockSize = 16;      ///< Width of a panel.
+    static constexpr size_type BatchLanes = 8;      ///< Systems interleaved by solveBatch.
+    static constexpr size_type BatchMaxOrder = 16;  ///< Largest order solved interleaved by solveBatch.
+
+    /**
+     * @brief Factorizes a matrix.
+     *
+     * @param matrix The symmetric positive definite matrix to factorize.
+     * @throws std::runtime_error if the matrix is not positive definite.
+     */
+    explicit CholeskyN(const MatrixND<T, N, N>& matrix)
+        : m_l(matrix) {
+        T* l = m_l.data();
+        for (size_type i = 0; i < N; ++i) {
+            std::fill(l + i * N + i + 1, l + i * N + N, T{});
+        }
+
+        if constexpr (N <= BlockThreshold) {
+            factorDiagonal(0, N);
+        }
+        else {
+            for (size_type k0 = 0; k0 < N; k0 += BlockSize) {
+                const size_type k1 = std::min(k0 + BlockSize, N);
+                factorDiagonal(k0, k1);
+                if (k1 < N) {
+                    solvePanel(k0, k1);
+                    updateTrailing(k0, k1);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Solves A * x = b.
+     *
+     * @param b The right-hand side.
+     * @return The solution x.
+     */
+    VectorND<T, N> solve(const VectorND<T, N>& b) const {
+        VectorND<T, N> x(b);
+        TriangularSolveN<T>::template lower<N, 1>(m_l.data(), N, x.data(), m_invDiagonal.data());
+        TriangularSolveN<T>::template lowerTransposed<N, 1>(m_l.data(), N, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for K right-hand sides.
+     *
+     * @param b The right-hand sides, one per column.
+     * @return The solution X.
+     */
+    template<std::size_t K>
+    MatrixND<T, N, K> solve(const MatrixND<T, N, K>& b) const {
+        MatrixND<T, N, K> x(b);
+        TriangularSolveN<T>::template lower<N, K>(m_l.data(), N, x.data(), m_invDiagonal.data());
+        TriangularSolveN<T>::template lowerTransposed<N, K>(m_l.data(), N, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Returns the determinant of the factorized matrix.
+     */
+    T determinant() const {
+        T det{ 1 };
+        for (size_type i = 0; i < N; ++i) {
+            det *= m_l.coeff(i, i) * m_l.coeff(i, i);
+        }
+        return det;
+    }
+
+    /**
+     * @brief Solves matrices[i] * solutions[i] = rhs[i] for every system of a batch.
+     *
+     * Orders up to BatchMaxOrder are solved BatchLanes systems at a time, with
+     * the systems interleaved so the factorization runs across SIMD lanes; the
+     * remaining systems use the regular factorization.
+     *
+     * @param matrices The symmetric positive definite matrices of the systems.
+     * @param rhs The right-hand sides.
+     * @param solutions Receives the solutions.
+     * @throws std::runtime_error if the spans have different sizes or a matrix is not positive definite.
+     */
+    static void solveBatch(std::span<const MatrixND<T, N, N>> matrices, std::span<const VectorND<T, N>> rhs,
+        std::span<VectorND<T, N>> solutions) {
+        if (matrices.size() != rhs.size() || matrices.size() != solutions.size())
+            throw std::runtime_error("CholeskyN::solveBatch: spans have different sizes");
+
+        size_type s = 0;
+        if constexpr (N <= BatchMaxOrder) {
+            for (; s + BatchLanes <= matrices.size(); s += BatchLanes) {
+                solveLanes(matrices.data() + s, rhs.data() + s, solutions.data() + s);
+            }
+        }
+        for (; s < matrices.size(); ++s) {
+            solutions[s] = CholeskyN(matrices[s]).solve(rhs[s]);
+        }
+    }
+
+    /**
+     * @brief Returns the lower triangular factor L (its upper part is zero).
+     */
+    const MatrixND<T, N, N>& matrixL() const {
+        return m_l;
+    }
+
+private:
+    /**
+     * @brief Solves BatchLanes systems interleaved: coefficient e of system w is at l[e * BatchLanes + w].
+     */
+    static void solveLanes(const MatrixND<T, N, N>* matrices, const VectorND<T, N>* rhs, VectorND<T, N>* solutions) {
+        constexpr size_type W = BatchLanes;
+        T l[N * N * W];
+        T y[N * W];
+        T invDiagonal[N * W];
+
+        for (size_type w = 0; w < W; ++w) {
+            const T* src = matrices[w].data();
+            for (size_type i = 0; i < N; ++i) {
+                for (size_type j = 0; j <= i; ++j) {
+                    l[(i * N + j) * W + w] = src[i * N + j];
+                }
+                y[i * W + w] = rhs[w].data()[i];
+            }
+        }
+
+        for (size_type j = 0; j < N; ++j) {
+            const T* rowJ = l + j * N * W;
+            for (size_type i = j; i < N; ++i) {
+                T* rowI = l + i * N * W;
+                T sum[W];
+                for (size_type w = 0; w < W; ++w) {
+                    sum[w] = rowI[j * W + w];
+                }
+                for (size_type p = 0; p < j; ++p) {
+                    for (size_type w = 0; w < W; ++w) {
+                        sum[w] -= rowI[p * W + w] * rowJ[p * W + w];
+                    }
+                }
+                if (i == j) {
+                    bool positive = true;
+                    for (size_type w = 0; w < W; ++w) {
+                        positive = positive && sum[w] > T{};
+                    }
+                    if (!positive)
+                        throw std::runtime_error("CholeskyN: matrix is not positive definite");
+                    for (size_type w = 0; w < W; ++w) {
+                        const T diagonal = std::sqrt(sum[w]);
+                        rowI[j * W + w] = diagonal;
+                        invDiagonal[j * W + w] = T{ 1 } / diagonal;
+                    }
+                }
+                else {
+                    for (size_type w = 0; w < W; ++w) {
+                        rowI[j * W + w] = sum[w] * invDiagonal[j * W + w];
+                    }
+                }
+            }
+        }
+
+        for (size_type i = 0; i < N; ++i) {
+            const T* rowI = l + i * N * W;
+            for (size_type k = 0; k < i; ++k) {
+                for (size_type w = 0; w < W; ++w) {
+                    y[i * W + w] -= rowI[k * W + w] * y[k * W + w];
+                }
+            }
+            for (size_type w = 0; w < W; ++w) {
+                y[i * W + w] *= invDiagonal[i * W + w];
+            }
+        }
+        for (size_type i = N; i-- > 0;) {
+            const T* rowI = l + i * N * W;
+            for (size_type w = 0; w < W; ++w) {
+                y[i * W + w] *= invDiagonal[i * W + w];
+            }
+            for (size_type k = 0; k < i; ++k) {
+                for (size_type w = 0; w < W; ++w) {
+                    y[k * W + w] -= rowI[k * W + w] * y[i * W + w];
+                }
+            }
+        }
+
+        for (size_type w = 0; w < W; ++w) {
+            for (size_type i = 0; i < N; ++i) {
+                solutions[w].data()[i] = y[i * W + w];
+            }
+        }
+    }
+
+    /**
+     * @brief Factorizes the diagonal block [k0, k1) once the previous panels are applied.
+     *
+     * @throws std::runtime_error if a diagonal coefficient is not positive.
+     */
+    void factorDiagonal(size_type k0, size_type k1) {
+        T* l = m_l.data();
+        T* invDiagonal = m_invDiagonal.data();
+        for (size_type i = k0; i < k1; ++i) {
+            T* rowI = l + i * N;
+            for (size_type j = k0; j <= i; ++j) {
+                const T* rowJ = l + j * N;
+                T sum = rowI[j];
+                for (size_type p = k0; p < j; ++p) {
+                    sum -= rowI[p] * rowJ[p];
+                }
+                if (j < i) {
+                    rowI[j] = sum * invDiagonal[j];
+                }
+                else {
+                    if (!(sum > T{}))
+                        throw std::runtime_error("CholeskyN: matrix is not positive definite");
+                    rowI[i] = std::sqrt(sum);
+                    invDiagonal[i] = T{ 1 } / rowI[i];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Computes L21 = A21 * inverse(transpose(L11)) for the rows below the diagonal block.
+     */
+    void solvePanel(size_type k0, size_type k1) {
+        T* l = m_l.data();
+        const T* invDiagonal = m_invDiagonal.data();
+        for (size_type i = k1; i < N; ++i) {
+            T* rowI = l + i * N;
+            for (size_type j = k0; j < k1; ++j) {
+                const T* rowJ = l + j * N;
+                T sum = rowI[j];
+                for (size_type p = k0; p < j; ++p) {
+                    sum -= rowI[p] * rowJ[p];
+                }
+                rowI[j] = sum * invDiagonal[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Applies A22 -= L21 * transpose(L21) to the lower triangle of the trailing matrix.
+     */
+    void updateTrailing(size_type k0, size_type k1) {
+        T* l = m_l.data();
+        for (size_type i = k1; i < N; ++i) {
+            T* rowI = l + i * N;
+            for (size_type j = k1; j <= i; ++j) {
+                const T* rowJ = l + j * N;
+                T sum{};
+                for (size_type p = k0; p < k1; ++p) {
+                    sum += rowI[p] * rowJ[p];
+                }
+                rowI[j] -= sum;
+            }
+        }
+    }
+
+    MatrixND<T, N, N> m_l;       ///< The lower triangular factor.
+    ArrayN<T, N> m_invDiagonal;  ///< Reciprocals of the diagonal of L.
+};
+
+/**
+ * @class QrN
+ * @brief Householder QR decomposition of a matrix with at least as many rows as columns.
+ *
+ * R is stored in the upper triangle and the Householder vectors below it, as in
+ * LAPACK's geqrf. solve() returns the least-squares solution of A * x = b.
+ *
+ * @tparam T The element type (floating point).
+ * @tparam Rows The number of rows.
+ * @tparam Cols The number of columns (at most Rows).
+ */
+template<typename T, std::size_t Rows, std::size_t Cols>
+class QrN {
+    static_assert(std::is_floating_point_v<T>, "QrN requires a floating-point element type");
+    static_assert(Cols > 0 && Rows >= Cols, "QrN requires at least as many rows as columns");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Factorizes a matrix.
+     *
+     * @param matrix The matrix to factorize.
+     */
+    explicit QrN(const MatrixND<T, Rows, Cols>& matrix)
+        : m_qr(matrix) {
+        T* a = m_qr.data();
+
+        T maxAbs{};
+        for (size_type i = 0; i < Rows * Cols; ++i) {
+            maxAbs = std::max(maxAbs, std::abs(a[i]));
+        }
+        m_tolerance = maxAbs * static_cast<T>(Rows) * std::numeric_limits<T>::epsilon();
+
+        for (size_type k = 0; k < Cols; ++k) {
+            const T alpha = a[k * Cols + k];
+            T tailNorm{};
+            for (size_type i = k + 1; i < Rows; ++i) {
+                tailNorm += a[i * Cols + k] * a[i * Cols + k];
+            }
+
+            if (tailNorm == T{}) {
+                m_tau[k] = T{};
+                continue;
+            }
+
+            const T beta = alpha >= T{} ? -std::sqrt(alpha * alpha + tailNorm) : std::sqrt(alpha * alpha + tailNorm);
+            m_tau[k] = (beta - alpha) / beta;
+            const T scale = T{ 1 } / (alpha - beta);
+            for (size_type i = k + 1; i < Rows; ++i) {
+                a[i * Cols + k] *= scale;
+            }
+            a[k * Cols + k] = beta;
+
+            applyReflector<Cols>(k, a + k * Cols + k + 1, Cols - k - 1, Cols);
+        }
+
+        m_fullRank = true;
+        for (size_type i = 0; i < Cols; ++i) {
+            const T diagonal = a[i * Cols + i];
+            m_fullRank = m_fullRank && std::abs(diagonal) > m_tolerance;
+            m_invDiagonal[i] = diagonal != T{} ? T{ 1 } / diagonal : T{};
+        }
+    }
+
+    /**
+     * @brief Returns the least-squares solution of A * x = b.
+     *
+     * @param b The right-hand side.
+     * @return The vector x minimizing the norm of A * x - b.
+     * @throws std::runtime_error if A is rank deficient.
+     */
+    VectorND<T, Cols> solve(const VectorND<T, Rows>& b) const {
+        VectorND<T, Rows> y(b);
+        for (size_type k = 0; k < Cols; ++k) {
+            applyReflector<1>(k, y.data() + k, 1, 1);
+        }
+        VectorND<T, Cols> x;
+        std::copy(y.data(), y.data() + Cols, x.data());
+        checkRank();
+        TriangularSolveN<T>::template upper<Cols, 1>(m_qr.data(), Cols, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Returns the least-squares solution of A * X = B for K right-hand sides.
+     *
+     * @param b The right-hand sides, one per column.
+     * @return The matrix X minimizing the Frobenius norm of A * X - B.
+     * @throws std::runtime_error if A is rank deficient.
+     */
+    template<std::size_t K>
+    MatrixND<T, Cols, K> solve(const MatrixND<T, Rows, K>& b) const {
+        MatrixND<T, Rows, K> y(b);
+        for (size_type k = 0; k < Cols; ++k) {
+            applyReflector<K>(k, y.data() + k * K, K, K);
+        }
+        MatrixND<T, Cols, K> x;
+        std::copy(y.data(), y.data() + Cols * K, x.data());
+        checkRank();
+        TriangularSolveN<T>::template upper<Cols, K>(m_qr.data(), Cols, x.data(), m_invDiagonal.data());
+        return x;
+    }
+
+    /**
+     * @brief Returns the upper triangular factor R.
+     */
+    MatrixND<T, Cols, Cols> matrixR() const {
+        MatrixND<T, Cols, Cols> r;
+        for (size_type i = 0; i < Cols; ++i) {
+            for (size_type j = i; j < Cols; ++j) {
+                r.coeffRef(i, j) = m_qr.coeff(i, j);
+            }
+        }
+        return r;
+    }
+
+    /**
+     * @brief Returns the thin orthonormal factor Q (Rows x Cols).
+     */
+    MatrixND<T, Rows, Cols> matrixQ() const {
+        MatrixND<T, Rows, Cols> q;
+        for (size_type i = 0; i < Cols; ++i) {
+            q.coeffRef(i, i) = T{ 1 };
+        }
+        for (size_type k = Cols; k-- > 0;) {
+            applyReflector<Cols>(k, q.data() + k * Cols + k, Cols - k, Cols);
+        }
+        return q;
+    }
+
+    /**
+     * @brief Returns whether every diagonal coefficient of R is above the rank tolerance.
+     */
+    bool isFullRank() const {
+        return m_fullRank;
+    }
+
+private:
+    /**
+     * @brief Applies H_k = I - tau_k * v * transpose(v) to rows [k, Rows) of a row-major block.
+     *
+     * @tparam MaxWidth Upper bound of width, sizing the scratch row.
+     * @param k The reflector index; v is (1, m_qr[k+1..Rows-1][k]).
+     * @param first Pointer to the coefficient of row k, first column of the block.
+     * @param width Number of columns of the block.
+     * @param ld Leading dimension of the block.
+     */
+    template<std::size_t MaxWidth>
+    void applyReflector(size_type k, T* first, size_type width, size_type ld) const {
+        const T tau = m_tau[k];
+        if (tau == T{} || width == 0)
+            return;
+
+        const T* v = m_qr.data();
+        T dot[MaxWidth];
+
+        for (size_type j = 0; j < width; ++j) {
+            dot[j] = first[j];
+        }
+        for (size_type i = k + 1; i < Rows; ++i) {
+            const T vi = v[i * Cols + k];
+            const T* row = first + (i - k) * ld;
+            for (size_type j = 0; j < width; ++j) {
+                dot[j] += vi * row[j];
+            }
+        }
+        for (size_type j = 0; j < width; ++j) {
+            dot[j] *= tau;
+            first[j] -= dot[j];
+        }
+        for (size_type i = k + 1; i < Rows; ++i) {
+            const T vi = v[i * Cols + k];
+            T* row = first + (i - k) * ld;
+            for (size_type j = 0; j < width; ++j) {
+                row[j] -= vi * dot[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Throws if R is singular to working precision.
+     */
+    void checkRank() const {
+        if (!isFullRank())
+            throw std::runtime_error("QrN: matrix is rank deficient");
+    }
+
+    MatrixND<T, Rows, Cols> m_qr; ///< R and the Householder vectors.
+    ArrayN<T, Cols> m_tau;        ///< Householder coefficients.
+    ArrayN<T, Cols> m_invDiagonal; ///< Reciprocals of the diagonal of R.
+    T m_tolerance;                ///< Diagonal coefficients of R at or below this magnitude are treated as zero.
+    bool m_fullRank;              ///< Whether every diagonal coefficient of R is above m_tolerance.
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+
+/**
+ * @file ExpressionN.h
+ * @brief Concepts shared by the fixed-size matrices, vectors and their lazy expressions.
+ *
+ * A matrix expression exposes its compile-time shape and an unchecked coeff(row, col);
+ * a vector expression exposes its compile-time size and an unchecked coeff(index).
+ * MatrixND and VectorND model these concepts and can be built from any expression
+ * that does, which is how MatrixExprN.h evaluates a whole expression in one pass.
+ */
+
+/**
+ * @brief A type usable as a lazily evaluated matrix of compile-time shape.
+ */
+template<typename E>
+concept MatrixExpressionN = requires(const E& e, std::size_t i)
+{
+    typename E::value_type;
+    { E::RowsAtCompileTime } -> std::convertible_to<std::size_t>;
+    { E::ColsAtCompileTime } -> std::convertible_to<std::size_t>;
+    { e.coeff(i, i) } -> std::convertible_to<typename E::value_type>;
+};
+
+/**
+ * @brief A type usable as a lazily evaluated vector of compile-time size.
+ */
+template<typename E>
+concept VectorExpressionN = requires(const E& e, std::size_t i)
+{
+    typename E::value_type;
+    { E::SizeAtCompileTime } -> std::convertible_to<std::size_t>;
+    { e.coeff(i) } -> std::convertible_to<typename E::value_type>;
+};
@@ -0,0 +1,402 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include "AlignedAllocatorN.h"
+#include "SimdN.h"
+#include "ThreadPoolN.h"
+
+/**
+ * @brief Cache-blocked general matrix multiply on raw row-major storage.
+ *
+ * Computes C = A * B where A is m x k, B is k x n and C is m x n, each with its
+ * own leading dimension (distance in elements between two consecutive rows).
+ * The loops follow the usual GotoBLAS structure: a KC x NC panel of B and an
+ * MC x KC block of A are packed into contiguous micro-panels, then an
+ * MR x NR register-blocked micro-kernel accumulates one tile of C at a time.
+ * float and double use AVX2/FMA micro-kernels when CONTAINERS_HAS_AVX2 is
+ * defined; every other case uses a portable kernel the compiler can vectorize.
+ *
+ * @tparam T Arithmetic type of the elements.
+ */
+template<typename T>
+class GemmN
+{
+    static_assert(std::is_arithmetic_v<T>, "GemmN requires an arithmetic element type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+#if defined(CONTAINERS_HAS_AVX2)
+    static constexpr bool UsesAvx2 = std::is_same_v<T, float> || std::is_same_v<T, double>; ///< Whether the AVX2 micro-kernel is used.
+#else
+    static constexpr bool UsesAvx2 = false; ///< Whether the AVX2 micro-kernel is used.
+#endif
+
+    static constexpr size_type MR = UsesAvx2 ? 6 : 4;                                                  ///< Rows of the micro-kernel tile.
+    static constexpr size_type NR = UsesAvx2 ? (std::is_same_v<T, float> ? 16 : 8) : 8;               ///< Columns of the micro-kernel tile.
+    static constexpr size_type MC = MR * 16;                                                           ///< Rows of a packed block of A.
+    static constexpr size_type KC = 256;                                                               ///< Depth of the packed panels.
+    static constexpr size_type NC = NR * 128;                                                          ///< Columns of a packed panel of B.
+
+    /**
+     * @brief Computes C = A * B.
+     *
+     * @param m Number of rows of A and C.
+     * @param n Number of columns of B and C.
+     * @param k Number of columns of A and rows of B.
+     * @param a Pointer to the first element of A.
+     * @param lda Leading dimension of A.
+     * @param b Pointer to the first element of B.
+     * @param ldb Leading dimension of B.
+     * @param c Pointer to the first element of C. Must not overlap A or B.
+     * @param ldc Leading dimension of C.
+     */
+    static void multiply(size_type m, size_type n, size_type k,
+        const T* a, size_type lda, const T* b, size_type ldb, T* c, size_type ldc)
+    {
+        if (m == 0 || n == 0)
+            return;
+
+        if (k == 0)
+        {
+            for (size_type i = 0; i < m; ++i)
+                std::fill(c + i * ldc, c + i * ldc + n, T{});
+            return;
+        }
+
+        T* packedA = buffer(PackA, MC * KC);
+        T* packedB = buffer(PackB, std::min(KC, k) * roundUp(std::min(NC, n), NR));
+
+        for (size_type jc = 0; jc < n; jc += NC)
+        {
+            const size_type nc = std::min(NC, n - jc);
+            for (size_type pc = 0; pc < k; pc += KC)
+            {
+                const size_type kc = std::min(KC, k - pc);
+                const bool accumulate = pc != 0;
+                packPanelB(kc, nc, b + pc * ldb + jc, ldb, packedB);
+
+                for (size_type ic = 0; ic < m; ic += MC)
+                {
+                    const size_type mc = std::min(MC, m - ic);
+                    packBlockA(mc, kc, a + ic * lda + pc, lda, packedA);
+
+                    for (size_type jr = 0; jr < nc; jr += NR)
+                    {
+                        const size_type nr = std::min(NR, nc - jr);
+                        for (size_type ir = 0; ir < mc; ir += MR)
+                        {
+                            const size_type mr = std::min(MR, mc - ir);
+                            T* tile = c + (ic + ir) * ldc + jc + jr;
+                            if (mr == MR && nr == NR)
+                            {
+                                microKernel(kc, packedA + ir * kc, packedB + jr * kc, tile, ldc, accumulate);
+                            }
+                            else
+                            {
+                                T edge[MR * NR];
+                                microKernel(kc, packedA + ir * kc, packedB + jr * kc, edge, NR, false);
+                                for (size_type i = 0; i < mr; ++i)
+                                {
+                                    for (size_type j = 0; j < nr; ++j)
+                                    {
+                                        if (accumulate)
+                                            tile[i * ldc + j] += edge[i * NR + j];
+                                        else
+                                            tile[i * ldc + j] = edge[i * NR + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Computes C = A * B on a thread pool.
+     *
+     * C is partitioned into tiles of ParallelTileRows x ParallelTileCols; every
+     * tile is an independent call to the serial kernel, scheduled on the pool.
+     * Products smaller than ParallelThreshold multiply-adds run on the calling thread.
+     *
+     * @param pool Pool executing the tiles.
+     * @param m Number of rows of A and C.
+     * @param n Number of columns of B and C.
+     * @param k Number of columns of A and rows of B.
+     * @param a Pointer to the first element of A.
+     * @param lda Leading dimension of A.
+     * @param b Pointer to the first element of B.
+     * @param ldb Leading dimension of B.
+     * @param c Pointer to the first element of C. Must not overlap A or B.
+     * @param ldc Leading dimension of C.
+     */
+    static void multiply(ThreadPoolN& pool, size_type m, size_type n, size_type k,
+        const T* a, size_type lda, const T* b, size_type ldb, T* c, size_type ldc)
+    {
+        if (m * n * k < ParallelThreshold)
+        {
+            multiply(m, n, k, a, lda, b, ldb, c, ldc);
+            return;
+        }
+
+        const size_type tileRows = (m + ParallelTileRows - 1) / ParallelTileRows;
+        const size_type tileCols = (n + ParallelTileCols - 1) / ParallelTileCols;
+        pool.parallel_for(0, tileRows * tileCols, 1, [=](size_type first, size_type last)
+        {
+            for (size_type tile = first; tile < last; ++tile)
+            {
+                const size_type i0 = (tile / tileCols) * ParallelTileRows;
+                const size_type j0 = (tile % tileCols) * ParallelTileCols;
+                multiply(std::min(ParallelTileRows, m - i0), std::min(ParallelTileCols, n - j0), k,
+                    a + i0 * lda, lda, b + j0, ldb, c + i0 * ldc + j0, ldc);
+            }
+        });
+    }
+
+    static constexpr size_type ParallelThreshold = 96 * 96 * 96; ///< Minimum m * n * k scheduled on the pool.
+    static constexpr size_type ParallelTileRows = MC;            ///< Rows of a parallel tile of C.
+    static constexpr size_type ParallelTileCols = NR * 16;       ///< Columns of a parallel tile of C.
+
+private:
+    static constexpr int PackA = 0; ///< Slot of the packing buffer of A.
+    static constexpr int PackB = 1; ///< Slot of the packing buffer of B.
+
+    /**
+     * @brief Rounds a value up to a multiple of step.
+     */
+    static constexpr size_type roundUp(size_type value, size_type step)
+    {
+        return (value + step - 1) / step * step;
+    }
+
+    /**
+     * @brief Returns a thread-local, 64-byte aligned packing buffer of at least count elements.
+     *
+     * @param slot Which of the two buffers to return.
+     * @param count Minimum number of elements.
+     * @return Pointer to the buffer, valid until the next call with the same slot on this thread.
+     */
+    static T* buffer(int slot, size_type count)
+    {
+        struct Buffer
+        {
+            T* data = nullptr;
+            size_type capacity = 0;
+            ~Buffer()
+            {
+                if (data)
+                    AlignedAllocatorN<T>().deallocate(data, capacity);
+            }
+        };
+        static thread_local Buffer buffers[2];
+
+        Buffer& buf = buffers[slot];
+        if (buf.capacity < count)
+        {
+            AlignedAllocatorN<T> allocator;
+            if (buf.data)
+                allocator.deallocate(buf.data, buf.capacity);
+            buf.data = nullptr;
+            buf.capacity = 0;
+            buf.data = allocator.allocate(count);
+            buf.capacity = count;
+        }
+        return buf.data;
+    }
+
+    /**
+     * @brief Packs an mc x kc block of A into micro-panels of MR rows.
+     *
+     * Inside a micro-panel, the MR values of one column are contiguous. Missing
+     * rows of the last micro-panel are padded with zeros.
+     */
+    static void packBlockA(size_type mc, size_type kc, const T* a, size_type lda, T* dst)
+    {
+        for (size_type ir = 0; ir < mc; ir += MR)
+        {
+            const size_type mr = std::min(MR, mc - ir);
+            for (size_type p = 0; p < kc; ++p)
+            {
+                for (size_type i = 0; i < mr; ++i)
+                    dst[i] = a[(ir + i) * lda + p];
+                for (size_type i = mr; i < MR; ++i)
+                    dst[i] = T{};
+                dst += MR;
+            }
+        }
+    }
+
+    /**
+     * @brief Packs a kc x nc panel of B into micro-panels of NR columns.
+     *
+     * Inside a micro-panel, the NR values of one row are contiguous. Missing
+     * columns of the last micro-panel are padded with zeros.
+     */
+    static void packPanelB(size_type kc, size_type nc, const T* b, size_type ldb, T* dst)
+    {
+        for (size_type jr = 0; jr < nc; jr += NR)
+        {
+            const size_type nr = std::min(NR, nc - jr);
+            for (size_type p = 0; p < kc; ++p)
+            {
+                const T* row = b + p * ldb + jr;
+                for (size_type j = 0; j < nr; ++j)
+                    dst[j] = row[j];
+                for (size_type j = nr; j < NR; ++j)
+                    dst[j] = T{};
+                dst += NR;
+            }
+        }
+    }
+
+    /**
+     * @brief Computes one MR x NR tile of C from packed micro-panels.
+     *
+     * @param kc Depth of the micro-panels.
+     * @param a Packed micro-panel of A.
+     * @param b Packed micro-panel of B.
+     * @param c Top-left element of the tile.
+     * @param ldc Leading dimension of the tile.
+     * @param accumulate Whether the product is added to the tile instead of overwriting it.
+     */
+    static void microKernel(size_type kc, const T* a, const T* b, T* c, size_type ldc, bool accumulate)
+    {
+#if defined(CONTAINERS_HAS_AVX2)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            microKernelAvx2Float(kc, a, b, c, ldc, accumulate);
+            return;
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            microKernelAvx2Double(kc, a, b, c, ldc, accumulate);
+            return;
+        }
+        else
+#endif
+        {
+            T acc[MR][NR] = {};
+            for (size_type p = 0; p < kc; ++p)
+            {
+                for (size_type i = 0; i < MR; ++i)
+                {
+                    const T ai = a[p * MR + i];
+                    for (size_type j = 0; j < NR; ++j)
+                        acc[i][j] += ai * b[p * NR + j];
+                }
+            }
+            for (size_type i = 0; i < MR; ++i)
+            {
+                for (size_type j = 0; j < NR; ++j)
+                {
+                    if (accumulate)
+                        c[i * ldc + j] += acc[i][j];
+                    else
+                        c[i * ldc + j] = acc[i][j];
+                }
+            }
+        }
+    }
+
+#if defined(CONTAINERS_HAS_AVX2)
+    /**
+     * @brief 6 x 16 float micro-kernel using twelve AVX accumulators.
+     */
+    static void microKernelAvx2Float(size_type kc, const float* a, const float* b, float* c, size_type ldc, bool accumulate)
+    {
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+        __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+        for (size_type p = 0; p < kc; ++p)
+        {
+            const __m256 b0 = _mm256_load_ps(b);
+            const __m256 b1 = _mm256_load_ps(b + 8);
+            __m256 ai = _mm256_broadcast_ss(a + 0);
+            c00 = _mm256_fmadd_ps(ai, b0, c00); c01 = _mm256_fmadd_ps(ai, b1, c01);
+            ai = _mm256_broadcast_ss(a + 1);
+            c10 = _mm256_fmadd_ps(ai, b0, c10); c11 = _mm256_fmadd_ps(ai, b1, c11);
+            ai = _mm256_broadcast_ss(a + 2);
+            c20 = _mm256_fmadd_ps(ai, b0, c20); c21 = _mm256_fmadd_ps(ai, b1, c21);
+            ai = _mm256_broadcast_ss(a + 3);
+            c30 = _mm256_fmadd_ps(ai, b0, c30); c31 = _mm256_fmadd_ps(ai, b1, c31);
+            ai = _mm256_broadcast_ss(a + 4);
+            c40 = _mm256_fmadd_ps(ai, b0, c40); c41 = _mm256_fmadd_ps(ai, b1, c41);
+            ai = _mm256_broadcast_ss(a + 5);
+            c50 = _mm256_fmadd_ps(ai, b0, c50); c51 = _mm256_fmadd_ps(ai, b1, c51);
+            a += 6;
+            b += 16;
+        }
+
+        const __m256 rows[6][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 }, { c40, c41 }, { c50, c51 } };
+        for (size_type i = 0; i < 6; ++i)
+        {
+            float* row = c + i * ldc;
+            __m256 r0 = rows[i][0];
+            __m256 r1 = rows[i][1];
+            if (accumulate)
+            {
+                r0 = _mm256_add_ps(r0, _mm256_loadu_ps(row));
+                r1 = _mm256_add_ps(r1, _mm256_loadu_ps(row + 8));
+            }
+            _mm256_storeu_ps(row, r0);
+            _mm256_storeu_ps(row + 8, r1);
+        }
+    }
+
+    /**
+     * @brief 6 x 8 double micro-kernel using twelve AVX accumulators.
+     */
+    static void microKernelAvx2Double(size_type kc, const double* a, const double* b, double* c, size_type ldc, bool accumulate)
+    {
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+        __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+        __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+        __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+        for (size_type p = 0; p < kc; ++p)
+        {
+            const __m256d b0 = _mm256_load_pd(b);
+            const __m256d b1 = _mm256_load_pd(b + 4);
+            __m256d ai = _mm256_broadcast_sd(a + 0);
+            c00 = _mm256_fmadd_pd(ai, b0, c00); c01 = _mm256_fmadd_pd(ai, b1, c01);
+            ai = _mm256_broadcast_sd(a + 1);
+            c10 = _mm256_fmadd_pd(ai, b0, c10); c11 = _mm256_fmadd_pd(ai, b1, c11);
+            ai = _mm256_broadcast_sd(a + 2);
+            c20 = _mm256_fmadd_pd(ai, b0, c20); c21 = _mm256_fmadd_pd(ai, b1, c21);
+            ai = _mm256_broadcast_sd(a + 3);
+            c30 = _mm256_fmadd_pd(ai, b0, c30); c31 = _mm256_fmadd_pd(ai, b1, c31);
+            ai = _mm256_broadcast_sd(a + 4);
+            c40 = _mm256_fmadd_pd(ai, b0, c40); c41 = _mm256_fmadd_pd(ai, b1, c41);
+            ai = _mm256_broadcast_sd(a + 5);
+            c50 = _mm256_fmadd_pd(ai, b0, c50); c51 = _mm256_fmadd_pd(ai, b1, c51);
+            a += 6;
+            b += 8;
+        }
+
+        const __m256d rows[6][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 }, { c40, c41 }, { c50, c51 } };
+        for (size_type i = 0; i < 6; ++i)
+        {
+            double* row = c + i * ldc;
+            __m256d r0 = rows[i][0];
+            __m256d r1 = rows[i][1];
+            if (accumulate)
+            {
+                r0 = _mm256_add_pd(r0, _mm256_loadu_pd(row));
+                r1 = _mm256_add_pd(r1, _mm256_loadu_pd(row + 4));
+            }
+            _mm256_storeu_pd(row, r0);
+            _mm256_storeu_pd(row + 4, r1);
+        }
+    }
+#endif
+};
@@ -0,0 +1,268 @@
+#pragma once
+#include <concepts>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "HashTableN.h"
+
+/**
+ * @brief HashTableN policy storing key/value pairs.
+ */
+template<typename K, typename V>
+struct HashMapPolicyN
+{
+    using key_type = K;
+    using value_type = std::pair<const K, V>;
+
+    static const K& key(const value_type& value)
+    {
+        return value.first;
+    }
+};
+
+/**
+ * @class HashMapN
+ * @brief Unordered map with flat open addressing (Swiss table, see HashTableN).
+ *
+ * Interface close to std::unordered_map, with these differences: rehashing
+ * invalidates references to the elements, there is no bucket interface, and
+ * the default hasher/equality are transparent for std::string keys
+ * (HashN, std::equal_to<>), so find("literal") allocates nothing.
+ *
+ * @tparam K Key type.
+ * @tparam V Mapped type.
+ * @tparam Hash Hash function object.
+ * @tparam KeyEqual Equality function object.
+ * @tparam Allocator Allocator of std::pair<const K, V>.
+ */
+template<typename K, typename V, typename Hash = HashN<K>, typename KeyEqual = std::equal_to<>,
+    typename Allocator = std::allocator<std::pair<const K, V>>>
+class HashMapN : public HashTableN<HashMapPolicyN<K, V>, Hash, KeyEqual, Allocator>
+{
+    using Base = HashTableN<HashMapPolicyN<K, V>, Hash, KeyEqual, Allocator>;
+
+public:
+    using mapped_type = V;
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    /**
+     * @brief Constructs an empty map.
+     */
+    HashMapN() : Base() {}
+
+    /**
+     * @brief Constructs an empty map with room for capacity elements.
+     */
+    explicit HashMapN(size_type capacity, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+        const Allocator& alloc = Allocator())
+        : Base(capacity, hash, equal, alloc)
+    {
+    }
+
+    /**
+     * @brief Constructs an empty map using the given allocator.
+     */
+    explicit HashMapN(const Allocator& alloc) : Base(0, Hash(), KeyEqual(), alloc) {}
+
+    /**
+     * @brief Constructs a map from an initializer list; later duplicates are ignored.
+     */
+    HashMapN(std::initializer_list<value_type> init, const Allocator& alloc = Allocator())
+        : Base(init.size(), Hash(), KeyEqual(), alloc)
+    {
+        for (const value_type& value : init)
+            insert(value);
+    }
+
+    /**
+     * @brief Inserts a copy of value if its key is absent.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return this->findOrEmplace(value.first, value);
+    }
+
+    /**
+     * @brief Moves value in if its key is absent.
+     */
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return this->findOrEmplace(value.first, std::move(value));
+    }
+
+    /**
+     * @brief Inserts every element of [first, last) whose key is absent.
+     */
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            insert(value_type(*first));
+    }
+
+    /**
+     * @brief Constructs the mapped value from args if key is absent; does nothing otherwise.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    {
+        return this->findOrEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+    {
+        return this->findOrEmplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Constructs a value_type from args, as std::unordered_map::emplace, and inserts it if its key is absent.
+     *
+     * emplace(key, mapped) and emplace(std::piecewise_construct, key tuple,
+     * mapped tuple) with a key_type as the single key argument look the key
+     * up first and build nothing when it is present. Other forms (a pair,
+     * a key convertible to key_type, ...) build the pair first.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return this->findOrEmplace(value.first, std::move(value));
+    }
+
+    template<typename KeyArg, typename M>
+        requires std::same_as<std::remove_cvref_t<KeyArg>, key_type>
+    std::pair<iterator, bool> emplace(KeyArg&& key, M&& value)
+    {
+        return try_emplace(std::forward<KeyArg>(key), std::forward<M>(value));
+    }
+
+    template<typename KeyTuple, typename MappedTuple>
+        requires (std::tuple_size_v<std::remove_cvref_t<KeyTuple>> == 1
+            && std::same_as<std::remove_cvref_t<std::tuple_element_t<0, std::remove_cvref_t<KeyTuple>>>, key_type>)
+    std::pair<iterator, bool> emplace(std::piecewise_construct_t, KeyTuple&& key, MappedTuple&& mapped)
+    {
+        return this->findOrEmplace(std::get<0>(key), std::piecewise_construct, std::forward<KeyTuple>(key),
+            std::forward<MappedTuple>(mapped));
+    }
+
+    /**
+     * @brief Inserts the pair, or assigns value to the existing element with the key.
+     *
+     * @return Iterator to the element, and whether it was inserted.
+     */
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value)
+    {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second)
+            result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value)
+    {
+        auto result = try_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second)
+            result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    /**
+     * @brief Returns the value mapped to key, inserting a value-initialized one if absent.
+     */
+    V& operator[](const key_type& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    V& operator[](key_type&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * @brief Returns the value mapped to key.
+     *
+     * @throws std::out_of_range if the key is absent.
+     */
+    V& at(const key_type& key)
+    {
+        return checked(this->find(key))->second;
+    }
+
+    const V& at(const key_type& key) const
+    {
+        return checked(this->find(key))->second;
+    }
+
+    /**
+     * @brief Heterogeneous at, available when Hash and KeyEqual are transparent.
+     */
+    template<typename Q>
+        requires Base::isTransparent
+    V& at(const Q& key)
+    {
+        return checked(this->find(key))->second;
+    }
+
+    template<typename Q>
+        requires Base::isTransparent
+    const V& at(const Q& key) const
+    {
+        return checked(this->find(key))->second;
+    }
+
+private:
+    template<typename It>
+    It checked(It it) const
+    {
+        if (const_iterator(it) == this->cend())
+            throw std::out_of_range("HashMapN::at: key not found");
+        return it;
+    }
+};
+
+/**
+ * @brief Two maps are equal when they hold the same keys mapped to equal values.
+ */
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+bool operator==(const HashMapN<K, V, Hash, KeyEqual, Allocator>& a, const HashMapN<K, V, Hash, KeyEqual, Allocator>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (const auto& [key, value] : a)
+    {
+        auto it = b.find(key);
+        if (it == b.end() || !(it->second == value))
+            return false;
+    }
+    return true;
+}
+
+namespace pmr
+{
+/**
+ * @brief HashMapN whose table allocates from a std::pmr::memory_resource.
+ */
+template<typename K, typename V, typename Hash = HashN<K>, typename KeyEqual = std::equal_to<>>
+using HashMapN = ::HashMapN<K, V, Hash, KeyEqual, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+}
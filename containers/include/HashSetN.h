@@ -0,0 +1,192 @@
+#pragma once
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include "HashTableN.h"
+
+/**
+ * @brief HashTableN policy storing bare keys.
+ */
+template<typename K>
+struct HashSetPolicyN
+{
+    using key_type = K;
+    using value_type = K;
+
+    static const K& key(const value_type& value)
+    {
+        return value;
+    }
+};
+
+/**
+ * @class HashSetN
+ * @brief Unordered set with flat open addressing (Swiss table, see HashTableN).
+ *
+ * Interface close to std::unordered_set; the same differences as HashMapN
+ * apply. Elements are only reachable through const references.
+ *
+ * @tparam K Key type.
+ * @tparam Hash Hash function object.
+ * @tparam KeyEqual Equality function object.
+ * @tparam Allocator Allocator of K.
+ */
+template<typename K, typename Hash = HashN<K>, typename KeyEqual = std::equal_to<>, typename Allocator = std::allocator<K>>
+class HashSetN : public HashTableN<HashSetPolicyN<K>, Hash, KeyEqual, Allocator>
+{
+    using Base = HashTableN<HashSetPolicyN<K>, Hash, KeyEqual, Allocator>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /**
+     * @brief Constructs an empty set.
+     */
+    HashSetN() : Base() {}
+
+    /**
+     * @brief Constructs an empty set with room for capacity elements.
+     */
+    explicit HashSetN(size_type capacity, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+        const Allocator& alloc = Allocator())
+        : Base(capacity, hash, equal, alloc)
+    {
+    }
+
+    /**
+     * @brief Constructs an empty set using the given allocator.
+     */
+    explicit HashSetN(const Allocator& alloc) : Base(0, Hash(), KeyEqual(), alloc) {}
+
+    /**
+     * @brief Constructs a set from an initializer list.
+     */
+    HashSetN(std::initializer_list<K> init, const Allocator& alloc = Allocator())
+        : Base(init.size(), Hash(), KeyEqual(), alloc)
+    {
+        for (const K& key : init)
+            insert(key);
+    }
+
+    const_iterator begin() const
+    {
+        return Base::begin();
+    }
+
+    const_iterator end() const
+    {
+        return Base::end();
+    }
+
+    /**
+     * @brief Finds key; the element cannot be modified through the iterator.
+     */
+    const_iterator find(const key_type& key) const
+    {
+        return Base::find(key);
+    }
+
+    template<typename Q>
+        requires Base::isTransparent
+    const_iterator find(const Q& key) const
+    {
+        return Base::find(key);
+    }
+
+    /**
+     * @brief Inserts a copy of key if absent.
+     *
+     * @return Iterator to the element, and whether it was inserted.
+     */
+    std::pair<const_iterator, bool> insert(const K& key)
+    {
+        auto result = this->findOrEmplace(key, key);
+        return { result.first, result.second };
+    }
+
+    /**
+     * @brief Moves key in if absent.
+     */
+    std::pair<const_iterator, bool> insert(K&& key)
+    {
+        auto result = this->findOrEmplace(key, std::move(key));
+        return { result.first, result.second };
+    }
+
+    /**
+     * @brief Inserts every element of [first, last) not already present.
+     */
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            insert(K(*first));
+    }
+
+    /**
+     * @brief Constructs a key from args and inserts it if absent.
+     */
+    template<typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args)
+    {
+        return insert(K(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Removes the element at pos.
+     *
+     * @return Iterator to the following element.
+     */
+    const_iterator erase(const_iterator pos)
+    {
+        return Base::erase(pos);
+    }
+
+    /**
+     * @brief Removes key if present.
+     *
+     * @return Number of elements removed (0 or 1).
+     */
+    size_type erase(const key_type& key)
+    {
+        return Base::erase(key);
+    }
+
+    template<typename Q>
+        requires (Base::isTransparent && !std::is_convertible_v<const Q&, const_iterator>)
+    size_type erase(const Q& key)
+    {
+        return Base::erase(key);
+    }
+};
+
+/**
+ * @brief Two sets are equal when they hold the same keys.
+ */
+template<typename K, typename Hash, typename KeyEqual, typename Allocator>
+bool operator==(const HashSetN<K, Hash, KeyEqual, Allocator>& a, const HashSetN<K, Hash, KeyEqual, Allocator>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (const K& key : a)
+    {
+        if (!b.contains(key))
+            return false;
+    }
+    return true;
+}
+
+namespace pmr
+{
+/**
+ * @brief HashSetN whose table allocates from a std::pmr::memory_resource.
+ */
+template<typename K, typename Hash = HashN<K>, typename KeyEqual = std::equal_to<>>
+using HashSetN = ::HashSetN<K, Hash, KeyEqual, std::pmr::polymorphic_allocator<K>>;
+}
@@ -0,0 +1,932 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "SimdN.h"
+
+/**
+ * @brief Default hasher of HashMapN and HashSetN: std::hash, made transparent for strings.
+ *
+ * HashN<std::string> accepts std::string_view and C strings as well, so that
+ * maps keyed by std::string can be searched without building a std::string.
+ */
+template<typename T>
+struct HashN : std::hash<T>
+{
+};
+
+/**
+ * @brief Transparent string hasher.
+ */
+template<>
+struct HashN<std::string>
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view text) const noexcept
+    {
+        return std::hash<std::string_view>{}(text);
+    }
+};
+
+/**
+ * @class ControlGroupN
+ * @brief Sixteen control bytes of a HashTableN, compared in parallel.
+ *
+ * A control byte is Empty, Deleted, the Sentinel ending the table, or the 7
+ * low bits (H2) of the hash of a stored key. One SSE2 compare matches a byte
+ * against the whole group; without SSE2 the same bit masks are built by a
+ * plain loop.
+ */
+class ControlGroupN
+{
+public:
+    using ctrl_t = std::int8_t;
+
+    static constexpr std::size_t Width = 16;  ///< Control bytes per group.
+    static constexpr ctrl_t Empty = -128;     ///< Free slot that ends probe sequences.
+    static constexpr ctrl_t Deleted = -2;     ///< Free slot that probe sequences must skip (tombstone).
+    static constexpr ctrl_t Sentinel = -1;    ///< Byte after the last slot, stops iteration.
+
+    /**
+     * @brief Loads Width control bytes starting at pos (unaligned).
+     */
+    explicit ControlGroupN(const ctrl_t* pos)
+    {
+#if defined(CONTAINERS_HAS_SSE2)
+        m_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+#else
+        std::memcpy(m_bytes, pos, Width);
+#endif
+    }
+
+    /**
+     * @brief Bit i is set when byte i equals h2.
+     */
+    std::uint32_t match(ctrl_t h2) const
+    {
+#if defined(CONTAINERS_HAS_SSE2)
+        return std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_bytes)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < Width; ++i)
+            mask |= std::uint32_t(m_bytes[i] == h2) << i;
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Bit i is set when byte i is Empty.
+     */
+    std::uint32_t matchEmpty() const
+    {
+        return match(Empty);
+    }
+
+    /**
+     * @brief Bit i is set when byte i is Empty or Deleted.
+     */
+    std::uint32_t matchEmptyOrDeleted() const
+    {
+#if defined(CONTAINERS_HAS_SSE2)
+        return std::uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), m_bytes)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < Width; ++i)
+            mask |= std::uint32_t(m_bytes[i] < Sentinel) << i;
+        return mask;
+#endif
+    }
+
+private:
+#if defined(CONTAINERS_HAS_SSE2)
+    __m128i m_bytes; ///< The control bytes.
+#else
+    ctrl_t m_bytes[Width]; ///< The control bytes.
+#endif
+};
+
+/**
+ * @class HashTableN
+ * @brief Open-addressing hash table in the Swiss table layout, shared by HashMapN and HashSetN.
+ *
+ * Elements live in one flat slot array; a parallel array of control bytes
+ * holds 7 bits of each element's hash. A lookup hashes once, then scans the
+ * control bytes a ControlGroupN at a time, comparing keys only for slots whose
+ * bits match, and stops at the first group containing an Empty byte. Groups
+ * are probed quadratically.
+ *
+ * The capacity is 2^k - 1 slots (at least 15) and the table grows by
+ * doubling when it would become more than 7/8 full. The control array ends
+ * with a Sentinel and a copy of its first 15 bytes, so that a group can be
+ * loaded at any slot without wrapping.
+ *
+ * Erasing leaves the slot Empty when no probe sequence can have crossed it
+ * (its surrounding window of Width bytes still has an Empty byte), and a
+ * Deleted tombstone otherwise; tombstones are purged by rehashing in place
+ * when they, rather than elements, fill the table.
+ *
+ * Rehashing moves the elements: it invalidates iterators, pointers and
+ * references. Erasing invalidates only the erased element.
+ *
+ * Hashes are remixed with a multiplicative hash, so identity hashes such as
+ * std::hash<int> spread over the table. When both Hash and KeyEqual define
+ * is_transparent, lookups accept any type they can hash and compare to a key.
+ *
+ * @tparam Policy Provides key_type, value_type and static key(const value_type&).
+ * @tparam Hash Hash function object.
+ * @tparam KeyEqual Equality function object.
+ * @tparam Allocator Allocator of value_type, rebound for the control bytes.
+ */
+template<typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+class HashTableN
+{
+    using ctrl_t = ControlGroupN::ctrl_t;
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<typename Policy::value_type>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using ControlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+    using ControlTraits = std::allocator_traits<ControlAllocator>;
+
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    /**
+     * @brief Whether lookups accept keys of other types than key_type.
+     */
+    static constexpr bool isTransparent = requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+    /**
+     * @brief Forward iterator over the elements, in slot order.
+     */
+    template<bool Const>
+    class IteratorT
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        IteratorT() : m_ctrl(nullptr), m_slot(nullptr) {}
+
+        /**
+         * @brief Converts an iterator to a const_iterator.
+         */
+        template<bool OtherConst>
+            requires (Const && !OtherConst)
+        IteratorT(const IteratorT<OtherConst>& other) : m_ctrl(other.m_ctrl), m_slot(other.m_slot)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *m_slot;
+        }
+
+        pointer operator->() const
+        {
+            return m_slot;
+        }
+
+        IteratorT& operator++()
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skipFree();
+            return *this;
+        }
+
+        IteratorT operator++(int)
+        {
+            IteratorT copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const IteratorT& a, const IteratorT& b)
+        {
+            return a.m_ctrl == b.m_ctrl;
+        }
+
+    private:
+        friend class HashTableN;
+        template<bool> friend class IteratorT;
+
+        IteratorT(const ctrl_t* ctrl, pointer slot) : m_ctrl(ctrl), m_slot(slot) {}
+
+        /**
+         * @brief Advances to the next full slot, or to the Sentinel.
+         */
+        void skipFree()
+        {
+            while (*m_ctrl < ControlGroupN::Sentinel)
+            {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+        const ctrl_t* m_ctrl; ///< Control byte of the current slot.
+        pointer m_slot;       ///< Current slot.
+    };
+
+    using iterator = IteratorT<false>;
+    using const_iterator = IteratorT<true>;
+
+    /**
+     * @brief Constructs an empty table; nothing is allocated until the first insertion.
+     */
+    explicit HashTableN(size_type capacity = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+        const Allocator& alloc = Allocator())
+        : m_ctrl(nullptr), m_slots(nullptr), m_capacity(0), m_size(0), m_growthLeft(0),
+          m_hash(hash), m_equal(equal), m_alloc(alloc)
+    {
+        if (capacity)
+            reserve(capacity);
+    }
+
+    /**
+     * @brief Copy constructor.
+     */
+    HashTableN(const HashTableN& other)
+        : HashTableN(0, other.m_hash, other.m_equal, SlotTraits::select_on_container_copy_construction(other.m_alloc))
+    {
+        copyFrom(other);
+    }
+
+    /**
+     * @brief Move constructor: takes the storage of other, which is left empty.
+     */
+    HashTableN(HashTableN&& other) noexcept
+        : m_ctrl(std::exchange(other.m_ctrl, nullptr)), m_slots(std::exchange(other.m_slots, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, 0)), m_size(std::exchange(other.m_size, 0)),
+          m_growthLeft(std::exchange(other.m_growthLeft, 0)), m_hash(other.m_hash), m_equal(other.m_equal),
+          m_alloc(std::move(other.m_alloc))
+    {
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    HashTableN& operator=(const HashTableN& other)
+    {
+        if (this != &other)
+        {
+            destroyAll();
+            deallocate();
+            m_hash = other.m_hash;
+            m_equal = other.m_equal;
+            if constexpr (SlotTraits::propagate_on_container_copy_assignment::value)
+                m_alloc = other.m_alloc;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Takes the storage of other when the allocators allow it, and moves the
+     * elements one by one otherwise.
+     */
+    HashTableN& operator=(HashTableN&& other) noexcept(SlotTraits::propagate_on_container_move_assignment::value
+        || SlotTraits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+        destroyAll();
+        deallocate();
+        m_hash = other.m_hash;
+        m_equal = other.m_equal;
+        if constexpr (SlotTraits::propagate_on_container_move_assignment::value)
+            m_alloc = std::move(other.m_alloc);
+        if (SlotTraits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc)
+        {
+            m_ctrl = std::exchange(other.m_ctrl, nullptr);
+            m_slots = std::exchange(other.m_slots, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_size = std::exchange(other.m_size, 0);
+            m_growthLeft = std::exchange(other.m_growthLeft, 0);
+        }
+        else
+        {
+            reserve(other.size());
+            for (value_type& value : other)
+                insertUnique(hashOf(Policy::key(value)), std::move(value));
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the elements and releases the storage.
+     */
+    ~HashTableN()
+    {
+        destroyAll();
+        deallocate();
+    }
+
+    iterator begin()
+    {
+        iterator it(m_ctrl, m_slots);
+        if (m_ctrl)
+            it.skipFree();
+        return it;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it(m_ctrl, m_slots);
+        if (m_ctrl)
+            it.skipFree();
+        return it;
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator end()
+    {
+        return iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /**
+     * @brief Checks if the table is empty.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Returns the number of slots (0 before the first insertion).
+     */
+    size_type capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Returns the number of slots, for compatibility with the std unordered containers.
+     */
+    size_type bucket_count() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Returns size() / capacity().
+     */
+    float load_factor() const
+    {
+        return m_capacity ? float(m_size) / float(m_capacity) : 0.0f;
+    }
+
+    /**
+     * @brief Load factor above which the table grows (7/8).
+     */
+    static constexpr float max_load_factor()
+    {
+        return 0.875f;
+    }
+
+    /**
+     * @brief Returns the largest possible number of elements.
+     */
+    size_type max_size() const
+    {
+        return std::min<size_type>(SlotTraits::max_size(m_alloc), std::numeric_limits<size_type>::max() / 2);
+    }
+
+    hasher hash_function() const
+    {
+        return m_hash;
+    }
+
+    key_equal key_eq() const
+    {
+        return m_equal;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type(m_alloc);
+    }
+
+    /**
+     * @brief Destroys every element, keeping the storage.
+     */
+    void clear()
+    {
+        destroyAll();
+        if (m_ctrl)
+            resetControl();
+        m_size = 0;
+        m_growthLeft = growthFor(m_capacity);
+    }
+
+    /**
+     * @brief Makes room for count elements without further rehashing.
+     */
+    void reserve(size_type count)
+    {
+        if (count > m_size + m_growthLeft)
+            resize(capacityFor(count));
+    }
+
+    /**
+     * @brief Rehashes to the smallest capacity holding max(count, size()) elements; rehash(0) shrinks to fit.
+     */
+    void rehash(size_type count)
+    {
+        count = std::max(count, m_size);
+        if (count == 0)
+        {
+            destroyAll();
+            deallocate();
+            return;
+        }
+        const size_type capacity = capacityFor(count);
+        if (capacity != m_capacity || m_size + m_growthLeft < growthFor(m_capacity))
+            resize(capacity);
+    }
+
+    /**
+     * @brief Finds the element with the given key.
+     *
+     * @return Iterator to the element, or end().
+     */
+    iterator find(const key_type& key)
+    {
+        return iteratorAt(findIndex(key));
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        return constIteratorAt(findIndex(key));
+    }
+
+    /**
+     * @brief Heterogeneous find, available when Hash and KeyEqual are transparent.
+     */
+    template<typename Q>
+        requires isTransparent
+    iterator find(const Q& key)
+    {
+        return iteratorAt(findIndex(key));
+    }
+
+    template<typename Q>
+        requires isTransparent
+    const_iterator find(const Q& key) const
+    {
+        return constIteratorAt(findIndex(key));
+    }
+
+    /**
+     * @brief Checks whether an element has the given key.
+     */
+    bool contains(const key_type& key) const
+    {
+        return findIndex(key) != m_capacity;
+    }
+
+    template<typename Q>
+        requires isTransparent
+    bool contains(const Q& key) const
+    {
+        return findIndex(key) != m_capacity;
+    }
+
+    /**
+     * @brief Returns 1 if an element has the given key, 0 otherwise.
+     */
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename Q>
+        requires isTransparent
+    size_type count(const Q& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Removes the element with the given key.
+     *
+     * @return Number of elements removed (0 or 1).
+     */
+    size_type erase(const key_type& key)
+    {
+        return eraseKey(key);
+    }
+
+    template<typename Q>
+        requires (isTransparent && !std::is_convertible_v<const Q&, const_iterator>)
+    size_type erase(const Q& key)
+    {
+        return eraseKey(key);
+    }
+
+    /**
+     * @brief Removes the element at pos.
+     *
+     * @return Iterator to the element following pos.
+     */
+    iterator erase(const_iterator pos)
+    {
+        const size_type index = size_type(pos.m_ctrl - m_ctrl);
+        eraseAt(index);
+        iterator next(m_ctrl + index, m_slots + index);
+        ++next;
+        return next;
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+    /**
+     * @brief Removes every element for which pred returns true.
+     *
+     * @return Number of elements removed.
+     */
+    template<typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        const size_type before = m_size;
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (m_ctrl[i] >= 0 && pred(const_cast<const value_type&>(m_slots[i])))
+                eraseAt(i);
+        }
+        return before - m_size;
+    }
+
+    /**
+     * @brief Exchanges the contents with another table.
+     */
+    void swap(HashTableN& other) noexcept
+    {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growthLeft, other.m_growthLeft);
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+        if constexpr (SlotTraits::propagate_on_container_swap::value)
+            swap(m_alloc, other.m_alloc);
+    }
+
+protected:
+    /**
+     * @brief Finds key, or constructs a value from args in a free slot.
+     *
+     * args are only used when the key is absent, so they may reference key.
+     *
+     * @return Iterator to the element with the key, and whether it was inserted.
+     */
+    template<typename Q, typename... Args>
+    std::pair<iterator, bool> findOrEmplace(const Q& key, Args&&... args)
+    {
+        const size_type hash = hashOf(key);
+        const size_type found = findIndex(key, hash);
+        if (found != m_capacity)
+            return { iteratorAt(found), false };
+        return { iteratorAt(insertUnique(hash, std::forward<Args>(args)...)), true };
+    }
+
+private:
+    static constexpr size_type MinCapacity = ControlGroupN::Width - 1; ///< Smallest allocated capacity.
+    static constexpr size_type ClonedBytes = ControlGroupN::Width - 1; ///< Control bytes copied after the Sentinel.
+
+    /**
+     * @brief Number of elements a table of the given capacity holds before growing (7/8 load).
+     */
+    static size_type growthFor(size_type capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    /**
+     * @brief Smallest valid capacity (2^k - 1, at least MinCapacity) holding count elements.
+     */
+    static size_type capacityFor(size_type count)
+    {
+        size_type capacity = MinCapacity;
+        while (growthFor(capacity) < count)
+            capacity = capacity * 2 + 1;
+        return capacity;
+    }
+
+    /**
+     * @brief Hashes a key and mixes the bits, so that H1 and H2 both depend on the whole hash.
+     */
+    template<typename Q>
+    size_type hashOf(const Q& key) const
+    {
+        const std::uint64_t product = std::uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return size_type(product ^ (product >> 32));
+    }
+
+    /**
+     * @brief Start of the probe sequence.
+     */
+    static size_type h1(size_type hash)
+    {
+        return hash >> 7;
+    }
+
+    /**
+     * @brief Control byte stored for a hash.
+     */
+    static ctrl_t h2(size_type hash)
+    {
+        return ctrl_t(hash & 0x7F);
+    }
+
+    /**
+     * @brief Sets the control byte of slot index and its clone after the Sentinel.
+     */
+    void setControl(size_type index, ctrl_t value)
+    {
+        m_ctrl[index] = value;
+        m_ctrl[((index - ClonedBytes) & m_capacity) + ClonedBytes] = value;
+    }
+
+    /**
+     * @brief Marks every slot Empty and writes the Sentinel.
+     */
+    void resetControl()
+    {
+        std::memset(m_ctrl, static_cast<unsigned char>(ControlGroupN::Empty), m_capacity + 1 + ClonedBytes);
+        m_ctrl[m_capacity] = ControlGroupN::Sentinel;
+    }
+
+    /**
+     * @brief Index of the slot holding key, or m_capacity.
+     */
+    template<typename Q>
+    size_type findIndex(const Q& key) const
+    {
+        if (m_size == 0)
+            return m_capacity;
+        return findIndex(key, hashOf(key));
+    }
+
+    template<typename Q>
+    size_type findIndex(const Q& key, size_type hash) const
+    {
+        if (m_capacity == 0)
+            return 0;
+        const ctrl_t tag = h2(hash);
+        size_type pos = h1(hash) & m_capacity;
+        size_type step = 0;
+        while (true)
+        {
+            const ControlGroupN group(m_ctrl + pos);
+            for (std::uint32_t mask = group.match(tag); mask; mask &= mask - 1)
+            {
+                const size_type index = (pos + size_type(std::countr_zero(mask))) & m_capacity;
+                if (m_equal(Policy::key(m_slots[index]), key))
+                    return index;
+            }
+            if (group.matchEmpty())
+                return m_capacity;
+            step += ControlGroupN::Width;
+            pos = (pos + step) & m_capacity;
+        }
+    }
+
+    /**
+     * @brief First Empty or Deleted slot on the probe sequence of hash.
+     */
+    size_type findFreeSlot(size_type hash) const
+    {
+        size_type pos = h1(hash) & m_capacity;
+        size_type step = 0;
+        while (true)
+        {
+            const std::uint32_t mask = ControlGroupN(m_ctrl + pos).matchEmptyOrDeleted();
+            if (mask)
+                return (pos + size_type(std::countr_zero(mask))) & m_capacity;
+            step += ControlGroupN::Width;
+            pos = (pos + step) & m_capacity;
+        }
+    }
+
+    /**
+     * @brief Constructs a value from args for a key known to be absent.
+     *
+     * @return Index of the new element.
+     */
+    template<typename... Args>
+    size_type insertUnique(size_type hash, Args&&... args)
+    {
+        if (m_capacity == 0)
+            resize(MinCapacity);
+        size_type index = findFreeSlot(hash);
+        if (m_growthLeft == 0 && m_ctrl[index] != ControlGroupN::Deleted)
+        {
+            // Full of elements: double. Mostly tombstones: purge them at the same capacity.
+            resize(m_size * 32 <= m_capacity * 25 ? m_capacity : m_capacity * 2 + 1);
+            index = findFreeSlot(hash);
+        }
+        SlotTraits::construct(m_alloc, m_slots + index, std::forward<Args>(args)...);
+        if (m_ctrl[index] == ControlGroupN::Empty)
+            --m_growthLeft;
+        setControl(index, h2(hash));
+        ++m_size;
+        return index;
+    }
+
+    template<typename Q>
+    size_type eraseKey(const Q& key)
+    {
+        const size_type index = findIndex(key);
+        if (index == m_capacity)
+            return 0;
+        eraseAt(index);
+        return 1;
+    }
+
+    /**
+     * @brief Destroys the element of a full slot and frees the slot.
+     */
+    void eraseAt(size_type index)
+    {
+        SlotTraits::destroy(m_alloc, m_slots + index);
+        --m_size;
+
+        // A probe sequence only continues past a group with no Empty byte. If
+        // every window of Width bytes containing this slot still has one, no
+        // sequence crossed it and it can become Empty again.
+        const size_type before = (index - ControlGroupN::Width) & m_capacity;
+        const std::uint32_t emptyAfter = ControlGroupN(m_ctrl + index).matchEmpty();
+        const std::uint32_t emptyBefore = ControlGroupN(m_ctrl + before).matchEmpty();
+        const bool neverFull = emptyAfter && emptyBefore
+            && size_type(std::countr_zero(emptyAfter)) + size_type(std::countl_zero(std::uint16_t(emptyBefore))) < ControlGroupN::Width;
+        if (neverFull)
+        {
+            setControl(index, ControlGroupN::Empty);
+            ++m_growthLeft;
+        }
+        else
+        {
+            setControl(index, ControlGroupN::Deleted);
+        }
+    }
+
+    /**
+     * @brief Moves every element into fresh storage of the given capacity.
+     */
+    void resize(size_type capacity)
+    {
+        ctrl_t* oldCtrl = m_ctrl;
+        value_type* oldSlots = m_slots;
+        const size_type oldCapacity = m_capacity;
+
+        ControlAllocator ctrlAlloc(m_alloc);
+        m_ctrl = std::to_address(ControlTraits::allocate(ctrlAlloc, capacity + 1 + ClonedBytes));
+        try
+        {
+            m_slots = std::to_address(SlotTraits::allocate(m_alloc, capacity));
+        }
+        catch (...)
+        {
+            ControlTraits::deallocate(ctrlAlloc, m_ctrl, capacity + 1 + ClonedBytes);
+            m_ctrl = oldCtrl;
+            throw;
+        }
+        m_capacity = capacity;
+        resetControl();
+
+        for (size_type i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] < 0)
+                continue;
+            const size_type hash = hashOf(Policy::key(oldSlots[i]));
+            const size_type index = findFreeSlot(hash);
+            SlotTraits::construct(m_alloc, m_slots + index, std::move_if_noexcept(oldSlots[i]));
+            SlotTraits::destroy(m_alloc, oldSlots + i);
+            setControl(index, h2(hash));
+        }
+        m_growthLeft = growthFor(capacity) - m_size;
+
+        if (oldCtrl)
+        {
+            ControlTraits::deallocate(ctrlAlloc, oldCtrl, oldCapacity + 1 + ClonedBytes);
+            SlotTraits::deallocate(m_alloc, oldSlots, oldCapacity);
+        }
+    }
+
+    /**
+     * @brief Inserts copies of the elements of other into this empty table.
+     */
+    void copyFrom(const HashTableN& other)
+    {
+        reserve(other.m_size);
+        for (size_type i = 0; i < other.m_capacity; ++i)
+        {
+            if (other.m_ctrl[i] >= 0)
+                insertUnique(hashOf(Policy::key(other.m_slots[i])), other.m_slots[i]);
+        }
+    }
+
+    /**
+     * @brief Destroys every element, leaving the control bytes unchanged.
+     */
+    void destroyAll()
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+        {
+            for (size_type i = 0; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] >= 0)
+                    SlotTraits::destroy(m_alloc, m_slots + i);
+            }
+        }
+    }
+
+    /**
+     * @brief Releases the storage; the elements must already be destroyed.
+     */
+    void deallocate()
+    {
+        if (m_ctrl)
+        {
+            ControlAllocator ctrlAlloc(m_alloc);
+            ControlTraits::deallocate(ctrlAlloc, m_ctrl, m_capacity + 1 + ClonedBytes);
+            SlotTraits::deallocate(m_alloc, m_slots, m_capacity);
+        }
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growthLeft = 0;
+    }
+
+    iterator iteratorAt(size_type index)
+    {
+        return iterator(m_ctrl + index, m_slots + index);
+    }
+
+    const_iterator constIteratorAt(size_type index) const
+    {
+        return const_iterator(m_ctrl + index, m_slots + index);
+    }
+
+    ctrl_t* m_ctrl;                                ///< Control bytes: capacity, Sentinel, then ClonedBytes copies.
+    value_type* m_slots;                           ///< Slots, constructed only where the control byte is full.
+    size_type m_capacity;                          ///< Number of slots, 2^k - 1 or 0.
+    size_type m_size;                              ///< Number of elements.
+    size_type m_growthLeft;                        ///< Empty slots that may still be filled before growing.
+    [[no_unique_address]] Hash m_hash;             ///< Hash function.
+    [[no_unique_address]] KeyEqual m_equal;        ///< Key equality.
+    [[no_unique_address]] SlotAllocator m_alloc;   ///< Allocator of the slots.
+};
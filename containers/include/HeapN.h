@@ -0,0 +1,332 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include "VectorN.h"
+
+/**
+ * @class HeapN
+ * @brief Priority queue stored as a d-ary heap in a VectorN.
+ *
+ * top() is the element that orders first under Compare: with the default
+ * std::less it is the smallest element, which is what schedulers (earliest
+ * deadline, lowest cost) want. This is the opposite of std::priority_queue;
+ * pass std::greater to get a max-heap.
+ *
+ * Each node has D children stored next to each other. With D = 4 the tree is
+ * half as deep as a binary heap, and the four children of a node usually sit
+ * in one cache line, so pop() does fewer, cheaper levels. push() only
+ * compares with parents, which a larger D makes fewer of.
+ *
+ * Heapifying a range (constructor, assign(), adopt()) is O(n).
+ *
+ * @tparam T Element type; default constructible and move assignable.
+ * @tparam D Number of children per node (at least 2).
+ * @tparam Compare Strict weak ordering; the top is the element no other orders before.
+ */
+template<typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class HeapN
+{
+    static_assert(D >= 2, "HeapN: a node needs at least two children");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+    using const_iterator = typename VectorN<T>::const_iterator;
+
+    /**
+     * @brief Constructs an empty heap.
+     */
+    explicit HeapN(const Compare& comp = Compare()) : m_data(), m_comp(comp) {}
+
+    /**
+     * @brief Constructs a heap from the elements of a range, in linear time.
+     */
+    template<std::ranges::input_range R>
+        requires (!std::same_as<std::remove_cvref_t<R>, HeapN>)
+    explicit HeapN(R&& range, const Compare& comp = Compare()) : m_data(), m_comp(comp)
+    {
+        assign(std::forward<R>(range));
+    }
+
+    /**
+     * @brief Constructs a heap from an initializer list, in linear time.
+     */
+    HeapN(std::initializer_list<T> init, const Compare& comp = Compare()) : m_data(init), m_comp(comp)
+    {
+        heapify();
+    }
+
+    /**
+     * @brief Replaces the contents with the elements of a range, in linear time.
+     */
+    template<std::ranges::input_range R>
+    void assign(R&& range)
+    {
+        m_data.clear();
+        if constexpr (std::ranges::sized_range<R>)
+            m_data.reserve(size_type(std::ranges::size(range)));
+        for (auto&& element : range)
+            m_data.push_back(element);
+        heapify();
+    }
+
+    /**
+     * @brief Takes over the storage of a vector and heapifies it in place, in linear time.
+     *
+     * @param storage Elements of the new heap; left empty, holding the previous storage of the heap.
+     */
+    void adopt(VectorN<T>& storage)
+    {
+        m_data.swap(storage);
+        storage.clear();
+        heapify();
+    }
+
+    /**
+     * @brief Returns the element that orders first.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    const T& top() const
+    {
+        if (m_data.empty())
+            throw std::out_of_range("HeapN::top: heap is empty");
+        return m_data[0];
+    }
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_type size() const
+    {
+        return m_data.size();
+    }
+
+    /**
+     * @brief Reserves storage for capacity elements.
+     */
+    void reserve(size_type capacity)
+    {
+        m_data.reserve(capacity);
+    }
+
+    /**
+     * @brief Removes every element.
+     */
+    void clear()
+    {
+        m_data.clear();
+    }
+
+    /**
+     * @brief Inserts an element, in O(log_D n).
+     */
+    void push(const T& value)
+    {
+        m_data.push_back(value);
+        siftUp(m_data.size() - 1);
+    }
+
+    void push(T&& value)
+    {
+        m_data.emplace_back(std::move(value));
+        siftUp(m_data.size() - 1);
+    }
+
+    /**
+     * @brief Constructs an element from args and inserts it.
+     */
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        m_data.emplace_back(std::forward<Args>(args)...);
+        siftUp(m_data.size() - 1);
+    }
+
+    /**
+     * @brief Removes the top element, in O(D log_D n).
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    void pop()
+    {
+        if (m_data.empty())
+            throw std::out_of_range("HeapN::pop: heap is empty");
+        popTop();
+    }
+
+    /**
+     * @brief Removes the top element and returns it.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    T take()
+    {
+        if (m_data.empty())
+            throw std::out_of_range("HeapN::take: heap is empty");
+        T result = std::move(m_data[0]);
+        pop();
+        return result;
+    }
+
+    /**
+     * @brief Replaces the top element with value: a pop() then push() with a single sift.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    void replace_top(T value)
+    {
+        if (m_data.empty())
+            throw std::out_of_range("HeapN::replace_top: heap is empty");
+        m_data[0] = std::move(value);
+        siftDown(0);
+    }
+
+    /**
+     * @brief Iterators over the elements in heap order (not sorted).
+     */
+    const_iterator begin() const
+    {
+        return m_data.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_data.end();
+    }
+
+    value_compare value_comp() const
+    {
+        return m_comp;
+    }
+
+    /**
+     * @brief Swaps the contents with another heap.
+     */
+    void swap(HeapN& other)
+    {
+        m_data.swap(other.m_data);
+        std::swap(m_comp, other.m_comp);
+    }
+
+private:
+    /**
+     * @brief Moves the element at index up until its parent does not order after it.
+     *
+     * Works on a raw pointer: element stores could otherwise alias the size
+     * and pointer of the VectorN (size_t elements), forcing reloads.
+     */
+    void siftUp(size_type index)
+    {
+        T* data = m_data.data();
+        T value = std::move(data[index]);
+        while (index > 0)
+        {
+            const size_type parent = (index - 1) / D;
+            if (!m_comp(value, data[parent]))
+                break;
+            data[index] = std::move(data[parent]);
+            index = parent;
+        }
+        data[index] = std::move(value);
+    }
+
+    /**
+     * @brief Index of the child of index that orders first, or count if index is a leaf.
+     */
+    size_type bestChild(const T* data, size_type index, size_type count) const
+    {
+        const size_type first = index * D + 1;
+        if (first >= count)
+            return count;
+        size_type best = first;
+        if (first + D <= count)
+        {
+            for (size_type child = first + 1; child < first + D; ++child)
+                best = m_comp(data[child], data[best]) ? child : best;
+        }
+        else
+        {
+            for (size_type child = first + 1; child < count; ++child)
+                best = m_comp(data[child], data[best]) ? child : best;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Moves the element at index down until no child orders before it.
+     */
+    void siftDown(size_type index)
+    {
+        T* data = m_data.data();
+        const size_type count = m_data.size();
+        T value = std::move(data[index]);
+        for (size_type best = bestChild(data, index, count); best < count && m_comp(data[best], value);
+             best = bestChild(data, index, count))
+        {
+            data[index] = std::move(data[best]);
+            index = best;
+        }
+        data[index] = std::move(value);
+    }
+
+    /**
+     * @brief Fills the hole at the top with the last element (Floyd's bottom-up pop).
+     *
+     * The hole goes down to a leaf along the best children without comparing
+     * them to the last element, which then sifts up from there. The last
+     * element of a heap usually belongs near the bottom, so this saves one
+     * comparison per level over siftDown().
+     */
+    void popTop()
+    {
+        T* data = m_data.data();
+        const size_type count = m_data.size() - 1;
+        size_type hole = 0;
+        for (size_type best = bestChild(data, hole, count); best < count; best = bestChild(data, hole, count))
+        {
+            data[hole] = std::move(data[best]);
+            hole = best;
+        }
+        if (hole != count)
+        {
+            data[hole] = std::move(data[count]);
+            m_data.pop_back();
+            siftUp(hole);
+        }
+        else
+        {
+            m_data.pop_back();
+        }
+    }
+
+    /**
+     * @brief Restores the heap order over the whole storage, bottom-up (Floyd), in O(n).
+     */
+    void heapify()
+    {
+        const size_type count = m_data.size();
+        if (count < 2)
+            return;
+        for (size_type index = (count - 2) / D + 1; index-- > 0;)
+            siftDown(index);
+    }
+
+    VectorN<T> m_data;                    ///< Elements in heap order: the children of i are i * D + 1 .. i * D + D.
+    [[no_unique_address]] Compare m_comp; ///< Element ordering.
+};
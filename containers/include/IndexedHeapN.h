@@ -0,0 +1,385 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include "VectorN.h"
+
+/**
+ * @class IndexedHeapN
+ * @brief d-ary heap whose elements are addressed by handles, with decrease-key and erase.
+ *
+ * push() returns a handle that names the element until it is popped or
+ * erased; the handle is then recycled by a later push(). A position table
+ * maps each handle to the element's slot in the heap, so update(),
+ * decrease_key(), increase_key() and erase() run in O(log_D n) instead of a
+ * linear search.
+ *
+ * Ordering follows HeapN: top() is the element that orders first under
+ * Compare (the smallest with std::less). decrease_key() moves an element
+ * towards the top, increase_key() away from it.
+ *
+ * Heap slots store the value next to its handle, so sifting compares
+ * contiguous values and never goes through the position table.
+ *
+ * @tparam T Element type; default constructible and move assignable.
+ * @tparam D Number of children per node (at least 2).
+ * @tparam Compare Strict weak ordering; the top is the element no other orders before.
+ */
+template<typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class IndexedHeapN
+{
+    static_assert(D >= 2, "IndexedHeapN: a node needs at least two children");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using handle_type = std::size_t;
+    using value_compare = Compare;
+
+    static constexpr size_type npos = std::numeric_limits<size_type>::max(); ///< Position of a free handle.
+
+    /**
+     * @brief Constructs an empty heap.
+     */
+    explicit IndexedHeapN(const Compare& comp = Compare()) : m_heap(), m_position(), m_free(), m_comp(comp) {}
+
+    /**
+     * @brief Constructs a heap from the elements of a range, in linear time.
+     *
+     * The i-th element of the range gets handle i.
+     */
+    template<std::ranges::input_range R>
+        requires (!std::same_as<std::remove_cvref_t<R>, IndexedHeapN>)
+    explicit IndexedHeapN(R&& range, const Compare& comp = Compare()) : IndexedHeapN(comp)
+    {
+        assign(std::forward<R>(range));
+    }
+
+    /**
+     * @brief Replaces the contents with the elements of a range, in linear time.
+     *
+     * The i-th element of the range gets handle i.
+     */
+    template<std::ranges::input_range R>
+    void assign(R&& range)
+    {
+        m_heap.clear();
+        m_position.clear();
+        m_free.clear();
+        for (auto&& element : range)
+        {
+            const handle_type handle = m_heap.size();
+            m_heap.push_back(Entry{ element, handle });
+            m_position.push_back(handle);
+        }
+        const size_type count = m_heap.size();
+        if (count < 2)
+            return;
+        for (size_type index = (count - 2) / D + 1; index-- > 0;)
+            siftDown(index);
+    }
+
+    /**
+     * @brief Checks if the heap is empty.
+     */
+    bool empty() const
+    {
+        return m_heap.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_type size() const
+    {
+        return m_heap.size();
+    }
+
+    /**
+     * @brief Reserves storage for capacity elements.
+     */
+    void reserve(size_type capacity)
+    {
+        m_heap.reserve(capacity);
+        m_position.reserve(capacity);
+    }
+
+    /**
+     * @brief Removes every element. Every handle becomes free.
+     */
+    void clear()
+    {
+        m_heap.clear();
+        m_free.clear();
+        for (size_type handle = m_position.size(); handle-- > 0;)
+        {
+            m_position[handle] = npos;
+            m_free.push_back(handle);
+        }
+    }
+
+    /**
+     * @brief Checks whether handle names an element of the heap.
+     */
+    bool contains(handle_type handle) const
+    {
+        return handle < m_position.size() && m_position[handle] != npos;
+    }
+
+    /**
+     * @brief Returns the value of the element named by handle.
+     *
+     * @throws std::out_of_range if the handle names no element.
+     */
+    const T& operator[](handle_type handle) const
+    {
+        return m_heap[slot(handle)].value;
+    }
+
+    /**
+     * @brief Returns the element that orders first.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    const T& top() const
+    {
+        if (m_heap.empty())
+            throw std::out_of_range("IndexedHeapN::top: heap is empty");
+        return m_heap[0].value;
+    }
+
+    /**
+     * @brief Returns the handle of the element that orders first.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    handle_type top_handle() const
+    {
+        if (m_heap.empty())
+            throw std::out_of_range("IndexedHeapN::top_handle: heap is empty");
+        return m_heap[0].handle;
+    }
+
+    /**
+     * @brief Inserts an element, in O(log_D n).
+     *
+     * @return Handle naming the element.
+     */
+    handle_type push(T value)
+    {
+        handle_type handle;
+        if (!m_free.empty())
+        {
+            handle = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            handle = m_position.size();
+            m_position.push_back(npos);
+        }
+        m_heap.push_back(Entry{ std::move(value), handle });
+        m_position[handle] = m_heap.size() - 1;
+        siftUp(m_heap.size() - 1);
+        return handle;
+    }
+
+    /**
+     * @brief Removes the top element, in O(D log_D n).
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    void pop()
+    {
+        if (m_heap.empty())
+            throw std::out_of_range("IndexedHeapN::pop: heap is empty");
+        removeAt(0);
+    }
+
+    /**
+     * @brief Removes the top element and returns its handle and value.
+     *
+     * @throws std::out_of_range if the heap is empty.
+     */
+    std::pair<handle_type, T> take()
+    {
+        if (m_heap.empty())
+            throw std::out_of_range("IndexedHeapN::take: heap is empty");
+        std::pair<handle_type, T> result(m_heap[0].handle, std::move(m_heap[0].value));
+        removeAt(0);
+        return result;
+    }
+
+    /**
+     * @brief Removes the element named by handle, in O(D log_D n).
+     *
+     * @throws std::out_of_range if the handle names no element.
+     */
+    void erase(handle_type handle)
+    {
+        removeAt(slot(handle));
+    }
+
+    /**
+     * @brief Replaces the value of an element and restores the heap order, in either direction.
+     *
+     * @throws std::out_of_range if the handle names no element.
+     */
+    void update(handle_type handle, T value)
+    {
+        const size_type index = slot(handle);
+        const bool up = m_comp(value, m_heap[index].value);
+        m_heap[index].value = std::move(value);
+        if (up)
+            siftUp(index);
+        else
+            siftDown(index);
+    }
+
+    /**
+     * @brief Replaces the value of an element with one that does not order after it, in O(log_D n).
+     *
+     * @throws std::out_of_range if the handle names no element.
+     * @throws std::invalid_argument if value orders after the current value.
+     */
+    void decrease_key(handle_type handle, T value)
+    {
+        const size_type index = slot(handle);
+        if (m_comp(m_heap[index].value, value))
+            throw std::invalid_argument("IndexedHeapN::decrease_key: new value orders after the current one");
+        m_heap[index].value = std::move(value);
+        siftUp(index);
+    }
+
+    /**
+     * @brief Replaces the value of an element with one that does not order before it, in O(D log_D n).
+     *
+     * @throws std::out_of_range if the handle names no element.
+     * @throws std::invalid_argument if value orders before the current value.
+     */
+    void increase_key(handle_type handle, T value)
+    {
+        const size_type index = slot(handle);
+        if (m_comp(value, m_heap[index].value))
+            throw std::invalid_argument("IndexedHeapN::increase_key: new value orders before the current one");
+        m_heap[index].value = std::move(value);
+        siftDown(index);
+    }
+
+    value_compare value_comp() const
+    {
+        return m_comp;
+    }
+
+private:
+    /**
+     * @brief Heap slot: a value and the handle naming it.
+     */
+    struct Entry
+    {
+        T value;
+        handle_type handle;
+    };
+
+    /**
+     * @brief Heap index of the element named by handle.
+     *
+     * @throws std::out_of_range if the handle names no element.
+     */
+    size_type slot(handle_type handle) const
+    {
+        if (!contains(handle))
+            throw std::out_of_range("IndexedHeapN: handle names no element");
+        return m_position[handle];
+    }
+
+    /**
+     * @brief Places an entry at index and records its position.
+     */
+    void place(Entry* heap, size_type index, Entry&& entry)
+    {
+        m_position[entry.handle] = index;
+        heap[index] = std::move(entry);
+    }
+
+    /**
+     * @brief Removes the entry at index: the last entry fills the hole and is sifted.
+     */
+    void removeAt(size_type index)
+    {
+        Entry* heap = m_heap.data();
+        const handle_type handle = heap[index].handle;
+        m_position[handle] = npos;
+        m_free.push_back(handle);
+
+        const size_type last = m_heap.size() - 1;
+        if (index == last)
+        {
+            m_heap.pop_back();
+            return;
+        }
+        // The top has no parent, and take() has already moved its value out.
+        const bool up = index != 0 && m_comp(heap[last].value, heap[index].value);
+        place(heap, index, std::move(heap[last]));
+        m_heap.pop_back();
+        if (up)
+            siftUp(index);
+        else
+            siftDown(index);
+    }
+
+    /**
+     * @brief Moves the entry at index up until its parent does not order after it.
+     *
+     * Works on raw pointers: entry stores could otherwise alias the size and
+     * pointer of the VectorN members, forcing reloads.
+     */
+    void siftUp(size_type index)
+    {
+        Entry* heap = m_heap.data();
+        Entry entry = std::move(heap[index]);
+        while (index > 0)
+        {
+            const size_type parent = (index - 1) / D;
+            if (!m_comp(entry.value, heap[parent].value))
+                break;
+            place(heap, index, std::move(heap[parent]));
+            index = parent;
+        }
+        place(heap, index, std::move(entry));
+    }
+
+    /**
+     * @brief Moves the entry at index down until no child orders before it.
+     */
+    void siftDown(size_type index)
+    {
+        Entry* heap = m_heap.data();
+        const size_type count = m_heap.size();
+        Entry entry = std::move(heap[index]);
+        while (true)
+        {
+            const size_type first = index * D + 1;
+            if (first >= count)
+                break;
+            const size_type last = first + D < count ? first + D : count;
+            size_type best = first;
+            for (size_type child = first + 1; child < last; ++child)
+                best = m_comp(heap[child].value, heap[best].value) ? child : best;
+            if (!m_comp(heap[best].value, entry.value))
+                break;
+            place(heap, index, std::move(heap[best]));
+            index = best;
+        }
+        place(heap, index, std::move(entry));
+    }
+
+    VectorN<Entry> m_heap;                ///< Entries in heap order: the children of i are i * D + 1 .. i * D + D.
+    VectorN<size_type> m_position;        ///< Heap index of each handle, npos for free handles.
+    VectorN<handle_type> m_free;          ///< Free handles, reused last in first out.
+    [[no_unique_address]] Compare m_comp; ///< Element ordering.
+};
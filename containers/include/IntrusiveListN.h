@@ -3,6 +3,8 @@
 #include <utility>
 #include <cstddef>
 #include <functional>
+#include <iterator>
+#include <type_traits>
 
 /**
  * @brief Structure representing a hook for an intrusive list.
@@ -45,10 +47,23 @@ struct Node
     {
         return data == other.data;
     }
+
+    /**
+     * @brief Less-than operator ordering nodes by their data.
+     * @param other Other node to compare.
+     * @return true if the data of this node is smaller.
+     */
+    bool operator<(const Node& other) const
+    {
+        return data < other.data;
+    }
 };
 
 /**
- * @brief Template class for an iterator of an intrusive list.
+ * @brief Template class for a bidirectional iterator of an intrusive list.
+ *
+ * The end iterator remembers where the list keeps its tail, so that
+ * decrementing end() reaches the last element.
  * @tparam T Type of the elements in the list.
  * @tparam HookPtr Pointer to the hook of the intrusive list in the elements.
  */
@@ -56,21 +71,25 @@ template<typename T, IntrusiveListHook T::* HookPtr>
 class IntrusiveListIterator
 {
 public:
-    using value_type = T; ///< Type of the elements in the list.
-    using reference = value_type&; ///< Reference to an element.
-    using pointer = value_type*; ///< Pointer to an element.
+    using iterator_category = std::bidirectional_iterator_tag; ///< Category of the iterator.
+    using value_type = std::remove_cv_t<T>; ///< Type of the elements in the list.
+    using difference_type = std::ptrdiff_t; ///< Type of the distance between two iterators.
+    using reference = T&; ///< Reference to an element.
+    using pointer = T*; ///< Pointer to an element.
 
     /**
      * @brief Default constructor initializing the iterator to nullptr.
      */
-    IntrusiveListIterator() : m_node(nullptr)
+    IntrusiveListIterator() : m_node(nullptr), m_tail(nullptr)
     {}
 
     /**
      * @brief Constructor initializing the iterator with a list hook.
      * @param node Pointer to the list hook.
+     * @param tail Tail pointer of the list, reached by decrementing the end iterator.
      */
-    explicit IntrusiveListIterator(IntrusiveListHook* node) : m_node(node)
+    explicit IntrusiveListIterator(IntrusiveListHook* node, IntrusiveListHook* const* tail = nullptr)
+        : m_node(node), m_tail(tail)
     {}
 
     /**
@@ -121,6 +140,8 @@ public:
     {
         if (m_node)
             m_node = m_node->prev;
+        else if (m_tail)
+            m_node = *m_tail;
         return *this;
     }
 
@@ -184,6 +205,7 @@ public:
 
 private:
     IntrusiveListHook* m_node; ///< Pointer to the current list hook.
+    IntrusiveListHook* const* m_tail; ///< Tail pointer of the list.
 
 };
 
@@ -200,6 +222,9 @@ class IntrusiveList
 public:
     using value_type = T; ///< Type of the elements in the list.
     using size_type = std::size_t; ///< Type for the size of the list.
+    using difference_type = std::ptrdiff_t; ///< Type for the distance between two iterators.
+    using reference = T&; ///< Reference to an element.
+    using const_reference = const T&; ///< Constant reference to an element.
     using iterator = IntrusiveListIterator<T, HookPtr>; ///< Type for the list iterators.
     using const_iterator = IntrusiveListIterator<const T, HookPtr>; ///< Type for the constant list iterators.
 
@@ -225,7 +250,7 @@ public:
      */
     iterator begin()
     {
-        return iterator(m_head);
+        return iterator(m_head, &m_tail);
     }
 
     /**
@@ -234,7 +259,7 @@ public:
      */
     iterator end()
     {
-        return iterator(nullptr);
+        return iterator(nullptr, &m_tail);
     }
 
     /**
@@ -243,7 +268,7 @@ public:
      */
     const_iterator begin() const
     {
-        return const_iterator(m_head);
+        return const_iterator(m_head, &m_tail);
     }
 
     /**
@@ -252,7 +277,7 @@ public:
      */
     const_iterator end() const
     {
-        return const_iterator(nullptr);
+        return const_iterator(nullptr, &m_tail);
     }
 
     /**
@@ -446,6 +471,8 @@ public:
 
         if (m_tail != nullptr)
             m_tail->next = nullptr;
+        else
+            m_head = nullptr;
 
         oldTail->prev = nullptr;
         oldTail->next = nullptr;
@@ -479,7 +506,7 @@ public:
         hook->prev = nullptr;
         --m_size;
 
-        return iterator(nxt);
+        return iterator(nxt, &m_tail);
     }
 
 
@@ -766,8 +793,88 @@ public:
         sort(std::less<T>());
     }
 
+    /**
+     * @brief Sorts the elements in the list with a comparator.
+     *
+     * Bottom-up merge sort that relinks the hooks: no element is moved or
+     * copied, iterators stay valid, and equivalent elements keep their order.
+     * O(n log n) comparisons, O(1) extra memory.
+     *
+     * @tparam Compare Type of the comparator.
+     * @param comp Strict weak ordering on the elements.
+     */
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        if (m_size < 2)
+            return;
+
+        // bins[i] holds a sorted run of 2^i hooks, linked through next only.
+        IntrusiveListHook* bins[64] = {};
+        IntrusiveListHook* hook = m_head;
+        while (hook)
+        {
+            IntrusiveListHook* next = hook->next;
+            hook->next = nullptr;
+            IntrusiveListHook* carry = hook;
+            std::size_t level = 0;
+            for (; bins[level]; ++level)
+            {
+                carry = mergeRuns(bins[level], carry, comp);
+                bins[level] = nullptr;
+            }
+            bins[level] = carry;
+            hook = next;
+        }
+
+        IntrusiveListHook* sorted = nullptr;
+        for (IntrusiveListHook* run : bins)
+        {
+            if (run)
+                sorted = sorted ? mergeRuns(run, sorted, comp) : run;
+        }
+
+        m_head = sorted;
+        IntrusiveListHook* prev = nullptr;
+        for (hook = sorted; hook; hook = hook->next)
+        {
+            hook->prev = prev;
+            prev = hook;
+        }
+        m_tail = prev;
+    }
 
 private:
+    /**
+     * @brief Merges two sorted runs linked through next, taking from first on ties.
+     * @param first Run holding the earlier elements.
+     * @param second Run holding the later elements.
+     * @param comp Strict weak ordering on the elements.
+     * @return Head of the merged run.
+     */
+    template <typename Compare>
+    static IntrusiveListHook* mergeRuns(IntrusiveListHook* first, IntrusiveListHook* second, Compare& comp)
+    {
+        IntrusiveListHook* head = nullptr;
+        IntrusiveListHook** link = &head;
+        while (first && second)
+        {
+            if (comp(*iterator::get_value(second), *iterator::get_value(first)))
+            {
+                *link = second;
+                second = second->next;
+            }
+            else
+            {
+                *link = first;
+                first = first->next;
+            }
+            link = &(*link)->next;
+        }
+        *link = first ? first : second;
+        return head;
+    }
+
     IntrusiveListHook* m_head; ///< Pointer to the first element in the list.
     IntrusiveListHook* m_tail; ///< Pointer to the last element in the list.
     size_type m_size; ///< Number of elements in the list.
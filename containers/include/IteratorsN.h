@@ -0,0 +1,1607 @@
+#pragma once
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file IteratorsN.h
+ * @brief Lazy iterator adaptors: transformed, filtered, reversed, strided, chunked, enumerated and zip.
+ *
+ * Every adaptor is a std::ranges::view over any range (VectorN, ArrayN, ListN,
+ * standard containers or another view), usable directly or in a pipeline:
+ *
+ *     for (auto [index, value] : values | filtered(isValid) | transformed(scale) | enumerated())
+ *
+ * Nothing is copied or materialized: each element is computed when the
+ * iterator is dereferenced. Iterators are as strong as the adapted range
+ * allows (random access over VectorN and ArrayN, bidirectional over ListN),
+ * so std::ranges algorithms keep their fast paths. Views hold a reference to
+ * lvalue ranges and take ownership of rvalue ones; their iterators must not
+ * outlive the view.
+ */
+
+/**
+ * @brief The strongest standard iterator tag modelled by the iterators of R, capped at random access.
+ */
+template<typename R>
+using RangeIteratorConceptN = std::conditional_t<std::ranges::random_access_range<R>, std::random_access_iterator_tag,
+    std::conditional_t<std::ranges::bidirectional_range<R>, std::bidirectional_iterator_tag,
+    std::conditional_t<std::ranges::forward_range<R>, std::forward_iterator_tag, std::input_iterator_tag>>>;
+
+/**
+ * @brief Legacy iterator category of an adaptor over R whose dereference yields Reference.
+ *
+ * Legacy forward iterators must yield real references, so adaptors computing
+ * their elements report input_iterator_tag there, like the standard views.
+ */
+template<typename R, typename Reference>
+using RangeIteratorCategoryN = std::conditional_t<std::is_reference_v<Reference>,
+    std::conditional_t<std::derived_from<typename std::iterator_traits<std::ranges::iterator_t<R>>::iterator_category,
+        std::random_access_iterator_tag>, std::random_access_iterator_tag,
+        typename std::iterator_traits<std::ranges::iterator_t<R>>::iterator_category>,
+    std::input_iterator_tag>;
+
+/**
+ * @brief T, const-qualified when Const is true.
+ */
+template<bool Const, typename T>
+using MaybeConstN = std::conditional_t<Const, const T, T>;
+
+/**
+ * @class AdaptedSentinelN
+ * @brief End marker of an adaptor over a range whose end is not an iterator.
+ *
+ * An adaptor iterator reaches it when its base() compares equal to the wrapped sentinel.
+ *
+ * @tparam S The sentinel type of the adapted range.
+ */
+template<std::semiregular S>
+class AdaptedSentinelN
+{
+public:
+    AdaptedSentinelN() = default;
+
+    /**
+     * @brief Wraps the sentinel of the adapted range.
+     */
+    explicit AdaptedSentinelN(S end)
+        : m_end(std::move(end))
+    {
+    }
+
+    /**
+     * @brief Returns the wrapped sentinel.
+     */
+    const S& base() const
+    {
+        return m_end;
+    }
+
+    /**
+     * @brief Whether an adaptor iterator has reached the end.
+     */
+    template<typename It>
+        requires requires(const It& it, const S& end) { { it.base() == end } -> std::convertible_to<bool>; }
+    friend bool operator==(const It& it, const AdaptedSentinelN& sentinel)
+    {
+        return it.base() == sentinel.m_end;
+    }
+
+private:
+    S m_end{}; ///< Sentinel of the adapted range.
+};
+
+/**
+ * @class RangeAdaptorClosureN
+ * @brief Adaptor waiting for its range, applied with range | closure.
+ *
+ * @tparam Fn Callable building the view from the range.
+ */
+template<typename Fn>
+class RangeAdaptorClosureN
+{
+public:
+    /**
+     * @brief Wraps the view factory.
+     */
+    explicit RangeAdaptorClosureN(Fn fn)
+        : m_fn(std::move(fn))
+    {
+    }
+
+    /**
+     * @brief Applies the adaptor to a range.
+     */
+    template<std::ranges::viewable_range R>
+    friend auto operator|(R&& range, const RangeAdaptorClosureN& closure)
+    {
+        return closure.m_fn(std::forward<R>(range));
+    }
+
+private:
+    Fn m_fn; ///< The view factory.
+};
+
+/**
+ * @class TransformViewN
+ * @brief View of fn(element) for every element of a range.
+ *
+ * @tparam V The adapted view.
+ * @tparam F The function applied to each element.
+ */
+template<std::ranges::input_range V, std::copy_constructible F>
+    requires std::ranges::view<V> && std::is_object_v<F>
+        && std::regular_invocable<const F&, std::ranges::range_reference_t<V>>
+class TransformViewN : public std::ranges::view_interface<TransformViewN<V, F>>
+{
+    template<bool Const>
+    class Iterator
+    {
+        using Base = MaybeConstN<Const, V>;
+        using BaseIterator = std::ranges::iterator_t<Base>;
+        using Reference = std::invoke_result_t<const F&, std::ranges::range_reference_t<Base>>;
+
+    public:
+        using iterator_concept = RangeIteratorConceptN<Base>;
+        using iterator_category = RangeIteratorCategoryN<Base, Reference>;
+        using value_type = std::remove_cvref_t<Reference>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        Iterator() = default;
+
+        Iterator(const F* fn, BaseIterator current)
+            : m_fn(fn), m_current(std::move(current))
+        {
+        }
+
+        /**
+         * @brief Returns the iterator of the adapted range.
+         */
+        const BaseIterator& base() const
+        {
+            return m_current;
+        }
+
+        Reference operator*() const
+        {
+            return std::invoke(*m_fn, *m_current);
+        }
+
+        Reference operator[](difference_type n) const
+            requires std::ranges::random_access_range<Base>
+        {
+            return std::invoke(*m_fn, m_current[n]);
+        }
+
+        Iterator& operator++()
+        {
+            ++m_current;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++m_current;
+            return tmp;
+        }
+
+        Iterator& operator--()
+            requires std::ranges::bidirectional_range<Base>
+        {
+            --m_current;
+            return *this;
+        }
+
+        Iterator operator--(int)
+            requires std::ranges::bidirectional_range<Base>
+        {
+            Iterator tmp(*this);
+            --m_current;
+            return tmp;
+        }
+
+        Iterator& operator+=(difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            m_current += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            m_current -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            requires std::sized_sentinel_for<BaseIterator, BaseIterator>
+        {
+            return lhs.m_current - rhs.m_current;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            requires std::equality_comparable<BaseIterator>
+        {
+            return lhs.m_current == rhs.m_current;
+        }
+
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs)
+            requires std::ranges::random_access_range<Base> && std::three_way_comparable<BaseIterator>
+        {
+            return lhs.m_current <=> rhs.m_current;
+        }
+
+    private:
+        const F* m_fn = nullptr;   ///< The function of the view.
+        BaseIterator m_current{};  ///< Position in the adapted range.
+    };
+
+public:
+    TransformViewN()
+        requires std::default_initializable<V> && std::default_initializable<F> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param base The adapted view.
+     * @param fn The function applied to each element.
+     */
+    TransformViewN(V base, F fn)
+        : m_base(std::move(base)), m_fn(std::move(fn))
+    {
+    }
+
+    /**
+     * @brief Returns the adapted view.
+     */
+    V base() const
+    {
+        return m_base;
+    }
+
+    Iterator<false> begin()
+    {
+        return Iterator<false>(&m_fn, std::ranges::begin(m_base));
+    }
+
+    Iterator<true> begin() const
+        requires std::ranges::range<const V> && std::regular_invocable<const F&, std::ranges::range_reference_t<const V>>
+    {
+        return Iterator<true>(&m_fn, std::ranges::begin(m_base));
+    }
+
+    auto end()
+    {
+        if constexpr (std::ranges::common_range<V>)
+            return Iterator<false>(&m_fn, std::ranges::end(m_base));
+        else
+            return AdaptedSentinelN<std::ranges::sentinel_t<V>>(std::ranges::end(m_base));
+    }
+
+    auto end() const
+        requires std::ranges::range<const V> && std::regular_invocable<const F&, std::ranges::range_reference_t<const V>>
+    {
+        if constexpr (std::ranges::common_range<const V>)
+            return Iterator<true>(&m_fn, std::ranges::end(m_base));
+        else
+            return AdaptedSentinelN<std::ranges::sentinel_t<const V>>(std::ranges::end(m_base));
+    }
+
+    auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+private:
+    V m_base{}; ///< The adapted view.
+    F m_fn;     ///< The function applied to each element.
+};
+
+template<typename R, typename F>
+TransformViewN(R&&, F) -> TransformViewN<std::views::all_t<R>, F>;
+
+/**
+ * @class FilterViewN
+ * @brief View of the elements of a range that satisfy a predicate.
+ *
+ * Iterators are at most bidirectional. begin() scans for the first matching
+ * element, so it is linear in the number of leading rejected elements.
+ *
+ * @tparam V The adapted view.
+ * @tparam Pred The predicate selecting the elements.
+ */
+template<std::ranges::input_range V, std::indirect_unary_predicate<std::ranges::iterator_t<V>> Pred>
+    requires std::ranges::view<V> && std::is_object_v<Pred>
+class FilterViewN : public std::ranges::view_interface<FilterViewN<V, Pred>>
+{
+    using BaseIterator = std::ranges::iterator_t<V>;
+
+public:
+    class Iterator
+    {
+    public:
+        using iterator_concept = std::conditional_t<std::ranges::bidirectional_range<V>, std::bidirectional_iterator_tag,
+            std::conditional_t<std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag>>;
+        using iterator_category = std::conditional_t<std::ranges::bidirectional_range<V>, std::bidirectional_iterator_tag,
+            std::conditional_t<std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag>>;
+        using value_type = std::ranges::range_value_t<V>;
+        using difference_type = std::ranges::range_difference_t<V>;
+
+        Iterator() = default;
+
+        Iterator(FilterViewN* parent, BaseIterator current)
+            : m_parent(parent), m_current(std::move(current))
+        {
+        }
+
+        /**
+         * @brief Returns the iterator of the adapted range.
+         */
+        const BaseIterator& base() const
+        {
+            return m_current;
+        }
+
+        std::ranges::range_reference_t<V> operator*() const
+        {
+            return *m_current;
+        }
+
+        BaseIterator operator->() const
+            requires std::is_pointer_v<BaseIterator>
+        {
+            return m_current;
+        }
+
+        Iterator& operator++()
+        {
+            m_current = std::ranges::find_if(std::move(++m_current), std::ranges::end(m_parent->m_base),
+                std::ref(m_parent->m_pred));
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        Iterator& operator--()
+            requires std::ranges::bidirectional_range<V>
+        {
+            do
+                --m_current;
+            while (!std::invoke(m_parent->m_pred, *m_current));
+            return *this;
+        }
+
+        Iterator operator--(int)
+            requires std::ranges::bidirectional_range<V>
+        {
+            Iterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            requires std::equality_comparable<BaseIterator>
+        {
+            return lhs.m_current == rhs.m_current;
+        }
+
+    private:
+        FilterViewN* m_parent = nullptr; ///< The view owning the predicate.
+        BaseIterator m_current{};        ///< Position in the adapted range.
+    };
+
+    FilterViewN()
+        requires std::default_initializable<V> && std::default_initializable<Pred> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param base The adapted view.
+     * @param pred The predicate selecting the elements.
+     */
+    FilterViewN(V base, Pred pred)
+        : m_base(std::move(base)), m_pred(std::move(pred))
+    {
+    }
+
+    /**
+     * @brief Returns the adapted view.
+     */
+    V base() const
+    {
+        return m_base;
+    }
+
+    /**
+     * @brief Returns the predicate.
+     */
+    const Pred& pred() const
+    {
+        return m_pred;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, std::ranges::find_if(m_base, std::ref(m_pred)));
+    }
+
+    auto end()
+    {
+        if constexpr (std::ranges::common_range<V>)
+            return Iterator(this, std::ranges::end(m_base));
+        else
+            return AdaptedSentinelN<std::ranges::sentinel_t<V>>(std::ranges::end(m_base));
+    }
+
+private:
+    V m_base{};  ///< The adapted view.
+    Pred m_pred; ///< The predicate selecting the elements.
+};
+
+template<typename R, typename Pred>
+FilterViewN(R&&, Pred) -> FilterViewN<std::views::all_t<R>, Pred>;
+
+/**
+ * @class ReverseViewN
+ * @brief View of the elements of a bidirectional range in reverse order.
+ *
+ * Iterators are std::reverse_iterator over the adapted iterators, random
+ * access over VectorN and ArrayN.
+ *
+ * @tparam V The adapted view.
+ */
+template<std::ranges::view V>
+    requires std::ranges::bidirectional_range<V> && std::ranges::common_range<V>
+class ReverseViewN : public std::ranges::view_interface<ReverseViewN<V>>
+{
+public:
+    ReverseViewN()
+        requires std::default_initializable<V> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param base The adapted view.
+     */
+    explicit ReverseViewN(V base)
+        : m_base(std::move(base))
+    {
+    }
+
+    /**
+     * @brief Returns the adapted view.
+     */
+    V base() const
+    {
+        return m_base;
+    }
+
+    auto begin()
+    {
+        return std::make_reverse_iterator(std::ranges::end(m_base));
+    }
+
+    auto begin() const
+        requires std::ranges::bidirectional_range<const V> && std::ranges::common_range<const V>
+    {
+        return std::make_reverse_iterator(std::ranges::end(m_base));
+    }
+
+    auto end()
+    {
+        return std::make_reverse_iterator(std::ranges::begin(m_base));
+    }
+
+    auto end() const
+        requires std::ranges::bidirectional_range<const V> && std::ranges::common_range<const V>
+    {
+        return std::make_reverse_iterator(std::ranges::begin(m_base));
+    }
+
+    auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+private:
+    V m_base{}; ///< The adapted view.
+};
+
+template<typename R>
+ReverseViewN(R&&) -> ReverseViewN<std::views::all_t<R>>;
+
+/**
+ * @class StrideIteratorN
+ * @brief Iterator visiting every step-th position of a forward range.
+ *
+ * The iterator remembers how far its last move overshot the end of the range
+ * (missing), so that the end iterator of a random access range still sits a
+ * whole number of steps from begin and differences stay exact.
+ *
+ * @tparam Base The (possibly const) adapted view.
+ * @tparam Chunked Whether dereferencing yields the step elements starting at
+ *         the position (a std::ranges::subrange) instead of the single element.
+ */
+template<std::ranges::forward_range Base, bool Chunked>
+class StrideIteratorN
+{
+    using BaseIterator = std::ranges::iterator_t<Base>;
+    using BaseSentinel = std::ranges::sentinel_t<Base>;
+    using Reference = std::conditional_t<Chunked, std::ranges::subrange<BaseIterator>, std::ranges::range_reference_t<Base>>;
+
+public:
+    using iterator_concept = RangeIteratorConceptN<Base>;
+    using iterator_category = RangeIteratorCategoryN<Base, Reference>;
+    using value_type = std::conditional_t<Chunked, std::ranges::subrange<BaseIterator>, std::ranges::range_value_t<Base>>;
+    using difference_type = std::ranges::range_difference_t<Base>;
+    // Lets std::iterator_traits read the nested types instead of probing operator==: std is often an
+    // associated namespace of Base, and its operator==(unreachable_sentinel_t, const I&) makes that probe recursive.
+    using reference = Reference;
+
+    StrideIteratorN() = default;
+
+    /**
+     * @brief Constructs an iterator at current.
+     *
+     * @param current Position in the adapted range.
+     * @param end End of the adapted range.
+     * @param step Positions between two visited elements.
+     * @param missing How far the last move overshot end.
+     */
+    StrideIteratorN(BaseIterator current, BaseSentinel end, difference_type step, difference_type missing = 0)
+        : m_current(std::move(current)), m_end(std::move(end)), m_step(step), m_missing(missing)
+    {
+    }
+
+    /**
+     * @brief Returns the iterator of the adapted range.
+     */
+    const BaseIterator& base() const
+    {
+        return m_current;
+    }
+
+    Reference operator*() const
+    {
+        if constexpr (Chunked)
+            return Reference(m_current, std::ranges::next(m_current, m_step, m_end));
+        else
+            return *m_current;
+    }
+
+    Reference operator[](difference_type n) const
+        requires std::ranges::random_access_range<Base>
+    {
+        return *(*this + n);
+    }
+
+    StrideIteratorN& operator++()
+    {
+        m_missing = std::ranges::advance(m_current, m_step, m_end);
+        return *this;
+    }
+
+    StrideIteratorN operator++(int)
+    {
+        StrideIteratorN tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    StrideIteratorN& operator--()
+        requires std::ranges::bidirectional_range<Base>
+    {
+        std::ranges::advance(m_current, m_missing - m_step);
+        m_missing = 0;
+        return *this;
+    }
+
+    StrideIteratorN operator--(int)
+        requires std::ranges::bidirectional_range<Base>
+    {
+        StrideIteratorN tmp(*this);
+        --*this;
+        return tmp;
+    }
+
+    StrideIteratorN& operator+=(difference_type n)
+        requires std::ranges::random_access_range<Base>
+    {
+        if (n > 0)
+        {
+            m_missing = std::ranges::advance(m_current, m_step * n, m_end);
+        }
+        else if (n < 0)
+        {
+            std::ranges::advance(m_current, m_step * n + m_missing);
+            m_missing = 0;
+        }
+        return *this;
+    }
+
+    StrideIteratorN& operator-=(difference_type n)
+        requires std::ranges::random_access_range<Base>
+    {
+        return *this += -n;
+    }
+
+    friend StrideIteratorN operator+(StrideIteratorN it, difference_type n)
+        requires std::ranges::random_access_range<Base>
+    {
+        return it += n;
+    }
+
+    friend StrideIteratorN operator+(difference_type n, StrideIteratorN it)
+        requires std::ranges::random_access_range<Base>
+    {
+        return it += n;
+    }
+
+    friend StrideIteratorN operator-(StrideIteratorN it, difference_type n)
+        requires std::ranges::random_access_range<Base>
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const StrideIteratorN& lhs, const StrideIteratorN& rhs)
+        requires std::sized_sentinel_for<BaseIterator, BaseIterator>
+    {
+        const difference_type distance = (lhs.m_current - rhs.m_current) + (lhs.m_missing - rhs.m_missing);
+        return distance / lhs.m_step;
+    }
+
+    friend bool operator==(const StrideIteratorN& lhs, const StrideIteratorN& rhs)
+        requires std::equality_comparable<BaseIterator>
+    {
+        return lhs.m_current == rhs.m_current;
+    }
+
+    friend auto operator<=>(const StrideIteratorN& lhs, const StrideIteratorN& rhs)
+        requires std::ranges::random_access_range<Base> && std::three_way_comparable<BaseIterator>
+    {
+        return lhs.m_current <=> rhs.m_current;
+    }
+
+private:
+    BaseIterator m_current{};    ///< Position in the adapted range.
+    BaseSentinel m_end{};        ///< End of the adapted range.
+    difference_type m_step = 1;  ///< Positions between two visited elements.
+    difference_type m_missing = 0; ///< How far the last move overshot m_end.
+};
+
+/**
+ * @class StrideViewN
+ * @brief View of every step-th element of a range, or of its consecutive chunks of step elements.
+ *
+ * @tparam V The adapted view.
+ * @tparam Chunked Whether the elements are chunks (see StrideIteratorN).
+ */
+template<std::ranges::view V, bool Chunked>
+    requires std::ranges::forward_range<V>
+class StrideViewN : public std::ranges::view_interface<StrideViewN<V, Chunked>>
+{
+    using difference_type = std::ranges::range_difference_t<V>;
+
+public:
+    StrideViewN()
+        requires std::default_initializable<V> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param base The adapted view.
+     * @param step Positions between two visited elements, or chunk length. Must be positive.
+     */
+    StrideViewN(V base, difference_type step)
+        : m_base(std::move(base)), m_step(step)
+    {
+    }
+
+    /**
+     * @brief Returns the adapted view.
+     */
+    V base() const
+    {
+        return m_base;
+    }
+
+    /**
+     * @brief Returns the distance between two visited positions.
+     */
+    difference_type step() const
+    {
+        return m_step;
+    }
+
+    auto begin()
+    {
+        return makeBegin<V>(m_base, m_step);
+    }
+
+    auto begin() const
+        requires std::ranges::forward_range<const V>
+    {
+        return makeBegin<const V>(m_base, m_step);
+    }
+
+    auto end()
+    {
+        return makeEnd<V>(m_base, m_step);
+    }
+
+    auto end() const
+        requires std::ranges::forward_range<const V>
+    {
+        return makeEnd<const V>(m_base, m_step);
+    }
+
+    auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return divideCeil(std::ranges::size(m_base));
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return divideCeil(std::ranges::size(m_base));
+    }
+
+private:
+    template<typename Base>
+    static StrideIteratorN<Base, Chunked> makeBegin(Base& base, difference_type step)
+    {
+        return StrideIteratorN<Base, Chunked>(std::ranges::begin(base), std::ranges::end(base), step);
+    }
+
+    template<typename Base>
+    static auto makeEnd(Base& base, difference_type step)
+    {
+        if constexpr (std::ranges::common_range<Base> && std::ranges::sized_range<Base>)
+        {
+            const auto size = static_cast<difference_type>(std::ranges::size(base));
+            const difference_type missing = (step - size % step) % step;
+            return StrideIteratorN<Base, Chunked>(std::ranges::end(base), std::ranges::end(base), step, missing);
+        }
+        else if constexpr (std::ranges::common_range<Base> && !std::ranges::bidirectional_range<Base>)
+        {
+            return StrideIteratorN<Base, Chunked>(std::ranges::end(base), std::ranges::end(base), step);
+        }
+        else
+        {
+            return AdaptedSentinelN<std::ranges::sentinel_t<Base>>(std::ranges::end(base));
+        }
+    }
+
+    template<typename Size>
+    Size divideCeil(Size size) const
+    {
+        const auto step = static_cast<Size>(m_step);
+        return (size + step - 1) / step;
+    }
+
+    V m_base{};                 ///< The adapted view.
+    difference_type m_step = 1; ///< Positions between two visited elements.
+};
+
+template<typename R>
+StrideViewN(R&&, std::ranges::range_difference_t<R>) -> StrideViewN<std::views::all_t<R>, false>;
+
+/**
+ * @brief Every step-th element of a range.
+ */
+template<typename V>
+using StridedViewN = StrideViewN<V, false>;
+
+/**
+ * @brief Consecutive chunks of step elements of a range; the last one may be shorter.
+ */
+template<typename V>
+using ChunkViewN = StrideViewN<V, true>;
+
+/**
+ * @struct EnumeratedN
+ * @brief Element of an enumerated() range: the position and the element.
+ *
+ * Works with structured bindings: for (auto [index, value] : range | enumerated()).
+ *
+ * @tparam T The element type, a reference when the element is read in place.
+ */
+template<typename T>
+struct EnumeratedN
+{
+    std::size_t index; ///< Position of the element.
+    T value;           ///< The element.
+
+    EnumeratedN(std::size_t i, T v)
+        : index(i), value(std::forward<T>(v))
+    {
+    }
+
+    template<typename U>
+        requires (!std::is_same_v<T, U> && std::is_constructible_v<T, U&>)
+    EnumeratedN(EnumeratedN<U>& other)
+        : index(other.index), value(other.value)
+    {
+    }
+
+    template<typename U>
+        requires (!std::is_same_v<T, U> && std::is_constructible_v<T, const U&>)
+    EnumeratedN(const EnumeratedN<U>& other)
+        : index(other.index), value(other.value)
+    {
+    }
+
+    template<typename U>
+        requires (!std::is_same_v<T, U> && std::is_constructible_v<T, U>)
+    EnumeratedN(EnumeratedN<U>&& other)
+        : index(other.index), value(std::forward<U>(other.value))
+    {
+    }
+};
+
+/**
+ * @class EnumerateViewN
+ * @brief View pairing every element of a range with its position.
+ *
+ * @tparam V The adapted view.
+ */
+template<std::ranges::view V>
+    requires std::ranges::input_range<V>
+class EnumerateViewN : public std::ranges::view_interface<EnumerateViewN<V>>
+{
+    template<bool Const>
+    class Iterator
+    {
+        using Base = MaybeConstN<Const, V>;
+        using BaseIterator = std::ranges::iterator_t<Base>;
+        using Reference = EnumeratedN<std::ranges::range_reference_t<Base>>;
+
+    public:
+        using iterator_concept = RangeIteratorConceptN<Base>;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = EnumeratedN<std::ranges::range_value_t<Base>>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        Iterator() = default;
+
+        Iterator(BaseIterator current, std::size_t index)
+            : m_current(std::move(current)), m_index(index)
+        {
+        }
+
+        /**
+         * @brief Returns the iterator of the adapted range.
+         */
+        const BaseIterator& base() const
+        {
+            return m_current;
+        }
+
+        /**
+         * @brief Returns the position of the current element.
+         */
+        std::size_t index() const
+        {
+            return m_index;
+        }
+
+        Reference operator*() const
+        {
+            return Reference(m_index, *m_current);
+        }
+
+        Reference operator[](difference_type n) const
+            requires std::ranges::random_access_range<Base>
+        {
+            return Reference(m_index + static_cast<std::size_t>(n), m_current[n]);
+        }
+
+        Iterator& operator++()
+        {
+            ++m_current;
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        Iterator& operator--()
+            requires std::ranges::bidirectional_range<Base>
+        {
+            --m_current;
+            --m_index;
+            return *this;
+        }
+
+        Iterator operator--(int)
+            requires std::ranges::bidirectional_range<Base>
+        {
+            Iterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        Iterator& operator+=(difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            m_current += n;
+            m_index += static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            return *this += -n;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+            requires std::ranges::random_access_range<Base>
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+
+        friend std::strong_ordering operator<=>(const Iterator& lhs, const Iterator& rhs)
+        {
+            return lhs.m_index <=> rhs.m_index;
+        }
+
+    private:
+        BaseIterator m_current{}; ///< Position in the adapted range.
+        std::size_t m_index = 0;  ///< Index of the current element.
+    };
+
+public:
+    EnumerateViewN()
+        requires std::default_initializable<V> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param base The adapted view.
+     */
+    explicit EnumerateViewN(V base)
+        : m_base(std::move(base))
+    {
+    }
+
+    /**
+     * @brief Returns the adapted view.
+     */
+    V base() const
+    {
+        return m_base;
+    }
+
+    Iterator<false> begin()
+    {
+        return Iterator<false>(std::ranges::begin(m_base), 0);
+    }
+
+    Iterator<true> begin() const
+        requires std::ranges::input_range<const V>
+    {
+        return Iterator<true>(std::ranges::begin(m_base), 0);
+    }
+
+    auto end()
+    {
+        if constexpr (std::ranges::common_range<V> && std::ranges::sized_range<V>)
+            return Iterator<false>(std::ranges::end(m_base), std::ranges::size(m_base));
+        else
+            return AdaptedSentinelN<std::ranges::sentinel_t<V>>(std::ranges::end(m_base));
+    }
+
+    auto end() const
+        requires std::ranges::input_range<const V>
+    {
+        if constexpr (std::ranges::common_range<const V> && std::ranges::sized_range<const V>)
+            return Iterator<true>(std::ranges::end(m_base), std::ranges::size(m_base));
+        else
+            return AdaptedSentinelN<std::ranges::sentinel_t<const V>>(std::ranges::end(m_base));
+    }
+
+    auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(m_base);
+    }
+
+private:
+    V m_base{}; ///< The adapted view.
+};
+
+template<typename R>
+EnumerateViewN(R&&) -> EnumerateViewN<std::views::all_t<R>>;
+
+/**
+ * @struct ZippedN
+ * @brief Element of a zip() range: one element of each range.
+ *
+ * When the members are references, assigning to a ZippedN (even a const one)
+ * writes through them, which lets std::ranges::sort reorder two ranges
+ * together: std::ranges::sort(zip(keys, values), {}, [](const auto& z) { return z.first; }).
+ *
+ * @tparam A The element type of the first range.
+ * @tparam B The element type of the second range.
+ */
+template<typename A, typename B>
+struct ZippedN
+{
+    A first;  ///< Element of the first range.
+    B second; ///< Element of the second range.
+
+    ZippedN(A a, B b)
+        : first(std::forward<A>(a)), second(std::forward<B>(b))
+    {
+    }
+
+    ZippedN(const ZippedN&) = default;
+
+    template<typename C, typename D>
+        requires (!std::is_same_v<ZippedN<C, D>, ZippedN> && std::is_constructible_v<A, C&> && std::is_constructible_v<B, D&>)
+    ZippedN(ZippedN<C, D>& other)
+        : first(other.first), second(other.second)
+    {
+    }
+
+    template<typename C, typename D>
+        requires (!std::is_same_v<ZippedN<C, D>, ZippedN> && std::is_constructible_v<A, const C&>
+            && std::is_constructible_v<B, const D&>)
+    ZippedN(const ZippedN<C, D>& other)
+        : first(other.first), second(other.second)
+    {
+    }
+
+    template<typename C, typename D>
+        requires (!std::is_same_v<ZippedN<C, D>, ZippedN> && std::is_constructible_v<A, C> && std::is_constructible_v<B, D>)
+    ZippedN(ZippedN<C, D>&& other)
+        : first(std::forward<C>(other.first)), second(std::forward<D>(other.second))
+    {
+    }
+
+    ZippedN& operator=(const ZippedN& other)
+    {
+        first = other.first;
+        second = other.second;
+        return *this;
+    }
+
+    /**
+     * @brief Assigns through reference members, including from a temporary ZippedN.
+     */
+    template<typename C, typename D>
+        requires (std::is_reference_v<A> && std::is_reference_v<B> && std::is_assignable_v<A, C> && std::is_assignable_v<B, D>)
+    const ZippedN& operator=(ZippedN<C, D>&& other) const
+    {
+        first = std::forward<C>(other.first);
+        second = std::forward<D>(other.second);
+        return *this;
+    }
+
+    template<typename C, typename D>
+        requires (std::is_reference_v<A> && std::is_reference_v<B> && std::is_assignable_v<A, const C&>
+            && std::is_assignable_v<B, const D&>)
+    const ZippedN& operator=(const ZippedN<C, D>& other) const
+    {
+        first = other.first;
+        second = other.second;
+        return *this;
+    }
+
+    template<typename C, typename D>
+        requires (std::is_assignable_v<A&, C> && std::is_assignable_v<B&, D>)
+    ZippedN& operator=(ZippedN<C, D>&& other)
+    {
+        first = std::forward<C>(other.first);
+        second = std::forward<D>(other.second);
+        return *this;
+    }
+
+    template<typename C, typename D>
+        requires (!std::is_same_v<ZippedN<C, D>, ZippedN> && std::is_assignable_v<A&, const C&>
+            && std::is_assignable_v<B&, const D&>)
+    ZippedN& operator=(const ZippedN<C, D>& other)
+    {
+        first = other.first;
+        second = other.second;
+        return *this;
+    }
+
+    /**
+     * @brief Swaps the referenced elements, for algorithms that swap dereferenced iterators.
+     */
+    friend void swap(const ZippedN& lhs, const ZippedN& rhs)
+        requires (std::is_reference_v<A> && std::is_reference_v<B>)
+    {
+        using std::swap;
+        swap(lhs.first, rhs.first);
+        swap(lhs.second, rhs.second);
+    }
+};
+
+namespace std
+{
+    /**
+     * @brief Common reference of two EnumeratedN, needed for their iterators to be readable.
+     */
+    template<typename T, typename U, template<typename> class TQ, template<typename> class UQ>
+        requires requires { typename std::common_reference_t<TQ<T>, UQ<U>>; }
+    struct basic_common_reference<EnumeratedN<T>, EnumeratedN<U>, TQ, UQ>
+    {
+        using type = EnumeratedN<std::common_reference_t<TQ<T>, UQ<U>>>;
+    };
+
+    /**
+     * @brief Common reference of two ZippedN, needed for their iterators to be readable.
+     */
+    template<typename A, typename B, typename C, typename D, template<typename> class TQ, template<typename> class UQ>
+        requires requires { typename std::common_reference_t<TQ<A>, UQ<C>>; typename std::common_reference_t<TQ<B>, UQ<D>>; }
+    struct basic_common_reference<ZippedN<A, B>, ZippedN<C, D>, TQ, UQ>
+    {
+        using type = ZippedN<std::common_reference_t<TQ<A>, UQ<C>>, std::common_reference_t<TQ<B>, UQ<D>>>;
+    };
+}
+
+/**
+ * @class ZipViewN
+ * @brief View of the pairs of elements at the same position in two ranges.
+ *
+ * Stops at the end of the shorter range. Iterators are random access when both
+ * ranges are, and the pairs can be written through, so algorithms that
+ * permute (sort, reverse, rotate) move the elements of both ranges together.
+ *
+ * @tparam V1 The first adapted view.
+ * @tparam V2 The second adapted view.
+ */
+template<std::ranges::view V1, std::ranges::view V2>
+    requires std::ranges::input_range<V1> && std::ranges::input_range<V2>
+class ZipViewN : public std::ranges::view_interface<ZipViewN<V1, V2>>
+{
+    template<bool Const>
+    class Sentinel;
+
+    template<bool Const>
+    class Iterator
+    {
+        using Base1 = MaybeConstN<Const, V1>;
+        using Base2 = MaybeConstN<Const, V2>;
+        using Iterator1 = std::ranges::iterator_t<Base1>;
+        using Iterator2 = std::ranges::iterator_t<Base2>;
+        using Reference = ZippedN<std::ranges::range_reference_t<Base1>, std::ranges::range_reference_t<Base2>>;
+        using RvalueReference = ZippedN<std::ranges::range_rvalue_reference_t<Base1>, std::ranges::range_rvalue_reference_t<Base2>>;
+        static constexpr bool RandomAccess = std::ranges::random_access_range<Base1> && std::ranges::random_access_range<Base2>;
+
+        friend class Sentinel<Const>;
+
+    public:
+        using iterator_concept = std::conditional_t<RandomAccess, std::random_access_iterator_tag,
+            std::conditional_t<std::ranges::bidirectional_range<Base1> && std::ranges::bidirectional_range<Base2>,
+                std::bidirectional_iterator_tag,
+            std::conditional_t<std::ranges::forward_range<Base1> && std::ranges::forward_range<Base2>,
+                std::forward_iterator_tag, std::input_iterator_tag>>>;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ZippedN<std::ranges::range_value_t<Base1>, std::ranges::range_value_t<Base2>>;
+        using difference_type = std::common_type_t<std::ranges::range_difference_t<Base1>, std::ranges::range_difference_t<Base2>>;
+
+        Iterator() = default;
+
+        Iterator(Iterator1 first, Iterator2 second)
+            : m_first(std::move(first)), m_second(std::move(second))
+        {
+        }
+
+        Reference operator*() const
+        {
+            return Reference(*m_first, *m_second);
+        }
+
+        Reference operator[](difference_type n) const
+            requires RandomAccess
+        {
+            return Reference(m_first[n], m_second[n]);
+        }
+
+        Iterator& operator++()
+        {
+            ++m_first;
+            ++m_second;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        Iterator& operator--()
+            requires std::ranges::bidirectional_range<Base1> && std::ranges::bidirectional_range<Base2>
+        {
+            --m_first;
+            --m_second;
+            return *this;
+        }
+
+        Iterator operator--(int)
+            requires std::ranges::bidirectional_range<Base1> && std::ranges::bidirectional_range<Base2>
+        {
+            Iterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+
+        Iterator& operator+=(difference_type n)
+            requires RandomAccess
+        {
+            m_first += static_cast<std::ranges::range_difference_t<Base1>>(n);
+            m_second += static_cast<std::ranges::range_difference_t<Base2>>(n);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n)
+            requires RandomAccess
+        {
+            return *this += -n;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+            requires RandomAccess
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+            requires RandomAccess
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+            requires RandomAccess
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            requires std::sized_sentinel_for<Iterator1, Iterator1>
+        {
+            return static_cast<difference_type>(lhs.m_first - rhs.m_first);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            requires std::equality_comparable<Iterator1>
+        {
+            return lhs.m_first == rhs.m_first;
+        }
+
+        friend auto operator<=>(const Iterator& lhs, const Iterator& rhs)
+            requires RandomAccess && std::three_way_comparable<Iterator1>
+        {
+            return lhs.m_first <=> rhs.m_first;
+        }
+
+        /**
+         * @brief Moves out of both elements, for algorithms that permute the view.
+         */
+        friend RvalueReference iter_move(const Iterator& it)
+        {
+            return RvalueReference(std::ranges::iter_move(it.m_first), std::ranges::iter_move(it.m_second));
+        }
+
+        /**
+         * @brief Swaps both elements, for algorithms that permute the view.
+         */
+        friend void iter_swap(const Iterator& lhs, const Iterator& rhs)
+            requires std::indirectly_swappable<Iterator1> && std::indirectly_swappable<Iterator2>
+        {
+            std::ranges::iter_swap(lhs.m_first, rhs.m_first);
+            std::ranges::iter_swap(lhs.m_second, rhs.m_second);
+        }
+
+    private:
+        Iterator1 m_first{};  ///< Position in the first range.
+        Iterator2 m_second{}; ///< Position in the second range.
+    };
+
+    /**
+     * @brief End of a zip whose ranges are not both sized and random access: reached when either range ends.
+     */
+    template<bool Const>
+    class Sentinel
+    {
+        using Sentinel1 = std::ranges::sentinel_t<MaybeConstN<Const, V1>>;
+        using Sentinel2 = std::ranges::sentinel_t<MaybeConstN<Const, V2>>;
+
+    public:
+        Sentinel() = default;
+
+        Sentinel(Sentinel1 first, Sentinel2 second)
+            : m_first(std::move(first)), m_second(std::move(second))
+        {
+        }
+
+        friend bool operator==(const Iterator<Const>& it, const Sentinel& sentinel)
+        {
+            return sentinel.reachedBy(it);
+        }
+
+    private:
+        bool reachedBy(const Iterator<Const>& it) const
+        {
+            return it.m_first == m_first || it.m_second == m_second;
+        }
+
+        Sentinel1 m_first{};  ///< End of the first range.
+        Sentinel2 m_second{}; ///< End of the second range.
+    };
+
+    template<typename Base1, typename Base2>
+    static constexpr bool SizedRandomAccess = std::ranges::random_access_range<Base1> && std::ranges::sized_range<Base1>
+        && std::ranges::random_access_range<Base2> && std::ranges::sized_range<Base2>;
+
+public:
+    ZipViewN()
+        requires std::default_initializable<V1> && std::default_initializable<V2> = default;
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param first The first adapted view.
+     * @param second The second adapted view.
+     */
+    ZipViewN(V1 first, V2 second)
+        : m_first(std::move(first)), m_second(std::move(second))
+    {
+    }
+
+    Iterator<false> begin()
+    {
+        return Iterator<false>(std::ranges::begin(m_first), std::ranges::begin(m_second));
+    }
+
+    Iterator<true> begin() const
+        requires std::ranges::input_range<const V1> && std::ranges::input_range<const V2>
+    {
+        return Iterator<true>(std::ranges::begin(m_first), std::ranges::begin(m_second));
+    }
+
+    auto end()
+    {
+        if constexpr (SizedRandomAccess<V1, V2>)
+            return begin() + static_cast<std::ranges::range_difference_t<V1>>(size());
+        else
+            return Sentinel<false>(std::ranges::end(m_first), std::ranges::end(m_second));
+    }
+
+    auto end() const
+        requires std::ranges::input_range<const V1> && std::ranges::input_range<const V2>
+    {
+        if constexpr (SizedRandomAccess<const V1, const V2>)
+            return begin() + static_cast<std::ranges::range_difference_t<const V1>>(size());
+        else
+            return Sentinel<true>(std::ranges::end(m_first), std::ranges::end(m_second));
+    }
+
+    auto size()
+        requires std::ranges::sized_range<V1> && std::ranges::sized_range<V2>
+    {
+        using Size = std::common_type_t<std::ranges::range_size_t<V1>, std::ranges::range_size_t<V2>>;
+        return std::min<Size>(std::ranges::size(m_first), std::ranges::size(m_second));
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V1> && std::ranges::sized_range<const V2>
+    {
+        using Size = std::common_type_t<std::ranges::range_size_t<const V1>, std::ranges::range_size_t<const V2>>;
+        return std::min<Size>(std::ranges::size(m_first), std::ranges::size(m_second));
+    }
+
+private:
+    V1 m_first{};  ///< The first adapted view.
+    V2 m_second{}; ///< The second adapted view.
+};
+
+template<typename R1, typename R2>
+ZipViewN(R1&&, R2&&) -> ZipViewN<std::views::all_t<R1>, std::views::all_t<R2>>;
+
+/**
+ * @brief Returns a view of fn(element) for every element of range.
+ */
+template<std::ranges::viewable_range R, typename F>
+auto transformed(R&& range, F fn)
+{
+    return TransformViewN(std::forward<R>(range), std::move(fn));
+}
+
+/**
+ * @brief Returns an adaptor applying fn to every element: range | transformed(fn).
+ */
+template<typename F>
+auto transformed(F fn)
+{
+    return RangeAdaptorClosureN([fn = std::move(fn)]<typename R>(R&& range) {
+        return transformed(std::forward<R>(range), fn);
+    });
+}
+
+/**
+ * @brief Returns a view of the elements of range satisfying pred.
+ */
+template<std::ranges::viewable_range R, typename Pred>
+auto filtered(R&& range, Pred pred)
+{
+    return FilterViewN(std::forward<R>(range), std::move(pred));
+}
+
+/**
+ * @brief Returns an adaptor keeping the elements satisfying pred: range | filtered(pred).
+ */
+template<typename Pred>
+auto filtered(Pred pred)
+{
+    return RangeAdaptorClosureN([pred = std::move(pred)]<typename R>(R&& range) {
+        return filtered(std::forward<R>(range), pred);
+    });
+}
+
+/**
+ * @brief Returns a view of the elements of a bidirectional range in reverse order.
+ */
+template<std::ranges::viewable_range R>
+auto reversed(R&& range)
+{
+    return ReverseViewN(std::forward<R>(range));
+}
+
+/**
+ * @brief Returns an adaptor reversing a range: range | reversed().
+ */
+inline auto reversed()
+{
+    return RangeAdaptorClosureN([]<typename R>(R&& range) { return reversed(std::forward<R>(range)); });
+}
+
+/**
+ * @brief Returns a view of every step-th element of range, starting with the first.
+ */
+template<std::ranges::viewable_range R>
+auto strided(R&& range, std::ranges::range_difference_t<R> step)
+{
+    return StridedViewN<std::views::all_t<R>>(std::views::all(std::forward<R>(range)), step);
+}
+
+/**
+ * @brief Returns an adaptor keeping every step-th element: range | strided(step).
+ */
+inline auto strided(std::ptrdiff_t step)
+{
+    return RangeAdaptorClosureN([step]<typename R>(R&& range) {
+        return strided(std::forward<R>(range), static_cast<std::ranges::range_difference_t<R>>(step));
+    });
+}
+
+/**
+ * @brief Returns a view of the consecutive chunks of size elements of range.
+ */
+template<std::ranges::viewable_range R>
+auto chunked(R&& range, std::ranges::range_difference_t<R> size)
+{
+    return ChunkViewN<std::views::all_t<R>>(std::views::all(std::forward<R>(range)), size);
+}
+
+/**
+ * @brief Returns an adaptor splitting a range into chunks: range | chunked(size).
+ */
+inline auto chunked(std::ptrdiff_t size)
+{
+    return RangeAdaptorClosureN([size]<typename R>(R&& range) {
+        return chunked(std::forward<R>(range), static_cast<std::ranges::range_difference_t<R>>(size));
+    });
+}
+
+/**
+ * @brief Returns a view pairing every element of range with its position.
+ */
+template<std::ranges::viewable_range R>
+auto enumerated(R&& range)
+{
+    return EnumerateViewN(std::forward<R>(range));
+}
+
+/**
+ * @brief Returns an adaptor pairing elements with their positions: range | enumerated().
+ */
+inline auto enumerated()
+{
+    return RangeAdaptorClosureN([]<typename R>(R&& range) { return enumerated(std::forward<R>(range)); });
+}
+
+/**
+ * @brief Returns a view of the pairs of elements at the same position in two ranges.
+ */
+template<std::ranges::viewable_range R1, std::ranges::viewable_range R2>
+auto zip(R1&& first, R2&& second)
+{
+    return ZipViewN(std::forward<R1>(first), std::forward<R2>(second));
+}
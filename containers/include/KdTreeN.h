@@ -0,0 +1,404 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include "VectorN.h"
+#include "VecteurND.h"
+
+/**
+ * @brief A static k-d tree over a set of VectorND points.
+ *
+ * The tree is built once from a point set and then answers nearest-neighbour,
+ * k-nearest-neighbour and radius queries. Nodes live in one flat array in
+ * depth-first order (the left child of node i is always i + 1), and the points
+ * are copied into leaf order so that every leaf scans a contiguous block with
+ * VectorND::distanceSquared. Construction splits at the median along the axis
+ * of largest spread, and the upper levels are built on separate threads.
+ *
+ * @tparam T Type of the coordinates.
+ * @tparam N Number of dimensions.
+ */
+template<typename T, std::size_t N>
+class KdTreeN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using point_type = VectorND<T, N>;
+
+    /**
+     * @brief A query result: index of the point in the input set and its squared distance.
+     */
+    struct Neighbor
+    {
+        size_type index;    ///< Index of the point in the point set given at construction.
+        T distanceSquared;  ///< Squared distance to the query point.
+    };
+
+    /**
+     * @brief Builds an empty tree.
+     */
+    KdTreeN()
+        : m_leafSize(DefaultLeafSize)
+    {
+    }
+
+    /**
+     * @brief Builds the tree over a span of points.
+     *
+     * @param points Points to index. They are copied into the tree.
+     * @param leafSize Maximum number of points stored in a leaf.
+     * @param threadCount Number of threads used for construction (0 = hardware concurrency).
+     * @throws std::runtime_error if leafSize is 0 or there are more than 2^32 - 1 points.
+     */
+    explicit KdTreeN(std::span<const point_type> points, size_type leafSize = DefaultLeafSize, size_type threadCount = 0)
+        : m_leafSize(leafSize)
+    {
+        build(points, threadCount);
+    }
+
+    /**
+     * @brief Builds the tree over a VectorN of points.
+     *
+     * @param points Points to index. They are copied into the tree.
+     * @param leafSize Maximum number of points stored in a leaf.
+     * @param threadCount Number of threads used for construction (0 = hardware concurrency).
+     * @throws std::runtime_error if leafSize is 0 or there are more than 2^32 - 1 points.
+     */
+    explicit KdTreeN(const VectorN<point_type>& points, size_type leafSize = DefaultLeafSize, size_type threadCount = 0)
+        : KdTreeN(std::span<const point_type>(points.data(), points.size()), leafSize, threadCount)
+    {
+    }
+
+    /**
+     * @brief Returns the number of indexed points.
+     */
+    size_type size() const
+    {
+        return m_points.size();
+    }
+
+    /**
+     * @brief Checks if the tree indexes no point.
+     */
+    bool empty() const
+    {
+        return m_points.empty();
+    }
+
+    /**
+     * @brief Returns the number of nodes in the flat node array.
+     */
+    size_type nodeCount() const
+    {
+        return m_nodes.size();
+    }
+
+    /**
+     * @brief Finds the closest point to a query point.
+     *
+     * @param query Query point.
+     * @return Closest point of the set.
+     * @throws std::runtime_error if the tree is empty.
+     */
+    Neighbor nearest(const point_type& query) const
+    {
+        if (empty())
+            throw std::runtime_error("KdTreeN::nearest on an empty tree");
+        VectorN<Neighbor> result = knn(query, 1);
+        return result[0];
+    }
+
+    /**
+     * @brief Finds the k closest points to a query point.
+     *
+     * @param query Query point.
+     * @param k Number of neighbours to return.
+     * @return Up to k neighbours sorted by increasing distance.
+     */
+    VectorN<Neighbor> knn(const point_type& query, size_type k) const
+    {
+        VectorN<Neighbor> heap;
+        if (k == 0 || empty())
+            return heap;
+        heap.reserve(std::min(k, size()));
+
+        auto closer = [](const Neighbor& a, const Neighbor& b) { return a.distanceSquared < b.distanceSquared; };
+        const T* q = query.data();
+
+        StackEntry stack[MaxDepth];
+        size_type top = 0;
+        stack[top++] = { 0, T{} };
+
+        while (top > 0)
+        {
+            StackEntry entry = stack[--top];
+            if (heap.size() == k && entry.bound >= heap.front().distanceSquared)
+                continue;
+
+            std::uint32_t nodeIndex = entry.node;
+            while (m_nodes[nodeIndex].axis != LeafAxis)
+            {
+                const KdNode& node = m_nodes[nodeIndex];
+                T diff = q[node.axis] - node.split;
+                std::uint32_t nearChild = diff < T{} ? nodeIndex + 1 : node.first;
+                std::uint32_t farChild = diff < T{} ? node.first : nodeIndex + 1;
+                T bound = std::max(entry.bound, diff * diff);
+                if (heap.size() < k || bound < heap.front().distanceSquared)
+                    stack[top++] = { farChild, bound };
+                nodeIndex = nearChild;
+            }
+
+            const KdNode& leaf = m_nodes[nodeIndex];
+            for (std::uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+            {
+                T d = point_type::distanceSquared(query, m_points[i]);
+                if (heap.size() < k)
+                {
+                    heap.push_back(Neighbor{ m_indices[i], d });
+                    std::push_heap(heap.begin(), heap.end(), closer);
+                }
+                else if (d < heap.front().distanceSquared)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), closer);
+                    heap.back() = Neighbor{ m_indices[i], d };
+                    std::push_heap(heap.begin(), heap.end(), closer);
+                }
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end(), closer);
+        return heap;
+    }
+
+    /**
+     * @brief Calls a function for every point within a radius of a query point.
+     *
+     * @tparam Fn Callable as fn(const Neighbor&).
+     * @param query Query point.
+     * @param radius Search radius (inclusive).
+     * @param fn Function called for each point found, in no particular order.
+     */
+    template<typename Fn>
+    void forEachInRadius(const point_type& query, T radius, Fn fn) const
+    {
+        if (empty())
+            return;
+
+        const T r2 = radius * radius;
+        const T* q = query.data();
+
+        std::uint32_t stack[MaxDepth];
+        size_type top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            std::uint32_t nodeIndex = stack[--top];
+            while (m_nodes[nodeIndex].axis != LeafAxis)
+            {
+                const KdNode& node = m_nodes[nodeIndex];
+                T diff = q[node.axis] - node.split;
+                std::uint32_t nearChild = diff < T{} ? nodeIndex + 1 : node.first;
+                std::uint32_t farChild = diff < T{} ? node.first : nodeIndex + 1;
+                if (diff * diff <= r2)
+                    stack[top++] = farChild;
+                nodeIndex = nearChild;
+            }
+
+            const KdNode& leaf = m_nodes[nodeIndex];
+            for (std::uint32_t i = leaf.first; i < leaf.first + leaf.count; ++i)
+            {
+                T d = point_type::distanceSquared(query, m_points[i]);
+                if (d <= r2)
+                    fn(Neighbor{ m_indices[i], d });
+            }
+        }
+    }
+
+    /**
+     * @brief Finds every point within a radius of a query point.
+     *
+     * @param query Query point.
+     * @param radius Search radius (inclusive).
+     * @return Indices of the points found, in no particular order.
+     */
+    VectorN<size_type> radiusSearch(const point_type& query, T radius) const
+    {
+        VectorN<size_type> result;
+        forEachInRadius(query, radius, [&result](const Neighbor& n) { result.push_back(n.index); });
+        return result;
+    }
+
+private:
+    static constexpr size_type DefaultLeafSize = 16;                                   ///< Default maximum leaf size.
+    static constexpr std::uint32_t LeafAxis = std::numeric_limits<std::uint32_t>::max(); ///< Axis value marking a leaf.
+    static constexpr size_type MaxDepth = 64;                                           ///< Upper bound of the tree depth.
+    static constexpr size_type ParallelThreshold = 16384;                               ///< Minimum subtree size built on its own thread.
+
+    /**
+     * @brief A node of the flat tree.
+     *
+     * Internal nodes store the split plane and the index of the right child in first.
+     * Leaves store the range [first, first + count) of their points.
+     */
+    struct KdNode
+    {
+        T split;             ///< Split coordinate (internal nodes).
+        std::uint32_t axis;  ///< Split axis, or LeafAxis for a leaf.
+        std::uint32_t first; ///< Right child (internal nodes) or first point (leaves).
+        std::uint32_t count; ///< Number of points (leaves).
+    };
+
+    /**
+     * @brief A pending subtree during a k-nearest-neighbour search.
+     */
+    struct StackEntry
+    {
+        std::uint32_t node; ///< Subtree root.
+        T bound;            ///< Lower bound of the squared distance to the subtree.
+    };
+
+    /**
+     * @brief Builds the node array and the leaf-ordered point copy.
+     *
+     * @param points Source points.
+     * @param threadCount Number of threads used for construction (0 = hardware concurrency).
+     */
+    void build(std::span<const point_type> points, size_type threadCount)
+    {
+        if (m_leafSize == 0)
+            throw std::runtime_error("KdTreeN: leaf size must be at least 1");
+        if (points.size() >= std::numeric_limits<std::uint32_t>::max())
+            throw std::runtime_error("KdTreeN: too many points");
+        if (points.empty())
+            return;
+
+        if (threadCount == 0)
+            threadCount = std::max<size_type>(1, std::thread::hardware_concurrency());
+        size_type parallelDepth = 0;
+        while ((size_type(1) << parallelDepth) < threadCount)
+            ++parallelDepth;
+
+        const size_type count = points.size();
+        m_indices.resize(count);
+        for (size_type i = 0; i < count; ++i)
+            m_indices[i] = static_cast<std::uint32_t>(i);
+
+        std::unordered_map<size_type, size_type> subtreeSizes;
+        m_nodes.resize(subtreeNodeCount(count, subtreeSizes));
+
+        buildNode(points, 0, 0, count, 0, parallelDepth, subtreeSizes);
+
+        m_points.resize(count);
+        for (size_type i = 0; i < count; ++i)
+            m_points[i] = points[m_indices[i]];
+    }
+
+    /**
+     * @brief Computes the number of nodes of a subtree holding count points.
+     *
+     * The tree always splits at count / 2, so the shape only depends on count and
+     * every subtree can be assigned its slice of the node array up front.
+     *
+     * @param count Number of points of the subtree.
+     * @param memo Cache of already computed sizes.
+     * @return Number of nodes of the subtree.
+     */
+    size_type subtreeNodeCount(size_type count, std::unordered_map<size_type, size_type>& memo) const
+    {
+        if (count <= m_leafSize)
+            return 1;
+        auto it = memo.find(count);
+        if (it != memo.end())
+            return it->second;
+        size_type result = 1 + subtreeNodeCount(count / 2, memo) + subtreeNodeCount(count - count / 2, memo);
+        memo[count] = result;
+        return result;
+    }
+
+    /**
+     * @brief Recursively builds the subtree over m_indices[begin, end).
+     *
+     * @param points Source points.
+     * @param nodeIndex Index of the subtree root in m_nodes.
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param depth Depth of the subtree root.
+     * @param parallelDepth Depth up to which subtrees are built on separate threads.
+     * @param memo Subtree sizes computed by subtreeNodeCount.
+     */
+    void buildNode(std::span<const point_type> points, size_type nodeIndex, size_type begin, size_type end,
+        size_type depth, size_type parallelDepth, const std::unordered_map<size_type, size_type>& memo)
+    {
+        const size_type count = end - begin;
+        KdNode& node = m_nodes[nodeIndex];
+
+        if (count <= m_leafSize)
+        {
+            node.split = T{};
+            node.axis = LeafAxis;
+            node.first = static_cast<std::uint32_t>(begin);
+            node.count = static_cast<std::uint32_t>(count);
+            return;
+        }
+
+        T lo[N];
+        T hi[N];
+        const T* p0 = points[m_indices[begin]].data();
+        for (size_type d = 0; d < N; ++d)
+            lo[d] = hi[d] = p0[d];
+        for (size_type i = begin + 1; i < end; ++i)
+        {
+            const T* p = points[m_indices[i]].data();
+            for (size_type d = 0; d < N; ++d)
+            {
+                lo[d] = std::min(lo[d], p[d]);
+                hi[d] = std::max(hi[d], p[d]);
+            }
+        }
+        size_type axis = 0;
+        for (size_type d = 1; d < N; ++d)
+        {
+            if (hi[d] - lo[d] > hi[axis] - lo[axis])
+                axis = d;
+        }
+
+        const size_type mid = begin + count / 2;
+        std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end,
+            [&points, axis](std::uint32_t a, std::uint32_t b) { return points[a].data()[axis] < points[b].data()[axis]; });
+
+        const size_type leftCount = count / 2;
+        const size_type leftNodes = leftCount <= m_leafSize ? 1 : memo.at(leftCount);
+        const size_type rightIndex = nodeIndex + 1 + leftNodes;
+
+        node.split = points[m_indices[mid]].data()[axis];
+        node.axis = static_cast<std::uint32_t>(axis);
+        node.first = static_cast<std::uint32_t>(rightIndex);
+        node.count = 0;
+
+        if (depth < parallelDepth && count >= ParallelThreshold)
+        {
+            std::thread left([&, nodeIndex, begin, mid, depth]()
+            {
+                buildNode(points, nodeIndex + 1, begin, mid, depth + 1, parallelDepth, memo);
+            });
+            buildNode(points, rightIndex, mid, end, depth + 1, parallelDepth, memo);
+            left.join();
+        }
+        else
+        {
+            buildNode(points, nodeIndex + 1, begin, mid, depth + 1, parallelDepth, memo);
+            buildNode(points, rightIndex, mid, end, depth + 1, parallelDepth, memo);
+        }
+    }
+
+    size_type m_leafSize;                ///< Maximum number of points per leaf.
+    VectorN<KdNode> m_nodes;             ///< Flat node array in depth-first order.
+    VectorN<point_type> m_points;        ///< Points in leaf order.
+    VectorN<std::uint32_t> m_indices;    ///< Original index of each point in leaf order.
+};
@@ -4,15 +4,31 @@
 #include <initializer_list>
 #include <algorithm>
 #include <memory>
+#include <memory_resource>
 #include <limits>
 #include <iterator>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "AllocationStatsN.h"
 
 /**
  * @brief A doubly linked list implementation.
  *
+ * Nodes come from Allocator rebound to the node type, and elements are
+ * constructed with uses-allocator construction, so with a
+ * std::pmr::polymorphic_allocator both the nodes and whatever the elements
+ * allocate come from the same resource (see pmr::ListN). Copy, move and swap
+ * propagate the allocator as std::list does.
+ *
+ * With CONTAINERS_TRACK_ALLOCATIONS, every node allocation is reported to
+ * AllocationStatsN; the links of the nodes count as wasted bytes.
+ *
  * @tparam T The type of the elements in the list.
+ * @tparam Allocator Allocator of T, rebound for the nodes.
  */
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class ListN
 {
 private:
@@ -31,11 +47,83 @@ private:
          * @param value The value to store in the node.
          */
         Node(const T& value) : data(value), prev(nullptr), next(nullptr) {}
+
+        /**
+         * @brief Constructs a node with the given value, passing alloc to the value if it uses one.
+         *
+         * @param value The value to store in the node.
+         * @param alloc The allocator of the list.
+         */
+        template<typename Alloc>
+        Node(const T& value, const Alloc& alloc)
+            : data(std::make_obj_using_allocator<T>(alloc, value)), prev(nullptr), next(nullptr) {}
     };
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    static_assert(std::is_same_v<typename NodeTraits::pointer, Node*>, "ListN: the allocator must use raw pointers");
+
     Node* m_head;          ///< Pointer to the head of the list.
     Node* m_tail;          ///< Pointer to the tail of the list.
     std::size_t m_size;    ///< The number of elements in the list.
+    [[no_unique_address]] NodeAllocator m_alloc; ///< Allocator of the nodes.
+    [[no_unique_address]] AllocationTrackerN<ListN> m_track; ///< Allocation accounting, empty unless CONTAINERS_TRACK_ALLOCATIONS.
+
+    /**
+     * @brief Allocates and constructs an unlinked node holding value.
+     *
+     * @param value The value to store in the node.
+     * @return The new node.
+     */
+    Node* createNode(const T& value)
+    {
+        Node* node = NodeTraits::allocate(m_alloc, 1);
+        try
+        {
+            NodeTraits::construct(m_alloc, node, value, m_alloc);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(m_alloc, node, 1);
+            throw;
+        }
+        m_track.allocated(sizeof(Node));
+        return node;
+    }
+
+    /**
+     * @brief Destroys an unlinked node and gives its memory back to the allocator.
+     *
+     * @param node The node to destroy.
+     */
+    void destroyNode(Node* node)
+    {
+        NodeTraits::destroy(m_alloc, node);
+        NodeTraits::deallocate(m_alloc, node, 1);
+        m_track.deallocated();
+    }
+
+    /**
+     * @brief Takes the nodes of other, whose allocator can free them; other is left empty.
+     *
+     * @param other The list to take the nodes from.
+     */
+    void stealNodes(ListN& other)
+    {
+        m_head = std::exchange(other.m_head, nullptr);
+        m_tail = std::exchange(other.m_tail, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        trackUsage();
+        other.trackUsage();
+    }
+
+    /**
+     * @brief Reports the nodes held to the allocation tracker (no-op unless CONTAINERS_TRACK_ALLOCATIONS).
+     */
+    void trackUsage()
+    {
+        m_track.update(m_size * sizeof(Node), m_size * sizeof(T));
+    }
 
     /**
      * @brief Deletes all nodes in the list.
@@ -46,30 +134,89 @@ private:
             pop_back();
     }
 
+    /**
+     * @brief Returns the node before node, the tail when node is the end.
+     *
+     * @param node The current node, nullptr for the end of the list.
+     * @param tail The tail pointer of the list.
+     * @return The previous node.
+     * @throws std::out_of_range If node is the first node or the list is empty.
+     */
+    static Node* previous(const Node* node, Node* const* tail)
+    {
+        Node* prev = node ? node->prev : (tail ? *tail : nullptr);
+        if (!prev)
+            throw std::out_of_range("Cannot decrement iterator at the beginning of the list.");
+        return prev;
+    }
+
+    /**
+     * @brief Merges two sorted runs linked through next, taking from first on ties.
+     *
+     * @param first Run holding the earlier elements.
+     * @param second Run holding the later elements.
+     * @param comp Strict weak ordering on the elements.
+     * @return Head of the merged run.
+     */
+    template<typename Compare>
+    static Node* mergeRuns(Node* first, Node* second, Compare& comp)
+    {
+        Node* head = nullptr;
+        Node** link = &head;
+        while (first && second)
+        {
+            if (comp(second->data, first->data))
+            {
+                *link = second;
+                second = second->next;
+            }
+            else
+            {
+                *link = first;
+                first = first->next;
+            }
+            link = &(*link)->next;
+        }
+        *link = first ? first : second;
+        return head;
+    }
+
 public:
     using value_type = T;  ///< The type of the elements in the list.
+    using allocator_type = Allocator;         ///< The allocator type.
+    using size_type = std::size_t;            ///< An unsigned integral type used for sizes.
+    using difference_type = std::ptrdiff_t;   ///< A signed integral type used for distances.
+    using reference = value_type&;            ///< A reference to an element.
+    using const_reference = const value_type&; ///< A const reference to an element.
 
     /**
-     * @brief An iterator for the list.
+     * @brief A bidirectional iterator for the list.
+     *
+     * The end iterator remembers where the list keeps its tail, so that
+     * decrementing end() reaches the last element, as the standard
+     * bidirectional iterator requirements and std::ranges algorithms expect.
      */
     class iterator
     {
     public:
+        using iterator_category = std::bidirectional_iterator_tag; ///< The iterator category.
         using value_type = T;          ///< The type of the elements in the list.
+        using difference_type = std::ptrdiff_t; ///< The type of the distance between two iterators.
         using reference = value_type&; ///< Reference to an element.
         using pointer = value_type*;   ///< Pointer to an element.
 
         /**
          * @brief Constructs an iterator pointing to nullptr.
          */
-        iterator() : m_node(nullptr) {}
+        iterator() : m_node(nullptr), m_tail(nullptr) {}
 
         /**
          * @brief Constructs an iterator pointing to the given node.
          *
-         * @param node The node to point to.
+         * @param node The node to point to, nullptr for the end of the list.
+         * @param tail The tail pointer of the list, reached by decrementing the end iterator.
          */
-        explicit iterator(Node* node) : m_node(node) {}
+        iterator(Node* node, Node* const* tail) : m_node(node), m_tail(tail) {}
 
         /**
          * @brief Dereferences the iterator.
@@ -121,11 +268,7 @@ public:
          */
         iterator& operator--()
         {
-            if (!m_node)
-                throw std::out_of_range("Cannot decrement iterator when m_node is null.");
-            if (!m_node->prev)
-                throw std::out_of_range("Cannot decrement iterator at the beginning of the list.");
-            m_node = m_node->prev;
+            m_node = previous(m_node, m_tail);
             return *this;
         }
 
@@ -137,7 +280,7 @@ public:
         iterator operator--(int)
         {
             iterator tmp(*this);
-            m_node = m_node->prev;
+            --*this;
             return tmp;
         }
 
@@ -164,7 +307,8 @@ public:
         }
 
     private:
-        Node* m_node; ///< Pointer to the current node.
+        Node* m_node;        ///< Pointer to the current node.
+        Node* const* m_tail; ///< Tail pointer of the list.
         friend class const_iterator;
         friend class ListN;
     };
@@ -175,28 +319,31 @@ public:
     class const_iterator
     {
     public:
+        using iterator_category = std::bidirectional_iterator_tag; ///< The iterator category.
         using value_type = T;          ///< The type of the elements in the list.
+        using difference_type = std::ptrdiff_t; ///< The type of the distance between two iterators.
         using reference = const value_type&; ///< Reference to an element.
         using pointer = const value_type*;   ///< Pointer to an element.
 
         /**
          * @brief Constructs a constant iterator pointing to nullptr.
          */
-        const_iterator() : m_node(nullptr) {}
+        const_iterator() : m_node(nullptr), m_tail(nullptr) {}
 
         /**
          * @brief Constructs a constant iterator pointing to the given node.
          *
-         * @param node The node to point to.
+         * @param node The node to point to, nullptr for the end of the list.
+         * @param tail The tail pointer of the list, reached by decrementing the end iterator.
          */
-        explicit const_iterator(const Node* node) : m_node(node) {}
+        const_iterator(const Node* node, Node* const* tail) : m_node(node), m_tail(tail) {}
 
         /**
          * @brief Constructs a constant iterator from a non-constant iterator.
          *
          * @param it The non-constant iterator to copy from.
          */
-        const_iterator(const iterator& it) : m_node(it.m_node) {}
+        const_iterator(const iterator& it) : m_node(it.m_node), m_tail(it.m_tail) {}
 
         /**
          * @brief Dereferences the iterator.
@@ -248,7 +395,7 @@ public:
          */
         const_iterator& operator--()
         {
-            m_node = m_node->prev;
+            m_node = previous(m_node, m_tail);
             return *this;
         }
 
@@ -260,7 +407,7 @@ public:
         const_iterator operator--(int)
         {
             const_iterator tmp(*this);
-            m_node = m_node->prev;
+            --*this;
             return tmp;
         }
 
@@ -287,21 +434,33 @@ public:
         }
 
     private:
-        const Node* m_node; ///< Pointer to the current node.
+        const Node* m_node;  ///< Pointer to the current node.
+        Node* const* m_tail; ///< Tail pointer of the list.
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;             ///< A reverse iterator over the list.
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>; ///< A constant reverse iterator over the list.
+
     /**
      * @brief Constructs an empty list.
      */
-    ListN() : m_head(nullptr), m_tail(nullptr), m_size(0) {}
+    ListN() : m_head(nullptr), m_tail(nullptr), m_size(0), m_alloc(), m_track() {}
+
+    /**
+     * @brief Constructs an empty list using the given allocator.
+     *
+     * @param alloc The allocator.
+     */
+    explicit ListN(const Allocator& alloc) : m_head(nullptr), m_tail(nullptr), m_size(0), m_alloc(alloc), m_track() {}
 
     /**
      * @brief Constructs a list with elements from an initializer list.
      *
      * @param init The initializer list to copy elements from.
+     * @param alloc The allocator.
      */
-    ListN(const std::initializer_list<T>& init)
-        : m_head(nullptr), m_tail(nullptr), m_size(0)
+    ListN(const std::initializer_list<T>& init, const Allocator& alloc = Allocator())
+        : m_head(nullptr), m_tail(nullptr), m_size(0), m_alloc(alloc), m_track()
     {
         for (const auto& val : init)
             push_back(val);
@@ -310,17 +469,70 @@ public:
     /**
      * @brief Copy constructor.
      *
+     * The allocator is obtained with select_on_container_copy_construction
+     * (a polymorphic_allocator copy uses the default resource).
+     *
+     * @param other The list to copy elements from.
+     */
+    ListN(const ListN& other)
+        : ListN(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator()))
+    {
+    }
+
+    /**
+     * @brief Constructs a list with a copy of the elements of other, using the given allocator.
+     *
      * @param other The list to copy elements from.
+     * @param alloc The allocator.
      */
-    ListN(const ListN& other) : m_head(nullptr), m_tail(nullptr), m_size(0)
+    ListN(const ListN& other, const Allocator& alloc)
+        : m_head(nullptr), m_tail(nullptr), m_size(0), m_alloc(alloc), m_track(other.m_track)
     {
         for (auto it = other.begin(); it != other.end(); ++it)
             push_back(*it);
     }
 
+    /**
+     * @brief Move constructor. Takes the nodes and the allocator of other, which is left empty.
+     *
+     * @param other The list to move elements from.
+     */
+    ListN(ListN&& other) noexcept
+        : m_head(std::exchange(other.m_head, nullptr)), m_tail(std::exchange(other.m_tail, nullptr)),
+          m_size(std::exchange(other.m_size, 0)), m_alloc(std::move(other.m_alloc)), m_track(other.m_track)
+    {
+        trackUsage();
+        other.trackUsage();
+    }
+
+    /**
+     * @brief Moves other into a list using the given allocator.
+     *
+     * The nodes are taken over when the allocators compare equal; otherwise
+     * the elements are copied into new nodes and other is cleared.
+     *
+     * @param other The list to move elements from.
+     * @param alloc The allocator.
+     */
+    ListN(ListN&& other, const Allocator& alloc)
+        : m_head(nullptr), m_tail(nullptr), m_size(0), m_alloc(alloc), m_track(other.m_track)
+    {
+        if (m_alloc == other.m_alloc)
+        {
+            stealNodes(other);
+        }
+        else
+        {
+            append_range(other.begin(), other.end());
+            other.clear();
+        }
+    }
+
     /**
      * @brief Copy assignment operator.
      *
+     * The allocator is copied too when propagate_on_container_copy_assignment is true.
+     *
      * @param other The list to copy elements from.
      * @return Reference to the assigned list.
      */
@@ -329,12 +541,55 @@ public:
         if (this != &other)
         {
             clear();
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value)
+                m_alloc = other.m_alloc;
             for (auto it = other.begin(); it != other.end(); ++it)
                 push_back(*it);
         }
         return *this;
     }
 
+    /**
+     * @brief Move assignment operator.
+     *
+     * Takes the nodes of other when propagate_on_container_move_assignment is
+     * true (the allocator moves along) or when the allocators compare equal;
+     * otherwise the elements are copied into new nodes and other is cleared.
+     *
+     * @param other The list to move elements from.
+     * @return Reference to the assigned list.
+     */
+    ListN& operator=(ListN&& other) noexcept(NodeTraits::propagate_on_container_move_assignment::value
+        || NodeTraits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+        clear();
+        if constexpr (NodeTraits::propagate_on_container_move_assignment::value)
+        {
+            m_alloc = std::move(other.m_alloc);
+            stealNodes(other);
+        }
+        else if (m_alloc == other.m_alloc)
+        {
+            stealNodes(other);
+        }
+        else
+        {
+            append_range(other.begin(), other.end());
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Returns a copy of the allocator.
+     */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(m_alloc);
+    }
+
     /**
      * @brief Destructor.
      */
@@ -402,7 +657,7 @@ public:
      */
     iterator begin()
     {
-        return iterator(m_head);
+        return iterator(m_head, &m_tail);
     }
 
     /**
@@ -412,7 +667,7 @@ public:
      */
     const_iterator begin() const
     {
-        return const_iterator(m_head);
+        return const_iterator(m_head, &m_tail);
     }
 
     /**
@@ -422,7 +677,7 @@ public:
      */
     const_iterator cbegin() const
     {
-        return const_iterator(m_head);
+        return const_iterator(m_head, &m_tail);
     }
 
     /**
@@ -432,7 +687,7 @@ public:
      */
     iterator end()
     {
-        return iterator(nullptr);
+        return iterator(nullptr, &m_tail);
     }
 
     /**
@@ -442,7 +697,7 @@ public:
      */
     const_iterator end() const
     {
-        return const_iterator(nullptr);
+        return const_iterator(nullptr, &m_tail);
     }
 
     /**
@@ -452,7 +707,47 @@ public:
      */
     const_iterator cend() const
     {
-        return const_iterator(nullptr);
+        return const_iterator(nullptr, &m_tail);
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the last element of the list.
+     *
+     * @return Reverse iterator to the last element of the list.
+     */
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a constant reverse iterator to the last element of the list.
+     *
+     * @return Constant reverse iterator to the last element of the list.
+     */
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator past the first element of the list.
+     *
+     * @return Reverse iterator past the first element of the list.
+     */
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a constant reverse iterator past the first element of the list.
+     *
+     * @return Constant reverse iterator past the first element of the list.
+     */
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
     }
 
     /**
@@ -512,7 +807,7 @@ public:
      */
     void push_front(const T& value)
     {
-        Node* node = new Node(value);
+        Node* node = createNode(value);
         node->next = m_head;
         node->prev = nullptr;
 
@@ -523,6 +818,7 @@ public:
 
         m_head = node;
         ++m_size;
+        trackUsage();
     }
 
     /**
@@ -532,7 +828,7 @@ public:
      */
     void push_back(const T& value)
     {
-        Node* node = new Node(value);
+        Node* node = createNode(value);
         node->prev = m_tail;
         node->next = nullptr;
 
@@ -543,6 +839,7 @@ public:
 
         m_tail = node;
         ++m_size;
+        trackUsage();
     }
 
     /**
@@ -561,8 +858,9 @@ public:
         else
             m_tail = nullptr;
 
-        delete old_head;
+        destroyNode(old_head);
         --m_size;
+        trackUsage();
     }
 
     /**
@@ -581,8 +879,9 @@ public:
         else
             m_head = nullptr;
 
-        delete old_tail;
+        destroyNode(old_tail);
         --m_size;
+        trackUsage();
     }
 
     /**
@@ -606,13 +905,14 @@ public:
         }
         else {
             Node* current = pos.m_node;
-            Node* newNode = new Node(value);
+            Node* newNode = createNode(value);
             newNode->prev = current->prev;
             newNode->next = current;
             current->prev->next = newNode;
             current->prev = newNode;
             ++m_size;
-            return iterator(newNode);
+            trackUsage();
+            return iterator(newNode, &m_tail);
         }
     }
 
@@ -659,7 +959,7 @@ public:
             throw std::out_of_range("ListN erase: cannot erase end iterator");
 
         Node* target = pos.m_node;
-        iterator ret(target->next);
+        iterator ret(target->next, &m_tail);
 
         if (target->prev)
             target->prev->next = target->next;
@@ -671,8 +971,9 @@ public:
         else
             m_tail = target->prev;
 
-        delete target;
+        destroyNode(target);
         --m_size;
+        trackUsage();
         return ret;
     }
 
@@ -699,13 +1000,40 @@ public:
     /**
      * @brief Swaps the contents of this list with another list.
      *
+     * The allocators are swapped when propagate_on_container_swap is true.
+     * Otherwise, when they differ, the elements are copied so that each list
+     * keeps nodes from its own allocator.
+     *
      * @param other The list to swap contents with.
      */
     void swap(ListN& other)
     {
+        if constexpr (NodeTraits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        else if (!(m_alloc == other.m_alloc))
+        {
+            ListN mine(other, get_allocator());
+            ListN theirs(*this, other.get_allocator());
+            std::swap(m_head, mine.m_head);
+            std::swap(m_tail, mine.m_tail);
+            std::swap(m_size, mine.m_size);
+            std::swap(other.m_head, theirs.m_head);
+            std::swap(other.m_tail, theirs.m_tail);
+            std::swap(other.m_size, theirs.m_size);
+            trackUsage();
+            other.trackUsage();
+            mine.trackUsage();
+            theirs.trackUsage();
+            return;
+        }
         std::swap(m_head, other.m_head);
         std::swap(m_tail, other.m_tail);
         std::swap(m_size, other.m_size);
+        trackUsage();
+        other.trackUsage();
     }
 
     /**
@@ -767,18 +1095,70 @@ public:
         for (auto it = first; it != last; ++it)
             push_back(*it);
     }
+
+    /**
+     * @brief Sorts the list.
+     *
+     * Bottom-up merge sort that relinks the nodes: no element is moved or
+     * copied, iterators stay valid, and equivalent elements keep their order.
+     * O(n log n) comparisons, O(1) extra memory.
+     *
+     * @tparam Compare The type of the comparator.
+     * @param comp Strict weak ordering on the elements.
+     */
+    template<typename Compare = std::less<>>
+    void sort(Compare comp = Compare())
+    {
+        if (m_size < 2)
+            return;
+
+        // bins[i] holds a sorted run of 2^i nodes, linked through next only.
+        Node* bins[64] = {};
+        Node* node = m_head;
+        while (node)
+        {
+            Node* next = node->next;
+            node->next = nullptr;
+            Node* carry = node;
+            std::size_t level = 0;
+            for (; bins[level]; ++level)
+            {
+                carry = mergeRuns(bins[level], carry, comp);
+                bins[level] = nullptr;
+            }
+            bins[level] = carry;
+            node = next;
+        }
+
+        Node* sorted = nullptr;
+        for (Node* run : bins)
+        {
+            if (run)
+                sorted = sorted ? mergeRuns(run, sorted, comp) : run;
+        }
+
+        m_head = sorted;
+        Node* prev = nullptr;
+        for (node = sorted; node; node = node->next)
+        {
+            node->prev = prev;
+            prev = node;
+        }
+        m_tail = prev;
+    }
 };
 
 /**
  * @brief Outputs the contents of the list to the given output stream.
  *
  * @tparam T The type of the elements in the list.
+ * @tparam Allocator The allocator of the list.
  * @param os The output stream to write to.
  * @param lst The list to output.
  * @return The output stream.
  */
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const ListN<T>& lst)
+template<typename T, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const ListN<T, Allocator>& lst)
 {
     os << "{";
     auto it = lst.begin();
@@ -793,3 +1173,11 @@ std::ostream& operator<<(std::ostream& os, const ListN<T>& lst)
     return os;
 }
 
+namespace pmr
+{
+/**
+ * @brief ListN whose nodes and elements allocate from a std::pmr::memory_resource.
+ */
+template<typename T>
+using ListN = ::ListN<T, std::pmr::polymorphic_allocator<T>>;
+}
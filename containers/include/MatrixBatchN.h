@@ -0,0 +1,519 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocatorN.h"
+#include "MatrixN.h"
+#include "ThreadPoolN.h"
+#include "VecteurND.h"
+
+/**
+ * @class MatrixBatchN
+ * @brief Many independent N x N matrices stored interleaved for SIMD processing.
+ *
+ * Matrices are grouped in blocks of Lanes: inside a block, coefficient (i, j)
+ * of the Lanes matrices is contiguous (array of structures of arrays). Every
+ * kernel then processes one block with plain loops over the lanes, which the
+ * compiler turns into SIMD operations where a per-instance loop would leave
+ * most lanes idle. Unused lanes of the last block hold identity matrices.
+ * Batches spanning more than ParallelGrain blocks are split on ThreadPoolN::global().
+ *
+ * @tparam T The arithmetic element type.
+ * @tparam N The order of the matrices.
+ * @tparam Lanes The number of matrices interleaved in a block.
+ */
+template<typename T, std::size_t N, std::size_t Lanes = 8>
+class MatrixBatchN {
+    static_assert(std::is_arithmetic_v<T>, "MatrixBatchN requires an arithmetic element type");
+    static_assert(N > 0 && Lanes > 0, "MatrixBatchN requires a non-zero order and lane count");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type BlockSize = N * N * Lanes; ///< Coefficients per block.
+    static constexpr size_type ParallelGrain = 512;       ///< Blocks per parallel task.
+
+    /**
+     * @brief Constructs an empty batch.
+     */
+    MatrixBatchN()
+        : m_size(0), m_blocks(0), m_data(nullptr) {
+    }
+
+    /**
+     * @brief Constructs a batch of count identity matrices.
+     *
+     * @param count The number of matrices.
+     */
+    explicit MatrixBatchN(size_type count)
+        : MatrixBatchN() {
+        resize(count);
+    }
+
+    /**
+     * @brief Constructs a batch from a sequence of matrices.
+     *
+     * @param matrices The matrices to interleave.
+     */
+    explicit MatrixBatchN(std::span<const MatrixND<T, N, N>> matrices)
+        : MatrixBatchN(matrices.size()) {
+        for (size_type i = 0; i < matrices.size(); ++i) {
+            set(i, matrices[i]);
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     */
+    MatrixBatchN(const MatrixBatchN& other)
+        : m_size(other.m_size), m_blocks(other.m_blocks), m_data(allocate(other.m_blocks)) {
+        std::copy(other.m_data, other.m_data + m_blocks * BlockSize, m_data);
+    }
+
+    /**
+     * @brief Move constructor.
+     */
+    MatrixBatchN(MatrixBatchN&& other) noexcept
+        : m_size(std::exchange(other.m_size, 0)), m_blocks(std::exchange(other.m_blocks, 0)),
+        m_data(std::exchange(other.m_data, nullptr)) {
+    }
+
+    /**
+     * @brief Copy and move assignment.
+     */
+    MatrixBatchN& operator=(MatrixBatchN other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    /**
+     * @brief Releases the storage.
+     */
+    ~MatrixBatchN() {
+        release(m_data, m_blocks);
+    }
+
+    /**
+     * @brief Exchanges the content of two batches.
+     */
+    void swap(MatrixBatchN& other) noexcept {
+        std::swap(m_size, other.m_size);
+        std::swap(m_blocks, other.m_blocks);
+        std::swap(m_data, other.m_data);
+    }
+
+    /**
+     * @brief Returns the number of matrices.
+     */
+    size_type size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Returns the number of blocks of Lanes matrices.
+     */
+    size_type blockCount() const {
+        return m_blocks;
+    }
+
+    /**
+     * @brief Changes the number of matrices. Kept matrices are preserved, new ones are identity.
+     *
+     * @param count The new number of matrices.
+     */
+    void resize(size_type count) {
+        const size_type blocks = (count + Lanes - 1) / Lanes;
+        if (blocks != m_blocks) {
+            T* data = allocate(blocks);
+            const size_type kept = std::min(blocks, m_blocks);
+            std::copy(m_data, m_data + kept * BlockSize, data);
+            for (size_type b = kept; b < blocks; ++b) {
+                fillIdentity(data + b * BlockSize, 0);
+            }
+            release(m_data, m_blocks);
+            m_data = data;
+            m_blocks = blocks;
+        }
+        if (count < m_size && m_blocks > 0) {
+            const size_type lane = count % Lanes;
+            if (lane != 0) {
+                fillIdentity(m_data + (m_blocks - 1) * BlockSize, lane);
+            }
+        }
+        m_size = count;
+    }
+
+    /**
+     * @brief Stores a matrix at the specified index.
+     *
+     * @param index The index of the matrix.
+     * @param matrix The matrix to store.
+     * @throws std::out_of_range if index is not below size().
+     */
+    void set(size_type index, const MatrixND<T, N, N>& matrix) {
+        if (index >= m_size)
+            throw std::out_of_range("MatrixBatchN::set: index out of range");
+        T* block = m_data + (index / Lanes) * BlockSize + index % Lanes;
+        const T* src = matrix.data();
+        for (size_type e = 0; e < N * N; ++e) {
+            block[e * Lanes] = src[e];
+        }
+    }
+
+    /**
+     * @brief Returns the matrix at the specified index.
+     *
+     * @param index The index of the matrix.
+     * @return A copy of the matrix.
+     * @throws std::out_of_range if index is not below size().
+     */
+    MatrixND<T, N, N> get(size_type index) const {
+        if (index >= m_size)
+            throw std::out_of_range("MatrixBatchN::get: index out of range");
+        MatrixND<T, N, N> matrix;
+        const T* block = m_data + (index / Lanes) * BlockSize + index % Lanes;
+        T* dst = matrix.data();
+        for (size_type e = 0; e < N * N; ++e) {
+            dst[e] = block[e * Lanes];
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Returns a pointer to the interleaved storage (blockCount() * BlockSize coefficients).
+     */
+    const T* data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Returns a pointer to the interleaved storage (blockCount() * BlockSize coefficients).
+     */
+    T* data() {
+        return m_data;
+    }
+
+    /**
+     * @brief Computes out[i] = lhs[i] * rhs[i] for every matrix.
+     *
+     * @param lhs The left-hand side matrices.
+     * @param rhs The right-hand side matrices.
+     * @param out Receives the products; resized to lhs.size(). May alias lhs or rhs.
+     * @throws std::runtime_error if lhs and rhs have different sizes.
+     */
+    static void multiply(const MatrixBatchN& lhs, const MatrixBatchN& rhs, MatrixBatchN& out) {
+        if (lhs.m_size != rhs.m_size)
+            throw std::runtime_error("MatrixBatchN::multiply: batches have different sizes");
+        if (&out == &lhs || &out == &rhs) {
+            forEachBlock(lhs.m_blocks, [&](size_type b) {
+                T result[BlockSize];
+                multiplyBlock(lhs.m_data + b * BlockSize, rhs.m_data + b * BlockSize, result);
+                std::copy(result, result + BlockSize, out.m_data + b * BlockSize);
+            });
+            return;
+        }
+        out.resize(lhs.m_size);
+        forEachBlock(lhs.m_blocks, [&](size_type b) {
+            multiplyBlock(lhs.m_data + b * BlockSize, rhs.m_data + b * BlockSize, out.m_data + b * BlockSize);
+        });
+    }
+
+    /**
+     * @brief Computes the determinant of every matrix.
+     *
+     * @param batch The matrices.
+     * @param out Receives batch.size() determinants.
+     * @throws std::runtime_error if out is too small.
+     */
+    static void determinant(const MatrixBatchN& batch, std::span<T> out) {
+        static_assert(N == 2 || N == 3 || N == 4, "MatrixBatchN::determinant supports 2x2, 3x3 and 4x4 matrices");
+        if (out.size() < batch.m_size)
+            throw std::runtime_error("MatrixBatchN::determinant: output span too small");
+        forEachBlock(batch.m_blocks, [&](size_type b) {
+            T det[Lanes];
+            determinantBlock(batch.m_data + b * BlockSize, det);
+            const size_type count = std::min(Lanes, batch.m_size - b * Lanes);
+            std::copy(det, det + count, out.data() + b * Lanes);
+        });
+    }
+
+    /**
+     * @brief Computes out[i] = inverse(batch[i]) for every matrix, using the adjugate.
+     *
+     * @param batch The matrices.
+     * @param out Receives the inverses; resized to batch.size(). May alias batch.
+     * @throws std::runtime_error if a matrix is singular; out is then left unspecified.
+     */
+    static void inverse(const MatrixBatchN& batch, MatrixBatchN& out) {
+        static_assert(N == 2 || N == 3 || N == 4, "MatrixBatchN::inverse supports 2x2, 3x3 and 4x4 matrices");
+        static_assert(std::is_floating_point_v<T>, "MatrixBatchN::inverse requires a floating-point element type");
+        out.resize(batch.m_size);
+        forEachBlock(batch.m_blocks, [&](size_type b) {
+            T det[Lanes];
+            T result[BlockSize];
+            invertBlock(batch.m_data + b * BlockSize, result, det);
+            bool singular = false;
+            for (size_type l = 0; l < Lanes; ++l) {
+                singular = singular || det[l] == T{};
+            }
+            if (singular)
+                throw std::runtime_error("MatrixBatchN::inverse: singular matrix");
+            T invDet[Lanes];
+            for (size_type l = 0; l < Lanes; ++l) {
+                invDet[l] = T{ 1 } / det[l];
+            }
+            T* dst = out.m_data + b * BlockSize;
+            for (size_type e = 0; e < N * N; ++e) {
+                for (size_type l = 0; l < Lanes; ++l) {
+                    dst[e * Lanes + l] = result[e * Lanes + l] * invDet[l];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Computes out[i] = batch[i] * in[i] for every matrix.
+     *
+     * @param batch The matrices.
+     * @param in The vectors to transform, one per matrix.
+     * @param out Receives the transformed vectors. May alias in.
+     * @throws std::runtime_error if in or out do not hold batch.size() vectors.
+     */
+    static void transform(const MatrixBatchN& batch, std::span<const VectorND<T, N>> in, std::span<VectorND<T, N>> out) {
+        static_assert(sizeof(VectorND<T, N>) == N * sizeof(T), "VectorND must be tightly packed");
+        if (in.size() != batch.m_size || out.size() != batch.m_size)
+            throw std::runtime_error("MatrixBatchN::transform: span sizes differ from the batch size");
+        forEachBlock(batch.m_blocks, [&](size_type b) {
+            const size_type first = b * Lanes;
+            const size_type count = std::min(Lanes, batch.m_size - first);
+            T v[N * Lanes] = {};
+            for (size_type l = 0; l < count; ++l) {
+                const T* src = in[first + l].data();
+                for (size_type i = 0; i < N; ++i) {
+                    v[i * Lanes + l] = src[i];
+                }
+            }
+
+            const T* a = batch.m_data + b * BlockSize;
+            T r[N * Lanes] = {};
+            for (size_type i = 0; i < N; ++i) {
+                for (size_type k = 0; k < N; ++k) {
+                    for (size_type l = 0; l < Lanes; ++l) {
+                        r[i * Lanes + l] += a[(i * N + k) * Lanes + l] * v[k * Lanes + l];
+                    }
+                }
+            }
+
+            for (size_type l = 0; l < count; ++l) {
+                T* dst = out[first + l].data();
+                for (size_type i = 0; i < N; ++i) {
+                    dst[i] = r[i * Lanes + l];
+                }
+            }
+        });
+    }
+
+private:
+    /**
+     * @brief Runs fn(block) for every block, in parallel for large batches.
+     */
+    template<typename Fn>
+    static void forEachBlock(size_type blocks, Fn fn) {
+        if (blocks <= ParallelGrain) {
+            for (size_type b = 0; b < blocks; ++b) {
+                fn(b);
+            }
+            return;
+        }
+        ThreadPoolN::global().parallel_for(0, blocks, ParallelGrain, [&](size_type first, size_type last) {
+            for (size_type b = first; b < last; ++b) {
+                fn(b);
+            }
+        });
+    }
+
+    /**
+     * @brief Multiplies the Lanes matrix pairs of a block.
+     */
+    static void multiplyBlock(const T* a, const T* b, T* c) {
+        for (size_type i = 0; i < N; ++i) {
+            for (size_type j = 0; j < N; ++j) {
+                T sum[Lanes] = {};
+                for (size_type k = 0; k < N; ++k) {
+                    const T* aik = a + (i * N + k) * Lanes;
+                    const T* bkj = b + (k * N + j) * Lanes;
+                    for (size_type l = 0; l < Lanes; ++l) {
+                        sum[l] += aik[l] * bkj[l];
+                    }
+                }
+                std::copy(sum, sum + Lanes, c + (i * N + j) * Lanes);
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the determinants of the Lanes matrices of a block.
+     */
+    static void determinantBlock(const T* a, T* det) {
+        auto in = [a](size_type i, size_type j) { return a + (i * N + j) * Lanes; };
+        T determinant[Lanes];
+
+        if constexpr (N == 2) {
+            for (size_type l = 0; l < Lanes; ++l) {
+                determinant[l] = in(0, 0)[l] * in(1, 1)[l] - in(0, 1)[l] * in(1, 0)[l];
+            }
+        }
+        else if constexpr (N == 3) {
+            for (size_type l = 0; l < Lanes; ++l) {
+                determinant[l] = in(0, 0)[l] * (in(1, 1)[l] * in(2, 2)[l] - in(1, 2)[l] * in(2, 1)[l])
+                    + in(0, 1)[l] * (in(1, 2)[l] * in(2, 0)[l] - in(1, 0)[l] * in(2, 2)[l])
+                    + in(0, 2)[l] * (in(1, 0)[l] * in(2, 1)[l] - in(1, 1)[l] * in(2, 0)[l]);
+            }
+        }
+        else {
+            for (size_type l = 0; l < Lanes; ++l) {
+                const T s0 = in(0, 0)[l] * in(1, 1)[l] - in(1, 0)[l] * in(0, 1)[l];
+                const T s1 = in(0, 0)[l] * in(1, 2)[l] - in(1, 0)[l] * in(0, 2)[l];
+                const T s2 = in(0, 0)[l] * in(1, 3)[l] - in(1, 0)[l] * in(0, 3)[l];
+                const T s3 = in(0, 1)[l] * in(1, 2)[l] - in(1, 1)[l] * in(0, 2)[l];
+                const T s4 = in(0, 1)[l] * in(1, 3)[l] - in(1, 1)[l] * in(0, 3)[l];
+                const T s5 = in(0, 2)[l] * in(1, 3)[l] - in(1, 2)[l] * in(0, 3)[l];
+                const T c5 = in(2, 2)[l] * in(3, 3)[l] - in(3, 2)[l] * in(2, 3)[l];
+                const T c4 = in(2, 1)[l] * in(3, 3)[l] - in(3, 1)[l] * in(2, 3)[l];
+                const T c3 = in(2, 1)[l] * in(3, 2)[l] - in(3, 1)[l] * in(2, 2)[l];
+                const T c2 = in(2, 0)[l] * in(3, 3)[l] - in(3, 0)[l] * in(2, 3)[l];
+                const T c1 = in(2, 0)[l] * in(3, 2)[l] - in(3, 0)[l] * in(2, 2)[l];
+                const T c0 = in(2, 0)[l] * in(3, 1)[l] - in(3, 0)[l] * in(2, 1)[l];
+                determinant[l] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+        }
+        std::copy(determinant, determinant + Lanes, det);
+    }
+
+    /**
+     * @brief Computes the adjugate and determinant of the Lanes matrices of a block.
+     *
+     * @param a The block.
+     * @param adj Receives the adjugates (inverse times determinant).
+     * @param det Receives the Lanes determinants.
+     */
+    static void invertBlock(const T* block, T* adj, T* det) {
+        // Working on local copies lets the compiler vectorize the lane loops
+        // without versioning them for every possible overlap of the arguments.
+        T a[BlockSize];
+        T result[BlockSize];
+        T determinant[Lanes];
+        std::copy(block, block + BlockSize, a);
+        auto in = [&a](size_type i, size_type j) { return a + (i * N + j) * Lanes; };
+        auto out = [&result](size_type i, size_type j) { return result + (i * N + j) * Lanes; };
+
+        if constexpr (N == 2) {
+            for (size_type l = 0; l < Lanes; ++l) {
+                const T a00 = in(0, 0)[l], a01 = in(0, 1)[l], a10 = in(1, 0)[l], a11 = in(1, 1)[l];
+                out(0, 0)[l] = a11;
+                out(0, 1)[l] = -a01;
+                out(1, 0)[l] = -a10;
+                out(1, 1)[l] = a00;
+                determinant[l] = a00 * a11 - a01 * a10;
+            }
+        }
+        else if constexpr (N == 3) {
+            for (size_type l = 0; l < Lanes; ++l) {
+                const T a00 = in(0, 0)[l], a01 = in(0, 1)[l], a02 = in(0, 2)[l];
+                const T a10 = in(1, 0)[l], a11 = in(1, 1)[l], a12 = in(1, 2)[l];
+                const T a20 = in(2, 0)[l], a21 = in(2, 1)[l], a22 = in(2, 2)[l];
+                const T c00 = a11 * a22 - a12 * a21;
+                const T c10 = a12 * a20 - a10 * a22;
+                const T c20 = a10 * a21 - a11 * a20;
+                out(0, 0)[l] = c00;
+                out(0, 1)[l] = a02 * a21 - a01 * a22;
+                out(0, 2)[l] = a01 * a12 - a02 * a11;
+                out(1, 0)[l] = c10;
+                out(1, 1)[l] = a00 * a22 - a02 * a20;
+                out(1, 2)[l] = a02 * a10 - a00 * a12;
+                out(2, 0)[l] = c20;
+                out(2, 1)[l] = a01 * a20 - a00 * a21;
+                out(2, 2)[l] = a00 * a11 - a01 * a10;
+                determinant[l] = a00 * c00 + a01 * c10 + a02 * c20;
+            }
+        }
+        else {
+            for (size_type l = 0; l < Lanes; ++l) {
+                const T a00 = in(0, 0)[l], a01 = in(0, 1)[l], a02 = in(0, 2)[l], a03 = in(0, 3)[l];
+                const T a10 = in(1, 0)[l], a11 = in(1, 1)[l], a12 = in(1, 2)[l], a13 = in(1, 3)[l];
+                const T a20 = in(2, 0)[l], a21 = in(2, 1)[l], a22 = in(2, 2)[l], a23 = in(2, 3)[l];
+                const T a30 = in(3, 0)[l], a31 = in(3, 1)[l], a32 = in(3, 2)[l], a33 = in(3, 3)[l];
+
+                // 2x2 minors of the two upper rows (s) and the two lower rows (c).
+                const T s0 = a00 * a11 - a10 * a01;
+                const T s1 = a00 * a12 - a10 * a02;
+                const T s2 = a00 * a13 - a10 * a03;
+                const T s3 = a01 * a12 - a11 * a02;
+                const T s4 = a01 * a13 - a11 * a03;
+                const T s5 = a02 * a13 - a12 * a03;
+                const T c5 = a22 * a33 - a32 * a23;
+                const T c4 = a21 * a33 - a31 * a23;
+                const T c3 = a21 * a32 - a31 * a22;
+                const T c2 = a20 * a33 - a30 * a23;
+                const T c1 = a20 * a32 - a30 * a22;
+                const T c0 = a20 * a31 - a30 * a21;
+
+                out(0, 0)[l] = a11 * c5 - a12 * c4 + a13 * c3;
+                out(0, 1)[l] = -a01 * c5 + a02 * c4 - a03 * c3;
+                out(0, 2)[l] = a31 * s5 - a32 * s4 + a33 * s3;
+                out(0, 3)[l] = -a21 * s5 + a22 * s4 - a23 * s3;
+                out(1, 0)[l] = -a10 * c5 + a12 * c2 - a13 * c1;
+                out(1, 1)[l] = a00 * c5 - a02 * c2 + a03 * c1;
+                out(1, 2)[l] = -a30 * s5 + a32 * s2 - a33 * s1;
+                out(1, 3)[l] = a20 * s5 - a22 * s2 + a23 * s1;
+                out(2, 0)[l] = a10 * c4 - a11 * c2 + a13 * c0;
+                out(2, 1)[l] = -a00 * c4 + a01 * c2 - a03 * c0;
+                out(2, 2)[l] = a30 * s4 - a31 * s2 + a33 * s0;
+                out(2, 3)[l] = -a20 * s4 + a21 * s2 - a23 * s0;
+                out(3, 0)[l] = -a10 * c3 + a11 * c1 - a12 * c0;
+                out(3, 1)[l] = a00 * c3 - a01 * c1 + a02 * c0;
+                out(3, 2)[l] = -a30 * s3 + a31 * s1 - a32 * s0;
+                out(3, 3)[l] = a20 * s3 - a21 * s1 + a22 * s0;
+                determinant[l] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+        }
+        std::copy(result, result + BlockSize, adj);
+        std::copy(determinant, determinant + Lanes, det);
+    }
+
+    /**
+     * @brief Writes identity matrices in the lanes [firstLane, Lanes) of a block.
+     */
+    static void fillIdentity(T* block, size_type firstLane) {
+        for (size_type i = 0; i < N; ++i) {
+            for (size_type j = 0; j < N; ++j) {
+                T* coeffs = block + (i * N + j) * Lanes;
+                std::fill(coeffs + firstLane, coeffs + Lanes, i == j ? T{ 1 } : T{});
+            }
+        }
+    }
+
+    /**
+     * @brief Allocates storage for a number of blocks.
+     */
+    static T* allocate(size_type blocks) {
+        return blocks == 0 ? nullptr : AlignedAllocatorN<T>().allocate(blocks * BlockSize);
+    }
+
+    /**
+     * @brief Releases storage obtained from allocate.
+     */
+    static void release(T* data, size_type blocks) {
+        if (data)
+            AlignedAllocatorN<T>().deallocate(data, blocks * BlockSize);
+    }
+
+    size_type m_size;   ///< Number of matrices.
+    size_type m_blocks; ///< Number of allocated blocks.
+    T* m_data;          ///< Interleaved coefficients.
+};
@@ -0,0 +1,524 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "AlignedAllocatorN.h"
+#include "GemmN.h"
+#include "MatrixN.h"
+#include "ThreadPoolN.h"
+#include "TransposeN.h"
+
+/**
+ * @brief Storage order of a MatrixDyn.
+ */
+enum class MatrixLayout
+{
+    RowMajor, ///< Elements of a row are contiguous.
+    ColMajor  ///< Elements of a column are contiguous.
+};
+
+/**
+ * @class MatrixDyn
+ * @brief A matrix whose dimensions are chosen at runtime, stored on the heap.
+ *
+ * Storage is 64-byte aligned and every row (row-major) or column (column-major)
+ * is padded so that it starts on a 64-byte boundary. stride() gives the distance
+ * in elements between two consecutive rows (or columns), which is the leading
+ * dimension expected by the raw kernels such as GemmN.
+ *
+ * @tparam T The type of the elements in the matrix.
+ * @tparam Layout Storage order.
+ */
+template<typename T, MatrixLayout Layout = MatrixLayout::RowMajor>
+class MatrixDyn {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = AlignedAllocatorN<T, 64>;
+
+    static constexpr MatrixLayout layout = Layout; ///< Storage order of the matrix.
+
+    /**
+     * @brief Default constructor that builds an empty 0 x 0 matrix.
+     */
+    MatrixDyn()
+        : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {
+    }
+
+    /**
+     * @brief Constructor that builds a rows x cols matrix filled with a value.
+     *
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param value The value of every element.
+     */
+    MatrixDyn(size_type rows, size_type cols, const T& value = T{})
+        : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {
+        allocate(rows, cols);
+        fill(value);
+    }
+
+    /**
+     * @brief Constructor from a nested initializer list.
+     *
+     * The number of rows is the number of lists and the number of columns the
+     * length of the longest list; missing elements are set to T{}.
+     *
+     * @param init A nested initializer list containing the rows of the matrix.
+     */
+    MatrixDyn(std::initializer_list<std::initializer_list<T>> init)
+        : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {
+        size_type cols = 0;
+        for (const auto& rowList : init)
+            cols = std::max(cols, rowList.size());
+        allocate(init.size(), cols);
+        fill(T{});
+
+        size_type rowIndex = 0;
+        for (const auto& rowList : init) {
+            size_type colIndex = 0;
+            for (const auto& elem : rowList) {
+                m_data[offset(rowIndex, colIndex)] = elem;
+                ++colIndex;
+            }
+            ++rowIndex;
+        }
+    }
+
+    /**
+     * @brief Converting constructor from a fixed-size MatrixND.
+     *
+     * @param other The matrix to copy.
+     */
+    template<std::size_t Rows, std::size_t Cols>
+    explicit MatrixDyn(const MatrixND<T, Rows, Cols>& other)
+        : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {
+        allocate(Rows, Cols);
+        fill(T{});
+        const T* src = other.data();
+        for (size_type i = 0; i < Rows; ++i)
+            for (size_type j = 0; j < Cols; ++j)
+                m_data[offset(i, j)] = src[i * Cols + j];
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @param other The matrix to copy.
+     */
+    MatrixDyn(const MatrixDyn& other)
+        : m_rows(0), m_cols(0), m_stride(0), m_data(nullptr) {
+        allocate(other.m_rows, other.m_cols);
+        std::copy(other.m_data, other.m_data + storageSize(), m_data);
+    }
+
+    /**
+     * @brief Move constructor. The moved-from matrix becomes empty.
+     *
+     * @param other The matrix to move from.
+     */
+    MatrixDyn(MatrixDyn&& other) noexcept
+        : m_rows(other.m_rows), m_cols(other.m_cols), m_stride(other.m_stride), m_data(other.m_data) {
+        other.m_rows = other.m_cols = other.m_stride = 0;
+        other.m_data = nullptr;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The matrix to copy.
+     * @return A reference to this matrix.
+     */
+    MatrixDyn& operator=(const MatrixDyn& other) {
+        if (this != &other) {
+            MatrixDyn copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The matrix to move from.
+     * @return A reference to this matrix.
+     */
+    MatrixDyn& operator=(MatrixDyn&& other) noexcept {
+        if (this != &other) {
+            release();
+            std::swap(m_rows, other.m_rows);
+            std::swap(m_cols, other.m_cols);
+            std::swap(m_stride, other.m_stride);
+            std::swap(m_data, other.m_data);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~MatrixDyn() {
+        release();
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @return A reference to the element at the specified position.
+     * @throws std::out_of_range if the row or column index is out of bounds.
+     */
+    T& operator()(size_type row, size_type col) {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Index out of range in MatrixDyn::operator()");
+        return m_data[offset(row, col)];
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column (const version).
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @return A const reference to the element at the specified position.
+     * @throws std::out_of_range if the row or column index is out of bounds.
+     */
+    const T& operator()(size_type row, size_type col) const {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Index out of range in MatrixDyn::operator() const");
+        return m_data[offset(row, col)];
+    }
+
+    /**
+     * @brief Returns the number of rows in the matrix.
+     */
+    size_type rowCount() const {
+        return m_rows;
+    }
+
+    /**
+     * @brief Returns the number of columns in the matrix.
+     */
+    size_type colCount() const {
+        return m_cols;
+    }
+
+    /**
+     * @brief Returns the distance in elements between two consecutive rows (row-major)
+     * or columns (column-major), padding included.
+     */
+    size_type stride() const {
+        return m_stride;
+    }
+
+    /**
+     * @brief Checks if the matrix has no element.
+     */
+    bool empty() const {
+        return m_rows == 0 || m_cols == 0;
+    }
+
+    /**
+     * @brief Sets every element (padding included) to a value.
+     *
+     * @param value The value to assign.
+     */
+    void fill(const T& value) {
+        std::fill(m_data, m_data + storageSize(), value);
+    }
+
+    /**
+     * @brief Swaps the contents of this matrix with another matrix.
+     *
+     * @param other The matrix to swap with.
+     */
+    void swap(MatrixDyn& other) noexcept {
+        std::swap(m_rows, other.m_rows);
+        std::swap(m_cols, other.m_cols);
+        std::swap(m_stride, other.m_stride);
+        std::swap(m_data, other.m_data);
+    }
+
+    /**
+     * @brief Copies this matrix into a fixed-size MatrixND.
+     *
+     * @tparam Rows The number of rows of the destination.
+     * @tparam Cols The number of columns of the destination.
+     * @return The fixed-size copy.
+     * @throws std::runtime_error if the dimensions do not match.
+     */
+    template<std::size_t Rows, std::size_t Cols>
+    MatrixND<T, Rows, Cols> toMatrixND() const {
+        if (Rows != m_rows || Cols != m_cols)
+            throw std::runtime_error("MatrixDyn::toMatrixND: dimension mismatch");
+        MatrixND<T, Rows, Cols> result;
+        T* dst = result.data();
+        for (size_type i = 0; i < Rows; ++i)
+            for (size_type j = 0; j < Cols; ++j)
+                dst[i * Cols + j] = m_data[offset(i, j)];
+        return result;
+    }
+
+    /**
+     * @brief Returns a copy of the matrix stored in another order.
+     *
+     * Row-major to column-major (and back) is a transposition of the storage,
+     * done by the cache-oblivious TransposeN kernel.
+     *
+     * @tparam Target Storage order of the copy.
+     * @return The same matrix in Target order.
+     */
+    template<MatrixLayout Target>
+    MatrixDyn<T, Target> toLayout() const {
+        if constexpr (Target == Layout) {
+            return *this;
+        } else {
+            MatrixDyn<T, Target> result;
+            result.allocate(m_rows, m_cols);
+            transposeStorageInto(result);
+            return result;
+        }
+    }
+
+    /**
+     * @brief Returns the transposed matrix, in the same storage order.
+     *
+     * @return The colCount() x rowCount() transpose.
+     */
+    MatrixDyn transposed() const {
+        MatrixDyn result;
+        result.allocate(m_cols, m_rows);
+        transposeStorageInto(result);
+        return result;
+    }
+
+    /**
+     * @brief Multiplies two matrices and returns the result.
+     *
+     * Arithmetic element types use the blocked GemmN kernel on ThreadPoolN::global()
+     * (a column-major product is computed as the row-major product of the transposes).
+     *
+     * @param lhs The left-hand side matrix.
+     * @param rhs The right-hand side matrix.
+     * @return The result of the matrix multiplication.
+     * @throws std::runtime_error if lhs.colCount() != rhs.rowCount().
+     */
+    static MatrixDyn multiply(const MatrixDyn& lhs, const MatrixDyn& rhs) {
+        return multiply(ThreadPoolN::global(), lhs, rhs);
+    }
+
+    /**
+     * @brief Multiplies two matrices on a given thread pool.
+     *
+     * @param pool The pool executing the tiles of the product.
+     * @param lhs The left-hand side matrix.
+     * @param rhs The right-hand side matrix.
+     * @return The result of the matrix multiplication.
+     * @throws std::runtime_error if lhs.colCount() != rhs.rowCount().
+     */
+    static MatrixDyn multiply(ThreadPoolN& pool, const MatrixDyn& lhs, const MatrixDyn& rhs) {
+        if (lhs.m_cols != rhs.m_rows)
+            throw std::runtime_error("MatrixDyn::multiply: dimension mismatch");
+
+        MatrixDyn result(lhs.m_rows, rhs.m_cols);
+        const size_type m = lhs.m_rows;
+        const size_type n = rhs.m_cols;
+        const size_type k = lhs.m_cols;
+
+        if constexpr (std::is_arithmetic_v<T>) {
+            if constexpr (Layout == MatrixLayout::RowMajor)
+                GemmN<T>::multiply(pool, m, n, k, lhs.m_data, lhs.m_stride, rhs.m_data, rhs.m_stride, result.m_data, result.m_stride);
+            else
+                GemmN<T>::multiply(pool, n, m, k, rhs.m_data, rhs.m_stride, lhs.m_data, lhs.m_stride, result.m_data, result.m_stride);
+        }
+        else {
+            result.forEachRow([&](size_type i, T* row, size_type step) {
+                for (size_type p = 0; p < k; ++p) {
+                    const T aip = lhs.m_data[lhs.offset(i, p)];
+                    for (size_type j = 0; j < n; ++j)
+                        row[j * step] += aip * rhs.m_data[rhs.offset(p, j)];
+                }
+            }, pool);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls a function for every row, rows being processed in parallel.
+     *
+     * @tparam Fn Callable as fn(size_type row, T* first, size_type step), where
+     * first points to the first element of the row and step is the distance
+     * between two consecutive elements of the row.
+     * @param fn Function called once per row.
+     * @param pool The pool executing the rows.
+     */
+    template<typename Fn>
+    void forEachRow(Fn fn, ThreadPoolN& pool = ThreadPoolN::global()) {
+        const size_type step = Layout == MatrixLayout::RowMajor ? 1 : m_stride;
+        pool.parallel_for(0, m_rows, grainFor(m_cols), [&](size_type first, size_type last) {
+            for (size_type i = first; i < last; ++i)
+                fn(i, m_data + offset(i, 0), step);
+        });
+    }
+
+    /**
+     * @brief Calls a function for every column, columns being processed in parallel.
+     *
+     * @tparam Fn Callable as fn(size_type col, T* first, size_type step), where
+     * first points to the first element of the column and step is the distance
+     * between two consecutive elements of the column.
+     * @param fn Function called once per column.
+     * @param pool The pool executing the columns.
+     */
+    template<typename Fn>
+    void forEachCol(Fn fn, ThreadPoolN& pool = ThreadPoolN::global()) {
+        const size_type step = Layout == MatrixLayout::ColMajor ? 1 : m_stride;
+        pool.parallel_for(0, m_cols, grainFor(m_rows), [&](size_type first, size_type last) {
+            for (size_type j = first; j < last; ++j)
+                fn(j, m_data + offset(0, j), step);
+        });
+    }
+
+    /**
+     * @brief Returns a pointer to the underlying data array (const version).
+     */
+    const T* data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Returns a pointer to the underlying data array.
+     */
+    T* data() {
+        return m_data;
+    }
+
+private:
+    template<typename, MatrixLayout>
+    friend class MatrixDyn;
+
+    static constexpr size_type ParallelGrainElements = 16384; ///< Approximate number of elements per parallel chunk.
+
+    /**
+     * @brief Returns the number of rows (or columns) of length lineLength per parallel chunk.
+     */
+    static size_type grainFor(size_type lineLength) {
+        return std::max<size_type>(1, ParallelGrainElements / std::max<size_type>(1, lineLength));
+    }
+
+    /**
+     * @brief Returns the position of an element in the storage.
+     */
+    size_type offset(size_type row, size_type col) const {
+        if constexpr (Layout == MatrixLayout::RowMajor)
+            return row * m_stride + col;
+        else
+            return col * m_stride + row;
+    }
+
+    /**
+     * @brief Returns the number of stored elements, padding included.
+     */
+    size_type storageSize() const {
+        return m_stride * (Layout == MatrixLayout::RowMajor ? m_rows : m_cols);
+    }
+
+    /**
+     * @brief Allocates storage for a rows x cols matrix.
+     *
+     * Elements of trivially constructible types are left uninitialized.
+     */
+    void allocate(size_type rows, size_type cols) {
+        constexpr size_type step = std::max<size_type>(1, allocator_type::alignment / sizeof(T));
+        const size_type inner = Layout == MatrixLayout::RowMajor ? cols : rows;
+        const size_type stride = (inner + step - 1) / step * step;
+        const size_type count = stride * (Layout == MatrixLayout::RowMajor ? rows : cols);
+
+        m_data = count != 0 ? allocator_type().allocate(count) : nullptr;
+        m_rows = rows;
+        m_cols = cols;
+        m_stride = stride;
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            try {
+                std::uninitialized_value_construct(m_data, m_data + count);
+            }
+            catch (...) {
+                allocator_type().deallocate(m_data, count);
+                m_data = nullptr;
+                m_rows = m_cols = m_stride = 0;
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the transpose of the storage into the freshly allocated storage of result.
+     *
+     * The storage lines of result are the storage columns of this matrix, which
+     * makes result either the transpose (same order) or a layout conversion.
+     * Padding of result is zeroed.
+     */
+    template<MatrixLayout Target>
+    void transposeStorageInto(MatrixDyn<T, Target>& result) const {
+        const size_type lines = Layout == MatrixLayout::RowMajor ? m_rows : m_cols;
+        const size_type length = Layout == MatrixLayout::RowMajor ? m_cols : m_rows;
+        TransposeN<T>::copy(lines, length, m_data, m_stride, result.m_data, result.m_stride);
+        if (result.m_stride != lines) {
+            for (size_type i = 0; i < length; ++i)
+                std::fill(result.m_data + i * result.m_stride + lines, result.m_data + (i + 1) * result.m_stride, T{});
+        }
+    }
+
+    /**
+     * @brief Destroys the elements and releases the storage.
+     */
+    void release() {
+        if (m_data) {
+            std::destroy(m_data, m_data + storageSize());
+            allocator_type().deallocate(m_data, storageSize());
+        }
+        m_data = nullptr;
+        m_rows = m_cols = m_stride = 0;
+    }
+
+    size_type m_rows;   ///< The number of rows.
+    size_type m_cols;   ///< The number of columns.
+    size_type m_stride; ///< Elements between two consecutive rows (or columns).
+    T* m_data;          ///< The aligned storage.
+};
+
+/**
+ * @brief Overloads the stream insertion operator to print the matrix.
+ *
+ * @tparam T The type of the elements in the matrix.
+ * @tparam Layout Storage order of the matrix.
+ * @param os The output stream.
+ * @param mat The matrix to be printed.
+ * @return The output stream.
+ */
+template<typename T, MatrixLayout Layout>
+std::ostream& operator<<(std::ostream& os, const MatrixDyn<T, Layout>& mat)
+{
+    os << "[\n";
+    for (std::size_t i = 0; i < mat.rowCount(); ++i)
+    {
+        os << "  [";
+        for (std::size_t j = 0; j < mat.colCount(); ++j)
+        {
+            os << mat(i, j);
+            if (j + 1 < mat.colCount())
+                os << ", ";
+        }
+        os << "]";
+        if (i + 1 < mat.rowCount())
+            os << ",\n";
+        else
+            os << "\n";
+    }
+    os << "]";
+    return os;
+}
@@ -0,0 +1,629 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "ExpressionN.h"
+#include "GemmN.h"
+#include "MatrixN.h"
+#include "MatrixViewN.h"
+#include "VecteurND.h"
+
+/**
+ * @file MatrixExprN.h
+ * @brief Lazy expression templates over MatrixND and VectorND.
+ *
+ * The operators below return lightweight nodes instead of results. A node only
+ * computes a coefficient when asked, so assigning alpha * A + B or A * x + b to
+ * a MatrixND / VectorND evaluates the whole expression in one pass without
+ * intermediate objects. transpose() returns a view that swaps the indices.
+ *
+ * Nodes keep references to the MatrixND / VectorND they read and copies of the
+ * MatrixViewN windows: an expression stored in an auto variable must not
+ * outlive the storage it reads.
+ */
+
+/**
+ * @brief Whether E owns its coefficients (MatrixND, VectorND) rather than computing them.
+ */
+template<typename E>
+struct ExprLeafN : std::false_type {};
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+struct ExprLeafN<MatrixND<T, Rows, Cols>> : std::true_type {};
+
+template<typename T, std::size_t N>
+struct ExprLeafN<VectorND<T, N>> : std::true_type {};
+
+/**
+ * @brief Whether E stores its rows contiguously with a fixed distance between them.
+ *
+ * Such operands (MatrixND, views with a unit column stride) are handed to GemmN
+ * as a pointer and a leading dimension, RowStride.
+ */
+template<typename E>
+struct ExprRowStorageN : std::false_type {};
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+struct ExprRowStorageN<MatrixND<T, Rows, Cols>> : std::true_type {
+    static constexpr std::size_t RowStride = Cols; ///< Elements between two consecutive rows.
+};
+
+template<typename T, std::size_t Rows, std::size_t Cols, std::size_t Stride>
+struct ExprRowStorageN<MatrixViewN<T, Rows, Cols, Stride, 1>> : std::true_type {
+    static constexpr std::size_t RowStride = Stride; ///< Elements between two consecutive rows.
+};
+
+/**
+ * @brief How a node stores an operand: leaves by reference, nodes by value.
+ */
+template<typename E>
+using ExprRefN = std::conditional_t<ExprLeafN<E>::value, const E&, E>;
+
+/**
+ * @brief How a product stores an operand.
+ *
+ * A product reads each coefficient of its operands many times, so an operand
+ * that is itself a product is evaluated once into its PlainType instead of
+ * being recomputed for every coefficient.
+ */
+template<typename E>
+struct ProductOperandN {
+    using type = ExprRefN<E>;
+};
+
+template<typename E>
+    requires requires { typename E::PlainType; }
+struct ProductOperandN<E> {
+    using type = typename E::PlainType;
+};
+
+/**
+ * @brief Multiplies a coefficient by a fixed factor.
+ */
+template<typename T>
+struct ScaleOpN {
+    T factor; ///< The scaling factor.
+
+    T operator()(const T& value) const {
+        return factor * value;
+    }
+};
+
+/**
+ * @brief Divides a coefficient by a fixed divisor.
+ */
+template<typename T>
+struct DivideOpN {
+    T divisor; ///< The divisor.
+
+    T operator()(const T& value) const {
+        return value / divisor;
+    }
+};
+
+/**
+ * @class MatrixBinaryExprN
+ * @brief Coefficient-wise combination of two matrix expressions of the same shape.
+ *
+ * @tparam L The left operand type.
+ * @tparam R The right operand type.
+ * @tparam Op The binary function applied to each pair of coefficients.
+ */
+template<typename L, typename R, typename Op>
+class MatrixBinaryExprN {
+public:
+    using value_type = typename L::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type RowsAtCompileTime = L::RowsAtCompileTime; ///< Number of rows.
+    static constexpr size_type ColsAtCompileTime = L::ColsAtCompileTime; ///< Number of columns.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param lhs The left operand.
+     * @param rhs The right operand.
+     * @param op The binary function.
+     */
+    MatrixBinaryExprN(const L& lhs, const R& rhs, Op op = Op{})
+        : m_lhs(lhs), m_rhs(rhs), m_op(op) {
+    }
+
+    /**
+     * @brief Computes the coefficient at the specified position.
+     */
+    value_type coeff(size_type row, size_type col) const {
+        return static_cast<value_type>(m_op(m_lhs.coeff(row, col), m_rhs.coeff(row, col)));
+    }
+
+    /**
+     * @brief Writes the expression into a row-major buffer, starting with the product operand.
+     *
+     * Only available when one operand is a product: A * B + C evaluates the
+     * product with its own kernel directly into dst, then folds C in place.
+     *
+     * @param dst The destination, RowsAtCompileTime * ColsAtCompileTime coefficients.
+     */
+    void evalTo(value_type* dst) const
+        requires (requires(const L& l, value_type* d) { l.evalTo(d); }
+            || requires(const R& r, value_type* d) { r.evalTo(d); }) {
+        if constexpr (requires(value_type* d) { m_lhs.evalTo(d); }) {
+            m_lhs.evalTo(dst);
+            for (size_type i = 0; i < RowsAtCompileTime; ++i) {
+                for (size_type j = 0; j < ColsAtCompileTime; ++j) {
+                    value_type& out = dst[i * ColsAtCompileTime + j];
+                    out = static_cast<value_type>(m_op(out, m_rhs.coeff(i, j)));
+                }
+            }
+        }
+        else {
+            m_rhs.evalTo(dst);
+            for (size_type i = 0; i < RowsAtCompileTime; ++i) {
+                for (size_type j = 0; j < ColsAtCompileTime; ++j) {
+                    value_type& out = dst[i * ColsAtCompileTime + j];
+                    out = static_cast<value_type>(m_op(m_lhs.coeff(i, j), out));
+                }
+            }
+        }
+    }
+
+private:
+    ExprRefN<L> m_lhs; ///< The left operand.
+    ExprRefN<R> m_rhs; ///< The right operand.
+    Op m_op;           ///< The binary function.
+};
+
+/**
+ * @class MatrixUnaryExprN
+ * @brief Coefficient-wise function of a matrix expression (negation, scaling).
+ *
+ * @tparam E The operand type.
+ * @tparam Op The unary function applied to each coefficient.
+ */
+template<typename E, typename Op>
+class MatrixUnaryExprN {
+public:
+    using value_type = typename E::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type RowsAtCompileTime = E::RowsAtCompileTime; ///< Number of rows.
+    static constexpr size_type ColsAtCompileTime = E::ColsAtCompileTime; ///< Number of columns.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param expr The operand.
+     * @param op The unary function.
+     */
+    MatrixUnaryExprN(const E& expr, Op op = Op{})
+        : m_expr(expr), m_op(op) {
+    }
+
+    /**
+     * @brief Computes the coefficient at the specified position.
+     */
+    value_type coeff(size_type row, size_type col) const {
+        return static_cast<value_type>(m_op(m_expr.coeff(row, col)));
+    }
+
+    /**
+     * @brief Writes the expression into a row-major buffer when the operand is a product.
+     *
+     * @param dst The destination, RowsAtCompileTime * ColsAtCompileTime coefficients.
+     */
+    void evalTo(value_type* dst) const
+        requires requires(const E& e, value_type* d) { e.evalTo(d); } {
+        m_expr.evalTo(dst);
+        for (size_type i = 0; i < RowsAtCompileTime * ColsAtCompileTime; ++i) {
+            dst[i] = static_cast<value_type>(m_op(dst[i]));
+        }
+    }
+
+private:
+    ExprRefN<E> m_expr; ///< The operand.
+    Op m_op;            ///< The unary function.
+};
+
+/**
+ * @class MatrixTransposeN
+ * @brief Transposed view of a matrix expression; no coefficient is copied.
+ *
+ * @tparam E The viewed expression type.
+ */
+template<typename E>
+class MatrixTransposeN {
+public:
+    using value_type = typename E::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type RowsAtCompileTime = E::ColsAtCompileTime; ///< Number of rows.
+    static constexpr size_type ColsAtCompileTime = E::RowsAtCompileTime; ///< Number of columns.
+
+    /**
+     * @brief Constructs the view.
+     *
+     * @param expr The viewed expression.
+     */
+    explicit MatrixTransposeN(const E& expr)
+        : m_expr(expr) {
+    }
+
+    /**
+     * @brief Returns the coefficient at (col, row) of the viewed expression.
+     */
+    value_type coeff(size_type row, size_type col) const {
+        return m_expr.coeff(col, row);
+    }
+
+private:
+    ExprRefN<E> m_expr; ///< The viewed expression.
+};
+
+/**
+ * @class MatrixProductExprN
+ * @brief Matrix product of two matrix expressions.
+ *
+ * When assigned to a matrix the product is computed by evalTo: large enough
+ * operands with row storage (see ExprRowStorageN) go through GemmN, everything
+ * else through an i-k-j loop that streams the rows of the right operand. Nested products are evaluated once
+ * (see ProductOperandN).
+ *
+ * @tparam L The left operand type.
+ * @tparam R The right operand type.
+ */
+template<typename L, typename R>
+class MatrixProductExprN {
+public:
+    using value_type = typename L::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type RowsAtCompileTime = L::RowsAtCompileTime; ///< Number of rows.
+    static constexpr size_type ColsAtCompileTime = R::ColsAtCompileTime; ///< Number of columns.
+    static constexpr size_type InnerSize = L::ColsAtCompileTime;         ///< Shared dimension.
+
+    using PlainType = MatrixND<value_type, RowsAtCompileTime, ColsAtCompileTime>; ///< Type the product evaluates to.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param lhs The left operand.
+     * @param rhs The right operand.
+     */
+    MatrixProductExprN(const L& lhs, const R& rhs)
+        : m_lhs(lhs), m_rhs(rhs) {
+    }
+
+    /**
+     * @brief Computes the coefficient at the specified position as a dot product.
+     */
+    value_type coeff(size_type row, size_type col) const {
+        value_type sum{};
+        for (size_type k = 0; k < InnerSize; ++k) {
+            sum += m_lhs.coeff(row, k) * m_rhs.coeff(k, col);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Writes the product into a row-major buffer.
+     *
+     * @param dst The destination, RowsAtCompileTime * ColsAtCompileTime coefficients.
+     *            Must not overlap the operands.
+     */
+    void evalTo(value_type* dst) const {
+        using LhsStored = std::remove_cvref_t<typename ProductOperandN<L>::type>;
+        using RhsStored = std::remove_cvref_t<typename ProductOperandN<R>::type>;
+
+        if constexpr (std::is_arithmetic_v<value_type> && ExprRowStorageN<LhsStored>::value
+            && ExprRowStorageN<RhsStored>::value
+            && RowsAtCompileTime * ColsAtCompileTime * InnerSize >= GemmThreshold) {
+            GemmN<value_type>::multiply(ThreadPoolN::global(), RowsAtCompileTime, ColsAtCompileTime, InnerSize,
+                m_lhs.data(), ExprRowStorageN<LhsStored>::RowStride, m_rhs.data(), ExprRowStorageN<RhsStored>::RowStride,
+                dst, ColsAtCompileTime);
+        }
+        else {
+            for (size_type i = 0; i < RowsAtCompileTime * ColsAtCompileTime; ++i) {
+                dst[i] = value_type{};
+            }
+            for (size_type i = 0; i < RowsAtCompileTime; ++i) {
+                value_type* out = dst + i * ColsAtCompileTime;
+                for (size_type k = 0; k < InnerSize; ++k) {
+                    const value_type aik = m_lhs.coeff(i, k);
+                    for (size_type j = 0; j < ColsAtCompileTime; ++j) {
+                        out[j] += aik * m_rhs.coeff(k, j);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_type GemmThreshold = 16 * 16 * 16; ///< Same cut-over as MatrixND::multiply.
+
+    typename ProductOperandN<L>::type m_lhs; ///< The left operand.
+    typename ProductOperandN<R>::type m_rhs; ///< The right operand.
+};
+
+/**
+ * @class VectorBinaryExprN
+ * @brief Coefficient-wise combination of two vector expressions of the same size.
+ *
+ * @tparam L The left operand type.
+ * @tparam R The right operand type.
+ * @tparam Op The binary function applied to each pair of coefficients.
+ */
+template<typename L, typename R, typename Op>
+class VectorBinaryExprN {
+public:
+    using value_type = typename L::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type SizeAtCompileTime = L::SizeAtCompileTime; ///< Number of elements.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param lhs The left operand.
+     * @param rhs The right operand.
+     * @param op The binary function.
+     */
+    VectorBinaryExprN(const L& lhs, const R& rhs, Op op = Op{})
+        : m_lhs(lhs), m_rhs(rhs), m_op(op) {
+    }
+
+    /**
+     * @brief Computes the coefficient at the specified index.
+     */
+    value_type coeff(size_type index) const {
+        return static_cast<value_type>(m_op(m_lhs.coeff(index), m_rhs.coeff(index)));
+    }
+
+private:
+    ExprRefN<L> m_lhs; ///< The left operand.
+    ExprRefN<R> m_rhs; ///< The right operand.
+    Op m_op;           ///< The binary function.
+};
+
+/**
+ * @class VectorUnaryExprN
+ * @brief Coefficient-wise function of a vector expression (negation, scaling).
+ *
+ * @tparam E The operand type.
+ * @tparam Op The unary function applied to each coefficient.
+ */
+template<typename E, typename Op>
+class VectorUnaryExprN {
+public:
+    using value_type = typename E::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type SizeAtCompileTime = E::SizeAtCompileTime; ///< Number of elements.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param expr The operand.
+     * @param op The unary function.
+     */
+    VectorUnaryExprN(const E& expr, Op op = Op{})
+        : m_expr(expr), m_op(op) {
+    }
+
+    /**
+     * @brief Computes the coefficient at the specified index.
+     */
+    value_type coeff(size_type index) const {
+        return static_cast<value_type>(m_op(m_expr.coeff(index)));
+    }
+
+private:
+    ExprRefN<E> m_expr; ///< The operand.
+    Op m_op;            ///< The unary function.
+};
+
+/**
+ * @class MatrixVectorProductExprN
+ * @brief Product of a matrix expression and a vector expression.
+ *
+ * Each coefficient is the dot product of a row with the vector, so A * x + b
+ * is a single pass over A. A vector operand that is itself a product is
+ * evaluated once beforehand.
+ *
+ * @tparam M The matrix operand type.
+ * @tparam V The vector operand type.
+ */
+template<typename M, typename V>
+class MatrixVectorProductExprN {
+public:
+    using value_type = typename M::value_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type SizeAtCompileTime = M::RowsAtCompileTime; ///< Number of elements.
+    static constexpr size_type InnerSize = M::ColsAtCompileTime;         ///< Shared dimension.
+
+    using PlainType = VectorND<value_type, SizeAtCompileTime>; ///< Type the product evaluates to.
+
+    /**
+     * @brief Constructs the node.
+     *
+     * @param mat The matrix operand.
+     * @param vec The vector operand.
+     */
+    MatrixVectorProductExprN(const M& mat, const V& vec)
+        : m_mat(mat), m_vec(vec) {
+    }
+
+    /**
+     * @brief Computes the dot product of a row of the matrix with the vector.
+     */
+    value_type coeff(size_type index) const {
+        value_type sum{};
+        for (size_type k = 0; k < InnerSize; ++k) {
+            sum += m_mat.coeff(index, k) * m_vec.coeff(k);
+        }
+        return sum;
+    }
+
+private:
+    typename ProductOperandN<M>::type m_mat; ///< The matrix operand.
+    typename ProductOperandN<V>::type m_vec; ///< The vector operand.
+};
+
+/**
+ * @brief Whether two matrix expressions have the same shape and element type.
+ */
+template<typename L, typename R>
+concept SameMatrixShapeN = L::RowsAtCompileTime == R::RowsAtCompileTime
+    && L::ColsAtCompileTime == R::ColsAtCompileTime
+    && std::is_same_v<typename L::value_type, typename R::value_type>;
+
+/**
+ * @brief Whether two vector expressions have the same size and element type.
+ */
+template<typename L, typename R>
+concept SameVectorSizeN = L::SizeAtCompileTime == R::SizeAtCompileTime
+    && std::is_same_v<typename L::value_type, typename R::value_type>;
+
+/**
+ * @brief Returns a transposed view of a matrix expression.
+ */
+template<MatrixExpressionN E>
+MatrixTransposeN<E> transpose(const E& expr)
+{
+    return MatrixTransposeN<E>(expr);
+}
+
+/**
+ * @brief Coefficient-wise sum of two matrix expressions.
+ */
+template<MatrixExpressionN L, MatrixExpressionN R>
+    requires SameMatrixShapeN<L, R>
+MatrixBinaryExprN<L, R, std::plus<>> operator+(const L& lhs, const R& rhs)
+{
+    return MatrixBinaryExprN<L, R, std::plus<>>(lhs, rhs);
+}
+
+/**
+ * @brief Coefficient-wise difference of two matrix expressions.
+ */
+template<MatrixExpressionN L, MatrixExpressionN R>
+    requires SameMatrixShapeN<L, R>
+MatrixBinaryExprN<L, R, std::minus<>> operator-(const L& lhs, const R& rhs)
+{
+    return MatrixBinaryExprN<L, R, std::minus<>>(lhs, rhs);
+}
+
+/**
+ * @brief Coefficient-wise negation of a matrix expression.
+ */
+template<MatrixExpressionN E>
+MatrixUnaryExprN<E, std::negate<>> operator-(const E& expr)
+{
+    return MatrixUnaryExprN<E, std::negate<>>(expr);
+}
+
+/**
+ * @brief Scales a matrix expression.
+ */
+template<MatrixExpressionN E>
+MatrixUnaryExprN<E, ScaleOpN<typename E::value_type>> operator*(const typename E::value_type& factor, const E& expr)
+{
+    return MatrixUnaryExprN<E, ScaleOpN<typename E::value_type>>(expr, { factor });
+}
+
+/**
+ * @brief Scales a matrix expression.
+ */
+template<MatrixExpressionN E>
+MatrixUnaryExprN<E, ScaleOpN<typename E::value_type>> operator*(const E& expr, const typename E::value_type& factor)
+{
+    return MatrixUnaryExprN<E, ScaleOpN<typename E::value_type>>(expr, { factor });
+}
+
+/**
+ * @brief Divides every coefficient of a matrix expression.
+ */
+template<MatrixExpressionN E>
+MatrixUnaryExprN<E, DivideOpN<typename E::value_type>> operator/(const E& expr, const typename E::value_type& divisor)
+{
+    return MatrixUnaryExprN<E, DivideOpN<typename E::value_type>>(expr, { divisor });
+}
+
+/**
+ * @brief Matrix product of two matrix expressions.
+ */
+template<MatrixExpressionN L, MatrixExpressionN R>
+    requires (L::ColsAtCompileTime == R::RowsAtCompileTime
+        && std::is_same_v<typename L::value_type, typename R::value_type>)
+MatrixProductExprN<L, R> operator*(const L& lhs, const R& rhs)
+{
+    return MatrixProductExprN<L, R>(lhs, rhs);
+}
+
+/**
+ * @brief Product of a matrix expression and a vector expression.
+ */
+template<MatrixExpressionN M, VectorExpressionN V>
+    requires (M::ColsAtCompileTime == V::SizeAtCompileTime
+        && std::is_same_v<typename M::value_type, typename V::value_type>)
+MatrixVectorProductExprN<M, V> operator*(const M& mat, const V& vec)
+{
+    return MatrixVectorProductExprN<M, V>(mat, vec);
+}
+
+/**
+ * @brief Coefficient-wise sum of two vector expressions.
+ */
+template<VectorExpressionN L, VectorExpressionN R>
+    requires SameVectorSizeN<L, R>
+VectorBinaryExprN<L, R, std::plus<>> operator+(const L& lhs, const R& rhs)
+{
+    return VectorBinaryExprN<L, R, std::plus<>>(lhs, rhs);
+}
+
+/**
+ * @brief Coefficient-wise difference of two vector expressions.
+ */
+template<VectorExpressionN L, VectorExpressionN R>
+    requires SameVectorSizeN<L, R>
+VectorBinaryExprN<L, R, std::minus<>> operator-(const L& lhs, const R& rhs)
+{
+    return VectorBinaryExprN<L, R, std::minus<>>(lhs, rhs);
+}
+
+/**
+ * @brief Coefficient-wise negation of a vector expression.
+ */
+template<VectorExpressionN E>
+VectorUnaryExprN<E, std::negate<>> operator-(const E& expr)
+{
+    return VectorUnaryExprN<E, std::negate<>>(expr);
+}
+
+/**
+ * @brief Scales a vector expression.
+ */
+template<VectorExpressionN E>
+VectorUnaryExprN<E, ScaleOpN<typename E::value_type>> operator*(const typename E::value_type& factor, const E& expr)
+{
+    return VectorUnaryExprN<E, ScaleOpN<typename E::value_type>>(expr, { factor });
+}
+
+/**
+ * @brief Scales a vector expression.
+ */
+template<VectorExpressionN E>
+VectorUnaryExprN<E, ScaleOpN<typename E::value_type>> operator*(const E& expr, const typename E::value_type& factor)
+{
+    return VectorUnaryExprN<E, ScaleOpN<typename E::value_type>>(expr, { factor });
+}
+
+/**
+ * @brief Divides every coefficient of a vector expression.
+ */
+template<VectorExpressionN E>
+VectorUnaryExprN<E, DivideOpN<typename E::value_type>> operator/(const E& expr, const typename E::value_type& divisor)
+{
+    return VectorUnaryExprN<E, DivideOpN<typename E::value_type>>(expr, { divisor });
+}
@@ -0,0 +1,607 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "MatrixDyn.h"
+#include "MatrixN.h"
+#include "TransposeN.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CONTAINERS_HAS_MMAP 1
+#endif
+
+/**
+ * @file MatrixIoN.h
+ * @brief Binary NumPy .npy and text output for MatrixND and MatrixDyn.
+ *
+ * Files follow the .npy format (version 1.0 on write; 1.0 to 3.0 on read) with
+ * a two-dimensional shape, so numpy.load() reads what saveNpy() writes and the
+ * other way round. Column-major MatrixDyn are stored with fortran_order True,
+ * which keeps both directions a straight copy of the storage.
+ */
+
+/**
+ * @struct NpyHeaderN
+ * @brief Decoded header of a .npy file.
+ */
+struct NpyHeaderN {
+    std::string descr;        ///< NumPy type string, such as "<f8".
+    bool fortranOrder;        ///< Whether the data is stored column by column.
+    std::size_t rows;         ///< Number of rows (1 for a one-dimensional array).
+    std::size_t cols;         ///< Number of columns.
+    std::size_t dataOffset;   ///< Position of the first element in the file.
+};
+
+/**
+ * @class MatrixIoN
+ * @brief Saving and loading matrices as .npy files, and writing them as text.
+ *
+ * Only arithmetic element types can be stored. Loading checks the element type
+ * and the shape and converts byte order and storage order when they differ.
+ * I/O errors and malformed files throw std::runtime_error.
+ */
+class MatrixIoN {
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Returns the NumPy type string of T in native byte order ("<f8" for double).
+     */
+    template<typename T>
+    static std::string npyDescr() {
+        static_assert(std::is_arithmetic_v<T>, "MatrixIoN requires an arithmetic element type");
+        if constexpr (std::is_same_v<T, bool>) {
+            return "|b1";
+        } else {
+            const char order = sizeof(T) == 1 ? '|' : (std::endian::native == std::endian::little ? '<' : '>');
+            const char kind = std::is_floating_point_v<T> ? 'f' : (std::is_signed_v<T> ? 'i' : 'u');
+            return std::string{ order, kind } + std::to_string(sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Decodes the header at the start of a .npy file.
+     *
+     * @param bytes The first bytes of the file.
+     * @param size Number of bytes available.
+     * @return The decoded header.
+     * @throws std::runtime_error if the header is malformed or incomplete.
+     */
+    static NpyHeaderN parseNpyHeader(const char* bytes, size_type size) {
+        if (size < 10 || std::memcmp(bytes, "\x93NUMPY", 6) != 0)
+            throw std::runtime_error("MatrixIoN: not a .npy file");
+        const auto major = static_cast<unsigned char>(bytes[6]);
+        const size_type preamble = major == 1 ? 10 : 12;
+        if (major < 1 || major > 3 || size < preamble)
+            throw std::runtime_error("MatrixIoN: unsupported .npy version");
+        size_type length = 0;
+        for (size_type i = preamble - 1; i >= 8; --i)
+            length = length << 8 | static_cast<unsigned char>(bytes[i]);
+        if (size < preamble + length)
+            throw std::runtime_error("MatrixIoN: truncated .npy header");
+
+        const std::string_view dict(bytes + preamble, length);
+        NpyHeaderN header{};
+        header.dataOffset = preamble + length;
+
+        const std::string_view descr = valueOf(dict, "descr");
+        if (descr.size() < 2 || (descr.front() != '\'' && descr.front() != '"'))
+            throw std::runtime_error("MatrixIoN: malformed descr in .npy header");
+        const size_type descrEnd = descr.find(descr.front(), 1);
+        if (descrEnd == std::string_view::npos)
+            throw std::runtime_error("MatrixIoN: malformed descr in .npy header");
+        header.descr = std::string(descr.substr(1, descrEnd - 1));
+
+        header.fortranOrder = valueOf(dict, "fortran_order").starts_with("True");
+
+        const std::string_view shape = valueOf(dict, "shape");
+        const size_type close = shape.find(')');
+        if (shape.empty() || shape.front() != '(' || close == std::string_view::npos)
+            throw std::runtime_error("MatrixIoN: malformed shape in .npy header");
+        size_type dims[2] = { 1, 1 };
+        size_type count = 0;
+        const char* it = shape.data() + 1;
+        const char* end = shape.data() + close;
+        while (it < end) {
+            while (it < end && (*it == ' ' || *it == ','))
+                ++it;
+            if (it == end)
+                break;
+            size_type dim = 0;
+            const auto result = std::from_chars(it, end, dim);
+            if (result.ec != std::errc() || count == 2)
+                throw std::runtime_error("MatrixIoN: only one and two-dimensional .npy arrays are supported");
+            dims[count++] = dim;
+            it = result.ptr;
+        }
+        header.rows = count == 2 ? dims[0] : 1;
+        header.cols = count == 2 ? dims[1] : dims[0];
+        return header;
+    }
+
+    /**
+     * @brief Reads and decodes the header of a .npy stream, leaving it at the first element.
+     *
+     * @param in The stream to read.
+     * @return The decoded header.
+     * @throws std::runtime_error if the header is malformed or incomplete.
+     */
+    static NpyHeaderN readNpyHeader(std::istream& in) {
+        char preamble[12] = {};
+        if (!in.read(preamble, 10))
+            throw std::runtime_error("MatrixIoN: not a .npy file");
+        size_type size = 10;
+        if (static_cast<unsigned char>(preamble[6]) >= 2) {
+            if (!in.read(preamble + 10, 2))
+                throw std::runtime_error("MatrixIoN: truncated .npy header");
+            size = 12;
+        }
+        const NpyHeaderN prefix = parsePreambleLength(preamble, size);
+        std::string bytes(preamble, size);
+        bytes.resize(prefix.dataOffset);
+        if (!in.read(bytes.data() + size, static_cast<std::streamsize>(prefix.dataOffset - size)))
+            throw std::runtime_error("MatrixIoN: truncated .npy header");
+        return parseNpyHeader(bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief Writes a matrix from strided storage as a .npy stream.
+     *
+     * @param out The destination stream, opened in binary mode.
+     * @param data The first stored element.
+     * @param rows Number of rows of the matrix.
+     * @param cols Number of columns of the matrix.
+     * @param stride Elements between two consecutive stored lines.
+     * @param fortranOrder Whether the stored lines are columns (true) or rows (false).
+     * @throws std::runtime_error if writing fails.
+     */
+    template<typename T>
+    static void writeNpy(std::ostream& out, const T* data, size_type rows, size_type cols, size_type stride,
+        bool fortranOrder) {
+        std::string dict = "{'descr': '" + npyDescr<T>() + "', 'fortran_order': " + (fortranOrder ? "True" : "False")
+            + ", 'shape': (" + std::to_string(rows) + ", " + std::to_string(cols) + "), }";
+        // NumPy pads the header with spaces so that the data starts on a 64-byte boundary.
+        const size_type unpadded = 10 + dict.size() + 1;
+        dict.append((NpyAlignment - unpadded % NpyAlignment) % NpyAlignment, ' ');
+        dict.push_back('\n');
+        if (dict.size() > 0xFFFF)
+            throw std::runtime_error("MatrixIoN: .npy header too long");
+
+        const char preamble[10] = { '\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0,
+            static_cast<char>(dict.size() & 0xFF), static_cast<char>(dict.size() >> 8) };
+        out.write(preamble, sizeof(preamble));
+        out.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+
+        const size_type lines = fortranOrder ? cols : rows;
+        const size_type length = fortranOrder ? rows : cols;
+        if (stride == length) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(lines * length * sizeof(T)));
+        } else {
+            for (size_type i = 0; i < lines; ++i)
+                out.write(reinterpret_cast<const char*>(data + i * stride), static_cast<std::streamsize>(length * sizeof(T)));
+        }
+        if (!out)
+            throw std::runtime_error("MatrixIoN: write failed");
+    }
+
+    /**
+     * @brief Saves a fixed-size matrix as a .npy file.
+     *
+     * @param path The file to create or overwrite.
+     * @param matrix The matrix to save.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template<typename T, size_type Rows, size_type Cols>
+    static void saveNpy(const std::string& path, const MatrixND<T, Rows, Cols>& matrix) {
+        std::ofstream out = openOutput(path);
+        writeNpy(out, matrix.data(), Rows, Cols, Cols, false);
+    }
+
+    /**
+     * @brief Saves a runtime-sized matrix as a .npy file, column-major matrices in Fortran order.
+     *
+     * @param path The file to create or overwrite.
+     * @param matrix The matrix to save.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template<typename T, MatrixLayout Layout>
+    static void saveNpy(const std::string& path, const MatrixDyn<T, Layout>& matrix) {
+        std::ofstream out = openOutput(path);
+        writeNpy(out, matrix.data(), matrix.rowCount(), matrix.colCount(), matrix.stride(),
+            Layout == MatrixLayout::ColMajor);
+    }
+
+    /**
+     * @brief Loads a .npy file into a MatrixND or a MatrixDyn.
+     *
+     * A one-dimensional array loads as a single row. Data in the other storage
+     * order is transposed with TransposeN, data in the other byte order is swapped.
+     *
+     * @tparam Matrix MatrixND<T, Rows, Cols> or MatrixDyn<T, Layout>.
+     * @param path The file to read.
+     * @return The loaded matrix.
+     * @throws std::runtime_error if the file cannot be read, holds another element
+     *         type or, for MatrixND, another shape.
+     */
+    template<typename Matrix>
+    static Matrix loadNpy(const std::string& path) {
+        using T = typename Matrix::value_type;
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("MatrixIoN: cannot open " + path);
+        const NpyHeaderN header = readNpyHeader(in);
+        const bool swapBytes = checkDescr<T>(header.descr);
+        const size_type lines = header.fortranOrder ? header.cols : header.rows;
+        const size_type length = header.fortranOrder ? header.rows : header.cols;
+
+        if constexpr (requires { Matrix::RowsAtCompileTime; }) {
+            if (header.rows != Matrix::RowsAtCompileTime || header.cols != Matrix::ColsAtCompileTime)
+                throw std::runtime_error("MatrixIoN: shape of " + path + " does not match the matrix");
+            Matrix result;
+            if (!header.fortranOrder) {
+                readElements(in, result.data(), lines * length, swapBytes);
+            } else {
+                std::unique_ptr<T[]> buffer(new T[lines * length]);
+                readElements(in, buffer.get(), lines * length, swapBytes);
+                TransposeN<T>::copy(lines, length, buffer.get(), length, result.data(), header.cols);
+            }
+            return result;
+        } else {
+            Matrix result(header.rows, header.cols);
+            if (header.fortranOrder == (Matrix::layout == MatrixLayout::ColMajor)) {
+                for (size_type i = 0; i < lines; ++i)
+                    readElements(in, result.data() + i * result.stride(), length, swapBytes);
+            } else {
+                std::unique_ptr<T[]> buffer(new T[lines * length]);
+                readElements(in, buffer.get(), lines * length, swapBytes);
+                TransposeN<T>::copy(lines, length, buffer.get(), length, result.data(), result.stride());
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Writes a matrix as text, one row per line.
+     *
+     * Numbers are formatted with std::to_chars into a local buffer, which gives the shortest
+     * representation that reads back to the same value and bypasses the
+     * per-element formatting of iostream.
+     *
+     * @param out The destination stream.
+     * @param matrix A MatrixND or a MatrixDyn.
+     * @param delimiter Separator written between two values of a row.
+     * @throws std::runtime_error if writing fails.
+     */
+    template<typename Matrix>
+    static void writeText(std::ostream& out, const Matrix& matrix, char delimiter = ' ') {
+        using T = typename Matrix::value_type;
+        static_assert(std::is_arithmetic_v<T>, "MatrixIoN requires an arithmetic element type");
+        const T* data = matrix.data();
+        size_type rowStep = matrix.colCount();
+        size_type colStep = 1;
+        if constexpr (requires { matrix.stride(); }) {
+            rowStep = Matrix::layout == MatrixLayout::RowMajor ? matrix.stride() : 1;
+            colStep = Matrix::layout == MatrixLayout::RowMajor ? 1 : matrix.stride();
+        }
+
+        char buffer[TextBufferSize];
+        size_type used = 0;
+        for (size_type i = 0; i < matrix.rowCount(); ++i) {
+            for (size_type j = 0; j < matrix.colCount(); ++j) {
+                if (TextBufferSize - used < MaxNumberLength) {
+                    out.write(buffer, static_cast<std::streamsize>(used));
+                    used = 0;
+                }
+                const T value = data[i * rowStep + j * colStep];
+                char* end;
+                if constexpr (std::is_same_v<T, bool>)
+                    end = std::to_chars(buffer + used, buffer + TextBufferSize, static_cast<int>(value)).ptr;
+                else
+                    end = std::to_chars(buffer + used, buffer + TextBufferSize, value).ptr;
+                *end++ = j + 1 < matrix.colCount() ? delimiter : '\n';
+                used = static_cast<size_type>(end - buffer);
+            }
+        }
+        out.write(buffer, static_cast<std::streamsize>(used));
+        if (!out)
+            throw std::runtime_error("MatrixIoN: write failed");
+    }
+
+    /**
+     * @brief Writes a matrix as a text file, one row per line.
+     *
+     * @param path The file to create or overwrite.
+     * @param matrix A MatrixND or a MatrixDyn.
+     * @param delimiter Separator written between two values of a row.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template<typename Matrix>
+    static void saveText(const std::string& path, const Matrix& matrix, char delimiter = ' ') {
+        std::ofstream out = openOutput(path);
+        writeText(out, matrix, delimiter);
+    }
+
+    /**
+     * @brief Checks that a NumPy type string describes T.
+     *
+     * @return Whether the data is in the other byte order.
+     * @throws std::runtime_error if the type differs.
+     */
+    template<typename T>
+    static bool checkDescr(const std::string& descr) {
+        const std::string native = npyDescr<T>();
+        if (descr.size() != native.size() || descr.compare(1, std::string::npos, native, 1, std::string::npos) != 0)
+            throw std::runtime_error("MatrixIoN: element type " + descr + " does not match " + native);
+        return sizeof(T) > 1 && descr[0] != native[0] && descr[0] != '=' && descr[0] != '|';
+    }
+
+private:
+    static constexpr size_type NpyAlignment = 64;     ///< Alignment of the data in written files.
+    static constexpr size_type TextBufferSize = 65536; ///< Bytes formatted before each stream write.
+    static constexpr size_type MaxNumberLength = 64;   ///< Upper bound on one formatted value and its delimiter.
+
+    /**
+     * @brief Decodes only the header length from the preamble.
+     */
+    static NpyHeaderN parsePreambleLength(const char* preamble, size_type size) {
+        if (std::memcmp(preamble, "\x93NUMPY", 6) != 0)
+            throw std::runtime_error("MatrixIoN: not a .npy file");
+        size_type length = 0;
+        for (size_type i = size - 1; i >= 8; --i)
+            length = length << 8 | static_cast<unsigned char>(preamble[i]);
+        NpyHeaderN header{};
+        header.dataOffset = size + length;
+        return header;
+    }
+
+    /**
+     * @brief Returns the text following key: in a header dictionary.
+     */
+    static std::string_view valueOf(std::string_view dict, std::string_view key) {
+        for (char quote : { '\'', '"' }) {
+            const std::string quoted = quote + std::string(key) + quote;
+            size_type pos = dict.find(quoted);
+            if (pos == std::string_view::npos)
+                continue;
+            pos = dict.find(':', pos + quoted.size());
+            if (pos == std::string_view::npos)
+                break;
+            pos = dict.find_first_not_of(' ', pos + 1);
+            if (pos != std::string_view::npos)
+                return dict.substr(pos);
+        }
+        throw std::runtime_error("MatrixIoN: missing '" + std::string(key) + "' in .npy header");
+    }
+
+    /**
+     * @brief Reads count elements, swapping their bytes if requested.
+     */
+    template<typename T>
+    static void readElements(std::istream& in, T* dst, size_type count, bool swapBytes) {
+        if (!in.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(count * sizeof(T))))
+            throw std::runtime_error("MatrixIoN: truncated .npy data");
+        if (swapBytes) {
+            for (size_type i = 0; i < count; ++i) {
+                char* bytes = reinterpret_cast<char*>(dst + i);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * @brief Opens a file for binary writing.
+     */
+    static std::ofstream openOutput(const std::string& path) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("MatrixIoN: cannot create " + path);
+        return out;
+    }
+};
+
+/**
+ * @class NpyMappedN
+ * @brief Read-only .npy matrix whose elements stay in the file, mapped in memory.
+ *
+ * Opening costs one header parse regardless of the size of the file; pages are
+ * read by the system on first access. On platforms without mmap the file is
+ * read into memory instead. The file must hold T in native byte order.
+ *
+ * @tparam T The arithmetic element type.
+ */
+template<typename T>
+class NpyMappedN {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Maps a .npy file.
+     *
+     * @param path The file to map.
+     * @throws std::runtime_error if the file cannot be mapped, is malformed, holds
+     *         another element type or another byte order.
+     */
+    explicit NpyMappedN(const std::string& path)
+        : m_base(nullptr), m_size(0), m_data(nullptr), m_header{} {
+        map(path);
+        try {
+            m_header = MatrixIoN::parseNpyHeader(m_base, m_size);
+            if (MatrixIoN::checkDescr<T>(m_header.descr))
+                throw std::runtime_error("MatrixIoN: cannot map " + path + " stored in foreign byte order");
+            if (m_header.dataOffset + m_header.rows * m_header.cols * sizeof(T) > m_size)
+                throw std::runtime_error("MatrixIoN: truncated .npy data");
+            if (m_header.dataOffset % alignof(T) != 0)
+                throw std::runtime_error("MatrixIoN: misaligned .npy data");
+        }
+        catch (...) {
+            unmap();
+            throw;
+        }
+        m_data = reinterpret_cast<const T*>(m_base + m_header.dataOffset);
+    }
+
+    NpyMappedN(const NpyMappedN&) = delete;
+    NpyMappedN& operator=(const NpyMappedN&) = delete;
+
+    /**
+     * @brief Move constructor. The moved-from object maps nothing.
+     */
+    NpyMappedN(NpyMappedN&& other) noexcept
+        : m_base(std::exchange(other.m_base, nullptr)), m_size(std::exchange(other.m_size, 0)),
+        m_data(std::exchange(other.m_data, nullptr)), m_header(std::move(other.m_header)) {
+    }
+
+    /**
+     * @brief Move assignment operator. The moved-from object maps nothing.
+     */
+    NpyMappedN& operator=(NpyMappedN&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_base = std::exchange(other.m_base, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_header = std::move(other.m_header);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~NpyMappedN() {
+        unmap();
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    size_type rowCount() const {
+        return m_header.rows;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    size_type colCount() const {
+        return m_header.cols;
+    }
+
+    /**
+     * @brief Returns whether the elements are stored column by column.
+     */
+    bool fortranOrder() const {
+        return m_header.fortranOrder;
+    }
+
+    /**
+     * @brief Returns the first element, in the storage order given by fortranOrder().
+     */
+    const T* data() const {
+        return m_data;
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @throws std::out_of_range if the row or column index is out of bounds.
+     */
+    const T& operator()(size_type row, size_type col) const {
+        if (row >= m_header.rows || col >= m_header.cols)
+            throw std::out_of_range("Index hors limites dans NpyMappedN::operator()");
+        return m_header.fortranOrder ? m_data[col * m_header.rows + row] : m_data[row * m_header.cols + col];
+    }
+
+    /**
+     * @brief Copies the mapped matrix into a MatrixDyn.
+     *
+     * @tparam Layout Storage order of the copy.
+     */
+    template<MatrixLayout Layout = MatrixLayout::RowMajor>
+    MatrixDyn<T, Layout> toMatrixDyn() const {
+        MatrixDyn<T, Layout> result(m_header.rows, m_header.cols);
+        const size_type lines = m_header.fortranOrder ? m_header.cols : m_header.rows;
+        const size_type length = m_header.fortranOrder ? m_header.rows : m_header.cols;
+        if (m_header.fortranOrder == (Layout == MatrixLayout::ColMajor)) {
+            for (size_type i = 0; i < lines; ++i)
+                std::copy(m_data + i * length, m_data + (i + 1) * length, result.data() + i * result.stride());
+        } else {
+            TransposeN<T>::copy(lines, length, m_data, length, result.data(), result.stride());
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Maps (or reads) the whole file into m_base.
+     */
+    void map(const std::string& path) {
+#if defined(CONTAINERS_HAS_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MatrixIoN: cannot open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("MatrixIoN: cannot map " + path);
+        }
+        void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED)
+            throw std::runtime_error("MatrixIoN: cannot map " + path);
+        m_base = static_cast<const char*>(address);
+        m_size = static_cast<size_type>(info.st_size);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw std::runtime_error("MatrixIoN: cannot open " + path);
+        m_size = static_cast<size_type>(in.tellg());
+        char* buffer = static_cast<char*>(::operator new(m_size, std::align_val_t{ 64 }));
+        in.seekg(0);
+        if (!in.read(buffer, static_cast<std::streamsize>(m_size))) {
+            ::operator delete(buffer, std::align_val_t{ 64 });
+            throw std::runtime_error("MatrixIoN: cannot read " + path);
+        }
+        m_base = buffer;
+#endif
+    }
+
+    /**
+     * @brief Releases the mapping.
+     */
+    void unmap() {
+        if (!m_base)
+            return;
+#if defined(CONTAINERS_HAS_MMAP)
+        ::munmap(const_cast<char*>(m_base), m_size);
+#else
+        ::operator delete(const_cast<char*>(m_base), std::align_val_t{ 64 });
+#endif
+        m_base = nullptr;
+        m_size = 0;
+        m_data = nullptr;
+    }
+
+    const char* m_base;   ///< Start of the mapped file.
+    size_type m_size;     ///< Size of the mapped file in bytes.
+    const T* m_data;      ///< First element of the matrix.
+    NpyHeaderN m_header;  ///< Decoded header.
+};
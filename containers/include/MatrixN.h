@@ -3,7 +3,12 @@
 #include <stdexcept>
 #include <initializer_list>
 #include <ostream>
+#include <type_traits>
 #include "ArrayN.h"
+#include "ExpressionN.h"
+#include "GemmN.h"
+#include "MatrixViewN.h"
+#include "TransposeN.h"
 
 
 
@@ -21,6 +26,9 @@ public:
     using value_type = T;
     using size_type = std::size_t;
 
+    static constexpr size_type RowsAtCompileTime = Rows; ///< Number of rows, for MatrixExpressionN.
+    static constexpr size_type ColsAtCompileTime = Cols; ///< Number of columns, for MatrixExpressionN.
+
     /**
      * @brief Default constructor that initializes all elements to the default value of T.
      */
@@ -64,6 +72,43 @@ public:
         }
     }
 
+    /**
+     * @brief Evaluates a matrix expression of the same shape in a single pass.
+     *
+     * Expressions providing evalTo(T*) (products) write their result directly;
+     * every other expression is evaluated coefficient by coefficient, so
+     * alpha * A + transpose(B) creates no intermediate matrix. The conversion
+     * is explicit when the element type of the expression differs from T.
+     *
+     * @tparam E The expression type.
+     * @param expr The expression to evaluate.
+     */
+    template<MatrixExpressionN E>
+        requires (E::RowsAtCompileTime == Rows && E::ColsAtCompileTime == Cols
+            && std::is_convertible_v<typename E::value_type, T>)
+    explicit(!std::is_same_v<typename E::value_type, T>) MatrixND(const E& expr) {
+        assign(expr);
+    }
+
+    /**
+     * @brief Assigns the value of a matrix expression of the same shape.
+     *
+     * The expression may reference this matrix (A = transpose(A) * B): it is
+     * evaluated into a temporary first, then copied.
+     *
+     * @tparam E The expression type.
+     * @param expr The expression to evaluate.
+     * @return A reference to this matrix.
+     */
+    template<MatrixExpressionN E>
+        requires (E::RowsAtCompileTime == Rows && E::ColsAtCompileTime == Cols
+            && std::is_convertible_v<typename E::value_type, T>)
+    MatrixND& operator=(const E& expr) {
+        MatrixND result(expr);
+        m_data = result.m_data;
+        return *this;
+    }
+
     /**
      * @brief Accesses the element at the specified row and column.
      *
@@ -92,6 +137,28 @@ public:
         return m_data[row * Cols + col];
     }
 
+    /**
+     * @brief Accesses the element at the specified row and column without bounds checking.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @return A const reference to the element at the specified position.
+     */
+    const T& coeff(size_type row, size_type col) const {
+        return m_data.data()[row * Cols + col];
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column without bounds checking.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @return A reference to the element at the specified position.
+     */
+    T& coeffRef(size_type row, size_type col) {
+        return m_data.data()[row * Cols + col];
+    }
+
     /**
      * @brief Returns the number of rows in the matrix.
      *
@@ -110,9 +177,123 @@ public:
         return Cols;
     }
 
+    /**
+     * @brief Returns a view of one row.
+     *
+     * @param row The row index.
+     * @return A 1 x Cols view sharing the storage of this matrix.
+     * @throws std::out_of_range if row is out of bounds.
+     */
+    RowViewN<T, Cols> row(size_type row) {
+        if (row >= Rows)
+            throw std::out_of_range("Index hors limites dans MatrixND::row");
+        return RowViewN<T, Cols>(m_data.data() + row * Cols);
+    }
+
+    /**
+     * @brief Returns a read-only view of one row.
+     *
+     * @param row The row index.
+     * @return A 1 x Cols view sharing the storage of this matrix.
+     * @throws std::out_of_range if row is out of bounds.
+     */
+    RowViewN<const T, Cols> row(size_type row) const {
+        if (row >= Rows)
+            throw std::out_of_range("Index hors limites dans MatrixND::row const");
+        return RowViewN<const T, Cols>(m_data.data() + row * Cols);
+    }
+
+    /**
+     * @brief Returns a view of one column.
+     *
+     * @param col The column index.
+     * @return A Rows x 1 view sharing the storage of this matrix.
+     * @throws std::out_of_range if col is out of bounds.
+     */
+    ColViewN<T, Rows, Cols> col(size_type col) {
+        if (col >= Cols)
+            throw std::out_of_range("Index hors limites dans MatrixND::col");
+        return ColViewN<T, Rows, Cols>(m_data.data() + col);
+    }
+
+    /**
+     * @brief Returns a read-only view of one column.
+     *
+     * @param col The column index.
+     * @return A Rows x 1 view sharing the storage of this matrix.
+     * @throws std::out_of_range if col is out of bounds.
+     */
+    ColViewN<const T, Rows, Cols> col(size_type col) const {
+        if (col >= Cols)
+            throw std::out_of_range("Index hors limites dans MatrixND::col const");
+        return ColViewN<const T, Rows, Cols>(m_data.data() + col);
+    }
+
+    /**
+     * @brief Returns a view of the BlockRows x BlockCols block starting at (row, col).
+     *
+     * @tparam BlockRows The number of rows of the block.
+     * @tparam BlockCols The number of columns of the block.
+     * @param row The first row of the block.
+     * @param col The first column of the block.
+     * @return A view sharing the storage of this matrix.
+     * @throws std::out_of_range if the block does not fit in the matrix.
+     */
+    template<std::size_t BlockRows, std::size_t BlockCols>
+        requires (BlockRows <= Rows && BlockCols <= Cols)
+    BlockViewN<T, BlockRows, BlockCols, Cols> block(size_type row, size_type col) {
+        if (row > Rows - BlockRows || col > Cols - BlockCols)
+            throw std::out_of_range("Index hors limites dans MatrixND::block");
+        return BlockViewN<T, BlockRows, BlockCols, Cols>(m_data.data() + row * Cols + col);
+    }
+
+    /**
+     * @brief Returns a read-only view of the BlockRows x BlockCols block starting at (row, col).
+     *
+     * @tparam BlockRows The number of rows of the block.
+     * @tparam BlockCols The number of columns of the block.
+     * @param row The first row of the block.
+     * @param col The first column of the block.
+     * @return A view sharing the storage of this matrix.
+     * @throws std::out_of_range if the block does not fit in the matrix.
+     */
+    template<std::size_t BlockRows, std::size_t BlockCols>
+        requires (BlockRows <= Rows && BlockCols <= Cols)
+    BlockViewN<const T, BlockRows, BlockCols, Cols> block(size_type row, size_type col) const {
+        if (row > Rows - BlockRows || col > Cols - BlockCols)
+            throw std::out_of_range("Index hors limites dans MatrixND::block const");
+        return BlockViewN<const T, BlockRows, BlockCols, Cols>(m_data.data() + row * Cols + col);
+    }
+
+    /**
+     * @brief Returns a copy of the transposed matrix.
+     *
+     * Goes through the cache-oblivious TransposeN kernel. transpose() from
+     * MatrixExprN.h is the lazy counterpart for use inside expressions.
+     *
+     * @return The Cols x Rows transpose.
+     */
+    MatrixND<T, Cols, Rows> transposed() const {
+        MatrixND<T, Cols, Rows> result;
+        TransposeN<T>::copy(Rows, Cols, m_data.data(), Cols, result.data(), Rows);
+        return result;
+    }
+
+    /**
+     * @brief Transposes a square matrix in place.
+     */
+    void transposeInPlace()
+        requires (Rows == Cols) {
+        TransposeN<T>::inPlace(Rows, m_data.data(), Cols);
+    }
+
     /**
      * @brief Multiplies two matrices and returns the result.
      *
+     * Small products and non-arithmetic element types use an i-k-j loop on the raw
+     * storage; larger arithmetic products are forwarded to the blocked GemmN kernel,
+     * which splits big products into tiles on ThreadPoolN::global().
+     *
      * @tparam OtherCols The number of columns in the second matrix.
      * @param lhs The left-hand side matrix.
      * @param rhs The right-hand side matrix.
@@ -122,13 +303,21 @@ public:
     static MatrixND<T, Rows, OtherCols> multiply(const MatrixND<T, Rows, Cols>& lhs,
         const MatrixND<T, Cols, OtherCols>& rhs) {
         MatrixND<T, Rows, OtherCols> result;
-        for (size_type i = 0; i < Rows; ++i) {
-            for (size_type j = 0; j < OtherCols; ++j) {
-                T sum = T{};
+        if constexpr (std::is_arithmetic_v<T> && Rows * Cols * OtherCols >= GemmThreshold) {
+            GemmN<T>::multiply(ThreadPoolN::global(), Rows, OtherCols, Cols,
+                lhs.data(), Cols, rhs.data(), OtherCols, result.data(), OtherCols);
+        }
+        else {
+            const T* a = lhs.data();
+            const T* b = rhs.data();
+            T* c = result.data();
+            for (size_type i = 0; i < Rows; ++i) {
                 for (size_type k = 0; k < Cols; ++k) {
-                    sum += lhs(i, k) * rhs(k, j);
+                    const T aik = a[i * Cols + k];
+                    for (size_type j = 0; j < OtherCols; ++j) {
+                        c[i * OtherCols + j] += aik * b[k * OtherCols + j];
+                    }
                 }
-                result(i, j) = sum;
             }
         }
         return result;
@@ -153,6 +342,26 @@ public:
     }
 
 private:
+    /**
+     * @brief Writes the value of expr into the storage.
+     */
+    template<typename E>
+    void assign(const E& expr) {
+        T* dst = m_data.data();
+        if constexpr (requires { expr.evalTo(dst); }) {
+            expr.evalTo(dst);
+        }
+        else {
+            for (size_type i = 0; i < Rows; ++i) {
+                for (size_type j = 0; j < Cols; ++j) {
+                    dst[i * Cols + j] = static_cast<T>(expr.coeff(i, j));
+                }
+            }
+        }
+    }
+
+    static constexpr size_type GemmThreshold = 16 * 16 * 16; ///< Minimum Rows * Cols * OtherCols forwarded to GemmN.
+
     ArrayN<T, Rows* Cols> m_data; ///< The underlying data array.
 };
 
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "ExpressionN.h"
+
+/**
+ * @class MatrixViewN
+ * @brief Non-owning Rows x Cols window over strided storage.
+ *
+ * Coefficient (row, col) lives at data()[row * RowStride + col * ColStride].
+ * The strides are template parameters, so index arithmetic folds into the
+ * kernels exactly as it does for MatrixND. A view models MatrixExpressionN:
+ * it can be read by every operator of MatrixExprN.h and assigned from any
+ * expression of the same shape, which writes through to the viewed storage.
+ * A view with T = const U is read-only.
+ *
+ * Copying a view copies the window, not the coefficients; assigning to a view
+ * copies the coefficients. The view must not outlive the viewed storage.
+ *
+ * @tparam T The element type, const-qualified for read-only views.
+ * @tparam Rows The number of rows of the window.
+ * @tparam Cols The number of columns of the window.
+ * @tparam RowStride Elements between two consecutive rows.
+ * @tparam ColStride Elements between two consecutive columns.
+ */
+template<typename T, std::size_t Rows, std::size_t Cols, std::size_t RowStride, std::size_t ColStride = 1>
+class MatrixViewN {
+public:
+    using value_type = std::remove_const_t<T>;
+    using size_type = std::size_t;
+
+    static constexpr size_type RowsAtCompileTime = Rows;           ///< Number of rows, for MatrixExpressionN.
+    static constexpr size_type ColsAtCompileTime = Cols;           ///< Number of columns, for MatrixExpressionN.
+    static constexpr size_type RowStrideAtCompileTime = RowStride; ///< Elements between two consecutive rows.
+    static constexpr size_type ColStrideAtCompileTime = ColStride; ///< Elements between two consecutive columns.
+
+    /**
+     * @brief Constructs a view whose coefficient (0, 0) is data[0].
+     *
+     * @param data The first viewed element.
+     */
+    explicit MatrixViewN(T* data)
+        : m_data(data) {
+    }
+
+    MatrixViewN(const MatrixViewN&) = default;
+
+    /**
+     * @brief Converts a mutable view into a read-only one.
+     *
+     * @param other The mutable view.
+     */
+    template<typename U>
+        requires (std::is_const_v<T> && std::is_same_v<U, value_type>)
+    MatrixViewN(const MatrixViewN<U, Rows, Cols, RowStride, ColStride>& other)
+        : m_data(other.data()) {
+    }
+
+    /**
+     * @brief Copies the coefficients of another view of the same shape.
+     *
+     * @param other The view to copy, which may overlap this one.
+     * @return A reference to this view.
+     */
+    MatrixViewN& operator=(const MatrixViewN& other)
+        requires (!std::is_const_v<T>) {
+        return assign(other);
+    }
+
+    /**
+     * @brief Writes the value of a matrix expression of the same shape.
+     *
+     * The expression is evaluated into a temporary first, so it may read the
+     * viewed storage (overlapping blocks, block = block * B).
+     *
+     * @tparam E The expression type.
+     * @param expr The expression to evaluate.
+     * @return A reference to this view.
+     */
+    template<MatrixExpressionN E>
+        requires (!std::is_const_v<T> && E::RowsAtCompileTime == Rows && E::ColsAtCompileTime == Cols
+            && std::is_convertible_v<typename E::value_type, value_type>)
+    MatrixViewN& operator=(const E& expr) {
+        return assign(expr);
+    }
+
+    /**
+     * @brief Adds a matrix expression of the same shape coefficient-wise.
+     *
+     * @tparam E The expression type.
+     * @param expr The expression to add.
+     * @return A reference to this view.
+     */
+    template<MatrixExpressionN E>
+        requires (!std::is_const_v<T> && E::RowsAtCompileTime == Rows && E::ColsAtCompileTime == Cols)
+    MatrixViewN& operator+=(const E& expr) {
+        const std::array<value_type, Rows * Cols> values = evaluate(expr);
+        for (size_type i = 0; i < Rows; ++i) {
+            for (size_type j = 0; j < Cols; ++j) {
+                coeffRef(i, j) += values[i * Cols + j];
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Subtracts a matrix expression of the same shape coefficient-wise.
+     *
+     * @tparam E The expression type.
+     * @param expr The expression to subtract.
+     * @return A reference to this view.
+     */
+    template<MatrixExpressionN E>
+        requires (!std::is_const_v<T> && E::RowsAtCompileTime == Rows && E::ColsAtCompileTime == Cols)
+    MatrixViewN& operator-=(const E& expr) {
+        const std::array<value_type, Rows * Cols> values = evaluate(expr);
+        for (size_type i = 0; i < Rows; ++i) {
+            for (size_type j = 0; j < Cols; ++j) {
+                coeffRef(i, j) -= values[i * Cols + j];
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies every coefficient by a scalar.
+     *
+     * @param factor The scaling factor.
+     * @return A reference to this view.
+     */
+    MatrixViewN& operator*=(const value_type& factor)
+        requires (!std::is_const_v<T>) {
+        for (size_type i = 0; i < Rows; ++i) {
+            for (size_type j = 0; j < Cols; ++j) {
+                coeffRef(i, j) *= factor;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Sets every coefficient to a value.
+     *
+     * @param value The value to write.
+     */
+    void fill(const value_type& value) const
+        requires (!std::is_const_v<T>) {
+        for (size_type i = 0; i < Rows; ++i) {
+            for (size_type j = 0; j < Cols; ++j) {
+                coeffRef(i, j) = value;
+            }
+        }
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @return A reference to the element at the specified position.
+     * @throws std::out_of_range if the row or column index is out of bounds.
+     */
+    T& operator()(size_type row, size_type col) const {
+        if (row >= Rows || col >= Cols)
+            throw std::out_of_range("Index hors limites dans MatrixViewN::operator()");
+        return coeffRef(row, col);
+    }
+
+    /**
+     * @brief Accesses an element of a row or column view by its position along the view.
+     *
+     * @param index The position of the element.
+     * @return A reference to the element.
+     * @throws std::out_of_range if index is out of bounds.
+     */
+    T& operator[](size_type index) const
+        requires (Rows == 1 || Cols == 1) {
+        if (index >= Rows * Cols)
+            throw std::out_of_range("Index hors limites dans MatrixViewN::operator[]");
+        return Rows == 1 ? coeffRef(0, index) : coeffRef(index, 0);
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column without bounds checking.
+     */
+    const value_type& coeff(size_type row, size_type col) const {
+        return m_data[row * RowStride + col * ColStride];
+    }
+
+    /**
+     * @brief Accesses the element at the specified row and column without bounds checking.
+     */
+    T& coeffRef(size_type row, size_type col) const {
+        return m_data[row * RowStride + col * ColStride];
+    }
+
+    /**
+     * @brief Returns the number of rows of the view.
+     */
+    constexpr size_type rowCount() const {
+        return Rows;
+    }
+
+    /**
+     * @brief Returns the number of columns of the view.
+     */
+    constexpr size_type colCount() const {
+        return Cols;
+    }
+
+    /**
+     * @brief Returns the first viewed element, for kernels taking a pointer and strides.
+     */
+    T* data() const {
+        return m_data;
+    }
+
+private:
+    /**
+     * @brief Evaluates expr into a row-major temporary.
+     */
+    template<typename E>
+    static std::array<value_type, Rows * Cols> evaluate(const E& expr) {
+        std::array<value_type, Rows * Cols> values;
+        if constexpr (requires { expr.evalTo(values.data()); }) {
+            expr.evalTo(values.data());
+        }
+        else {
+            for (size_type i = 0; i < Rows; ++i) {
+                for (size_type j = 0; j < Cols; ++j) {
+                    values[i * Cols + j] = static_cast<value_type>(expr.coeff(i, j));
+                }
+            }
+        }
+        return values;
+    }
+
+    /**
+     * @brief Writes the value of expr through the view.
+     */
+    template<typename E>
+    MatrixViewN& assign(const E& expr) {
+        const std::array<value_type, Rows * Cols> values = evaluate(expr);
+        for (size_type i = 0; i < Rows; ++i) {
+            for (size_type j = 0; j < Cols; ++j) {
+                coeffRef(i, j) = values[i * Cols + j];
+            }
+        }
+        return *this;
+    }
+
+    T* m_data; ///< The viewed coefficient (0, 0).
+};
+
+/**
+ * @brief View of one row of a row-major matrix with Cols columns.
+ */
+template<typename T, std::size_t Cols>
+using RowViewN = MatrixViewN<T, 1, Cols, Cols, 1>;
+
+/**
+ * @brief View of one column of a row-major matrix with Rows rows and Stride columns.
+ */
+template<typename T, std::size_t Rows, std::size_t Stride>
+using ColViewN = MatrixViewN<T, Rows, 1, Stride, 1>;
+
+/**
+ * @brief View of a Rows x Cols block of a row-major matrix with Stride columns.
+ */
+template<typename T, std::size_t Rows, std::size_t Cols, std::size_t Stride>
+using BlockViewN = MatrixViewN<T, Rows, Cols, Stride, 1>;
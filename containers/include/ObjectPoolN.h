@@ -0,0 +1,411 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "IntrusiveListN.h"
+
+/**
+ * @class PoolThreadIndexN
+ * @brief Small dense index of the current thread, shared by every ObjectPoolN.
+ *
+ * Live threads hold distinct indices. An index is handed back when its
+ * thread exits and reused by the next thread that asks, so indices stay
+ * below the peak number of threads using pools at once. Handing an index
+ * over goes through a mutex, which orders everything the old thread did
+ * with it before anything the new one does.
+ */
+class PoolThreadIndexN
+{
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Index of the calling thread.
+     */
+    static size_type current()
+    {
+        static thread_local Holder holder;
+        return holder.index;
+    }
+
+private:
+    /**
+     * @brief Owns the index of a thread for the thread's lifetime.
+     */
+    struct Holder
+    {
+        Holder() : index(acquire()) {}
+        ~Holder()
+        {
+            release(index);
+        }
+
+        size_type index;
+    };
+
+    /**
+     * @brief Indices handed back by exited threads, and the next never-used index.
+     */
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<size_type> released;
+        size_type next = 0;
+    };
+
+    static Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    static size_type acquire()
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (reg.released.empty())
+            return reg.next++;
+        // Smallest released index first, so low indices (which have a thread cache) are reused.
+        auto smallest = std::min_element(reg.released.begin(), reg.released.end());
+        const size_type index = *smallest;
+        *smallest = reg.released.back();
+        reg.released.pop_back();
+        return index;
+    }
+
+    static void release(size_type index)
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.released.push_back(index);
+    }
+};
+
+/**
+ * @class ObjectPoolN
+ * @brief Pool allocating objects of type T in slabs and recycling them through an intrusive free list.
+ *
+ * create() constructs a T in a free cell and destroy() destroys it and puts
+ * the cell back; memory goes back to the system only when the pool is
+ * destroyed. A free cell stores the free-list link in its own bytes, so the
+ * pool needs no memory besides the slabs. Objects are freshly constructed
+ * by create(), so an IntrusiveListHook member starts unlinked and the
+ * object can go straight into an IntrusiveList; destroy(list, object) and
+ * destroy_all(list) unlink objects before recycling them.
+ *
+ * The pool is thread-safe. The first CacheSlots threads (see
+ * PoolThreadIndexN) each get a private cache of up to CacheCapacity free
+ * cells: create() and destroy() touch only that cache and take the pool
+ * mutex once per CacheCapacity / 2 cells, to refill from or flush to the
+ * shared free list. Other threads, and pools built with threadCache off, go
+ * through the mutex every time. An object may be destroyed by another
+ * thread than the one that created it.
+ *
+ * stats() reports live objects, slabs and capacity exactly. peak counts
+ * the cells that have left the shared free list at once, which includes
+ * the cells waiting in thread caches: with caching it is an upper bound of
+ * the peak number of live objects, off by at most the cached cells.
+ *
+ * Objects still alive when the pool is destroyed are not destroyed; their
+ * memory is released with the slabs.
+ *
+ * @tparam T Object type.
+ */
+template<typename T>
+class ObjectPoolN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static constexpr size_type CacheSlots = 64;    ///< Threads with a private cache, by PoolThreadIndexN index.
+    static constexpr size_type CacheCapacity = 64; ///< Free cells a thread cache holds before flushing half.
+
+    /// Cells per slab by default: about 64 KiB, and at least 32 cells.
+    static constexpr size_type DefaultSlabObjects = std::max<size_type>(32, (size_type(64) << 10) / std::max(sizeof(T), sizeof(void*)));
+
+    /**
+     * @brief Snapshot of the pool counters.
+     */
+    struct Stats
+    {
+        size_type live;     ///< Objects created and not yet destroyed.
+        size_type peak;     ///< High-water mark of cells out of the shared free list (see ObjectPoolN).
+        size_type slabs;    ///< Slabs allocated.
+        size_type capacity; ///< Cells in all slabs.
+        size_type cached;   ///< Free cells held by thread caches.
+    };
+
+    /**
+     * @brief Constructs an empty pool; no slab is allocated until the first create().
+     *
+     * @param objectsPerSlab Cells per slab (at least 1); the default makes slabs of about 64 KiB.
+     * @param threadCache Whether threads get private caches of free cells.
+     */
+    explicit ObjectPoolN(size_type objectsPerSlab = DefaultSlabObjects, bool threadCache = true)
+        : m_objectsPerSlab(std::max<size_type>(objectsPerSlab, 1)), m_caches(threadCache ? new Cache[CacheSlots] : nullptr)
+    {
+    }
+
+    ObjectPoolN(const ObjectPoolN&) = delete;
+    ObjectPoolN& operator=(const ObjectPoolN&) = delete;
+
+    /**
+     * @brief Releases every slab.
+     */
+    ~ObjectPoolN()
+    {
+        for (Cell* slab : m_slabs)
+            ::operator delete(slab, std::align_val_t(alignof(Cell)));
+    }
+
+    /**
+     * @brief Constructs an object from args in a free cell.
+     *
+     * @return The new object.
+     * @throws Whatever the constructor of T or the slab allocation throws; the cell is then recycled.
+     */
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        Cache* cache = localCache();
+        Cell* cell = cache ? popCached(*cache) : popShared();
+        try
+        {
+            T* object = ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+            if (cache)
+                bump(cache->created);
+            else
+                m_sharedCreated.fetch_add(1, std::memory_order_relaxed);
+            return object;
+        }
+        catch (...)
+        {
+            if (cache)
+                pushCached(*cache, cell);
+            else
+                pushShared(cell);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destroys an object created by this pool and recycles its cell; does nothing for nullptr.
+     *
+     * The object must not be linked in an IntrusiveList (see destroy(list, object)).
+     */
+    void destroy(T* object)
+    {
+        if (!object)
+            return;
+        object->~T();
+        Cell* cell = reinterpret_cast<Cell*>(object);
+        if (Cache* cache = localCache())
+        {
+            bump(cache->destroyed);
+            pushCached(*cache, cell);
+        }
+        else
+        {
+            m_sharedDestroyed.fetch_add(1, std::memory_order_relaxed);
+            pushShared(cell);
+        }
+    }
+
+    /**
+     * @brief Unlinks an object from the list holding it, then destroys it.
+     */
+    template<IntrusiveListHook T::* HookPtr>
+    void destroy(IntrusiveList<T, HookPtr>& list, T& object)
+    {
+        list.erase(typename IntrusiveList<T, HookPtr>::iterator(&(object.*HookPtr)));
+        destroy(&object);
+    }
+
+    /**
+     * @brief Empties a list and destroys every object it held.
+     */
+    template<IntrusiveListHook T::* HookPtr>
+    void destroy_all(IntrusiveList<T, HookPtr>& list)
+    {
+        while (!list.empty())
+        {
+            T& object = list.front();
+            list.pop_front();
+            destroy(&object);
+        }
+    }
+
+    /**
+     * @brief Number of objects created and not yet destroyed.
+     */
+    size_type live() const
+    {
+        return stats().live;
+    }
+
+    /**
+     * @brief Reads the pool counters.
+     *
+     * Thread caches are read without stopping their threads, so counters of
+     * a pool in use may be a few operations stale.
+     */
+    Stats stats() const
+    {
+        size_type created = m_sharedCreated.load(std::memory_order_relaxed);
+        size_type destroyed = m_sharedDestroyed.load(std::memory_order_relaxed);
+        size_type cached = 0;
+        if (m_caches)
+        {
+            for (size_type i = 0; i < CacheSlots; ++i)
+            {
+                created += m_caches[i].created.load(std::memory_order_relaxed);
+                destroyed += m_caches[i].destroyed.load(std::memory_order_relaxed);
+                cached += m_caches[i].size.load(std::memory_order_relaxed);
+            }
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Stats{ created - destroyed, m_peak, m_slabs.size(), m_slabs.size() * m_objectsPerSlab, cached };
+    }
+
+private:
+    /**
+     * @brief Storage for one object, or the free-list link while the cell is free.
+     */
+    union Cell
+    {
+        Cell* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * @brief Free cells and counters of one thread, on its own cache line.
+     */
+    struct alignas(64) Cache
+    {
+        Cell* head = nullptr;                   ///< Free cells, linked through Cell::next.
+        std::atomic<size_type> size{ 0 };       ///< Number of cells in the list; atomic for stats() only.
+        std::atomic<size_type> created{ 0 };    ///< Objects created by the owning thread.
+        std::atomic<size_type> destroyed{ 0 };  ///< Objects destroyed by the owning thread.
+    };
+
+    /**
+     * @brief Increments a counter that only the calling thread writes; no read-modify-write needed.
+     */
+    static void bump(std::atomic<size_type>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Cache of the calling thread, nullptr if it has none.
+     */
+    Cache* localCache() const
+    {
+        if (!m_caches)
+            return nullptr;
+        const size_type index = PoolThreadIndexN::current();
+        return index < CacheSlots ? &m_caches[index] : nullptr;
+    }
+
+    /**
+     * @brief Takes a cell from a thread cache, refilling it with half its capacity when empty.
+     */
+    Cell* popCached(Cache& cache)
+    {
+        if (!cache.head)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_type i = 0; i < CacheCapacity / 2; ++i)
+            {
+                Cell* cell = takeLocked();
+                cell->next = cache.head;
+                cache.head = cell;
+                cache.size.store(i + 1, std::memory_order_relaxed);
+            }
+        }
+        Cell* cell = cache.head;
+        cache.head = cell->next;
+        cache.size.store(cache.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        return cell;
+    }
+
+    /**
+     * @brief Puts a cell in a thread cache, flushing half of it to the shared list when full.
+     */
+    void pushCached(Cache& cache, Cell* cell)
+    {
+        cell->next = cache.head;
+        cache.head = cell;
+        size_type size = cache.size.load(std::memory_order_relaxed) + 1;
+        if (size > CacheCapacity)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (; size > CacheCapacity / 2; --size)
+            {
+                Cell* flushed = cache.head;
+                cache.head = flushed->next;
+                giveLocked(flushed);
+            }
+        }
+        cache.size.store(size, std::memory_order_relaxed);
+    }
+
+    Cell* popShared()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return takeLocked();
+    }
+
+    void pushShared(Cell* cell)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        giveLocked(cell);
+    }
+
+    /**
+     * @brief Takes a cell from the shared free list, allocating a slab if it is empty. Needs m_mutex.
+     */
+    Cell* takeLocked()
+    {
+        if (!m_free)
+        {
+            Cell* slab = static_cast<Cell*>(::operator new(m_objectsPerSlab * sizeof(Cell), std::align_val_t(alignof(Cell))));
+            m_slabs.push_back(slab);
+            for (size_type i = m_objectsPerSlab; i-- > 0;)
+            {
+                slab[i].next = m_free;
+                m_free = &slab[i];
+            }
+        }
+        Cell* cell = m_free;
+        m_free = cell->next;
+        m_peak = std::max(m_peak, ++m_outstanding);
+        return cell;
+    }
+
+    /**
+     * @brief Returns a cell to the shared free list. Needs m_mutex.
+     */
+    void giveLocked(Cell* cell)
+    {
+        cell->next = m_free;
+        m_free = cell;
+        --m_outstanding;
+    }
+
+    const size_type m_objectsPerSlab;         ///< Cells per slab.
+    std::unique_ptr<Cache[]> m_caches;        ///< Thread caches, nullptr when caching is off.
+    mutable std::mutex m_mutex;               ///< Guards the shared free list, the slabs and the peak.
+    Cell* m_free = nullptr;                   ///< Shared free list.
+    std::vector<Cell*> m_slabs;               ///< Allocated slabs.
+    size_type m_outstanding = 0;              ///< Cells out of the shared free list (live or cached).
+    size_type m_peak = 0;                     ///< High-water mark of m_outstanding.
+    std::atomic<size_type> m_sharedCreated{ 0 };   ///< Objects created through the shared list.
+    std::atomic<size_type> m_sharedDestroyed{ 0 }; ///< Objects destroyed through the shared list.
+};
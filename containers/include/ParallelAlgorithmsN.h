@@ -0,0 +1,528 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ListN.h"
+#include "MatrixN.h"
+#include "ThreadPoolN.h"
+
+/**
+ * @class ParallelAlgorithmsN
+ * @brief Parallel versions of the standard algorithms over the storage of VectorN, ArrayN and MatrixND.
+ *
+ * Every algorithm works on the contiguous storage of a container (see
+ * storage()) and runs on a ThreadPoolN, so it does not depend on
+ * std::execution. The storage is cut into chunks of grain elements, which
+ * idle workers steal. A grain of 0 picks one automatically: enough chunks to
+ * balance the load over the pool, but never fewer than MinGrain elements per
+ * chunk, and a single chunk when the pool has one worker. Inputs that fit in
+ * one chunk run the sequential standard algorithm on the calling thread.
+ *
+ * Callables are invoked concurrently from several threads and must be safe
+ * to call that way. The first exception thrown by a callable is rethrown
+ * once the running chunks have finished.
+ */
+class ParallelAlgorithmsN
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type MinGrain = 4096;        ///< Smallest automatic chunk: below it task overhead dominates.
+    static constexpr size_type ChunksPerThread = 8;    ///< Automatic chunks per worker, for load balancing.
+    static constexpr size_type MinSortRun = 16384;     ///< Smallest run sorted by one task before the merges.
+
+    /**
+     * @brief Returns the storage of a contiguous sized range (VectorN, ArrayN, std::vector, std::span...).
+     */
+    template<typename R>
+        requires std::ranges::contiguous_range<R&> && std::ranges::sized_range<R&>
+    static auto storage(R& range)
+    {
+        return std::span(std::ranges::data(range), std::ranges::size(range));
+    }
+
+    /**
+     * @brief Returns the row-major storage of a MatrixND.
+     */
+    template<typename T, size_type Rows, size_type Cols>
+    static std::span<T> storage(MatrixND<T, Rows, Cols>& matrix)
+    {
+        return std::span<T>(matrix.data(), Rows * Cols);
+    }
+
+    /**
+     * @brief Returns the row-major storage of a MatrixND.
+     */
+    template<typename T, size_type Rows, size_type Cols>
+    static std::span<const T> storage(const MatrixND<T, Rows, Cols>& matrix)
+    {
+        return std::span<const T>(matrix.data(), Rows * Cols);
+    }
+
+    /**
+     * @brief Calls fn on every element.
+     *
+     * @param container The elements to visit.
+     * @param fn Callable as fn(element&).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     */
+    template<typename C, typename Fn>
+    static void for_each(C& container, Fn fn, ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        auto data = storage(container);
+        pool.parallel_for(0, data.size(), grainFor(pool, data.size(), grain), [&](size_type first, size_type last)
+        {
+            for (size_type i = first; i < last; ++i)
+                fn(data[i]);
+        });
+    }
+
+    /**
+     * @brief Writes fn(input[i]) to output[i] for every element of input.
+     *
+     * @param input The elements to transform.
+     * @param output Receives the results; may be input itself.
+     * @param fn Callable as fn(const element&).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     * @return Pointer past the last element written.
+     * @throws std::runtime_error if output is smaller than input.
+     */
+    template<typename In, typename Out, typename Fn>
+    static auto transform(const In& input, Out& output, Fn fn, ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        auto in = storage(input);
+        auto out = storage(output);
+        if (out.size() < in.size())
+            throw std::runtime_error("ParallelAlgorithmsN::transform: output smaller than input");
+
+        pool.parallel_for(0, in.size(), grainFor(pool, in.size(), grain), [&](size_type first, size_type last)
+        {
+            for (size_type i = first; i < last; ++i)
+                out[i] = fn(in[i]);
+        });
+        return out.data() + in.size();
+    }
+
+    /**
+     * @brief Folds the elements with an associative operation.
+     *
+     * As with std::reduce, op combines values of T: each chunk starts from
+     * its first element converted to T and folds the rest with op(T, element),
+     * then the chunk results are folded with op(T, T). op must therefore be
+     * associative over T, with an element behaving as the T it converts to;
+     * an op that weighs its two operands differently, such as a + 2 * x,
+     * gives a result that depends on the grain. Chunks are folded in order,
+     * so op need not be commutative and, for a given grain, floating-point
+     * results are reproducible from run to run.
+     *
+     * @param container The elements to fold; each must convert to T.
+     * @param init The initial value, folded first.
+     * @param op Associative callable as op(T, element) and op(T, T).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     * @return init op e0 op e1 ... op en-1.
+     */
+    template<typename C, typename T, typename BinaryOp = std::plus<>>
+    static T reduce(const C& container, T init, BinaryOp op = BinaryOp(), ThreadPoolN& pool = ThreadPoolN::global(),
+        size_type grain = 0)
+    {
+        auto data = storage(container);
+        const size_type n = data.size();
+        const size_type chunkSize = grainFor(pool, n, grain);
+        if (n <= chunkSize)
+            return std::accumulate(data.begin(), data.end(), std::move(init), op);
+
+        std::vector<T> partial = foldChunks<T>(data, chunkSize, op, pool);
+        for (T& value : partial)
+            init = op(std::move(init), std::move(value));
+        return init;
+    }
+
+    /**
+     * @brief Writes the running folds of the input: output[i] = input[0] op ... op input[i].
+     *
+     * Runs in three passes: fold every chunk, scan the chunk results, then scan
+     * every chunk again starting from its carry. The chunk results are
+     * combined with each other, so op has the same requirements as in reduce().
+     *
+     * @param input The elements to scan.
+     * @param output Receives the running folds; may be input itself.
+     * @param op Associative callable as op(T, element) and op(T, T).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     * @return Pointer past the last element written.
+     * @throws std::runtime_error if output is smaller than input.
+     */
+    template<typename In, typename Out, typename BinaryOp = std::plus<>>
+    static auto inclusive_scan(const In& input, Out& output, BinaryOp op = BinaryOp(), ThreadPoolN& pool = ThreadPoolN::global(),
+        size_type grain = 0)
+    {
+        auto in = storage(input);
+        auto out = storage(output);
+        using T = std::remove_cv_t<typename decltype(in)::element_type>;
+        const size_type n = in.size();
+        if (out.size() < n)
+            throw std::runtime_error("ParallelAlgorithmsN::inclusive_scan: output smaller than input");
+
+        const size_type chunkSize = grainFor(pool, n, grain);
+        if (n <= chunkSize)
+            return std::inclusive_scan(in.begin(), in.end(), out.begin(), op) - out.begin() + out.data();
+
+        std::vector<T> carry = foldChunks<T>(in, chunkSize, op, pool);
+        for (size_type c = 1; c < carry.size(); ++c)
+            carry[c] = op(carry[c - 1], carry[c]);
+
+        pool.parallel_for(0, carry.size(), 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                const size_type first = c * chunkSize;
+                const size_type last = std::min(n, first + chunkSize);
+                T running = c == 0 ? T(in[first]) : op(carry[c - 1], in[first]);
+                out[first] = running;
+                for (size_type i = first + 1; i < last; ++i)
+                {
+                    running = op(std::move(running), in[i]);
+                    out[i] = running;
+                }
+            }
+        });
+        return out.data() + n;
+    }
+
+    /**
+     * @brief Finds the first element satisfying a predicate.
+     *
+     * Chunks past an element already found are skipped, so the search stops
+     * early like std::find_if.
+     *
+     * @param container The elements to search.
+     * @param pred Callable as pred(const element&).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     * @return Pointer to the first matching element, or past the last element if none matches.
+     */
+    template<typename C, typename Pred>
+    static auto find_if(C& container, Pred pred, ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        auto data = storage(container);
+        const size_type n = data.size();
+        std::atomic<size_type> found(n);
+        pool.parallel_for(0, n, grainFor(pool, n, grain), [&](size_type first, size_type last)
+        {
+            for (size_type i = first; i < last; ++i)
+            {
+                if ((i - first) % FindCheckInterval == 0 && i >= found.load(std::memory_order_relaxed))
+                    return;
+                if (pred(data[i]))
+                {
+                    size_type current = found.load(std::memory_order_relaxed);
+                    while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                    {
+                    }
+                    return;
+                }
+            }
+        });
+        return data.data() + found.load();
+    }
+
+    /**
+     * @brief Moves the elements satisfying a predicate before the others.
+     *
+     * The partition is stable: both groups keep their relative order. The
+     * predicate is evaluated once per element; the elements go through a
+     * temporary buffer of the same size.
+     *
+     * @param container The elements to partition.
+     * @param pred Callable as pred(const element&).
+     * @param pool Pool running the chunks.
+     * @param grain Elements per chunk (0 = automatic).
+     * @return Pointer to the first element of the second group.
+     */
+    template<typename C, typename Pred>
+    static auto partition(C& container, Pred pred, ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        auto data = storage(container);
+        using T = typename decltype(data)::element_type;
+        const size_type n = data.size();
+        const size_type chunkSize = grainFor(pool, n, grain);
+        if (n <= chunkSize)
+            return std::stable_partition(data.begin(), data.end(), pred) - data.begin() + data.data();
+
+        const size_type chunks = (n + chunkSize - 1) / chunkSize;
+        std::vector<unsigned char> selected(n);
+        std::vector<size_type> offsets(chunks + 1, 0);
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                size_type count = 0;
+                for (size_type i = c * chunkSize; i < std::min(n, (c + 1) * chunkSize); ++i)
+                {
+                    selected[i] = pred(data[i]) ? 1 : 0;
+                    count += selected[i];
+                }
+                offsets[c + 1] = count;
+            }
+        });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        const size_type selectedCount = offsets[chunks];
+
+        std::vector<T> buffer(n);
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                const size_type first = c * chunkSize;
+                size_type inFirst = offsets[c];
+                size_type inSecond = selectedCount + first - offsets[c];
+                for (size_type i = first; i < std::min(n, first + chunkSize); ++i)
+                    buffer[selected[i] ? inFirst++ : inSecond++] = std::move(data[i]);
+            }
+        });
+        moveParallel(buffer.data(), n, data.data(), pool, chunkSize);
+        return data.data() + selectedCount;
+    }
+
+    /**
+     * @brief Sorts the elements.
+     *
+     * Runs of the storage are sorted in parallel with std::sort, then merged
+     * pairwise; each merge is itself split in parallel by binary search, so
+     * the last merges keep every worker busy. Uses a temporary buffer of the
+     * same size.
+     *
+     * @param container The elements to sort.
+     * @param comp Strict weak ordering.
+     * @param pool Pool running the chunks.
+     * @param grain Elements per sorted run (0 = automatic).
+     */
+    template<typename C, typename Compare = std::less<>>
+    static void sort(C& container, Compare comp = Compare(), ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        auto data = storage(container);
+        mergeSort<false>(data.data(), data.size(), comp, pool, grain);
+    }
+
+    /**
+     * @brief Sorts the elements, keeping equivalent elements in their original order.
+     *
+     * Same scheme as sort(), with std::stable_sort runs and stable merges.
+     *
+     * @param container The elements to sort.
+     * @param comp Strict weak ordering.
+     * @param pool Pool running the chunks.
+     * @param grain Elements per sorted run (0 = automatic).
+     */
+    template<typename C, typename Compare = std::less<>>
+    static void stable_sort(C& container, Compare comp = Compare(), ThreadPoolN& pool = ThreadPoolN::global(),
+        size_type grain = 0)
+    {
+        auto data = storage(container);
+        mergeSort<true>(data.data(), data.size(), comp, pool, grain);
+    }
+
+    /**
+     * @brief Sorts a ListN, keeping equivalent elements in their original order.
+     *
+     * A list cannot be split in parallel, so its values are moved into a
+     * contiguous buffer, sorted there with the parallel merge sort, and moved
+     * back into the same nodes.
+     *
+     * @param list The list to sort.
+     * @param comp Strict weak ordering.
+     * @param pool Pool running the chunks.
+     * @param grain Elements per sorted run (0 = automatic).
+     */
+    template<typename T, typename Allocator, typename Compare = std::less<>>
+    static void sort(ListN<T, Allocator>& list, Compare comp = Compare(), ThreadPoolN& pool = ThreadPoolN::global(), size_type grain = 0)
+    {
+        std::vector<T> values;
+        values.reserve(list.size());
+        for (T& value : list)
+            values.push_back(std::move(value));
+        mergeSort<true>(values.data(), values.size(), comp, pool, grain);
+        auto it = values.begin();
+        for (T& value : list)
+            value = std::move(*it++);
+    }
+
+    /**
+     * @brief Sorts a ListN, keeping equivalent elements in their original order (see sort(ListN&)).
+     */
+    template<typename T, typename Allocator, typename Compare = std::less<>>
+    static void stable_sort(ListN<T, Allocator>& list, Compare comp = Compare(), ThreadPoolN& pool = ThreadPoolN::global(),
+        size_type grain = 0)
+    {
+        sort(list, comp, pool, grain);
+    }
+
+private:
+    static constexpr size_type FindCheckInterval = 1024; ///< Elements between two checks of the best match in find_if.
+
+    /**
+     * @brief Returns grain, or the automatic chunk size for n elements when grain is 0.
+     *
+     * A pool with a single worker gets one chunk: splitting would only add
+     * the cost of the extra passes and tasks.
+     */
+    static size_type grainFor(const ThreadPoolN& pool, size_type n, size_type grain)
+    {
+        if (grain != 0)
+            return grain;
+        if (pool.threadCount() <= 1)
+            return std::max<size_type>(1, n);
+        const size_type chunks = pool.threadCount() * ChunksPerThread;
+        return std::max(MinGrain, (n + chunks - 1) / chunks);
+    }
+
+    /**
+     * @brief Folds every chunk of data from left to right, in parallel.
+     *
+     * Each fold starts from the first element of its chunk converted to T.
+     *
+     * @return The fold of each chunk, in order.
+     */
+    template<typename T, typename Span, typename BinaryOp>
+    static std::vector<T> foldChunks(const Span& data, size_type chunkSize, BinaryOp& op, ThreadPoolN& pool)
+    {
+        const size_type n = data.size();
+        const size_type chunks = (n + chunkSize - 1) / chunkSize;
+        std::vector<T> partial;
+        partial.reserve(chunks);
+        for (size_type c = 0; c < chunks; ++c)
+            partial.emplace_back(data[c * chunkSize]);
+
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                T running = std::move(partial[c]);
+                for (size_type i = c * chunkSize + 1; i < std::min(n, (c + 1) * chunkSize); ++i)
+                    running = op(std::move(running), data[i]);
+                partial[c] = std::move(running);
+            }
+        });
+        return partial;
+    }
+
+    /**
+     * @brief Moves n elements from src to dst, in parallel.
+     */
+    template<typename T>
+    static void moveParallel(T* src, size_type n, T* dst, ThreadPoolN& pool, size_type grain)
+    {
+        pool.parallel_for(0, n, grain, [&](size_type first, size_type last)
+        {
+            std::move(src + first, src + last, dst + first);
+        });
+    }
+
+    /**
+     * @brief Sorts runs in parallel, then merges them pairwise, ping-ponging with a buffer.
+     */
+    template<bool Stable, typename T, typename Compare>
+    static void mergeSort(T* data, size_type n, const Compare& comp, ThreadPoolN& pool, size_type grain)
+    {
+        size_type run = grain;
+        if (run == 0 && pool.threadCount() <= 1)
+        {
+            run = n;
+        }
+        else if (run == 0)
+        {
+            const size_type runs = 2 * pool.threadCount();
+            run = std::max(MinSortRun, (n + runs - 1) / runs);
+        }
+        if (n <= run)
+        {
+            if constexpr (Stable)
+                std::stable_sort(data, data + n, comp);
+            else
+                std::sort(data, data + n, comp);
+            return;
+        }
+
+        const size_type runs = (n + run - 1) / run;
+        pool.parallel_for(0, runs, 1, [&](size_type firstRun, size_type lastRun)
+        {
+            for (size_type r = firstRun; r < lastRun; ++r)
+            {
+                T* first = data + r * run;
+                T* last = data + std::min(n, (r + 1) * run);
+                if constexpr (Stable)
+                    std::stable_sort(first, last, comp);
+                else
+                    std::sort(first, last, comp);
+            }
+        });
+
+        const size_type mergeGrain = std::max<size_type>(MinGrain, run / 2);
+        std::vector<T> buffer(n);
+        T* src = data;
+        T* dst = buffer.data();
+        for (size_type width = run; width < n; width *= 2)
+        {
+            ThreadPoolN::TaskGroup group(pool);
+            for (size_type first = 0; first < n; first += 2 * width)
+            {
+                const size_type mid = std::min(n, first + width);
+                const size_type last = std::min(n, first + 2 * width);
+                group.run([=, &group, &comp]()
+                {
+                    mergeParallel(group, src + first, src + mid, src + mid, src + last, dst + first, comp, mergeGrain);
+                });
+            }
+            group.wait();
+            std::swap(src, dst);
+        }
+        if (src != data)
+            moveParallel(src, n, data, pool, mergeGrain);
+    }
+
+    /**
+     * @brief Stable merge of [a, aEnd) and [b, bEnd) into out, split in parallel.
+     *
+     * While the merge is larger than grain, the longer input is cut at its
+     * middle and the other at the matching bound, and the upper halves are
+     * merged by a separate task. Equivalent elements of a stay before those of b.
+     */
+    template<typename T, typename Compare>
+    static void mergeParallel(ThreadPoolN::TaskGroup& group, T* a, T* aEnd, T* b, T* bEnd, T* out, const Compare& comp,
+        size_type grain)
+    {
+        while (size_type(aEnd - a) + size_type(bEnd - b) > grain)
+        {
+            T* aMid;
+            T* bMid;
+            if (aEnd - a >= bEnd - b)
+            {
+                aMid = a + (aEnd - a) / 2;
+                bMid = std::lower_bound(b, bEnd, *aMid, comp);
+            }
+            else
+            {
+                bMid = b + (bEnd - b) / 2;
+                aMid = std::upper_bound(a, aEnd, *bMid, comp);
+            }
+            T* outMid = out + (aMid - a) + (bMid - b);
+            group.run([=, &group, &comp]() { mergeParallel(group, aMid, aEnd, bMid, bEnd, outMid, comp, grain); });
+            aEnd = aMid;
+            bEnd = bMid;
+        }
+        std::merge(std::make_move_iterator(a), std::make_move_iterator(aEnd), std::make_move_iterator(b),
+            std::make_move_iterator(bEnd), out, comp);
+    }
+};
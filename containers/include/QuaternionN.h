@@ -0,0 +1,385 @@
+#pragma once
+#include <cmath>
+#include <stdexcept>
+#include <ostream>
+#include "VecteurND.h"
+#include "MatrixN.h"
+
+/**
+ * @brief A rotation quaternion built on top of VectorND.
+ *
+ * The four coefficients are stored contiguously as (x, y, z, w) in a
+ * VectorND<T, 4>, so a quaternion occupies exactly one 128-bit lane for float.
+ *
+ * @tparam T Type of the coefficients (float or double).
+ */
+template<typename T>
+class QuaternionN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using vector3_type = VectorND<T, 3>;
+    using matrix3_type = MatrixND<T, 3, 3>;
+
+    /**
+     * @brief Default constructor that builds the identity rotation.
+     */
+    QuaternionN()
+        : QuaternionN(T{ 1 }, T{}, T{}, T{})
+    {
+    }
+
+    /**
+     * @brief Constructor from the scalar part and the vector part.
+     *
+     * @param w Scalar part.
+     * @param x First component of the vector part.
+     * @param y Second component of the vector part.
+     * @param z Third component of the vector part.
+     */
+    QuaternionN(T w, T x, T y, T z)
+    {
+        T* q = m_coeffs.data();
+        q[0] = x;
+        q[1] = y;
+        q[2] = z;
+        q[3] = w;
+    }
+
+    /**
+     * @brief Returns the identity rotation.
+     *
+     * @return Identity quaternion.
+     */
+    static QuaternionN identity()
+    {
+        return QuaternionN();
+    }
+
+    /**
+     * @brief Builds a rotation of the given angle around the given axis.
+     *
+     * @param axis Rotation axis (does not need to be normalized).
+     * @param angle Rotation angle in radians.
+     * @return Unit quaternion describing the rotation.
+     * @throws std::runtime_error if the axis has zero length.
+     */
+    static QuaternionN fromAxisAngle(const vector3_type& axis, T angle)
+    {
+        vector3_type unit = axis.normalized();
+        T half = angle / T{ 2 };
+        T s = std::sin(half);
+        return QuaternionN(std::cos(half), unit[0] * s, unit[1] * s, unit[2] * s);
+    }
+
+    /**
+     * @brief Extracts the rotation stored in an orthonormal 3x3 matrix.
+     *
+     * @param m Rotation matrix (row-major, orthonormal, determinant +1).
+     * @return Unit quaternion describing the same rotation.
+     */
+    static QuaternionN fromMatrix(const matrix3_type& m)
+    {
+        const T* a = m.data();
+        T trace = a[0] + a[4] + a[8];
+        QuaternionN q;
+        if (trace > T{})
+        {
+            T s = std::sqrt(trace + T{ 1 }) * T{ 2 };
+            q = QuaternionN(s / T{ 4 }, (a[7] - a[5]) / s, (a[2] - a[6]) / s, (a[3] - a[1]) / s);
+        }
+        else if (a[0] > a[4] && a[0] > a[8])
+        {
+            T s = std::sqrt(T{ 1 } + a[0] - a[4] - a[8]) * T{ 2 };
+            q = QuaternionN((a[7] - a[5]) / s, s / T{ 4 }, (a[1] + a[3]) / s, (a[2] + a[6]) / s);
+        }
+        else if (a[4] > a[8])
+        {
+            T s = std::sqrt(T{ 1 } + a[4] - a[0] - a[8]) * T{ 2 };
+            q = QuaternionN((a[2] - a[6]) / s, (a[1] + a[3]) / s, s / T{ 4 }, (a[5] + a[7]) / s);
+        }
+        else
+        {
+            T s = std::sqrt(T{ 1 } + a[8] - a[0] - a[4]) * T{ 2 };
+            q = QuaternionN((a[3] - a[1]) / s, (a[2] + a[6]) / s, (a[5] + a[7]) / s, s / T{ 4 });
+        }
+        q.normalize();
+        return q;
+    }
+
+    /**
+     * @brief Returns the scalar part.
+     */
+    T w() const { return m_coeffs.data()[3]; }
+
+    /**
+     * @brief Returns the first component of the vector part.
+     */
+    T x() const { return m_coeffs.data()[0]; }
+
+    /**
+     * @brief Returns the second component of the vector part.
+     */
+    T y() const { return m_coeffs.data()[1]; }
+
+    /**
+     * @brief Returns the third component of the vector part.
+     */
+    T z() const { return m_coeffs.data()[2]; }
+
+    /**
+     * @brief Returns the vector part (x, y, z).
+     *
+     * @return Vector part of the quaternion.
+     */
+    vector3_type vec() const
+    {
+        return vector3_type{ x(), y(), z() };
+    }
+
+    /**
+     * @brief Returns the coefficients stored as (x, y, z, w).
+     *
+     * @return Const reference to the coefficient vector.
+     */
+    const VectorND<T, 4>& coeffs() const
+    {
+        return m_coeffs;
+    }
+
+    /**
+     * @brief Computes the dot product of two quaternions.
+     *
+     * @param lhs Left-hand side quaternion.
+     * @param rhs Right-hand side quaternion.
+     * @return Dot product of the coefficients.
+     */
+    static T dot(const QuaternionN& lhs, const QuaternionN& rhs)
+    {
+        return VectorND<T, 4>::dot(lhs.m_coeffs, rhs.m_coeffs);
+    }
+
+    /**
+     * @brief Computes the norm of the quaternion.
+     *
+     * @return Euclidean norm of the four coefficients.
+     */
+    T norm() const
+    {
+        return m_coeffs.norm();
+    }
+
+    /**
+     * @brief Normalizes the quaternion.
+     *
+     * @throws std::runtime_error if the quaternion has zero length.
+     */
+    void normalize()
+    {
+        m_coeffs.normalize();
+    }
+
+    /**
+     * @brief Returns a normalized copy of the quaternion.
+     *
+     * @return Normalized copy.
+     * @throws std::runtime_error if the quaternion has zero length.
+     */
+    QuaternionN normalized() const
+    {
+        QuaternionN copy(*this);
+        copy.normalize();
+        return copy;
+    }
+
+    /**
+     * @brief Returns the conjugate (w, -x, -y, -z).
+     *
+     * @return Conjugate quaternion.
+     */
+    QuaternionN conjugate() const
+    {
+        return QuaternionN(w(), -x(), -y(), -z());
+    }
+
+    /**
+     * @brief Returns the multiplicative inverse.
+     *
+     * For unit quaternions this is equal to the conjugate.
+     *
+     * @return Inverse quaternion.
+     * @throws std::runtime_error if the quaternion has zero length.
+     */
+    QuaternionN inverse() const
+    {
+        T n2 = dot(*this, *this);
+        if (n2 == T{})
+            throw std::runtime_error("Cannot invert a zero-length quaternion");
+        return QuaternionN(w() / n2, -x() / n2, -y() / n2, -z() / n2);
+    }
+
+    /**
+     * @brief Composes two rotations (Hamilton product).
+     *
+     * The result applies rhs first, then lhs.
+     *
+     * @param rhs Right-hand side quaternion.
+     * @return Product this * rhs.
+     */
+    QuaternionN operator*(const QuaternionN& rhs) const
+    {
+        const T* a = m_coeffs.data();
+        const T* b = rhs.m_coeffs.data();
+        return QuaternionN(
+            a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2],
+            a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+            a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+            a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3]);
+    }
+
+    /**
+     * @brief Composes this rotation with another one in place.
+     *
+     * @param rhs Right-hand side quaternion.
+     * @return Reference to this quaternion.
+     */
+    QuaternionN& operator*=(const QuaternionN& rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Rotates a vector by this (unit) quaternion.
+     *
+     * @param v Vector to rotate.
+     * @return Rotated vector.
+     */
+    vector3_type rotate(const vector3_type& v) const
+    {
+        const T* q = m_coeffs.data();
+        const T* p = v.data();
+        T tx = T{ 2 } * (q[1] * p[2] - q[2] * p[1]);
+        T ty = T{ 2 } * (q[2] * p[0] - q[0] * p[2]);
+        T tz = T{ 2 } * (q[0] * p[1] - q[1] * p[0]);
+        return vector3_type{
+            p[0] + q[3] * tx + (q[1] * tz - q[2] * ty),
+            p[1] + q[3] * ty + (q[2] * tx - q[0] * tz),
+            p[2] + q[3] * tz + (q[0] * ty - q[1] * tx) };
+    }
+
+    /**
+     * @brief Converts this (unit) quaternion to a 3x3 rotation matrix.
+     *
+     * @return Row-major rotation matrix.
+     */
+    matrix3_type toMatrix() const
+    {
+        const T* q = m_coeffs.data();
+        T xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+        T xy = q[0] * q[1], xz = q[0] * q[2], yz = q[1] * q[2];
+        T wx = q[3] * q[0], wy = q[3] * q[1], wz = q[3] * q[2];
+
+        matrix3_type m;
+        T* a = m.data();
+        a[0] = T{ 1 } - T{ 2 } * (yy + zz);
+        a[1] = T{ 2 } * (xy - wz);
+        a[2] = T{ 2 } * (xz + wy);
+        a[3] = T{ 2 } * (xy + wz);
+        a[4] = T{ 1 } - T{ 2 } * (xx + zz);
+        a[5] = T{ 2 } * (yz - wx);
+        a[6] = T{ 2 } * (xz - wy);
+        a[7] = T{ 2 } * (yz + wx);
+        a[8] = T{ 1 } - T{ 2 } * (xx + yy);
+        return m;
+    }
+
+    /**
+     * @brief Spherical linear interpolation between two unit quaternions.
+     *
+     * Always follows the shortest arc, and falls back to a normalized linear
+     * interpolation when both rotations are almost identical.
+     *
+     * @param a Start rotation (t = 0).
+     * @param b End rotation (t = 1).
+     * @param t Interpolation parameter in [0, 1].
+     * @return Interpolated unit quaternion.
+     */
+    static QuaternionN slerp(const QuaternionN& a, const QuaternionN& b, T t)
+    {
+        const T* pa = a.m_coeffs.data();
+        const T* pb = b.m_coeffs.data();
+
+        T cosTheta = dot(a, b);
+        T sign = T{ 1 };
+        if (cosTheta < T{})
+        {
+            cosTheta = -cosTheta;
+            sign = T{ -1 };
+        }
+
+        T wa;
+        T wb;
+        if (cosTheta > T{ 1 } - T{ 1e-5 })
+        {
+            wa = T{ 1 } - t;
+            wb = t * sign;
+        }
+        else
+        {
+            T theta = std::acos(cosTheta);
+            T invSin = T{ 1 } / std::sin(theta);
+            wa = std::sin((T{ 1 } - t) * theta) * invSin;
+            wb = std::sin(t * theta) * invSin * sign;
+        }
+
+        QuaternionN result(
+            wa * pa[3] + wb * pb[3],
+            wa * pa[0] + wb * pb[0],
+            wa * pa[1] + wb * pb[1],
+            wa * pa[2] + wb * pb[2]);
+        result.normalize();
+        return result;
+    }
+
+    /**
+     * @brief Equality operator.
+     *
+     * @param other Quaternion to compare with.
+     * @return true if all coefficients are equal, false otherwise.
+     */
+    bool operator==(const QuaternionN& other) const
+    {
+        return m_coeffs == other.m_coeffs;
+    }
+
+    /**
+     * @brief Inequality operator.
+     *
+     * @param other Quaternion to compare with.
+     * @return true if any coefficient differs, false otherwise.
+     */
+    bool operator!=(const QuaternionN& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    VectorND<T, 4> m_coeffs; ///< Coefficients stored as (x, y, z, w).
+};
+
+/**
+ * @brief Stream insertion operator for QuaternionN.
+ *
+ * @tparam T Type of the coefficients.
+ * @param os Output stream.
+ * @param q Quaternion to insert into the stream.
+ * @return Reference to the output stream.
+ */
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const QuaternionN<T>& q)
+{
+    os << "(" << q.w() << "; " << q.x() << ", " << q.y() << ", " << q.z() << ")";
+    return os;
+}
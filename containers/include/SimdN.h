@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * @file SimdN.h
+ * @brief Compile-time detection of the SIMD instruction sets used by the kernels.
+ *
+ * CONTAINERS_HAS_AVX2 is defined when AVX2 and FMA code can be emitted
+ * (enable it with the CONTAINERS_ENABLE_AVX2 CMake option, or -mavx2 -mfma,
+ * or /arch:AVX2). CONTAINERS_HAS_SSE2 is defined on every x86-64 target.
+ * Define CONTAINERS_DISABLE_SIMD to force the portable code paths.
+ */
+
+#if !defined(CONTAINERS_DISABLE_SIMD)
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define CONTAINERS_HAS_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTAINERS_HAS_SSE2 1
+#endif
+
+#endif
+
+#if defined(CONTAINERS_HAS_AVX2) || defined(CONTAINERS_HAS_SSE2)
+#include <immintrin.h>
+#endif
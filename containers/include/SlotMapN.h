@@ -0,0 +1,322 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "VectorN.h"
+
+/**
+ * @class SlotMapN
+ * @brief Container with O(1) insert and erase, stable generational handles and dense storage.
+ *
+ * Elements are stored contiguously in a VectorN, so iteration runs at
+ * VectorN speed. erase() moves the last element into the hole instead of
+ * shifting, which keeps the storage dense but changes the order of the
+ * elements.
+ *
+ * Elements are addressed by handles (slot index + generation) that stay
+ * valid whatever is inserted or erased afterwards. Each slot records where
+ * its element sits in the dense storage. Erasing an element bumps the
+ * generation of its slot, so old handles to it are recognised as stale
+ * instead of reaching whatever element reuses the slot.
+ *
+ * Free slots form an intrusive list threaded through the slot table and are
+ * reused most recently freed first, which keeps the table small and hot. A
+ * slot whose generation would wrap around is retired instead of reused.
+ *
+ * @tparam T Element type; default constructible and move assignable.
+ */
+template<typename T>
+class SlotMapN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = typename VectorN<T>::iterator;
+    using const_iterator = typename VectorN<T>::const_iterator;
+
+    static constexpr std::uint32_t Invalid = std::numeric_limits<std::uint32_t>::max(); ///< Index of no slot.
+
+    /**
+     * @brief Stable name of an element.
+     */
+    struct Handle
+    {
+        std::uint32_t index = Invalid; ///< Slot index.
+        std::uint32_t generation = 0;  ///< Generation of the slot when the element was inserted.
+
+        friend bool operator==(const Handle&, const Handle&) = default;
+    };
+
+    /**
+     * @brief Constructs an empty slot map.
+     */
+    SlotMapN() : m_values(), m_owners(), m_slots(), m_freeHead(Invalid) {}
+
+    /**
+     * @brief Checks if the slot map is empty.
+     */
+    bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_type size() const
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief Reserves storage for capacity elements.
+     */
+    void reserve(size_type capacity)
+    {
+        m_values.reserve(capacity);
+        m_owners.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    /**
+     * @brief Inserts an element, in O(1).
+     *
+     * @return Handle naming the element.
+     * @throws std::length_error if every slot index is in use.
+     */
+    Handle insert(const T& value)
+    {
+        return emplace(value);
+    }
+
+    Handle insert(T&& value)
+    {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element from args and inserts it, in O(1).
+     *
+     * If constructing the element or taking its slot throws, the map is left unchanged.
+     *
+     * @return Handle naming the element.
+     * @throws std::length_error if every slot index is in use.
+     */
+    template<typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        const size_type size = m_values.size();
+        try
+        {
+            m_values.emplace_back(std::forward<Args>(args)...);
+            return acquireSlot();
+        }
+        catch (...)
+        {
+            if (m_values.size() != size)
+                m_values.pop_back();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Removes the element named by handle, in O(1).
+     *
+     * The last element moves into the freed position.
+     *
+     * @return Whether an element was removed (false for stale handles).
+     */
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+        Slot& slot = m_slots[handle.index];
+        const std::uint32_t position = slot.position;
+        const std::uint32_t last = std::uint32_t(m_values.size() - 1);
+        if (position != last)
+        {
+            m_values[position] = std::move(m_values[last]);
+            m_owners[position] = m_owners[last];
+            m_slots[m_owners[position]].position = position;
+        }
+        m_values.pop_back();
+        m_owners.pop_back();
+        releaseSlot(handle.index);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether handle names an element.
+     */
+    bool contains(Handle handle) const
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation
+            && m_slots[handle.index].position != Invalid;
+    }
+
+    /**
+     * @brief Returns a pointer to the element named by handle, nullptr for stale handles.
+     */
+    T* get(Handle handle)
+    {
+        return contains(handle) ? &m_values[m_slots[handle.index].position] : nullptr;
+    }
+
+    const T* get(Handle handle) const
+    {
+        return contains(handle) ? &m_values[m_slots[handle.index].position] : nullptr;
+    }
+
+    /**
+     * @brief Returns the element named by handle.
+     *
+     * @throws std::out_of_range if the handle is stale.
+     */
+    T& at(Handle handle)
+    {
+        if (!contains(handle))
+            throw std::out_of_range("SlotMapN::at: stale handle");
+        return m_values[m_slots[handle.index].position];
+    }
+
+    const T& at(Handle handle) const
+    {
+        if (!contains(handle))
+            throw std::out_of_range("SlotMapN::at: stale handle");
+        return m_values[m_slots[handle.index].position];
+    }
+
+    /**
+     * @brief Returns the element named by handle, without checking it.
+     */
+    T& operator[](Handle handle)
+    {
+        return m_values[m_slots[handle.index].position];
+    }
+
+    const T& operator[](Handle handle) const
+    {
+        return m_values[m_slots[handle.index].position];
+    }
+
+    /**
+     * @brief Handle of the element at a position of the dense storage.
+     */
+    Handle handle_at(size_type position) const
+    {
+        const std::uint32_t index = m_owners[position];
+        return Handle{ index, m_slots[index].generation };
+    }
+
+    /**
+     * @brief Removes every element. Every handle becomes stale.
+     */
+    void clear()
+    {
+        for (size_type position = m_owners.size(); position-- > 0;)
+            releaseSlot(m_owners[position]);
+        m_values.clear();
+        m_owners.clear();
+    }
+
+    /**
+     * @brief Iterators over the live elements, in storage order.
+     */
+    iterator begin()
+    {
+        return m_values.begin();
+    }
+
+    const_iterator begin() const
+    {
+        return m_values.begin();
+    }
+
+    iterator end()
+    {
+        return m_values.end();
+    }
+
+    const_iterator end() const
+    {
+        return m_values.end();
+    }
+
+    /**
+     * @brief Contiguous storage of the live elements.
+     */
+    T* data()
+    {
+        return m_values.data();
+    }
+
+    const T* data() const
+    {
+        return m_values.data();
+    }
+
+private:
+    /**
+     * @brief Entry of the slot table.
+     */
+    struct Slot
+    {
+        std::uint32_t position;   ///< Position of the element in the dense storage, Invalid when free.
+        std::uint32_t generation; ///< Bumped each time the slot is freed.
+        std::uint32_t nextFree;   ///< Next free slot while this one is free.
+    };
+
+    /**
+     * @brief Takes a slot for the element just appended to the dense storage.
+     *
+     * Changes nothing if it throws.
+     */
+    Handle acquireSlot()
+    {
+        const std::uint32_t position = std::uint32_t(m_values.size() - 1);
+        std::uint32_t index = m_freeHead;
+        const bool fresh = index == Invalid;
+        if (fresh)
+        {
+            if (m_slots.size() >= Invalid)
+                throw std::length_error("SlotMapN: too many slots");
+            index = std::uint32_t(m_slots.size());
+            m_slots.push_back(Slot{ Invalid, 0, Invalid });
+        }
+        try
+        {
+            m_owners.push_back(index);
+        }
+        catch (...)
+        {
+            if (fresh)
+                m_slots.pop_back();
+            throw;
+        }
+        if (!fresh)
+            m_freeHead = m_slots[index].nextFree;
+        m_slots[index].position = position;
+        return Handle{ index, m_slots[index].generation };
+    }
+
+    /**
+     * @brief Frees a slot: bumps its generation and pushes it on the free list, or retires it.
+     */
+    void releaseSlot(std::uint32_t index)
+    {
+        Slot& slot = m_slots[index];
+        slot.position = Invalid;
+        if (slot.generation == std::numeric_limits<std::uint32_t>::max())
+            return;
+        ++slot.generation;
+        slot.nextFree = m_freeHead;
+        m_freeHead = index;
+    }
+
+    VectorN<T> m_values;              ///< Live elements, dense.
+    VectorN<std::uint32_t> m_owners;  ///< Slot index of each element of m_values.
+    VectorN<Slot> m_slots;            ///< Slot table, indexed by Handle::index.
+    std::uint32_t m_freeHead;         ///< First free slot, Invalid when none.
+};
@@ -0,0 +1,665 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "IntrusiveListN.h"
+#include "ListN.h"
+#include "ParallelAlgorithmsN.h"
+#include "ThreadPoolN.h"
+
+/**
+ * @class SortN
+ * @brief Sorting algorithms for VectorN, ArrayN, MatrixND storage and the list types.
+ *
+ * - radix_sort(): stable LSD radix sort on integer and floating-point keys,
+ *   either the elements themselves or a key extracted from each record. Passes
+ *   over bytes on which every key agrees are skipped. On a pool with several
+ *   workers, large inputs are first split by their most significant varying
+ *   byte (one MSD pass), and the buckets are then sorted independently.
+ * - pdqsort() / sort(): pattern-defeating quicksort (Peters, 2021): linear
+ *   time on sorted, reversed and equal runs, O(n log n) worst case through a
+ *   heap sort fallback, not stable. sort() runs the partitions in parallel.
+ * - sort(ListN&) / sort(IntrusiveList&): merge sort relinking the nodes.
+ *
+ * Contiguous containers are accessed through ParallelAlgorithmsN::storage().
+ */
+class SortN
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type ParallelRadixMin = size_type(1) << 16; ///< Smallest input split across the pool by radix_sort().
+    static constexpr size_type ParallelSortMin = size_type(1) << 15;  ///< Smallest input partitioned in parallel by sort().
+    static constexpr size_type SmallRadixSort = 64;                   ///< Inputs below this are insertion sorted on the key.
+
+    /**
+     * @brief Key types accepted by radix_sort(): integers and 32 or 64-bit floating point.
+     */
+    template<typename K>
+    static constexpr bool isRadixKey = (std::is_integral_v<K> && !std::is_same_v<K, bool>)
+        || (std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+    /**
+     * @brief Sorts numbers in ascending order with a stable radix sort.
+     *
+     * Floating-point values follow the IEEE total order: -0.0 before +0.0,
+     * negative NaNs first and positive NaNs last.
+     *
+     * @param container Integers or floating-point values.
+     * @param pool Pool used for large inputs.
+     */
+    template<typename C>
+    static void radix_sort(C& container, ThreadPoolN& pool = ThreadPoolN::global())
+    {
+        auto data = ParallelAlgorithmsN::storage(container);
+        using T = std::remove_cvref_t<decltype(data[0])>;
+        static_assert(isRadixKey<T>, "SortN::radix_sort: element type is not an integer or float/double");
+        radixSort(data.data(), data.size(), std::identity(), pool);
+    }
+
+    /**
+     * @brief Sorts records in ascending order of an extracted key with a stable radix sort.
+     *
+     * Records are moved between the container and a buffer of the same size,
+     * which is default constructed, or copied from the input when the record
+     * type has no default constructor.
+     *
+     * @param container The records.
+     * @param key Callable returning the integer or floating-point key of a record; called once per record per pass.
+     * @param pool Pool used for large inputs.
+     */
+    template<typename C, typename KeyFn>
+        requires (!std::derived_from<KeyFn, ThreadPoolN>)
+    static void radix_sort(C& container, KeyFn key, ThreadPoolN& pool = ThreadPoolN::global())
+    {
+        auto data = ParallelAlgorithmsN::storage(container);
+        using T = std::remove_cvref_t<decltype(data[0])>;
+        static_assert(isRadixKey<std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>>,
+            "SortN::radix_sort: key is not an integer or float/double");
+        radixSort(data.data(), data.size(), key, pool);
+    }
+
+    /**
+     * @brief Sorts [first, last) with pattern-defeating quicksort, on the calling thread.
+     *
+     * @param first Start of the range.
+     * @param last End of the range.
+     * @param comp Strict weak ordering.
+     */
+    template<std::random_access_iterator It, typename Compare = std::less<>>
+    static void pdqsort(It first, It last, Compare comp = Compare())
+    {
+        if (last - first < 2)
+            return;
+        pdqLoop(first, last, comp, badPartitionLimit(size_type(last - first)), true, nullptr, 0);
+    }
+
+    /**
+     * @brief Sorts a contiguous container with pattern-defeating quicksort, on the calling thread.
+     */
+    template<typename C, typename Compare = std::less<>>
+        requires (!std::random_access_iterator<C>)
+    static void pdqsort(C& container, Compare comp = Compare())
+    {
+        auto data = ParallelAlgorithmsN::storage(container);
+        pdqsort(data.begin(), data.end(), comp);
+    }
+
+    /**
+     * @brief Sorts a contiguous container with a parallel pattern-defeating quicksort.
+     *
+     * The two sides of every partition larger than a cutoff are sorted as
+     * separate tasks; the cutoff gives each worker a few tasks to steal. With a
+     * single worker, or below ParallelSortMin elements, this is pdqsort().
+     * Not stable.
+     *
+     * @param container The elements to sort.
+     * @param comp Strict weak ordering, called concurrently.
+     * @param pool Pool running the partitions.
+     */
+    template<typename C, typename Compare = std::less<>>
+    static void sort(C& container, Compare comp = Compare(), ThreadPoolN& pool = ThreadPoolN::global())
+    {
+        auto data = ParallelAlgorithmsN::storage(container);
+        const size_type n = data.size();
+        if (n < 2)
+            return;
+        if (pool.threadCount() <= 1 || n < ParallelSortMin)
+        {
+            pdqsort(data.begin(), data.end(), comp);
+            return;
+        }
+
+        const Compare& shared = comp;
+        const size_type cutoff = std::max(ParallelSortMin / 4, n / (pool.threadCount() * ThreadPoolN::ChunksPerThread));
+        ThreadPoolN::TaskGroup group(pool);
+        pdqLoop(data.data(), data.data() + n, shared, badPartitionLimit(n), true, &group, cutoff);
+        group.wait();
+    }
+
+    /**
+     * @brief Sorts a ListN by relinking its nodes (stable, see ListN::sort()).
+     */
+    template<typename T, typename Allocator, typename Compare = std::less<>>
+    static void sort(ListN<T, Allocator>& list, Compare comp = Compare())
+    {
+        list.sort(comp);
+    }
+
+    /**
+     * @brief Sorts an IntrusiveList by relinking its hooks (stable, see IntrusiveList::sort()).
+     */
+    template<typename T, IntrusiveListHook T::* HookPtr, typename Compare = std::less<>>
+    static void sort(IntrusiveList<T, HookPtr>& list, Compare comp = Compare())
+    {
+        list.sort(comp);
+    }
+
+    /**
+     * @brief Maps a key to an unsigned integer with the same order.
+     *
+     * Signed integers have their sign bit flipped; floating-point values have
+     * every bit flipped when negative and the sign bit flipped otherwise.
+     */
+    template<typename K>
+    static auto radixKey(K key)
+    {
+        if constexpr (std::is_floating_point_v<K>)
+        {
+            using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+            constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+            const U bits = std::bit_cast<U>(key);
+            return (bits & sign) ? U(~bits) : U(bits | sign);
+        }
+        else
+        {
+            using U = std::make_unsigned_t<K>;
+            if constexpr (std::is_signed_v<K>)
+                return U(U(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+            else
+                return U(key);
+        }
+    }
+
+private:
+    static constexpr std::ptrdiff_t InsertionSortThreshold = 24;   ///< Ranges below this are insertion sorted.
+    static constexpr std::ptrdiff_t NintherThreshold = 128;        ///< Ranges above this pick the pivot as a median of medians.
+    static constexpr size_type PartialInsertionSortLimit = 8;      ///< Element moves tolerated when finishing a nearly sorted range.
+
+    /**
+     * @brief Number of highly unbalanced partitions tolerated before falling back to heap sort: log2(n).
+     */
+    static int badPartitionLimit(size_type n)
+    {
+        return int(std::bit_width(n));
+    }
+
+    /**
+     * @brief Radix key of a record as an unsigned integer.
+     */
+    template<typename T, typename KeyFn>
+    using RadixKeyT = decltype(radixKey(std::declval<KeyFn&>()(std::declval<const T&>())));
+
+    /**
+     * @brief Scratch buffer for n records: default constructed, or a copy of data.
+     */
+    template<typename T>
+    static std::vector<T> scratchFor(T* data, size_type n)
+    {
+        if constexpr (std::is_default_constructible_v<T>)
+            return std::vector<T>(n);
+        else
+            return std::vector<T>(data, data + n);
+    }
+
+    /**
+     * @brief Dispatches to the sequential or the parallel radix sort.
+     */
+    template<typename T, typename KeyFn>
+    static void radixSort(T* data, size_type n, const KeyFn& key, ThreadPoolN& pool)
+    {
+        using U = RadixKeyT<T, KeyFn>;
+        if (n < SmallRadixSort)
+        {
+            insertionSortByKey(data, n, key);
+        }
+        else if (pool.threadCount() <= 1 || n < ParallelRadixMin)
+        {
+            std::vector<T> scratch = scratchFor(data, n);
+            lsdSort(data, scratch.data(), n, key, sizeof(U));
+        }
+        else
+        {
+            parallelRadixSort(data, n, key, pool);
+        }
+    }
+
+    /**
+     * @brief Stable insertion sort on the radix key, for small inputs and buckets.
+     */
+    template<typename T, typename KeyFn>
+    static void insertionSortByKey(T* data, size_type n, const KeyFn& key)
+    {
+        for (size_type i = 1; i < n; ++i)
+        {
+            const auto current = radixKey(key(data[i]));
+            if (!(current < radixKey(key(data[i - 1]))))
+                continue;
+            T moving = std::move(data[i]);
+            size_type j = i;
+            do
+            {
+                data[j] = std::move(data[j - 1]);
+                --j;
+            } while (j > 0 && current < radixKey(key(data[j - 1])));
+            data[j] = std::move(moving);
+        }
+    }
+
+    /**
+     * @brief LSD radix sort on the low bytes of the key, leaving the result in data.
+     *
+     * One pass builds the histograms of every byte; each byte on which the
+     * keys differ then costs one stable scatter between data and scratch.
+     *
+     * @param data Records to sort.
+     * @param scratch n valid records used as the second buffer.
+     * @param n Number of records.
+     * @param key Key extractor.
+     * @param bytes Number of low key bytes to sort on.
+     */
+    template<typename T, typename KeyFn>
+    static void lsdSort(T* data, T* scratch, size_type n, const KeyFn& key, size_type bytes)
+    {
+        if (n < SmallRadixSort)
+        {
+            insertionSortByKey(data, n, key);
+            return;
+        }
+
+        std::vector<size_type> counts(bytes * 256, 0);
+        for (size_type i = 0; i < n; ++i)
+        {
+            auto k = radixKey(key(data[i]));
+            for (size_type b = 0; b < bytes; ++b)
+                ++counts[b * 256 + ((k >> (8 * b)) & 0xFF)];
+        }
+
+        T* src = data;
+        T* dst = scratch;
+        const auto firstKey = radixKey(key(data[0]));
+        for (size_type b = 0; b < bytes; ++b)
+        {
+            size_type* count = &counts[b * 256];
+            if (count[(firstKey >> (8 * b)) & 0xFF] == n)
+                continue;
+
+            size_type offset = 0;
+            for (size_type digit = 0; digit < 256; ++digit)
+                offset += std::exchange(count[digit], offset);
+            for (size_type i = 0; i < n; ++i)
+                dst[count[(radixKey(key(src[i])) >> (8 * b)) & 0xFF]++] = std::move(src[i]);
+            std::swap(src, dst);
+        }
+        if (src != data)
+            std::move(src, src + n, data);
+    }
+
+    /**
+     * @brief One parallel MSD pass on the highest varying byte, then an LSD sort of every bucket.
+     */
+    template<typename T, typename KeyFn>
+    static void parallelRadixSort(T* data, size_type n, const KeyFn& key, ThreadPoolN& pool)
+    {
+        using U = RadixKeyT<T, KeyFn>;
+        const size_type chunks = pool.threadCount() * ThreadPoolN::ChunksPerThread;
+        const size_type chunkSize = (n + chunks - 1) / chunks;
+
+        // Bits on which some key differs from the first one.
+        const U firstKey = radixKey(key(data[0]));
+        std::vector<U> chunkDiff(chunks, 0);
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                U diff = 0;
+                for (size_type i = c * chunkSize; i < std::min(n, (c + 1) * chunkSize); ++i)
+                    diff |= U(radixKey(key(data[i])) ^ firstKey);
+                chunkDiff[c] = diff;
+            }
+        });
+        U diff = 0;
+        for (U d : chunkDiff)
+            diff |= d;
+        if (diff == 0)
+            return;
+        const size_type top = (size_type(std::bit_width(diff)) - 1) / 8;
+        const auto digitOf = [&](const T& record) { return size_type((radixKey(key(record)) >> (8 * top)) & 0xFF); };
+
+        std::vector<size_type> offsets(chunks * 256, 0);
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                for (size_type i = c * chunkSize; i < std::min(n, (c + 1) * chunkSize); ++i)
+                    ++offsets[c * 256 + digitOf(data[i])];
+            }
+        });
+
+        // Bucket-major prefix sum: chunk c writes bucket d after the earlier chunks, which keeps the pass stable.
+        std::vector<size_type> bucketStart(257, 0);
+        size_type running = 0;
+        for (size_type digit = 0; digit < 256; ++digit)
+        {
+            bucketStart[digit] = running;
+            for (size_type c = 0; c < chunks; ++c)
+                running += std::exchange(offsets[c * 256 + digit], running);
+        }
+        bucketStart[256] = n;
+
+        std::vector<T> scratch = scratchFor(data, n);
+        pool.parallel_for(0, chunks, 1, [&](size_type firstChunk, size_type lastChunk)
+        {
+            for (size_type c = firstChunk; c < lastChunk; ++c)
+            {
+                size_type* offset = &offsets[c * 256];
+                for (size_type i = c * chunkSize; i < std::min(n, (c + 1) * chunkSize); ++i)
+                    scratch[offset[digitOf(data[i])]++] = std::move(data[i]);
+            }
+        });
+
+        pool.parallel_for(0, 256, 1, [&](size_type firstDigit, size_type lastDigit)
+        {
+            for (size_type digit = firstDigit; digit < lastDigit; ++digit)
+            {
+                const size_type begin = bucketStart[digit];
+                const size_type count = bucketStart[digit + 1] - begin;
+                lsdSort(scratch.data() + begin, data + begin, count, key, top);
+                std::move(scratch.data() + begin, scratch.data() + begin + count, data + begin);
+            }
+        });
+    }
+
+    /**
+     * @brief Insertion sort of [first, last).
+     *
+     * @param unguarded When true, *(first - 1) is known not to be greater than any element, so the bound check is skipped.
+     */
+    template<typename It, typename Compare>
+    static void insertionSort(It first, It last, Compare& comp, bool unguarded)
+    {
+        if (first == last)
+            return;
+        for (It current = first + 1; current != last; ++current)
+        {
+            It sift = current;
+            It previous = current - 1;
+            if (!comp(*sift, *previous))
+                continue;
+            auto moving = std::move(*sift);
+            do
+            {
+                *sift-- = std::move(*previous);
+            } while ((unguarded || sift != first) && comp(moving, *--previous));
+            *sift = std::move(moving);
+        }
+    }
+
+    /**
+     * @brief Insertion sort that gives up after PartialInsertionSortLimit element moves.
+     *
+     * @return true if [first, last) is now sorted.
+     */
+    template<typename It, typename Compare>
+    static bool partialInsertionSort(It first, It last, Compare& comp)
+    {
+        if (first == last)
+            return true;
+        size_type moves = 0;
+        for (It current = first + 1; current != last; ++current)
+        {
+            It sift = current;
+            It previous = current - 1;
+            if (comp(*sift, *previous))
+            {
+                auto moving = std::move(*sift);
+                do
+                {
+                    *sift-- = std::move(*previous);
+                } while (sift != first && comp(moving, *--previous));
+                *sift = std::move(moving);
+                moves += size_type(current - sift);
+            }
+            if (moves > PartialInsertionSortLimit)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Orders *a and *b.
+     */
+    template<typename It, typename Compare>
+    static void sort2(It a, It b, Compare& comp)
+    {
+        if (comp(*b, *a))
+            std::iter_swap(a, b);
+    }
+
+    /**
+     * @brief Orders *a, *b and *c.
+     */
+    template<typename It, typename Compare>
+    static void sort3(It a, It b, It c, Compare& comp)
+    {
+        sort2(a, b, comp);
+        sort2(b, c, comp);
+        sort2(a, b, comp);
+    }
+
+    /**
+     * @brief Partitions around the pivot *first: smaller elements to its left, the others to its right.
+     *
+     * Requires a median-of-three pivot, so that the scans are bounded.
+     *
+     * @return The final pivot position, and whether the range was already partitioned.
+     */
+    template<typename It, typename Compare>
+    static std::pair<It, bool> partitionRight(It first, It last, Compare& comp)
+    {
+        auto pivot = std::move(*first);
+        It left = first;
+        It right = last;
+
+        while (comp(*++left, pivot))
+        {
+        }
+        if (left - 1 == first)
+        {
+            while (left < right && !comp(*--right, pivot))
+            {
+            }
+        }
+        else
+        {
+            while (!comp(*--right, pivot))
+            {
+            }
+        }
+
+        const bool alreadyPartitioned = left >= right;
+        while (left < right)
+        {
+            std::iter_swap(left, right);
+            while (comp(*++left, pivot))
+            {
+            }
+            while (!comp(*--right, pivot))
+            {
+            }
+        }
+
+        It pivotPos = left - 1;
+        *first = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return { pivotPos, alreadyPartitioned };
+    }
+
+    /**
+     * @brief Partitions around the pivot *first, putting elements equal to it on its left.
+     *
+     * Used when the pivot equals the element before the range: the left side
+     * then holds only copies of the pivot and needs no more sorting.
+     *
+     * @return The final pivot position.
+     */
+    template<typename It, typename Compare>
+    static It partitionLeft(It first, It last, Compare& comp)
+    {
+        auto pivot = std::move(*first);
+        It left = first;
+        It right = last;
+
+        while (comp(pivot, *--right))
+        {
+        }
+        if (right + 1 == last)
+        {
+            while (left < right && !comp(pivot, *++left))
+            {
+            }
+        }
+        else
+        {
+            while (!comp(pivot, *++left))
+            {
+            }
+        }
+
+        while (left < right)
+        {
+            std::iter_swap(left, right);
+            while (comp(pivot, *--right))
+            {
+            }
+            while (!comp(pivot, *++left))
+            {
+            }
+        }
+
+        It pivotPos = right;
+        *first = std::move(*pivotPos);
+        *pivotPos = std::move(pivot);
+        return pivotPos;
+    }
+
+    /**
+     * @brief Main pdqsort loop: recurses on the left side, iterates on the right side.
+     *
+     * @param leftmost Whether the range starts the whole input; otherwise *(first - 1) bounds it from below.
+     * @param group When not null, left sides of at least cutoff elements run as tasks of the group.
+     */
+    template<typename It, typename Compare>
+    static void pdqLoop(It first, It last, Compare& comp, int badAllowed, bool leftmost, ThreadPoolN::TaskGroup* group,
+        size_type cutoff)
+    {
+        using Diff = typename std::iterator_traits<It>::difference_type;
+        while (true)
+        {
+            const Diff size = last - first;
+            if (size < InsertionSortThreshold)
+            {
+                insertionSort(first, last, comp, !leftmost);
+                return;
+            }
+
+            // Median of three, or pseudo-median of nine, moved to *first.
+            const Diff half = size / 2;
+            if (size > NintherThreshold)
+            {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                std::iter_swap(first, first + half);
+            }
+            else
+            {
+                sort3(first + half, first, last - 1, comp);
+            }
+
+            // A pivot equal to the element before the range: every copy of it goes left, and is done.
+            if (!leftmost && !comp(*(first - 1), *first))
+            {
+                first = partitionLeft(first, last, comp) + 1;
+                continue;
+            }
+
+            const auto [pivotPos, alreadyPartitioned] = partitionRight(first, last, comp);
+            const Diff leftSize = pivotPos - first;
+            const Diff rightSize = last - (pivotPos + 1);
+
+            if (leftSize < size / 8 || rightSize < size / 8)
+            {
+                if (--badAllowed == 0)
+                {
+                    std::make_heap(first, last, comp);
+                    std::sort_heap(first, last, comp);
+                    return;
+                }
+
+                // Break the pattern that produced the bad pivot.
+                if (leftSize >= InsertionSortThreshold)
+                {
+                    std::iter_swap(first, first + leftSize / 4);
+                    std::iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+                    if (leftSize > NintherThreshold)
+                    {
+                        std::iter_swap(first + 1, first + (leftSize / 4 + 1));
+                        std::iter_swap(first + 2, first + (leftSize / 4 + 2));
+                        std::iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+                        std::iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+                    }
+                }
+                if (rightSize >= InsertionSortThreshold)
+                {
+                    std::iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+                    std::iter_swap(last - 1, last - rightSize / 4);
+                    if (rightSize > NintherThreshold)
+                    {
+                        std::iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+                        std::iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+                        std::iter_swap(last - 2, last - (1 + rightSize / 4));
+                        std::iter_swap(last - 3, last - (2 + rightSize / 4));
+                    }
+                }
+            }
+            else if (alreadyPartitioned && partialInsertionSort(first, pivotPos, comp)
+                && partialInsertionSort(pivotPos + 1, last, comp))
+            {
+                return;
+            }
+
+            if (group && size_type(leftSize) >= cutoff)
+            {
+                group->run([first, pivotPos, &comp, badAllowed, leftmost, group, cutoff]()
+                {
+                    pdqLoop(first, pivotPos, comp, badAllowed, leftmost, group, cutoff);
+                });
+            }
+            else
+            {
+                pdqLoop(first, pivotPos, comp, badAllowed, leftmost, group, cutoff);
+            }
+            first = pivotPos + 1;
+            leftmost = false;
+        }
+    }
+};
@@ -0,0 +1,562 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "MatrixDyn.h"
+#include "MatrixN.h"
+#include "SimdN.h"
+#include "ThreadPoolN.h"
+#include "VectorN.h"
+
+/**
+ * @brief Compression order of a SparseMatrixN.
+ */
+enum class SparseFormat
+{
+    CSR, ///< Compressed sparse rows: the non-zeros of a row are contiguous.
+    CSC  ///< Compressed sparse columns: the non-zeros of a column are contiguous.
+};
+
+/**
+ * @struct TripletN
+ * @brief One (row, col, value) entry of a matrix in coordinate (COO) form.
+ *
+ * @tparam T The type of the value.
+ */
+template<typename T>
+struct TripletN {
+    std::size_t row; ///< Row of the entry.
+    std::size_t col; ///< Column of the entry.
+    T value;         ///< Value of the entry.
+};
+
+/**
+ * @class SparseMatrixN
+ * @brief A matrix storing only its non-zero coefficients, in CSR or CSC form.
+ *
+ * The matrix is split in "outer" lines (rows for CSR, columns for CSC). The
+ * inner indices and values of outer line o are stored, sorted by inner index,
+ * in [offsets()[o], offsets()[o + 1]). Indices are 32-bit, which bounds both
+ * dimensions to 2^31 - 1 and keeps the index arrays half the size of size_t ones.
+ *
+ * The product whose rows follow the storage (A * x for CSR, A^T * x for CSC)
+ * gathers from x and runs in parallel on a ThreadPoolN; with AVX2 the float and
+ * double gathers use hardware gather instructions. The other product scatters
+ * into y and runs sequentially: convert with toFormat() when it is the hot one.
+ *
+ * @tparam T The arithmetic element type.
+ * @tparam Format The compression order.
+ */
+template<typename T, SparseFormat Format = SparseFormat::CSR>
+class SparseMatrixN {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+
+    static constexpr size_type MaxDimension = static_cast<size_type>(std::numeric_limits<std::int32_t>::max()); ///< Largest number of rows or columns.
+
+    /**
+     * @brief Constructs an empty 0 x 0 matrix.
+     */
+    SparseMatrixN()
+        : SparseMatrixN(0, 0) {
+    }
+
+    /**
+     * @brief Constructs a rows x cols matrix with no non-zero coefficient.
+     *
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @throws std::runtime_error if a dimension exceeds MaxDimension.
+     */
+    SparseMatrixN(size_type rows, size_type cols)
+        : m_rows(rows), m_cols(cols) {
+        checkDimensions(rows, cols);
+        m_offsets.resize(outerSize() + 1, 0);
+    }
+
+    /**
+     * @brief Constructs a matrix from coordinate triplets.
+     *
+     * The triplets may come in any order; entries sharing a position are summed.
+     *
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param triplets The entries of the matrix.
+     * @throws std::runtime_error if a dimension exceeds MaxDimension.
+     * @throws std::out_of_range if a triplet lies outside the matrix.
+     */
+    SparseMatrixN(size_type rows, size_type cols, const VectorN<TripletN<T>>& triplets)
+        : SparseMatrixN(rows, cols) {
+        const size_type count = triplets.size();
+        if (count > std::numeric_limits<index_type>::max())
+            throw std::runtime_error("SparseMatrixN: too many triplets for 32-bit offsets");
+        for (size_type k = 0; k < count; ++k) {
+            if (triplets[k].row >= m_rows || triplets[k].col >= m_cols)
+                throw std::out_of_range("Index hors limites dans SparseMatrixN");
+        }
+
+        // Bucket the triplets by outer line (counting sort), then sort every line by inner index.
+        VectorN<size_type> cursor(outerSize() + 1, 0);
+        for (size_type k = 0; k < count; ++k)
+            ++cursor[outerOf(triplets[k]) + 1];
+        for (size_type o = 0; o < outerSize(); ++o)
+            cursor[o + 1] += cursor[o];
+        VectorN<size_type> order(count, 0);
+        for (size_type k = 0; k < count; ++k)
+            order[cursor[outerOf(triplets[k])]++] = k;
+
+        m_indices.reserve(count);
+        m_values.reserve(count);
+        size_type first = 0;
+        for (size_type o = 0; o < outerSize(); ++o) {
+            const size_type last = cursor[o];
+            std::stable_sort(order.data() + first, order.data() + last, [&](size_type a, size_type b) {
+                return innerOf(triplets[a]) < innerOf(triplets[b]);
+            });
+            for (size_type k = first; k < last; ++k) {
+                const TripletN<T>& t = triplets[order[k]];
+                const index_type inner = static_cast<index_type>(innerOf(t));
+                if (m_indices.size() > m_offsets[o] && m_indices.back() == inner)
+                    m_values.back() += t.value;
+                else {
+                    m_indices.push_back(inner);
+                    m_values.push_back(t.value);
+                }
+            }
+            m_offsets[o + 1] = static_cast<index_type>(m_indices.size());
+            first = last;
+        }
+    }
+
+    /**
+     * @brief Constructs a sparse copy of a dense matrix, dropping its zero coefficients.
+     *
+     * @param dense The matrix to compress.
+     */
+    template<size_type Rows, size_type Cols>
+    explicit SparseMatrixN(const MatrixND<T, Rows, Cols>& dense)
+        : SparseMatrixN(Rows, Cols) {
+        compress([&](size_type row, size_type col) { return dense.coeff(row, col); });
+    }
+
+    /**
+     * @brief Constructs a sparse copy of a runtime-sized matrix, dropping its zero coefficients.
+     *
+     * @param dense The matrix to compress.
+     */
+    template<MatrixLayout Layout>
+    explicit SparseMatrixN(const MatrixDyn<T, Layout>& dense)
+        : SparseMatrixN(dense.rowCount(), dense.colCount()) {
+        compress([&](size_type row, size_type col) { return dense(row, col); });
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    size_type rowCount() const {
+        return m_rows;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    size_type colCount() const {
+        return m_cols;
+    }
+
+    /**
+     * @brief Returns the number of stored coefficients.
+     */
+    size_type nonZeros() const {
+        return m_values.size();
+    }
+
+    /**
+     * @brief Returns the number of bytes used by the offsets, indices and values.
+     */
+    size_type memoryBytes() const {
+        return (m_offsets.size() + m_indices.size()) * sizeof(index_type) + m_values.size() * sizeof(T);
+    }
+
+    /**
+     * @brief Returns the coefficient at (row, col), zero when it is not stored.
+     *
+     * Runs a binary search in the outer line of the coefficient.
+     *
+     * @param row The row index.
+     * @param col The column index.
+     * @throws std::out_of_range if the position lies outside the matrix.
+     */
+    T coeff(size_type row, size_type col) const {
+        if (row >= m_rows || col >= m_cols)
+            throw std::out_of_range("Index hors limites dans SparseMatrixN::coeff");
+        const size_type outer = Format == SparseFormat::CSR ? row : col;
+        const index_type inner = static_cast<index_type>(Format == SparseFormat::CSR ? col : row);
+        const index_type* first = m_indices.data() + m_offsets[outer];
+        const index_type* last = m_indices.data() + m_offsets[outer + 1];
+        const index_type* it = std::lower_bound(first, last, inner);
+        return it != last && *it == inner ? m_values[static_cast<size_type>(it - m_indices.data())] : T{};
+    }
+
+    /**
+     * @brief Returns the start of every outer line, followed by nonZeros().
+     */
+    const VectorN<index_type>& offsets() const {
+        return m_offsets;
+    }
+
+    /**
+     * @brief Returns the inner index of every stored coefficient.
+     */
+    const VectorN<index_type>& indices() const {
+        return m_indices;
+    }
+
+    /**
+     * @brief Returns the value of every stored coefficient.
+     */
+    const VectorN<T>& values() const {
+        return m_values;
+    }
+
+    /**
+     * @brief Computes y = A * x.
+     *
+     * @param x Input vector of colCount() elements.
+     * @param y Output vector of rowCount() elements, overwritten; must not overlap x.
+     * @param pool The pool running the CSR kernel.
+     */
+    void multiply(const T* x, T* y, ThreadPoolN& pool = ThreadPoolN::global()) const {
+        if constexpr (Format == SparseFormat::CSR)
+            gatherProduct(x, y, pool);
+        else
+            scatterProduct(x, y);
+    }
+
+    /**
+     * @brief Returns A * x.
+     *
+     * @param x Input vector of colCount() elements.
+     * @param pool The pool running the CSR kernel.
+     * @throws std::runtime_error if x has the wrong size.
+     */
+    VectorN<T> multiply(const VectorN<T>& x, ThreadPoolN& pool = ThreadPoolN::global()) const {
+        if (x.size() != m_cols)
+            throw std::runtime_error("SparseMatrixN::multiply: vector size does not match the matrix");
+        VectorN<T> y(m_rows, T{});
+        multiply(x.data(), y.data(), pool);
+        return y;
+    }
+
+    /**
+     * @brief Computes y = A^T * x.
+     *
+     * @param x Input vector of rowCount() elements.
+     * @param y Output vector of colCount() elements, overwritten; must not overlap x.
+     * @param pool The pool running the CSC kernel.
+     */
+    void multiplyTransposed(const T* x, T* y, ThreadPoolN& pool = ThreadPoolN::global()) const {
+        if constexpr (Format == SparseFormat::CSC)
+            gatherProduct(x, y, pool);
+        else
+            scatterProduct(x, y);
+    }
+
+    /**
+     * @brief Returns A^T * x.
+     *
+     * @param x Input vector of rowCount() elements.
+     * @param pool The pool running the CSC kernel.
+     * @throws std::runtime_error if x has the wrong size.
+     */
+    VectorN<T> multiplyTransposed(const VectorN<T>& x, ThreadPoolN& pool = ThreadPoolN::global()) const {
+        if (x.size() != m_rows)
+            throw std::runtime_error("SparseMatrixN::multiplyTransposed: vector size does not match the matrix");
+        VectorN<T> y(m_cols, T{});
+        multiplyTransposed(x.data(), y.data(), pool);
+        return y;
+    }
+
+    /**
+     * @brief Returns the same matrix stored in another compression order.
+     */
+    template<SparseFormat Target>
+    SparseMatrixN<T, Target> toFormat() const {
+        if constexpr (Target == Format) {
+            return *this;
+        } else {
+            SparseMatrixN<T, Target> result(m_rows, m_cols);
+            transposeInto(result);
+            return result;
+        }
+    }
+
+    /**
+     * @brief Returns A^T in the same compression order.
+     *
+     * Costs one counting sort over the non-zeros.
+     */
+    SparseMatrixN transposed() const {
+        SparseMatrixN result(m_cols, m_rows);
+        transposeInto(result);
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a fixed-size dense matrix.
+     *
+     * @tparam Rows Must equal rowCount().
+     * @tparam Cols Must equal colCount().
+     * @throws std::runtime_error if the dimensions differ.
+     */
+    template<size_type Rows, size_type Cols>
+    MatrixND<T, Rows, Cols> toMatrixND() const {
+        if (Rows != m_rows || Cols != m_cols)
+            throw std::runtime_error("SparseMatrixN::toMatrixND: dimensions do not match");
+        MatrixND<T, Rows, Cols> result;
+        expand([&](size_type row, size_type col, const T& value) { result.coeffRef(row, col) = value; });
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a runtime-sized dense matrix.
+     *
+     * @tparam Layout Storage order of the result.
+     */
+    template<MatrixLayout Layout = MatrixLayout::RowMajor>
+    MatrixDyn<T, Layout> toMatrixDyn() const {
+        MatrixDyn<T, Layout> result(m_rows, m_cols, T{});
+        expand([&](size_type row, size_type col, const T& value) { result(row, col) = value; });
+        return result;
+    }
+
+private:
+    template<typename, SparseFormat>
+    friend class SparseMatrixN;
+
+    static constexpr size_type ParallelGrainNonZeros = 32768; ///< Approximate number of non-zeros per parallel chunk.
+    static constexpr size_type UnrollMinLength = 16;          ///< Shortest line summed with four accumulators.
+    static constexpr size_type GatherMinLength = 64;          ///< Shortest line summed with AVX2 gathers.
+
+    /**
+     * @brief Throws if a dimension does not fit the 32-bit indices.
+     */
+    static void checkDimensions(size_type rows, size_type cols) {
+        if (rows > MaxDimension || cols > MaxDimension)
+            throw std::runtime_error("SparseMatrixN: dimension too large for 32-bit indices");
+    }
+
+    /**
+     * @brief Returns the number of outer lines.
+     */
+    size_type outerSize() const {
+        return Format == SparseFormat::CSR ? m_rows : m_cols;
+    }
+
+    /**
+     * @brief Returns the number of inner positions per outer line.
+     */
+    size_type innerSize() const {
+        return Format == SparseFormat::CSR ? m_cols : m_rows;
+    }
+
+    /**
+     * @brief Returns the outer line of a triplet.
+     */
+    static size_type outerOf(const TripletN<T>& t) {
+        return Format == SparseFormat::CSR ? t.row : t.col;
+    }
+
+    /**
+     * @brief Returns the inner position of a triplet.
+     */
+    static size_type innerOf(const TripletN<T>& t) {
+        return Format == SparseFormat::CSR ? t.col : t.row;
+    }
+
+    /**
+     * @brief Fills an empty matrix with the non-zero coefficients returned by get(row, col).
+     */
+    template<typename Get>
+    void compress(Get get) {
+        for (size_type o = 0; o < outerSize(); ++o) {
+            for (size_type i = 0; i < innerSize(); ++i) {
+                const T value = Format == SparseFormat::CSR ? get(o, i) : get(i, o);
+                if (value != T{}) {
+                    m_indices.push_back(static_cast<index_type>(i));
+                    m_values.push_back(value);
+                }
+            }
+            m_offsets[o + 1] = static_cast<index_type>(m_indices.size());
+        }
+    }
+
+    /**
+     * @brief Calls set(row, col, value) for every stored coefficient.
+     */
+    template<typename Set>
+    void expand(Set set) const {
+        for (size_type o = 0; o < outerSize(); ++o) {
+            for (size_type k = m_offsets[o]; k < m_offsets[o + 1]; ++k) {
+                if constexpr (Format == SparseFormat::CSR)
+                    set(o, m_indices[k], m_values[k]);
+                else
+                    set(m_indices[k], o, m_values[k]);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the transposed compression of this matrix into an empty result.
+     *
+     * The outer lines of result are the inner positions of this matrix, so the
+     * same routine converts between formats and transposes within one format.
+     * Scanning the outer lines in order keeps every line of result sorted.
+     */
+    template<SparseFormat Target>
+    void transposeInto(SparseMatrixN<T, Target>& result) const {
+        const size_type count = nonZeros();
+        VectorN<index_type>& offsets = result.m_offsets;
+        for (size_type k = 0; k < count; ++k)
+            ++offsets[m_indices[k] + 1];
+        for (size_type i = 0; i < innerSize(); ++i)
+            offsets[i + 1] += offsets[i];
+
+        result.m_indices.resize(count, 0);
+        result.m_values.resize(count, T{});
+        VectorN<index_type> cursor(offsets);
+        for (size_type o = 0; o < outerSize(); ++o) {
+            for (size_type k = m_offsets[o]; k < m_offsets[o + 1]; ++k) {
+                const index_type slot = cursor[m_indices[k]]++;
+                result.m_indices[slot] = static_cast<index_type>(o);
+                result.m_values[slot] = m_values[k];
+            }
+        }
+    }
+
+    /**
+     * @brief y[o] = dot(outer line o, x) for every outer line, lines split across the pool.
+     */
+    void gatherProduct(const T* x, T* y, ThreadPoolN& pool) const {
+        const index_type* offsets = m_offsets.data();
+        const index_type* indices = m_indices.data();
+        const T* values = m_values.data();
+        const size_type outer = outerSize();
+        const size_type grain = std::max<size_type>(1, ParallelGrainNonZeros * outer / std::max<size_type>(1, nonZeros()));
+        pool.parallel_for(0, outer, grain, [=](size_type first, size_type last) {
+            for (size_type o = first; o < last; ++o)
+                y[o] = dotGather(values + offsets[o], indices + offsets[o], x, offsets[o + 1] - offsets[o]);
+        });
+    }
+
+    /**
+     * @brief y = 0, then y[inner] += value * x[o] for every stored coefficient.
+     */
+    void scatterProduct(const T* x, T* y) const {
+        std::fill(y, y + innerSize(), T{});
+        for (size_type o = 0; o < outerSize(); ++o) {
+            const T xo = x[o];
+            for (size_type k = m_offsets[o]; k < m_offsets[o + 1]; ++k)
+                y[m_indices[k]] += m_values[k] * xo;
+        }
+    }
+
+    /**
+     * @brief Returns sum(values[k] * x[indices[k]]) for k in [0, count).
+     *
+     * SpMV is bound by memory traffic, so short lines (typical of graph
+     * Laplacians) keep a plain loop. Longer lines split the sum over four
+     * accumulators to hide the latency of the gathered loads, and from
+     * GatherMinLength on float and double use AVX2 gathers.
+     */
+    static T dotGather(const T* values, const index_type* indices, const T* x, size_type count) {
+#if defined(CONTAINERS_HAS_AVX2)
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            if (count >= GatherMinLength)
+                return dotGatherAvx2(values, indices, x, count);
+        }
+#endif
+        if (count < UnrollMinLength) {
+            T sum{};
+            for (size_type k = 0; k < count; ++k)
+                sum += values[k] * x[indices[k]];
+            return sum;
+        }
+        T s0{}, s1{}, s2{}, s3{};
+        size_type k = 0;
+        for (; k + 4 <= count; k += 4) {
+            s0 += values[k] * x[indices[k]];
+            s1 += values[k + 1] * x[indices[k + 1]];
+            s2 += values[k + 2] * x[indices[k + 2]];
+            s3 += values[k + 3] * x[indices[k + 3]];
+        }
+        for (; k < count; ++k)
+            s0 += values[k] * x[indices[k]];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+#if defined(CONTAINERS_HAS_AVX2)
+    /**
+     * @brief AVX2 gather dot product on 4 doubles per instruction.
+     */
+    static double dotGatherAvx2(const double* values, const index_type* indices, const double* x, size_type count) {
+        // The masked gathers with a zero source avoid GCC's uninitialized-source warning on _mm256_i32gather_*.
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        __m256d acc0 = zero;
+        __m256d acc1 = zero;
+        size_type k = 0;
+        for (; k + 8 <= count; k += 8) {
+            const __m128i i0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k));
+            const __m128i i1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k + 4));
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), _mm256_mask_i32gather_pd(zero, x, i0, all, 8), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k + 4), _mm256_mask_i32gather_pd(zero, x, i1, all, 8), acc1);
+        }
+        if (k + 4 <= count) {
+            const __m128i i0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k));
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), _mm256_mask_i32gather_pd(zero, x, i0, all, 8), acc0);
+            k += 4;
+        }
+        const __m256d acc = _mm256_add_pd(acc0, acc1);
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+        double result = _mm_cvtsd_f64(sum);
+        for (; k < count; ++k)
+            result += values[k] * x[indices[k]];
+        return result;
+    }
+
+    /**
+     * @brief AVX2 gather dot product on 8 floats per instruction.
+     */
+    static float dotGatherAvx2(const float* values, const index_type* indices, const float* x, size_type count) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        __m256 acc = zero;
+        size_type k = 0;
+        for (; k + 8 <= count; k += 8) {
+            const __m256i i0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + k));
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(values + k), _mm256_mask_i32gather_ps(zero, x, i0, all, 4), acc);
+        }
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        float result = _mm_cvtss_f32(sum);
+        for (; k < count; ++k)
+            result += values[k] * x[indices[k]];
+        return result;
+    }
+#endif
+
+    size_type m_rows;              ///< Number of rows.
+    size_type m_cols;              ///< Number of columns.
+    VectorN<index_type> m_offsets; ///< Start of every outer line, followed by nonZeros().
+    VectorN<index_type> m_indices; ///< Inner index of every stored coefficient.
+    VectorN<T> m_values;           ///< Value of every stored coefficient.
+};
@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ThreadPoolN.h"
+
+/**
+ * @class TaskGraphN
+ * @brief A directed acyclic graph of tasks executed on a ThreadPoolN.
+ *
+ * Tasks are added with add() and ordered with precede(). run() starts every
+ * task without predecessors; a finished task releases its successors, which
+ * are pushed on the deque of the worker that released them, so dependent
+ * stages tend to stay on the same core. A task that throws does not release
+ * its successors, and run() rethrows the first exception once the remaining
+ * tasks have finished.
+ *
+ * The graph is not modified by run() and can be run any number of times,
+ * but not concurrently with itself or while tasks are added.
+ */
+class TaskGraphN
+{
+public:
+    using size_type = std::size_t;
+    using TaskId = size_type; ///< Identifier returned by add().
+
+    /**
+     * @brief Constructs an empty graph.
+     */
+    TaskGraphN() = default;
+
+    TaskGraphN(const TaskGraphN&) = delete; ///< Delete copy constructor.
+    TaskGraphN& operator=(const TaskGraphN&) = delete; ///< Delete copy assignment operator.
+    TaskGraphN(TaskGraphN&&) noexcept = default; ///< Default move constructor.
+    TaskGraphN& operator=(TaskGraphN&&) noexcept = default; ///< Default move assignment operator.
+
+    /**
+     * @brief Adds a task.
+     *
+     * @tparam Fn Callable with no argument.
+     * @param fn Work of the task.
+     * @return Identifier of the new task.
+     */
+    template<typename Fn>
+    TaskId add(Fn&& fn)
+    {
+        auto node = std::make_unique<NodeN>();
+        node->fn = std::function<void()>(std::forward<Fn>(fn));
+        m_nodes.push_back(std::move(node));
+        return m_nodes.size() - 1;
+    }
+
+    /**
+     * @brief Adds a task running after the given tasks.
+     *
+     * @tparam Fn Callable with no argument.
+     * @param fn Work of the task.
+     * @param dependencies Tasks that must finish first.
+     * @return Identifier of the new task.
+     * @throws std::out_of_range if a dependency is not a task of the graph.
+     */
+    template<typename Fn>
+    TaskId add(Fn&& fn, std::initializer_list<TaskId> dependencies)
+    {
+        for (TaskId dependency : dependencies)
+            checkId(dependency);
+        const TaskId id = add(std::forward<Fn>(fn));
+        for (TaskId dependency : dependencies)
+            precede(dependency, id);
+        return id;
+    }
+
+    /**
+     * @brief Requires before to finish before after starts.
+     *
+     * @param before The predecessor.
+     * @param after The successor.
+     * @throws std::out_of_range if either identifier is not a task of the graph.
+     */
+    void precede(TaskId before, TaskId after)
+    {
+        checkId(before);
+        checkId(after);
+        m_nodes[before]->successors.push_back(after);
+        ++m_nodes[after]->predecessors;
+    }
+
+    /**
+     * @brief Returns the number of tasks.
+     */
+    size_type size() const
+    {
+        return m_nodes.size();
+    }
+
+    /**
+     * @brief Whether the graph has no task.
+     */
+    bool empty() const
+    {
+        return m_nodes.empty();
+    }
+
+    /**
+     * @brief Removes every task.
+     */
+    void clear()
+    {
+        m_nodes.clear();
+    }
+
+    /**
+     * @brief Runs every task, respecting the dependencies, and waits for completion.
+     *
+     * The calling thread executes tasks while it waits.
+     *
+     * @param pool Pool executing the tasks.
+     * @throws std::runtime_error if the dependencies contain a cycle (nothing is run).
+     * @throws Rethrows the first exception thrown by a task.
+     */
+    void run(ThreadPoolN& pool = ThreadPoolN::global())
+    {
+        checkAcyclic();
+        for (auto& node : m_nodes)
+            node->remaining.store(node->predecessors, std::memory_order_relaxed);
+
+        ThreadPoolN::TaskGroup group(pool);
+        for (TaskId id = 0; id < m_nodes.size(); ++id)
+        {
+            if (m_nodes[id]->predecessors == 0)
+                group.run([this, &group, id]() { execute(group, id); });
+        }
+        group.wait();
+    }
+
+private:
+    /**
+     * @brief A task and its edges.
+     */
+    struct NodeN
+    {
+        std::function<void()> fn;          ///< Work of the task.
+        std::vector<TaskId> successors;    ///< Tasks released when this one finishes.
+        size_type predecessors = 0;        ///< Number of incoming edges.
+        std::atomic<size_type> remaining;  ///< Predecessors still running during run().
+    };
+
+    /**
+     * @brief Throws if id is not a task of the graph.
+     */
+    void checkId(TaskId id) const
+    {
+        if (id >= m_nodes.size())
+            throw std::out_of_range("TaskGraphN: unknown task");
+    }
+
+    /**
+     * @brief Throws if the graph has a cycle (Kahn's algorithm).
+     */
+    void checkAcyclic() const
+    {
+        std::vector<size_type> indegree(m_nodes.size());
+        std::vector<TaskId> ready;
+        for (TaskId id = 0; id < m_nodes.size(); ++id)
+        {
+            indegree[id] = m_nodes[id]->predecessors;
+            if (indegree[id] == 0)
+                ready.push_back(id);
+        }
+
+        size_type visited = 0;
+        while (!ready.empty())
+        {
+            const TaskId id = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (TaskId next : m_nodes[id]->successors)
+            {
+                if (--indegree[next] == 0)
+                    ready.push_back(next);
+            }
+        }
+        if (visited != m_nodes.size())
+            throw std::runtime_error("TaskGraphN: dependency cycle");
+    }
+
+    /**
+     * @brief Runs a task, then schedules the successors it was the last predecessor of.
+     *
+     * An exception propagates to the TaskGroup, which records it; the
+     * successors are then never released.
+     */
+    void execute(ThreadPoolN::TaskGroup& group, TaskId id)
+    {
+        NodeN& node = *m_nodes[id];
+        node.fn();
+        for (TaskId next : node.successors)
+        {
+            if (m_nodes[next]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                group.run([this, &group, next]() { execute(group, next); });
+        }
+    }
+
+    std::vector<std::unique_ptr<NodeN>> m_nodes; ///< Tasks, indexed by TaskId.
+};
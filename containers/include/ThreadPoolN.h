@@ -0,0 +1,602 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class WorkStealingDequeN
+ * @brief Lock-free Chase–Lev work-stealing deque.
+ *
+ * The owner thread pushes and pops at the bottom without locking; any other
+ * thread steals from the top with a single compare-and-swap, and only the
+ * last element is contended. The circular buffer doubles when full; replaced
+ * buffers are kept until the deque is destroyed, since a thief may still be
+ * reading one.
+ *
+ * Follows Chase and Lev, "Dynamic Circular Work-Stealing Deque" (SPAA 2005),
+ * with sequentially consistent accesses to top and bottom instead of
+ * standalone fences, as in Lê et al. (PPoPP 2013).
+ *
+ * @tparam T Trivially copyable element type, typically a task pointer.
+ */
+template<typename T>
+class WorkStealingDequeN
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDequeN stores trivially copyable elements");
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs an empty deque.
+     *
+     * @param capacity Initial capacity, rounded up to a power of two.
+     */
+    explicit WorkStealingDequeN(size_type capacity = 256)
+        : m_top(0), m_bottom(0)
+    {
+        size_type rounded = 2;
+        while (rounded < capacity)
+            rounded *= 2;
+        m_buffers.push_back(std::make_unique<Buffer>(rounded));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDequeN(const WorkStealingDequeN&) = delete; ///< Delete copy constructor.
+    WorkStealingDequeN& operator=(const WorkStealingDequeN&) = delete; ///< Delete copy assignment operator.
+
+    /**
+     * @brief Adds an element at the bottom. Owner thread only.
+     *
+     * @param item The element to add.
+     */
+    void push(T item)
+    {
+        const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (bottom - top >= std::int64_t(buffer->capacity()))
+            buffer = grow(buffer, top, bottom);
+        buffer->put(bottom, item);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes the most recently pushed element. Owner thread only.
+     *
+     * @param item Receives the element.
+     * @return true if an element was removed, false if the deque was empty.
+     */
+    bool pop(T& item)
+    {
+        const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = buffer->get(bottom);
+        if (top == bottom)
+        {
+            // Last element: race the thieves for it.
+            const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element. Any thread.
+     *
+     * @param item Receives the element.
+     * @return true if an element was stolen, false if the deque was empty or another thread won the race.
+     */
+    bool steal(T& item)
+    {
+        std::int64_t top = m_top.load(std::memory_order_seq_cst);
+        const std::int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom)
+            return false;
+
+        item = m_buffer.load(std::memory_order_acquire)->get(top);
+        return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns an estimate of the number of elements, exact when no other thread is active.
+     */
+    size_type size() const
+    {
+        const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? size_type(bottom - top) : 0;
+    }
+
+    /**
+     * @brief Whether the deque looks empty (see size()).
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    /**
+     * @brief Circular array indexed by the unbounded top and bottom counters.
+     */
+    class Buffer
+    {
+    public:
+        explicit Buffer(size_type capacity)
+            : m_mask(capacity - 1), m_slots(new std::atomic<T>[capacity])
+        {
+        }
+
+        size_type capacity() const
+        {
+            return m_mask + 1;
+        }
+
+        void put(std::int64_t index, T item)
+        {
+            m_slots[size_type(index) & m_mask].store(item, std::memory_order_relaxed);
+        }
+
+        T get(std::int64_t index) const
+        {
+            return m_slots[size_type(index) & m_mask].load(std::memory_order_relaxed);
+        }
+
+    private:
+        size_type m_mask;                          ///< capacity - 1, capacity being a power of two.
+        std::unique_ptr<std::atomic<T>[]> m_slots; ///< The elements.
+    };
+
+    /**
+     * @brief Replaces a full buffer by one twice as large holding the same elements.
+     */
+    Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+    {
+        auto larger = std::make_unique<Buffer>(buffer->capacity() * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+            larger->put(i, buffer->get(i));
+        m_buffers.push_back(std::move(larger));
+        Buffer* result = m_buffers.back().get();
+        m_buffer.store(result, std::memory_order_release);
+        return result;
+    }
+
+    alignas(64) std::atomic<std::int64_t> m_top;    ///< Next element to steal.
+    alignas(64) std::atomic<std::int64_t> m_bottom; ///< Next free slot of the owner.
+    std::atomic<Buffer*> m_buffer;                  ///< Current buffer.
+    std::vector<std::unique_ptr<Buffer>> m_buffers; ///< Every buffer allocated, owned until destruction.
+};
+
+/**
+ * @class ThreadPoolN
+ * @brief A work-stealing thread pool.
+ *
+ * Every worker owns a lock-free Chase–Lev deque of tasks (WorkStealingDequeN):
+ * it pushes and pops at the bottom, while idle workers steal from the top of
+ * the other deques. Tasks submitted from a thread that is not a worker go
+ * through a shared injection queue. A thread waiting on a TaskGroup executes
+ * pending tasks instead of blocking, so parallel algorithms can be nested
+ * freely. TaskGraphN (TaskGraphN.h) runs dependent stages on top of it.
+ *
+ * Queuing a task takes no pool-wide lock while every worker is busy: the
+ * sleep mutex is only taken to wake a worker that announced it is asleep,
+ * and the injection queue is only locked when its atomic size says it
+ * holds work.
+ */
+class ThreadPoolN
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type ChunksPerThread = 8; ///< Chunks per worker chosen by automatic chunking.
+
+    class TaskGroup;
+
+    /**
+     * @brief Constructs a pool and starts its worker threads.
+     *
+     * @param threadCount Number of worker threads (0 = hardware concurrency).
+     */
+    explicit ThreadPoolN(size_type threadCount = 0)
+        : m_injectSize(0), m_queued(0), m_sleepers(0), m_stop(false)
+    {
+        if (threadCount == 0)
+            threadCount = std::max<size_type>(1, std::thread::hardware_concurrency());
+
+        m_workers.reserve(threadCount);
+        for (size_type i = 0; i < threadCount; ++i)
+            m_workers.push_back(std::make_unique<Worker>());
+        m_threads.reserve(threadCount);
+        for (size_type i = 0; i < threadCount; ++i)
+            m_threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ThreadPoolN(const ThreadPoolN&) = delete; ///< Delete copy constructor.
+    ThreadPoolN& operator=(const ThreadPoolN&) = delete; ///< Delete copy assignment operator.
+
+    /**
+     * @brief Stops the workers once the queued tasks have run, and joins them.
+     */
+    ~ThreadPoolN()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_sleepCv.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    size_type threadCount() const
+    {
+        return m_threads.size();
+    }
+
+    /**
+     * @brief Returns the process-wide pool used by the library's parallel kernels.
+     *
+     * @return Pool with one worker per hardware thread.
+     */
+    static ThreadPoolN& global()
+    {
+        static ThreadPoolN pool;
+        return pool;
+    }
+
+    /**
+     * @brief Runs fn over [begin, end) split into chunks of at most grain indices.
+     *
+     * The range is split recursively: each split pushes its upper half as a
+     * task that idle workers can steal. Returns once every chunk has run.
+     *
+     * @tparam Fn Callable as fn(size_type chunkBegin, size_type chunkEnd).
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param grain Maximum number of indices per chunk (0 = automatic, see autoGrain()).
+     * @param fn Function called once per chunk.
+     * @throws Rethrows the first exception thrown by fn.
+     */
+    template<typename Fn>
+    void parallel_for(size_type begin, size_type end, size_type grain, Fn fn)
+    {
+        if (begin >= end)
+            return;
+        if (grain == 0)
+            grain = autoGrain(end - begin);
+        if (end - begin <= grain)
+        {
+            fn(begin, end);
+            return;
+        }
+
+        TaskGroup group(*this);
+        splitRange(group, begin, end, grain, fn);
+        group.wait();
+    }
+
+    /**
+     * @brief Runs fn over [begin, end) with automatic chunking.
+     *
+     * @tparam Fn Callable as fn(size_type chunkBegin, size_type chunkEnd).
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param fn Function called once per chunk.
+     * @throws Rethrows the first exception thrown by fn.
+     */
+    template<typename Fn>
+    void parallel_for(size_type begin, size_type end, Fn fn)
+    {
+        parallel_for(begin, end, 0, std::move(fn));
+    }
+
+    /**
+     * @brief Chunk size used by automatic chunking for count indices.
+     *
+     * Gives every worker ChunksPerThread chunks, so that stealing can even
+     * out chunks of unequal cost, and never splits below one index.
+     *
+     * @param count Number of indices.
+     * @return Chunk size, at least 1.
+     */
+    size_type autoGrain(size_type count) const
+    {
+        const size_type chunks = threadCount() * ChunksPerThread;
+        return std::max<size_type>(1, (count + chunks - 1) / chunks);
+    }
+
+    /**
+     * @brief A set of tasks that can be waited on together.
+     */
+    class TaskGroup
+    {
+    public:
+        /**
+         * @brief Constructs an empty group bound to a pool.
+         *
+         * @param pool Pool executing the tasks.
+         */
+        explicit TaskGroup(ThreadPoolN& pool)
+            : m_pool(pool), m_pending(0)
+        {
+        }
+
+        TaskGroup(const TaskGroup&) = delete; ///< Delete copy constructor.
+        TaskGroup& operator=(const TaskGroup&) = delete; ///< Delete copy assignment operator.
+
+        /**
+         * @brief Waits for the remaining tasks. Exceptions are discarded.
+         */
+        ~TaskGroup()
+        {
+            helpUntilDone();
+        }
+
+        /**
+         * @brief Schedules a task in the group.
+         *
+         * @tparam Fn Callable with no argument.
+         * @param fn Task to run.
+         */
+        template<typename Fn>
+        void run(Fn&& fn)
+        {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            m_pool.push(new Task{ std::function<void()>(std::forward<Fn>(fn)), this });
+        }
+
+        /**
+         * @brief Executes pending tasks of the pool until every task of the group has finished.
+         *
+         * @throws Rethrows the first exception thrown by a task of the group.
+         */
+        void wait()
+        {
+            helpUntilDone();
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> lock(m_errorMutex);
+                std::swap(error, m_error);
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+        friend class ThreadPoolN;
+
+        /**
+         * @brief Runs other tasks until the pending counter reaches zero.
+         */
+        void helpUntilDone()
+        {
+            while (m_pending.load(std::memory_order_acquire) != 0)
+            {
+                if (!m_pool.runOneTask())
+                    std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @brief Records the first exception thrown by a task.
+         */
+        void setError(std::exception_ptr error)
+        {
+            std::lock_guard<std::mutex> lock(m_errorMutex);
+            if (!m_error)
+                m_error = error;
+        }
+
+        ThreadPoolN& m_pool;               ///< Pool executing the tasks.
+        std::atomic<size_type> m_pending;  ///< Number of unfinished tasks.
+        std::mutex m_errorMutex;           ///< Protects m_error.
+        std::exception_ptr m_error;        ///< First exception thrown by a task.
+    };
+
+private:
+    /**
+     * @brief A unit of work.
+     */
+    struct Task
+    {
+        std::function<void()> fn; ///< Work to execute.
+        TaskGroup* group;         ///< Group notified on completion.
+    };
+
+    /**
+     * @brief Per-worker task deque.
+     */
+    struct Worker
+    {
+        WorkStealingDequeN<Task*> tasks; ///< Owner uses the bottom, thieves the top.
+    };
+
+    /**
+     * @brief Identifies the pool and worker index of the current thread.
+     */
+    struct WorkerContext
+    {
+        ThreadPoolN* pool = nullptr; ///< Pool owning the current thread, if any.
+        size_type index = 0;         ///< Index of the current worker in that pool.
+    };
+
+    /**
+     * @brief Returns the worker context of the calling thread.
+     */
+    static WorkerContext& context()
+    {
+        static thread_local WorkerContext ctx;
+        return ctx;
+    }
+
+    /**
+     * @brief Splits [begin, end) and runs the lowest chunk on the calling thread.
+     */
+    template<typename Fn>
+    void splitRange(TaskGroup& group, size_type begin, size_type end, size_type grain, const Fn& fn)
+    {
+        while (end - begin > grain)
+        {
+            const size_type mid = begin + (end - begin) / 2;
+            group.run([this, &group, mid, end, grain, &fn]() { splitRange(group, mid, end, grain, fn); });
+            end = mid;
+        }
+        fn(begin, end);
+    }
+
+    /**
+     * @brief Queues a task on the current worker, or on the injection queue.
+     */
+    void push(Task* task)
+    {
+        // Counted before the task is visible, so a worker that takes it cannot
+        // decrement m_queued first and wrap it around.
+        m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+        WorkerContext& ctx = context();
+        if (ctx.pool == this)
+        {
+            m_workers[ctx.index]->tasks.push(task);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            m_inject.push_back(task);
+            m_injectSize.fetch_add(1, std::memory_order_release);
+        }
+
+        // Pairs with workerLoop(): either this sees the sleeper, or the sleeper sees the task.
+        if (m_sleepers.load(std::memory_order_seq_cst) != 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_sleepCv.notify_one();
+        }
+    }
+
+    /**
+     * @brief Takes a task: own deque first, then the injection queue, then steals.
+     *
+     * @return A task, or nullptr if none is available.
+     */
+    Task* takeTask()
+    {
+        WorkerContext& ctx = context();
+        const bool isWorker = ctx.pool == this;
+
+        Task* task = nullptr;
+        if (isWorker && m_workers[ctx.index]->tasks.pop(task))
+            return task;
+
+        if (m_injectSize.load(std::memory_order_acquire) != 0)
+        {
+            std::lock_guard<std::mutex> lock(m_injectMutex);
+            if (!m_inject.empty())
+            {
+                task = m_inject.front();
+                m_inject.pop_front();
+                m_injectSize.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        const size_type count = m_workers.size();
+        const size_type start = isWorker ? ctx.index + 1 : 0;
+        for (size_type i = 0; i < count; ++i)
+        {
+            WorkStealingDequeN<Task*>& victim = m_workers[(start + i) % count]->tasks;
+            while (!victim.empty())
+            {
+                if (victim.steal(task))
+                    return task;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Executes one available task.
+     *
+     * @return true if a task was executed, false if none was available.
+     */
+    bool runOneTask()
+    {
+        Task* task = takeTask();
+        if (!task)
+            return false;
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+        TaskGroup* group = task->group;
+        try
+        {
+            task->fn();
+        }
+        catch (...)
+        {
+            group->setError(std::current_exception());
+        }
+        delete task;
+        group->m_pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Main loop of a worker thread.
+     */
+    void workerLoop(size_type index)
+    {
+        context().pool = this;
+        context().index = index;
+
+        while (true)
+        {
+            if (runOneTask())
+                continue;
+
+            // Announce the sleep before re-checking m_queued, so push() either sees a
+            // sleeper and notifies, or its task is seen here and the worker stays awake.
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            m_sleepCv.wait(lock, [this]() { return m_stop || m_queued.load(std::memory_order_seq_cst) != 0; });
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stop && m_queued.load(std::memory_order_acquire) == 0)
+                break;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> m_workers; ///< Per-worker deques.
+    std::vector<std::thread> m_threads;             ///< Worker threads.
+    std::mutex m_injectMutex;                       ///< Protects m_inject.
+    std::deque<Task*> m_inject;                     ///< Tasks submitted from outside the pool.
+    std::atomic<size_type> m_injectSize;            ///< Size of m_inject, read without the lock to skip an empty queue.
+    std::atomic<size_type> m_queued;                ///< Number of tasks queued or being queued by push().
+    std::atomic<size_type> m_sleepers;              ///< Workers waiting on m_sleepCv; push() notifies only when non-zero.
+    std::mutex m_sleepMutex;                        ///< Protects the sleep state.
+    std::condition_variable m_sleepCv;              ///< Wakes idle workers.
+    bool m_stop;                                    ///< Set when the pool is being destroyed.
+};
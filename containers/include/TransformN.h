@@ -0,0 +1,355 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include <ostream>
+#include "VecteurND.h"
+#include "MatrixN.h"
+#include "QuaternionN.h"
+
+/**
+ * @brief A 3D affine transform made of a linear part and a translation.
+ *
+ * A point p is mapped to linear * p + translation. The batch apply processes
+ * vectors in blocks of BatchLanes and works on one component at a time for the
+ * whole block, so the compiler vectorizes across vectors instead of inside one.
+ *
+ * @tparam T Type of the coefficients (float or double).
+ */
+template<typename T>
+class TransformN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using vector3_type = VectorND<T, 3>;
+    using matrix3_type = MatrixND<T, 3, 3>;
+    using quaternion_type = QuaternionN<T>;
+
+    static constexpr size_type BatchLanes = 16; ///< Number of vectors processed together by apply().
+
+    /**
+     * @brief Default constructor that builds the identity transform.
+     */
+    TransformN()
+        : m_linear{ { T{ 1 }, T{}, T{} }, { T{}, T{ 1 }, T{} }, { T{}, T{}, T{ 1 } } }
+    {
+    }
+
+    /**
+     * @brief Constructor from a linear part and a translation.
+     *
+     * @param linear Linear part (rotation, scale, shear).
+     * @param translation Translation applied after the linear part.
+     */
+    TransformN(const matrix3_type& linear, const vector3_type& translation)
+        : m_linear(linear), m_translation(translation)
+    {
+    }
+
+    /**
+     * @brief Builds a pure rotation.
+     *
+     * @param rotation Unit quaternion.
+     * @return Rotation transform.
+     */
+    static TransformN fromRotation(const quaternion_type& rotation)
+    {
+        return TransformN(rotation.toMatrix(), vector3_type{});
+    }
+
+    /**
+     * @brief Builds a pure translation.
+     *
+     * @param translation Translation vector.
+     * @return Translation transform.
+     */
+    static TransformN fromTranslation(const vector3_type& translation)
+    {
+        TransformN result;
+        result.m_translation = translation;
+        return result;
+    }
+
+    /**
+     * @brief Builds a transform that scales, then rotates, then translates.
+     *
+     * @param translation Translation vector.
+     * @param rotation Unit quaternion.
+     * @param scale Per-axis scale factors.
+     * @return Composed transform.
+     */
+    static TransformN fromTRS(const vector3_type& translation, const quaternion_type& rotation,
+        const vector3_type& scale)
+    {
+        matrix3_type linear = rotation.toMatrix();
+        T* a = linear.data();
+        const T* s = scale.data();
+        for (size_type r = 0; r < 3; ++r)
+            for (size_type c = 0; c < 3; ++c)
+                a[r * 3 + c] *= s[c];
+        return TransformN(linear, translation);
+    }
+
+    /**
+     * @brief Returns the linear part.
+     */
+    const matrix3_type& linear() const
+    {
+        return m_linear;
+    }
+
+    /**
+     * @brief Returns the translation.
+     */
+    const vector3_type& translation() const
+    {
+        return m_translation;
+    }
+
+    /**
+     * @brief Transforms a point (linear part and translation).
+     *
+     * @param p Point to transform.
+     * @return Transformed point.
+     */
+    vector3_type apply(const vector3_type& p) const
+    {
+        vector3_type result = applyVector(p);
+        T* r = result.data();
+        const T* t = m_translation.data();
+        r[0] += t[0];
+        r[1] += t[1];
+        r[2] += t[2];
+        return result;
+    }
+
+    /**
+     * @brief Transforms a direction (linear part only).
+     *
+     * @param v Direction to transform.
+     * @return Transformed direction.
+     */
+    vector3_type applyVector(const vector3_type& v) const
+    {
+        const T* m = m_linear.data();
+        const T* p = v.data();
+        return vector3_type{
+            m[0] * p[0] + m[1] * p[1] + m[2] * p[2],
+            m[3] * p[0] + m[4] * p[1] + m[5] * p[2],
+            m[6] * p[0] + m[7] * p[1] + m[8] * p[2] };
+    }
+
+    /**
+     * @brief Transforms a span of points.
+     *
+     * Input and output may be the same span.
+     *
+     * @param in Points to transform.
+     * @param out Destination, must have the same size as in.
+     * @throws std::runtime_error if the spans have different sizes.
+     */
+    void apply(std::span<const vector3_type> in, std::span<vector3_type> out) const
+    {
+        applyBatch(in, out, true);
+    }
+
+    /**
+     * @brief Transforms a span of points in place.
+     *
+     * @param points Points to transform.
+     */
+    void apply(std::span<vector3_type> points) const
+    {
+        applyBatch(points, points, true);
+    }
+
+    /**
+     * @brief Transforms a span of directions (no translation).
+     *
+     * @param in Directions to transform.
+     * @param out Destination, must have the same size as in.
+     * @throws std::runtime_error if the spans have different sizes.
+     */
+    void applyVectors(std::span<const vector3_type> in, std::span<vector3_type> out) const
+    {
+        applyBatch(in, out, false);
+    }
+
+    /**
+     * @brief Composes two transforms.
+     *
+     * The result applies rhs first, then this transform.
+     *
+     * @param rhs Right-hand side transform.
+     * @return Composed transform.
+     */
+    TransformN operator*(const TransformN& rhs) const
+    {
+        matrix3_type linear = matrix3_type::template multiply<3>(m_linear, rhs.m_linear);
+        return TransformN(linear, apply(rhs.m_translation));
+    }
+
+    /**
+     * @brief Composes this transform with another one in place.
+     *
+     * @param rhs Right-hand side transform.
+     * @return Reference to this transform.
+     */
+    TransformN& operator*=(const TransformN& rhs)
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Computes the inverse transform.
+     *
+     * @return Inverse transform.
+     * @throws std::runtime_error if the linear part is singular.
+     */
+    TransformN inverse() const
+    {
+        const T* m = m_linear.data();
+        T c00 = m[4] * m[8] - m[5] * m[7];
+        T c01 = m[5] * m[6] - m[3] * m[8];
+        T c02 = m[3] * m[7] - m[4] * m[6];
+        T det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        if (det == T{})
+            throw std::runtime_error("Cannot invert a singular TransformN");
+
+        T invDet = T{ 1 } / det;
+        matrix3_type inv;
+        T* r = inv.data();
+        r[0] = c00 * invDet;
+        r[1] = (m[2] * m[7] - m[1] * m[8]) * invDet;
+        r[2] = (m[1] * m[5] - m[2] * m[4]) * invDet;
+        r[3] = c01 * invDet;
+        r[4] = (m[0] * m[8] - m[2] * m[6]) * invDet;
+        r[5] = (m[2] * m[3] - m[0] * m[5]) * invDet;
+        r[6] = c02 * invDet;
+        r[7] = (m[1] * m[6] - m[0] * m[7]) * invDet;
+        r[8] = (m[0] * m[4] - m[1] * m[3]) * invDet;
+
+        TransformN result(inv, vector3_type{});
+        vector3_type t = result.applyVector(m_translation);
+        T* pt = t.data();
+        pt[0] = -pt[0];
+        pt[1] = -pt[1];
+        pt[2] = -pt[2];
+        result.m_translation = t;
+        return result;
+    }
+
+    /**
+     * @brief Interpolates between two rigid transforms.
+     *
+     * Rotations are interpolated with QuaternionN::slerp and translations
+     * linearly. Both linear parts must be pure rotations.
+     *
+     * @param a Start transform (t = 0).
+     * @param b End transform (t = 1).
+     * @param t Interpolation parameter in [0, 1].
+     * @return Interpolated transform.
+     */
+    static TransformN slerp(const TransformN& a, const TransformN& b, T t)
+    {
+        quaternion_type q = quaternion_type::slerp(
+            quaternion_type::fromMatrix(a.m_linear), quaternion_type::fromMatrix(b.m_linear), t);
+        const T* ta = a.m_translation.data();
+        const T* tb = b.m_translation.data();
+        vector3_type translation{
+            ta[0] + (tb[0] - ta[0]) * t,
+            ta[1] + (tb[1] - ta[1]) * t,
+            ta[2] + (tb[2] - ta[2]) * t };
+        return TransformN(q.toMatrix(), translation);
+    }
+
+private:
+    static_assert(sizeof(vector3_type) == 3 * sizeof(T), "VectorND<T, 3> must be tightly packed");
+
+    /**
+     * @brief Shared implementation of the batch apply.
+     *
+     * @param in Source vectors.
+     * @param out Destination vectors.
+     * @param withTranslation Whether the translation is added.
+     */
+    void applyBatch(std::span<const vector3_type> in, std::span<vector3_type> out, bool withTranslation) const
+    {
+        if (in.size() != out.size())
+            throw std::runtime_error("TransformN::apply: input and output sizes differ");
+
+        const T* m = m_linear.data();
+        const T m00 = m[0], m01 = m[1], m02 = m[2];
+        const T m10 = m[3], m11 = m[4], m12 = m[5];
+        const T m20 = m[6], m21 = m[7], m22 = m[8];
+        const T* t = m_translation.data();
+        const T tx = withTranslation ? t[0] : T{};
+        const T ty = withTranslation ? t[1] : T{};
+        const T tz = withTranslation ? t[2] : T{};
+
+        const size_type count = in.size();
+        const size_type blocked = count - count % BatchLanes;
+
+        T x[BatchLanes];
+        T y[BatchLanes];
+        T z[BatchLanes];
+
+        for (size_type base = 0; base < blocked; base += BatchLanes)
+        {
+            for (size_type l = 0; l < BatchLanes; ++l)
+            {
+                const T* p = in[base + l].data();
+                x[l] = p[0];
+                y[l] = p[1];
+                z[l] = p[2];
+            }
+
+            for (size_type l = 0; l < BatchLanes; ++l)
+            {
+                T ox = m00 * x[l] + m01 * y[l] + m02 * z[l] + tx;
+                T oy = m10 * x[l] + m11 * y[l] + m12 * z[l] + ty;
+                T oz = m20 * x[l] + m21 * y[l] + m22 * z[l] + tz;
+                x[l] = ox;
+                y[l] = oy;
+                z[l] = oz;
+            }
+
+            for (size_type l = 0; l < BatchLanes; ++l)
+            {
+                T* p = out[base + l].data();
+                p[0] = x[l];
+                p[1] = y[l];
+                p[2] = z[l];
+            }
+        }
+
+        for (size_type i = blocked; i < count; ++i)
+        {
+            const T* p = in[i].data();
+            T px = p[0], py = p[1], pz = p[2];
+            T* o = out[i].data();
+            o[0] = m00 * px + m01 * py + m02 * pz + tx;
+            o[1] = m10 * px + m11 * py + m12 * pz + ty;
+            o[2] = m20 * px + m21 * py + m22 * pz + tz;
+        }
+    }
+
+    matrix3_type m_linear;      ///< Linear part of the transform.
+    vector3_type m_translation; ///< Translation part of the transform.
+};
+
+/**
+ * @brief Stream insertion operator for TransformN.
+ *
+ * @tparam T Type of the coefficients.
+ * @param os Output stream.
+ * @param t Transform to insert into the stream.
+ * @return Reference to the output stream.
+ */
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const TransformN<T>& t)
+{
+    os << "{ linear: " << t.linear() << ", translation: " << t.translation() << " }";
+    return os;
+}
@@ -0,0 +1,349 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "SimdN.h"
+
+/**
+ * @brief Cache-oblivious matrix transposition on raw row-major storage.
+ *
+ * Both routines split the matrix recursively along its larger dimension until
+ * a tile fits in L1 (LeafSize x LeafSize), so every level of the cache hierarchy
+ * sees a working set it can hold without a tuned block size. A tile is walked as
+ * MicroSize x MicroSize micro-blocks transposed in registers: 8x8 float and 4x4
+ * double with AVX, 4x4 float and 2x2 double with SSE2, a plain loop otherwise.
+ *
+ * Converting between row-major and column-major storage is the same operation:
+ * the row-major storage of A is the column-major storage of A^T.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+class TransposeN
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+#if defined(CONTAINERS_HAS_AVX2)
+    static constexpr size_type MicroSize = std::is_same_v<T, float> ? 8 : 4; ///< Side of the register micro-block.
+#elif defined(CONTAINERS_HAS_SSE2)
+    static constexpr size_type MicroSize = std::is_same_v<T, double> ? 2 : 4; ///< Side of the register micro-block.
+#else
+    static constexpr size_type MicroSize = 4; ///< Side of the register micro-block.
+#endif
+    static constexpr size_type LeafSize = 32; ///< Largest tile side handled without splitting.
+
+    /**
+     * @brief Writes the transpose of a rows x cols matrix: dst(j, i) = src(i, j).
+     *
+     * @param rows Number of rows of the source.
+     * @param cols Number of columns of the source.
+     * @param src First element of the source.
+     * @param srcStride Elements between two consecutive rows of the source.
+     * @param dst First element of the destination, a cols x rows matrix. Must not overlap src.
+     * @param dstStride Elements between two consecutive rows of the destination.
+     */
+    static void copy(size_type rows, size_type cols, const T* src, size_type srcStride, T* dst, size_type dstStride)
+    {
+        if (rows == 0 || cols == 0)
+            return;
+        copyRecursive(rows, cols, src, srcStride, dst, dstStride);
+    }
+
+    /**
+     * @brief Transposes a square n x n matrix in place.
+     *
+     * The diagonal halves are transposed recursively and the off-diagonal
+     * quadrants are exchanged through swapped micro-blocks, so no buffer
+     * beyond one micro-block is used.
+     *
+     * @param n Order of the matrix.
+     * @param data First element of the matrix.
+     * @param stride Elements between two consecutive rows.
+     */
+    static void inPlace(size_type n, T* data, size_type stride)
+    {
+        if (n <= LeafSize)
+        {
+            inPlaceLeaf(n, data, stride);
+            return;
+        }
+        const size_type half = splitPoint(n);
+        inPlace(half, data, stride);
+        inPlace(n - half, data + half * stride + half, stride);
+        swapRecursive(half, n - half, data + half, data + half * stride, stride);
+    }
+
+private:
+    using MicroBlock = std::array<T, MicroSize * MicroSize>; ///< One micro-block, row-major.
+
+    /**
+     * @brief Returns where to split a dimension: about half, on a micro-block boundary.
+     */
+    static size_type splitPoint(size_type size)
+    {
+        const size_type half = (size / 2 + MicroSize - 1) / MicroSize * MicroSize;
+        return half < size ? half : size / 2;
+    }
+
+    /**
+     * @brief Splits the larger dimension until the tile fits in L1.
+     */
+    static void copyRecursive(size_type rows, size_type cols, const T* src, size_type srcStride, T* dst, size_type dstStride)
+    {
+        if (rows <= LeafSize && cols <= LeafSize)
+        {
+            copyLeaf(rows, cols, src, srcStride, dst, dstStride);
+        }
+        else if (rows >= cols)
+        {
+            const size_type half = splitPoint(rows);
+            copyRecursive(half, cols, src, srcStride, dst, dstStride);
+            copyRecursive(rows - half, cols, src + half * srcStride, srcStride, dst + half, dstStride);
+        }
+        else
+        {
+            const size_type half = splitPoint(cols);
+            copyRecursive(rows, half, src, srcStride, dst, dstStride);
+            copyRecursive(rows, cols - half, src + half, srcStride, dst + half * dstStride, dstStride);
+        }
+    }
+
+    /**
+     * @brief Transposes one tile: full micro-blocks in registers, the borders element by element.
+     */
+    static void copyLeaf(size_type rows, size_type cols, const T* src, size_type srcStride, T* dst, size_type dstStride)
+    {
+        const size_type fullRows = rows / MicroSize * MicroSize;
+        const size_type fullCols = cols / MicroSize * MicroSize;
+        for (size_type i = 0; i < fullRows; i += MicroSize)
+        {
+            for (size_type j = 0; j < fullCols; j += MicroSize)
+                microTranspose(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride);
+        }
+        for (size_type i = 0; i < rows; ++i)
+        {
+            for (size_type j = i < fullRows ? fullCols : 0; j < cols; ++j)
+                dst[j * dstStride + i] = src[i * srcStride + j];
+        }
+    }
+
+    /**
+     * @brief Exchanges a with the transpose of b: a(i, j) <-> b(j, i).
+     *
+     * @param rows Rows of a, columns of b.
+     * @param cols Columns of a, rows of b.
+     */
+    static void swapRecursive(size_type rows, size_type cols, T* a, T* b, size_type stride)
+    {
+        if (rows <= LeafSize && cols <= LeafSize)
+        {
+            swapLeaf(rows, cols, a, b, stride);
+        }
+        else if (rows >= cols)
+        {
+            const size_type half = splitPoint(rows);
+            swapRecursive(half, cols, a, b, stride);
+            swapRecursive(rows - half, cols, a + half * stride, b + half, stride);
+        }
+        else
+        {
+            const size_type half = splitPoint(cols);
+            swapRecursive(rows, half, a, b, stride);
+            swapRecursive(rows, cols - half, a + half, b + half * stride, stride);
+        }
+    }
+
+    /**
+     * @brief Exchanges one tile of a with the transpose of the matching tile of b.
+     */
+    static void swapLeaf(size_type rows, size_type cols, T* a, T* b, size_type stride)
+    {
+        const size_type fullRows = rows / MicroSize * MicroSize;
+        const size_type fullCols = cols / MicroSize * MicroSize;
+        MicroBlock block;
+        for (size_type i = 0; i < fullRows; i += MicroSize)
+        {
+            for (size_type j = 0; j < fullCols; j += MicroSize)
+            {
+                T* blockA = a + i * stride + j;
+                T* blockB = b + j * stride + i;
+                microTranspose(blockA, stride, block.data(), MicroSize);
+                microTranspose(blockB, stride, blockA, stride);
+                storeBlock(block, blockB, stride);
+            }
+        }
+        for (size_type i = 0; i < rows; ++i)
+        {
+            for (size_type j = i < fullRows ? fullCols : 0; j < cols; ++j)
+                std::swap(a[i * stride + j], b[j * stride + i]);
+        }
+    }
+
+    /**
+     * @brief Transposes one diagonal tile in place.
+     */
+    static void inPlaceLeaf(size_type n, T* data, size_type stride)
+    {
+        const size_type full = n / MicroSize * MicroSize;
+        MicroBlock block;
+        for (size_type i = 0; i < full; i += MicroSize)
+        {
+            T* diagonal = data + i * stride + i;
+            microTranspose(diagonal, stride, block.data(), MicroSize);
+            storeBlock(block, diagonal, stride);
+            for (size_type j = i + MicroSize; j < full; j += MicroSize)
+            {
+                T* upper = data + i * stride + j;
+                T* lower = data + j * stride + i;
+                microTranspose(upper, stride, block.data(), MicroSize);
+                microTranspose(lower, stride, upper, stride);
+                storeBlock(block, lower, stride);
+            }
+        }
+        for (size_type i = 0; i < n; ++i)
+        {
+            for (size_type j = std::max(i + 1, full); j < n; ++j)
+                std::swap(data[i * stride + j], data[j * stride + i]);
+        }
+    }
+
+    /**
+     * @brief Copies a micro-block back into strided storage.
+     */
+    static void storeBlock(const MicroBlock& block, T* dst, size_type dstStride)
+    {
+        for (size_type i = 0; i < MicroSize; ++i)
+            std::copy(block.data() + i * MicroSize, block.data() + (i + 1) * MicroSize, dst + i * dstStride);
+    }
+
+    /**
+     * @brief Transposes one MicroSize x MicroSize block; src and dst must not overlap.
+     */
+    static void microTranspose(const T* src, size_type srcStride, T* dst, size_type dstStride)
+    {
+#if defined(CONTAINERS_HAS_AVX2)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            microTransposeAvx(src, srcStride, dst, dstStride);
+            return;
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            microTransposeAvx(src, srcStride, dst, dstStride);
+            return;
+        }
+#elif defined(CONTAINERS_HAS_SSE2)
+        if constexpr (std::is_same_v<T, float>)
+        {
+            microTransposeSse(src, srcStride, dst, dstStride);
+            return;
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            microTransposeSse(src, srcStride, dst, dstStride);
+            return;
+        }
+#endif
+        for (size_type i = 0; i < MicroSize; ++i)
+        {
+            for (size_type j = 0; j < MicroSize; ++j)
+                dst[j * dstStride + i] = src[i * srcStride + j];
+        }
+    }
+
+#if defined(CONTAINERS_HAS_AVX2)
+    /**
+     * @brief 8 x 8 float transpose: unpack pairs, shuffle quads, exchange 128-bit halves.
+     */
+    static void microTransposeAvx(const float* src, size_type srcStride, float* dst, size_type dstStride)
+    {
+        __m256 r0 = _mm256_loadu_ps(src);
+        __m256 r1 = _mm256_loadu_ps(src + srcStride);
+        __m256 r2 = _mm256_loadu_ps(src + 2 * srcStride);
+        __m256 r3 = _mm256_loadu_ps(src + 3 * srcStride);
+        __m256 r4 = _mm256_loadu_ps(src + 4 * srcStride);
+        __m256 r5 = _mm256_loadu_ps(src + 5 * srcStride);
+        __m256 r6 = _mm256_loadu_ps(src + 6 * srcStride);
+        __m256 r7 = _mm256_loadu_ps(src + 7 * srcStride);
+
+        const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+        const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+        const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+        const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+        const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+        const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(s0, s4, 0x20));
+        _mm256_storeu_ps(dst + dstStride, _mm256_permute2f128_ps(s1, s5, 0x20));
+        _mm256_storeu_ps(dst + 2 * dstStride, _mm256_permute2f128_ps(s2, s6, 0x20));
+        _mm256_storeu_ps(dst + 3 * dstStride, _mm256_permute2f128_ps(s3, s7, 0x20));
+        _mm256_storeu_ps(dst + 4 * dstStride, _mm256_permute2f128_ps(s0, s4, 0x31));
+        _mm256_storeu_ps(dst + 5 * dstStride, _mm256_permute2f128_ps(s1, s5, 0x31));
+        _mm256_storeu_ps(dst + 6 * dstStride, _mm256_permute2f128_ps(s2, s6, 0x31));
+        _mm256_storeu_ps(dst + 7 * dstStride, _mm256_permute2f128_ps(s3, s7, 0x31));
+    }
+
+    /**
+     * @brief 4 x 4 double transpose: unpack pairs, exchange 128-bit halves.
+     */
+    static void microTransposeAvx(const double* src, size_type srcStride, double* dst, size_type dstStride)
+    {
+        const __m256d r0 = _mm256_loadu_pd(src);
+        const __m256d r1 = _mm256_loadu_pd(src + srcStride);
+        const __m256d r2 = _mm256_loadu_pd(src + 2 * srcStride);
+        const __m256d r3 = _mm256_loadu_pd(src + 3 * srcStride);
+
+        const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+        const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+        const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+        const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+        _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+        _mm256_storeu_pd(dst + dstStride, _mm256_permute2f128_pd(t1, t3, 0x20));
+        _mm256_storeu_pd(dst + 2 * dstStride, _mm256_permute2f128_pd(t0, t2, 0x31));
+        _mm256_storeu_pd(dst + 3 * dstStride, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+#elif defined(CONTAINERS_HAS_SSE2)
+    /**
+     * @brief 4 x 4 float transpose with _MM_TRANSPOSE4_PS.
+     */
+    static void microTransposeSse(const float* src, size_type srcStride, float* dst, size_type dstStride)
+    {
+        __m128 r0 = _mm_loadu_ps(src);
+        __m128 r1 = _mm_loadu_ps(src + srcStride);
+        __m128 r2 = _mm_loadu_ps(src + 2 * srcStride);
+        __m128 r3 = _mm_loadu_ps(src + 3 * srcStride);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + dstStride, r1);
+        _mm_storeu_ps(dst + 2 * dstStride, r2);
+        _mm_storeu_ps(dst + 3 * dstStride, r3);
+    }
+
+    /**
+     * @brief 2 x 2 double transpose with unpack instructions.
+     */
+    static void microTransposeSse(const double* src, size_type srcStride, double* dst, size_type dstStride)
+    {
+        const __m128d r0 = _mm_loadu_pd(src);
+        const __m128d r1 = _mm_loadu_pd(src + srcStride);
+        _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+        _mm_storeu_pd(dst + dstStride, _mm_unpackhi_pd(r0, r1));
+    }
+#endif
+};
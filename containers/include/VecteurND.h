@@ -1,8 +1,10 @@
 #pragma once
 #include "ArrayN.h"
+#include "ExpressionN.h"
 #include <cmath>
 #include <stdexcept>
 #include <ostream>
+#include <type_traits>
 
 /**
  * @brief This class VectorND uses the ArrayN<T, N> you provided earlier
@@ -18,6 +20,8 @@ public:
     using value_type = T;
     using size_type = std::size_t;
 
+    static constexpr size_type SizeAtCompileTime = N; ///< Number of elements, for VectorExpressionN.
+
     /**
      * @brief Default constructor that initializes all elements to the default value of T.
      */
@@ -52,6 +56,43 @@ public:
         }
     }
 
+    /**
+     * @brief Evaluates a vector expression of the same size in a single pass.
+     *
+     * The expression is evaluated coefficient by coefficient, so A * x + b
+     * reads each row of A once; an expression providing evalTo(T*) writes
+     * its result directly instead. The conversion is explicit when the
+     * element type of the expression differs from T.
+     *
+     * @tparam E Expression type.
+     * @param expr Expression to evaluate.
+     */
+    template<VectorExpressionN E>
+        requires (E::SizeAtCompileTime == N && std::is_convertible_v<typename E::value_type, T>)
+    explicit(!std::is_same_v<typename E::value_type, T>) VectorND(const E& expr)
+    {
+        assign(expr);
+    }
+
+    /**
+     * @brief Assigns the value of a vector expression of the same size.
+     *
+     * The expression may reference this vector (x = A * x): it is evaluated
+     * into a temporary first, then copied.
+     *
+     * @tparam E Expression type.
+     * @param expr Expression to evaluate.
+     * @return Reference to this vector.
+     */
+    template<VectorExpressionN E>
+        requires (E::SizeAtCompileTime == N && std::is_convertible_v<typename E::value_type, T>)
+    VectorND& operator=(const E& expr)
+    {
+        VectorND result(expr);
+        m_data = result.m_data;
+        return *this;
+    }
+
     /**
      * @brief Accesses the element at the given index.
      *
@@ -74,6 +115,17 @@ public:
         return m_data[index];
     }
 
+    /**
+     * @brief Accesses the element at the given index without bounds checking.
+     *
+     * @param index Index of the element to access.
+     * @return Const reference to the element at the given index.
+     */
+    const T& coeff(size_type index) const
+    {
+        return m_data.data()[index];
+    }
+
     /**
      * @brief Returns the size of the vector.
      *
@@ -84,6 +136,26 @@ public:
         return N;
     }
 
+    /**
+     * @brief Returns a pointer to the underlying data array.
+     *
+     * @return Pointer to the first component.
+     */
+    T* data()
+    {
+        return m_data.data();
+    }
+
+    /**
+     * @brief Returns a pointer to the underlying data array (const version).
+     *
+     * @return Const pointer to the first component.
+     */
+    const T* data() const
+    {
+        return m_data.data();
+    }
+
     /**
      * @brief Computes the dot product of two vectors.
      *
@@ -101,6 +173,26 @@ public:
         return result;
     }
 
+    /**
+     * @brief Computes the squared Euclidean distance between two vectors.
+     *
+     * @param lhs Left-hand side vector.
+     * @param rhs Right-hand side vector.
+     * @return Squared distance between the two vectors.
+     */
+    static T distanceSquared(const VectorND& lhs, const VectorND& rhs)
+    {
+        const T* a = lhs.m_data.data();
+        const T* b = rhs.m_data.data();
+        T result = T{};
+        for (size_type i = 0; i < N; ++i)
+        {
+            T d = a[i] - b[i];
+            result += d * d;
+        }
+        return result;
+    }
+
     /**
      * @brief Computes the cross product of two 3D vectors.
      *
@@ -189,6 +281,24 @@ public:
     }
 
 private:
+    /**
+     * @brief Writes the value of expr into the storage.
+     */
+    template<typename E>
+    void assign(const E& expr)
+    {
+        T* dst = m_data.data();
+        if constexpr (requires { expr.evalTo(dst); })
+        {
+            expr.evalTo(dst);
+        }
+        else
+        {
+            for (size_type i = 0; i < N; ++i)
+                dst[i] = static_cast<T>(expr.coeff(i));
+        }
+    }
+
     ArrayN<T, N> m_data; ///< Internal container for the vector data.
 };
 
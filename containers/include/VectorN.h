@@ -4,33 +4,68 @@
 #include <stdexcept>
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
 #include <limits>
+#include <type_traits>
 #include <utility>
+#include <cstddef>
+#include <iterator>
+#include "AllocationStatsN.h"
 
 /**
  * @class VectorN
  * @brief A dynamic array class template that provides a similar interface to std::vector.
  *
+ * Iterators are raw pointers, so VectorN models std::ranges::contiguous_range
+ * and std algorithms (copy, sort, views) take their contiguous fast paths.
+ *
+ * Storage comes from Allocator. Every slot up to the capacity holds a
+ * constructed element (trivial types are left uninitialized), and elements
+ * are constructed through std::allocator_traits, so a
+ * std::pmr::polymorphic_allocator passes its resource on to elements that
+ * use allocators (see pmr::VectorN). Copy, move and swap propagate the
+ * allocator as std::vector does.
+ *
+ * With CONTAINERS_TRACK_ALLOCATIONS, the vector reports its storage and
+ * size to AllocationStatsN (see AllocationStatsN.h).
+ *
  * @tparam T The type of elements stored in the vector.
+ * @tparam Allocator Allocator of T; its pointer type must be T*.
  */
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class VectorN
 {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "VectorN: the allocator must use raw pointers");
+
 public:
     using value_type = T;                ///< The type of elements stored in the vector.
+    using allocator_type = Allocator;    ///< The allocator type.
     using size_type = std::size_t;       ///< An unsigned integral type used for sizes.
+    using difference_type = std::ptrdiff_t; ///< A signed integral type used for distances.
     using reference = value_type&;       ///< A reference to an element.
     using const_reference = const value_type&; ///< A const reference to an element.
     using pointer = value_type*;         ///< A pointer to an element.
     using const_pointer = const value_type*; ///< A const pointer to an element.
     using iterator = value_type*;        ///< An iterator to an element.
     using const_iterator = const value_type*; ///< A const iterator to an element.
+    using reverse_iterator = std::reverse_iterator<iterator>;             ///< A reverse iterator to an element.
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>; ///< A const reverse iterator to an element.
 
     /**
      * @brief Default constructor. Constructs an empty vector.
      */
     VectorN()
-        : m_size(0), m_capacity(0), m_data(nullptr)
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(), m_track()
+    {
+    }
+
+    /**
+     * @brief Constructs an empty vector using the given allocator.
+     * @param alloc The allocator.
+     */
+    explicit VectorN(const Allocator& alloc)
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(alloc), m_track()
     {
     }
 
@@ -38,41 +73,91 @@ public:
      * @brief Constructs a vector with n copies of val.
      * @param n The number of elements.
      * @param val The value to initialize elements with.
+     * @param alloc The allocator.
      */
-    explicit VectorN(size_type n, const value_type& val = value_type())
-        : m_size(n), m_capacity(n), m_data(nullptr)
+    explicit VectorN(size_type n, const value_type& val = value_type(), const Allocator& alloc = Allocator())
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(alloc), m_track()
     {
-        m_data = (m_capacity != 0) ? new value_type[m_capacity] : nullptr;
+        m_data = allocateStorage(n);
+        m_capacity = m_size = n;
         std::fill_n(m_data, m_size, val);
+        trackUsage();
     }
 
     /**
      * @brief Constructs a vector with the contents of the initializer list.
      * @param init_list The initializer list to initialize elements with.
+     * @param alloc The allocator.
      */
-    VectorN(const std::initializer_list<value_type>& init_list)
-        : m_size(init_list.size()), m_capacity(init_list.size()), m_data(nullptr)
+    VectorN(const std::initializer_list<value_type>& init_list, const Allocator& alloc = Allocator())
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(alloc), m_track()
     {
-        m_data = (m_capacity != 0) ? new value_type[m_capacity] : nullptr;
+        m_data = allocateStorage(init_list.size());
+        m_capacity = m_size = init_list.size();
         std::copy(init_list.begin(), init_list.end(), m_data);
+        trackUsage();
     }
 
     /**
      * @brief Copy constructor. Constructs a vector with a copy of the contents of other.
+     *
+     * The allocator is obtained with select_on_container_copy_construction
+     * (a polymorphic_allocator copy uses the default resource).
      * @param other Another vector to copy the contents from.
      */
     VectorN(const VectorN& other)
-        : m_size(other.m_size), m_capacity(other.m_capacity), m_data(nullptr)
+        : VectorN(other, AllocTraits::select_on_container_copy_construction(other.m_alloc))
     {
-        if (m_capacity > 0)
-        {
-            m_data = new value_type[m_capacity];
-            std::copy(other.m_data, other.m_data + m_size, m_data);
-        }
+    }
+
+    /**
+     * @brief Constructs a vector with a copy of the contents of other, using the given allocator.
+     * @param other Another vector to copy the contents from.
+     * @param alloc The allocator.
+     */
+    VectorN(const VectorN& other, const Allocator& alloc)
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(alloc), m_track(other.m_track)
+    {
+        m_data = allocateStorage(other.m_capacity);
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        std::copy(other.m_data, other.m_data + m_size, m_data);
+        trackUsage();
+    }
+
+    /**
+     * @brief Move constructor. Takes the storage and the allocator of other, which is left empty.
+     * @param other Another vector to move the contents from.
+     */
+    VectorN(VectorN&& other) noexcept
+        : m_size(std::exchange(other.m_size, 0)), m_capacity(std::exchange(other.m_capacity, 0)),
+          m_data(std::exchange(other.m_data, nullptr)), m_alloc(std::move(other.m_alloc)), m_track(other.m_track)
+    {
+        trackUsage();
+        other.trackUsage();
+    }
+
+    /**
+     * @brief Moves other into a vector using the given allocator.
+     *
+     * The storage is taken over when the allocators compare equal; otherwise
+     * the elements are moved one by one into storage from alloc.
+     * @param other Another vector to move the contents from.
+     * @param alloc The allocator.
+     */
+    VectorN(VectorN&& other, const Allocator& alloc)
+        : m_size(0), m_capacity(0), m_data(nullptr), m_alloc(alloc), m_track(other.m_track)
+    {
+        if (m_alloc == other.m_alloc)
+            stealStorage(other);
+        else
+            moveElements(other);
     }
 
     /**
      * @brief Copy assignment operator. Replaces the contents with a copy of the contents of other.
+     *
+     * The allocator is copied too when propagate_on_container_copy_assignment is true.
      * @param other Another vector to copy the contents from.
      * @return *this
      */
@@ -80,11 +165,59 @@ public:
     {
         if (this != &other)
         {
-            delete[] m_data;
+            pointer data;
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                Allocator alloc = other.m_alloc;
+                data = allocateStorage(other.m_capacity, alloc);
+                if (data)
+                    m_track.allocated(other.m_capacity * sizeof(T));
+                std::copy(other.m_data, other.m_data + other.m_size, data);
+                releaseStorage();
+                m_alloc = std::move(alloc);
+            }
+            else
+            {
+                data = allocateStorage(other.m_capacity);
+                std::copy(other.m_data, other.m_data + other.m_size, data);
+                releaseStorage();
+            }
+            m_data = data;
             m_size = other.m_size;
             m_capacity = other.m_capacity;
-            m_data = (m_capacity > 0) ? new value_type[m_capacity] : nullptr;
-            std::copy(other.m_data, other.m_data + m_size, m_data);
+            trackUsage();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Takes the storage of other when propagate_on_container_move_assignment
+     * is true (the allocator moves along) or when the allocators compare
+     * equal; otherwise the elements are moved one by one.
+     * @param other Another vector to move the contents from.
+     * @return *this
+     */
+    VectorN& operator=(VectorN&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+        || AllocTraits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            releaseStorage();
+            m_alloc = std::move(other.m_alloc);
+            stealStorage(other);
+        }
+        else if (m_alloc == other.m_alloc)
+        {
+            releaseStorage();
+            stealStorage(other);
+        }
+        else
+        {
+            moveElements(other);
         }
         return *this;
     }
@@ -94,7 +227,15 @@ public:
      */
     ~VectorN()
     {
-        delete[] m_data;
+        releaseStorage();
+    }
+
+    /**
+     * @brief Returns a copy of the allocator.
+     */
+    allocator_type get_allocator() const
+    {
+        return m_alloc;
     }
 
     /**
@@ -104,14 +245,13 @@ public:
      */
     void assign(size_type count, const value_type& value)
     {
-        delete[] m_data;
+        pointer data = allocateStorage(count);
+        std::fill_n(data, count, value);
+        releaseStorage();
+        m_data = data;
         m_size = count;
         m_capacity = count;
-        m_data = (m_capacity != 0) ? new value_type[m_capacity] : nullptr;
-        for (size_type i = 0; i < m_size; ++i)
-        {
-            m_data[i] = value;
-        }
+        trackUsage();
     }
 
     /**
@@ -124,15 +264,17 @@ public:
     void assign_range(InputIt first, InputIt last)
     {
         size_type count = static_cast<size_type>(std::distance(first, last));
-        delete[] m_data;
-        m_size = count;
-        m_capacity = count;
-        m_data = (m_capacity != 0) ? new value_type[m_capacity] : nullptr;
+        pointer data = allocateStorage(count);
         size_type i = 0;
         for (; first != last; ++first, ++i)
         {
-            m_data[i] = *first;
+            data[i] = *first;
         }
+        releaseStorage();
+        m_data = data;
+        m_size = count;
+        m_capacity = count;
+        trackUsage();
     }
 
     /**
@@ -151,6 +293,7 @@ public:
             reserve(std::max(m_capacity * 2, m_size + count));
         for (; first != last; ++first)
             m_data[m_size++] = *first;
+        trackUsage();
     }
 
     /**
@@ -289,6 +432,42 @@ public:
         return m_data + m_size;
     }
 
+    /**
+     * @brief Returns a reverse iterator to the beginning of the reversed vector.
+     * @return Reverse iterator to the last element.
+     */
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the beginning of the reversed vector.
+     * @return Const reverse iterator to the last element.
+     */
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the reversed vector.
+     * @return Reverse iterator to the element preceding the first element.
+     */
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a reverse iterator to the end of the reversed vector.
+     * @return Const reverse iterator to the element preceding the first element.
+     */
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
     /**
      * @brief Checks if the container has no elements.
      * @return true if the container is empty, false otherwise.
@@ -334,14 +513,17 @@ public:
         if (new_cap <= m_capacity)
             return;
 
-        pointer new_data = new value_type[new_cap];
+        pointer new_data = allocateStorage(new_cap);
+        if (m_data)
+            m_track.reallocated();
 
         for (size_type i = 0; i < m_size; ++i)
             new_data[i] = std::move(m_data[i]);
 
-        delete[] m_data;
+        releaseStorage();
         m_data = new_data;
         m_capacity = new_cap;
+        trackUsage();
     }
 
     /**
@@ -364,6 +546,7 @@ public:
                 m_data[i] = val;
             m_size = new_size;
         }
+        trackUsage();
     }
 
     /**
@@ -375,6 +558,7 @@ public:
         if (m_size >= m_capacity)
             reserve(m_capacity == 0 ? 1 : m_capacity * 2);
         m_data[m_size++] = val;
+        trackUsage();
     }
 
     /**
@@ -391,6 +575,7 @@ public:
 
         m_data[0] = val;
         ++m_size;
+        trackUsage();
     }
 
     /**
@@ -400,6 +585,7 @@ public:
     {
         if (m_size > 0)
             --m_size;
+        trackUsage();
     }
 
     /**
@@ -412,6 +598,7 @@ public:
         for (size_type i = 0; i < m_size - 1; ++i)
             m_data[i] = std::move(m_data[i + 1]);
         --m_size;
+        trackUsage();
     }
 
     /**
@@ -420,6 +607,7 @@ public:
     void clear()
     {
         m_size = 0;
+        trackUsage();
     }
 
 
@@ -444,6 +632,7 @@ public:
 
         m_data[index] = val;
         ++m_size;
+        trackUsage();
 
         return (begin() + index);
     }
@@ -471,6 +660,7 @@ public:
 
         m_data[index] = T(std::forward<Args>(args)...);
         ++m_size;
+        trackUsage();
 
         return (begin() + index);
     }
@@ -487,6 +677,7 @@ public:
             reserve(m_capacity == 0 ? 1 : m_capacity * 2);
 
         m_data[m_size++] = T(std::forward<Args>(args)...);
+        trackUsage();
     }
 
     /**
@@ -505,6 +696,7 @@ public:
             m_data[i] = std::move(m_data[i + 1]);
 
         --m_size;
+        trackUsage();
         return (begin() + index);
     }
 
@@ -540,17 +732,46 @@ public:
         }
 
         m_size += count;
+        trackUsage();
     }
 
     /**
      * @brief Swaps the contents of the vector with another vector.
+     *
+     * The allocators are swapped when propagate_on_container_swap is true.
+     * Otherwise, when they differ, the elements are copied so that each
+     * vector keeps storage from its own allocator.
      * @param other The vector to swap contents with.
      */
     void swap(VectorN& other)
     {
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+        }
+        else if (!(m_alloc == other.m_alloc))
+        {
+            // Each vector keeps its allocator: the elements are copied across instead of swapping storage.
+            VectorN mine(other, m_alloc);
+            VectorN theirs(*this, other.m_alloc);
+            std::swap(m_data, mine.m_data);
+            std::swap(m_size, mine.m_size);
+            std::swap(m_capacity, mine.m_capacity);
+            std::swap(other.m_data, theirs.m_data);
+            std::swap(other.m_size, theirs.m_size);
+            std::swap(other.m_capacity, theirs.m_capacity);
+            trackUsage();
+            other.trackUsage();
+            mine.trackUsage();
+            theirs.trackUsage();
+            return;
+        }
         std::swap(m_data, other.m_data);
         std::swap(m_size, other.m_size);
         std::swap(m_capacity, other.m_capacity);
+        trackUsage();
+        other.trackUsage();
     }
 
     /**
@@ -572,6 +793,102 @@ public:
     }
 
 private:
+    /**
+     * @brief Whether storage slots need no construction or destruction.
+     */
+    static constexpr bool trivialSlots = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+    /**
+     * @brief Allocates storage for n elements from alloc and constructs every slot.
+     * @param n The number of slots.
+     * @param alloc The allocator to allocate from.
+     * @return The storage, nullptr when n is 0.
+     */
+    static pointer allocateStorage(size_type n, Allocator& alloc)
+    {
+        if (n == 0)
+            return nullptr;
+        pointer data = AllocTraits::allocate(alloc, n);
+        if constexpr (!trivialSlots)
+        {
+            size_type constructed = 0;
+            try
+            {
+                for (; constructed < n; ++constructed)
+                    AllocTraits::construct(alloc, data + constructed);
+            }
+            catch (...)
+            {
+                while (constructed > 0)
+                    AllocTraits::destroy(alloc, data + --constructed);
+                AllocTraits::deallocate(alloc, data, n);
+                throw;
+            }
+        }
+        return data;
+    }
+
+    pointer allocateStorage(size_type n)
+    {
+        pointer data = allocateStorage(n, m_alloc);
+        if (data)
+            m_track.allocated(n * sizeof(T));
+        return data;
+    }
+
+    /**
+     * @brief Destroys every slot and gives the storage back to the allocator.
+     *
+     * Leaves m_size and m_capacity for the caller to set.
+     */
+    void releaseStorage()
+    {
+        if (!m_data)
+            return;
+        if constexpr (!trivialSlots)
+        {
+            for (size_type i = 0; i < m_capacity; ++i)
+                AllocTraits::destroy(m_alloc, m_data + i);
+        }
+        AllocTraits::deallocate(m_alloc, m_data, m_capacity);
+        m_track.deallocated();
+        m_data = nullptr;
+    }
+
+    /**
+     * @brief Takes the storage of other, whose allocator can release it; other is left empty.
+     */
+    void stealStorage(VectorN& other)
+    {
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        trackUsage();
+        other.trackUsage();
+    }
+
+    /**
+     * @brief Replaces the contents with the elements of other, moved one by one into storage from this allocator.
+     */
+    void moveElements(VectorN& other)
+    {
+        pointer data = allocateStorage(other.m_size);
+        std::move(other.m_data, other.m_data + other.m_size, data);
+        releaseStorage();
+        m_data = data;
+        m_size = m_capacity = other.m_size;
+        trackUsage();
+        other.clear();
+    }
+
+    /**
+     * @brief Reports the storage and size to the allocation tracker (no-op unless CONTAINERS_TRACK_ALLOCATIONS).
+     */
+    void trackUsage()
+    {
+        m_track.update(m_capacity * sizeof(T), m_size * sizeof(T));
+    }
+
     /**
      * @brief The number of elements in the vector.
      */
@@ -586,18 +903,29 @@ private:
      * @brief Pointer to the array holding the elements.
      */
     pointer m_data;
+
+    /**
+     * @brief Allocator of the storage.
+     */
+    [[no_unique_address]] Allocator m_alloc;
+
+    /**
+     * @brief Allocation accounting, empty unless CONTAINERS_TRACK_ALLOCATIONS.
+     */
+    [[no_unique_address]] AllocationTrackerN<VectorN> m_track;
 };
 
 
 /**
  * @brief Overload of the stream insertion operator for VectorN.
  * @tparam T The type of elements stored in the vector.
+ * @tparam Allocator The allocator of the vector.
  * @param os The output stream.
  * @param vec The vector to output.
  * @return The output stream.
  */
-template<typename T>
-std::ostream& operator<<(std::ostream& os, const VectorN<T>& vec)
+template<typename T, typename Allocator>
+std::ostream& operator<<(std::ostream& os, const VectorN<T, Allocator>& vec)
 {
     os << "[";
     for (std::size_t i = 0; i < vec.size(); ++i)
@@ -609,3 +937,12 @@ std::ostream& operator<<(std::ostream& os, const VectorN<T>& vec)
     os << "]";
     return os;
 }
+
+namespace pmr
+{
+/**
+ * @brief VectorN whose storage and elements allocate from a std::pmr::memory_resource.
+ */
+template<typename T>
+using VectorN = ::VectorN<T, std::pmr::polymorphic_allocator<T>>;
+}
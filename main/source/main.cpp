@@ -1,8 +1,13 @@
 #include <iostream>
+#include <string>
 #include "UnitsTests.h"
+#include "Benchmarks.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+        return Benchmark();
+
     Test();
     return 0;
 }